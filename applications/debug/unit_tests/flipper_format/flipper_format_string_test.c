@@ -326,9 +326,48 @@ MU_TEST(flipper_format_file_test) {
     furi_record_close(RECORD_STORAGE);
 }
 
+MU_TEST(flipper_format_long_array_test) {
+    // Arrays longer than the value reader window, with extra spaces around values
+    FlipperFormat* flipper_format = flipper_format_string_alloc();
+    Stream* stream = flipper_format_get_raw_stream(flipper_format);
+
+    uint8_t hex_data[200];
+    int32_t int_data[200];
+    for(size_t i = 0; i < COUNT_OF(hex_data); i++) {
+        hex_data[i] = i * 7;
+        int_data[i] = (i % 2) ? -(int32_t)(i * 12345) : (int32_t)i;
+    }
+
+    mu_check(flipper_format_write_hex(flipper_format, "Block", ARRAY_W_COUNT(hex_data)));
+    mu_check(flipper_format_write_int32(flipper_format, "RAW_Data", ARRAY_W_COUNT(int_data)));
+    mu_check(stream_write_cstring(stream, "Spaces:   01    -2 \t 03  \r\n") > 0);
+
+    uint8_t hex_read[COUNT_OF(hex_data)] = {0};
+    int32_t int_read[COUNT_OF(int_data)] = {0};
+    uint32_t count = 0;
+
+    mu_check(flipper_format_rewind(flipper_format));
+    mu_check(flipper_format_get_value_count(flipper_format, "RAW_Data", &count));
+    mu_assert_int_eq(COUNT_OF(int_data), count);
+    mu_check(flipper_format_read_hex(flipper_format, "Block", ARRAY_W_COUNT(hex_read)));
+    mu_check(memcmp(hex_data, hex_read, sizeof(hex_data)) == 0);
+    mu_check(flipper_format_read_int32(flipper_format, "RAW_Data", ARRAY_W_COUNT(int_read)));
+    mu_check(memcmp(int_data, int_read, sizeof(int_data)) == 0);
+    mu_check(flipper_format_read_int32(flipper_format, "Spaces", int_read, 3));
+    mu_assert_int_eq(-2, int_read[1]);
+    mu_assert_int_eq(3, int_read[2]);
+
+    // Less values than requested
+    mu_check(flipper_format_rewind(flipper_format));
+    mu_check(!flipper_format_read_int32(flipper_format, "Spaces", int_read, 4));
+
+    flipper_format_free(flipper_format);
+}
+
 MU_TEST_SUITE(flipper_format_string_suite) {
     MU_RUN_TEST(flipper_format_string_test);
     MU_RUN_TEST(flipper_format_file_test);
+    MU_RUN_TEST(flipper_format_long_array_test);
 }
 
 int run_minunit_test_flipper_format_string() {
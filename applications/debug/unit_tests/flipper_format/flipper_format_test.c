@@ -323,13 +323,10 @@ static bool test_append_key(const char* file_name) {
     return result;
 }
 
-static bool test_update(const char* file_name) {
-    Storage* storage = furi_record_open(RECORD_STORAGE);
+static bool test_update_keys(FlipperFormat* file) {
     bool result = false;
-    FlipperFormat* file = flipper_format_file_alloc(storage);
 
     do {
-        if(!flipper_format_file_open_existing(file, file_name)) break;
         if(!flipper_format_update_string_cstr(file, test_string_key, test_string_updated_data))
             break;
         if(!flipper_format_update_int32(
@@ -351,6 +348,95 @@ static bool test_update(const char* file_name) {
         result = true;
     } while(false);
 
+    return result;
+}
+
+static bool test_update(const char* file_name) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    bool result = false;
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+
+    do {
+        if(!flipper_format_file_open_existing(file, file_name)) break;
+        if(!test_update_keys(file)) break;
+
+        result = true;
+    } while(false);
+
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
+
+static bool test_update_transaction(const char* file_name, bool commit) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    bool result = false;
+    FlipperFormat* file = flipper_format_buffered_file_alloc(storage);
+
+    do {
+        if(!flipper_format_buffered_file_open_existing(file, file_name)) break;
+        if(!flipper_format_transaction_begin(file)) break;
+        if(!test_update_keys(file)) break;
+
+        // Edits are visible before commit
+        if(!flipper_format_rewind(file)) break;
+        FuriString* string = furi_string_alloc();
+        bool updated = flipper_format_read_string(file, test_string_key, string) &&
+                       furi_string_equal(string, test_string_updated_data);
+        furi_string_free(string);
+        if(!updated) break;
+
+        if(commit) {
+            if(!flipper_format_transaction_commit(file)) break;
+        } else {
+            flipper_format_transaction_abort(file);
+        }
+        if(!flipper_format_buffered_file_close(file)) break;
+
+        result = true;
+    } while(false);
+
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
+
+static bool test_transaction_recover(const char* file_name) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    bool result = false;
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+    FuriString* tmp_path = furi_string_alloc_printf("%s.tmp", file_name);
+    FuriString* backup_path = furi_string_alloc_printf("%s.old.tmp", file_name);
+
+    do {
+        // Commit interrupted after original file was moved to backup
+        if(storage_common_copy(storage, file_name, furi_string_get_cstr(tmp_path)) != FSE_OK)
+            break;
+        if(storage_common_rename(storage, file_name, furi_string_get_cstr(backup_path)) !=
+           FSE_OK)
+            break;
+        if(!flipper_format_file_open_existing(file, file_name)) break;
+        if(!flipper_format_file_close(file)) break;
+        if(storage_common_exists(storage, furi_string_get_cstr(tmp_path)) ||
+           storage_common_exists(storage, furi_string_get_cstr(backup_path)))
+            break;
+
+        // Commit interrupted while new file was written: open keeps it, next transaction drops it
+        if(!storage_write_string(furi_string_get_cstr(tmp_path), "Filetype: ")) break;
+        if(!flipper_format_file_open_existing(file, file_name)) break;
+        if(!storage_common_exists(storage, furi_string_get_cstr(tmp_path))) break;
+        if(!flipper_format_transaction_begin(file)) break;
+        flipper_format_transaction_abort(file);
+        if(!flipper_format_file_close(file)) break;
+        if(storage_common_exists(storage, furi_string_get_cstr(tmp_path))) break;
+
+        result = true;
+    } while(false);
+
+    furi_string_free(backup_path);
+    furi_string_free(tmp_path);
     flipper_format_free(file);
     furi_record_close(RECORD_STORAGE);
 
@@ -517,6 +603,25 @@ MU_TEST(flipper_format_update_2_result_test) {
     mu_assert(test_read(test_file_flipper), "Data #2 updated incorrectly [Flipper]");
 }
 
+MU_TEST(flipper_format_transaction_abort_test) {
+    mu_assert(
+        test_update_transaction(test_file_linux, false), "Cannot abort transaction [Linux]");
+    mu_assert(test_read(test_file_linux), "Transaction abort changed data [Linux]");
+}
+
+MU_TEST(flipper_format_transaction_commit_test) {
+    mu_assert(
+        test_update_transaction(test_file_windows, true), "Cannot commit transaction [Windows]");
+    mu_assert(test_read_updated(test_file_windows), "Transaction committed incorrectly [Windows]");
+    mu_assert(test_update_backward(test_file_windows), "Cannot update data #3 [Windows]");
+    mu_assert(test_read(test_file_windows), "Data #3 updated incorrectly [Windows]");
+}
+
+MU_TEST(flipper_format_transaction_recover_test) {
+    mu_assert(test_transaction_recover(test_file_windows), "Cannot recover transaction [Windows]");
+    mu_assert(test_read(test_file_windows), "Transaction recovered incorrectly [Windows]");
+}
+
 MU_TEST(flipper_format_multikey_test) {
     mu_assert(test_write_multikey(TEST_DIR "ff_multiline.test"), "Multikey write test error");
     mu_assert(test_read_multikey(TEST_DIR "ff_multiline.test"), "Multikey read test error");
@@ -540,6 +645,9 @@ MU_TEST_SUITE(flipper_format) {
     MU_RUN_TEST(flipper_format_update_1_result_test);
     MU_RUN_TEST(flipper_format_update_2_test);
     MU_RUN_TEST(flipper_format_update_2_result_test);
+    MU_RUN_TEST(flipper_format_transaction_abort_test);
+    MU_RUN_TEST(flipper_format_transaction_commit_test);
+    MU_RUN_TEST(flipper_format_transaction_recover_test);
     MU_RUN_TEST(flipper_format_multikey_test);
     MU_RUN_TEST(flipper_format_oddities_test);
     tests_teardown();
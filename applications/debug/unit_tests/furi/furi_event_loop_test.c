@@ -0,0 +1,277 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include "../minunit.h"
+
+#define TAG "TestFuriEventLoop"
+
+#define EVENT_LOOP_EVENT_COUNT (10)
+#define EVENT_LOOP_LATENCY_ROUNDS (1000)
+
+#define EVENT_LOOP_FLAG_PRODUCER (1UL << 0)
+#define EVENT_LOOP_FLAG_ACK (1UL << 1)
+
+typedef struct {
+    FuriEventLoop* event_loop;
+    FuriThreadId consumer_id;
+    FuriThreadId producer_id;
+    FuriMessageQueue* queue;
+    FuriStreamBuffer* stream_buffer;
+
+    uint32_t queue_count;
+    uint32_t queue_errors;
+    uint32_t stream_count;
+    uint32_t stream_errors;
+    uint32_t flags_count;
+    uint32_t timer_count;
+    uint32_t timer_once_count;
+} TestFuriEventLoopData;
+
+static bool test_furi_event_loop_is_done(TestFuriEventLoopData* data) {
+    return data->queue_count == EVENT_LOOP_EVENT_COUNT &&
+           data->stream_count == EVENT_LOOP_EVENT_COUNT &&
+           data->flags_count == EVENT_LOOP_EVENT_COUNT && data->timer_count >= 3;
+}
+
+static void test_furi_event_loop_queue_callback(FuriMessageQueue* queue, void* context) {
+    TestFuriEventLoopData* data = context;
+
+    // Read one message per call, the loop has to call again while the queue is not empty
+    uint32_t value = 0;
+    furi_check(furi_message_queue_get(queue, &value, 0) == FuriStatusOk);
+    if(value != data->queue_count) data->queue_errors++;
+    data->queue_count++;
+
+    if(test_furi_event_loop_is_done(data)) furi_event_loop_stop(data->event_loop);
+}
+
+static void test_furi_event_loop_stream_callback(FuriStreamBuffer* stream_buffer, void* context) {
+    TestFuriEventLoopData* data = context;
+
+    uint8_t value = 0;
+    while(furi_stream_buffer_receive(stream_buffer, &value, 1, 0) == 1) {
+        if(value != data->stream_count) data->stream_errors++;
+        data->stream_count++;
+    }
+
+    if(test_furi_event_loop_is_done(data)) furi_event_loop_stop(data->event_loop);
+}
+
+static void test_furi_event_loop_flags_callback(uint32_t flags, void* context) {
+    TestFuriEventLoopData* data = context;
+
+    if(flags & EVENT_LOOP_FLAG_PRODUCER) data->flags_count++;
+    furi_thread_flags_set(data->producer_id, EVENT_LOOP_FLAG_ACK);
+
+    if(test_furi_event_loop_is_done(data)) furi_event_loop_stop(data->event_loop);
+}
+
+static void test_furi_event_loop_timer_callback(void* context) {
+    TestFuriEventLoopData* data = context;
+
+    data->timer_count++;
+
+    if(test_furi_event_loop_is_done(data)) furi_event_loop_stop(data->event_loop);
+}
+
+static void test_furi_event_loop_timer_once_callback(void* context) {
+    TestFuriEventLoopData* data = context;
+    data->timer_once_count++;
+}
+
+static int32_t test_furi_event_loop_producer(void* context) {
+    TestFuriEventLoopData* data = context;
+
+    for(uint32_t i = 0; i < EVENT_LOOP_EVENT_COUNT; i++) {
+        uint8_t byte = i;
+        furi_check(furi_message_queue_put(data->queue, &i, FuriWaitForever) == FuriStatusOk);
+        furi_check(furi_stream_buffer_send(data->stream_buffer, &byte, 1, FuriWaitForever) == 1);
+        furi_thread_flags_set(data->consumer_id, EVENT_LOOP_FLAG_PRODUCER);
+        // Let the consumer catch up, so every flag is seen separately
+        furi_thread_flags_wait(EVENT_LOOP_FLAG_ACK, FuriFlagWaitAny, FuriWaitForever);
+    }
+
+    return 0;
+}
+
+void test_furi_event_loop() {
+    TestFuriEventLoopData data = {0};
+
+    data.event_loop = furi_event_loop_alloc();
+    data.consumer_id = furi_thread_get_current_id();
+    data.queue = furi_message_queue_alloc(4, sizeof(uint32_t));
+    data.stream_buffer = furi_stream_buffer_alloc(4, 1);
+
+    FuriThread* producer =
+        furi_thread_alloc_ex("TestEventLoopProducer", 1024, test_furi_event_loop_producer, &data);
+
+    furi_event_loop_subscribe_message_queue(
+        data.event_loop, data.queue, test_furi_event_loop_queue_callback, &data);
+    furi_event_loop_subscribe_stream_buffer(
+        data.event_loop, data.stream_buffer, test_furi_event_loop_stream_callback, &data);
+    furi_event_loop_subscribe_thread_flags(
+        data.event_loop, EVENT_LOOP_FLAG_PRODUCER, test_furi_event_loop_flags_callback, &data);
+
+    FuriEventLoopTimer* timer = furi_event_loop_timer_alloc(
+        data.event_loop,
+        test_furi_event_loop_timer_callback,
+        FuriEventLoopTimerTypePeriodic,
+        &data);
+    FuriEventLoopTimer* timer_once = furi_event_loop_timer_alloc(
+        data.event_loop,
+        test_furi_event_loop_timer_once_callback,
+        FuriEventLoopTimerTypeOnce,
+        &data);
+    furi_event_loop_timer_start(timer, 5);
+    furi_event_loop_timer_start(timer_once, 1);
+
+    furi_thread_start(producer);
+    data.producer_id = furi_thread_get_id(producer);
+    furi_event_loop_run(data.event_loop);
+    furi_thread_join(producer);
+
+    mu_assert_int_eq(EVENT_LOOP_EVENT_COUNT, data.queue_count);
+    mu_assert_int_eq(0, data.queue_errors);
+    mu_assert_int_eq(EVENT_LOOP_EVENT_COUNT, data.stream_count);
+    mu_assert_int_eq(0, data.stream_errors);
+    mu_assert_int_eq(EVENT_LOOP_EVENT_COUNT, data.flags_count);
+    mu_assert(data.timer_count >= 3, "periodic timer didn't fire");
+    mu_assert_int_eq(1, data.timer_once_count);
+    mu_assert(!furi_event_loop_timer_is_running(timer_once), "one-shot timer still running");
+    mu_assert(furi_event_loop_timer_is_running(timer), "periodic timer stopped");
+
+    furi_event_loop_timer_free(timer);
+    furi_event_loop_timer_free(timer_once);
+    furi_event_loop_unsubscribe_thread_flags(data.event_loop);
+    furi_event_loop_unsubscribe(data.event_loop, data.stream_buffer);
+    furi_event_loop_unsubscribe(data.event_loop, data.queue);
+
+    furi_thread_free(producer);
+    furi_stream_buffer_free(data.stream_buffer);
+    furi_message_queue_free(data.queue);
+    furi_event_loop_free(data.event_loop);
+}
+
+typedef struct {
+    FuriEventLoop* event_loop;
+    FuriMessageQueue* queue;
+    FuriThreadId producer_id;
+    uint32_t rounds;
+    uint64_t total;
+    uint32_t max;
+} TestFuriEventLoopLatency;
+
+static void
+    test_furi_event_loop_latency_record(TestFuriEventLoopLatency* latency, uint32_t sent) {
+    uint32_t delta = furi_hal_cortex_timer_get(0).start - sent;
+    latency->total += delta;
+    if(delta > latency->max) latency->max = delta;
+    latency->rounds++;
+    furi_thread_flags_set(latency->producer_id, EVENT_LOOP_FLAG_ACK);
+}
+
+static int32_t test_furi_event_loop_latency_producer(void* context) {
+    TestFuriEventLoopLatency* latency = context;
+
+    for(uint32_t i = 0; i < EVENT_LOOP_LATENCY_ROUNDS; i++) {
+        uint32_t sent = furi_hal_cortex_timer_get(0).start;
+        furi_check(furi_message_queue_put(latency->queue, &sent, FuriWaitForever) == FuriStatusOk);
+        furi_thread_flags_wait(EVENT_LOOP_FLAG_ACK, FuriFlagWaitAny, FuriWaitForever);
+    }
+
+    return 0;
+}
+
+static void test_furi_event_loop_latency_callback(FuriMessageQueue* queue, void* context) {
+    TestFuriEventLoopLatency* latency = context;
+
+    uint32_t sent = 0;
+    furi_check(furi_message_queue_get(queue, &sent, 0) == FuriStatusOk);
+    test_furi_event_loop_latency_record(latency, sent);
+
+    if(latency->rounds == EVENT_LOOP_LATENCY_ROUNDS) furi_event_loop_stop(latency->event_loop);
+}
+
+static void test_furi_event_loop_idle_callback(void* context) {
+    UNUSED(context);
+}
+
+static FuriThread*
+    test_furi_event_loop_latency_producer_alloc(TestFuriEventLoopLatency* latency) {
+    FuriThread* producer = furi_thread_alloc_ex(
+        "TestEventLoopLatency", 1024, test_furi_event_loop_latency_producer, latency);
+    // Consumer preempts the producer right on put, so the wakeup path is measured alone
+    furi_thread_set_priority(producer, FuriThreadPriorityLow);
+    return producer;
+}
+
+void test_furi_event_loop_latency() {
+    uint32_t ipus = furi_hal_cortex_instructions_per_microsecond();
+
+    // Baseline: consumer blocked in furi_message_queue_get
+    TestFuriEventLoopLatency baseline = {0};
+    baseline.queue = furi_message_queue_alloc(1, sizeof(uint32_t));
+    FuriThread* producer = test_furi_event_loop_latency_producer_alloc(&baseline);
+    furi_thread_start(producer);
+    baseline.producer_id = furi_thread_get_id(producer);
+    while(baseline.rounds < EVENT_LOOP_LATENCY_ROUNDS) {
+        uint32_t sent = 0;
+        furi_check(
+            furi_message_queue_get(baseline.queue, &sent, FuriWaitForever) == FuriStatusOk);
+        test_furi_event_loop_latency_record(&baseline, sent);
+    }
+    furi_thread_join(producer);
+    furi_thread_free(producer);
+    furi_message_queue_free(baseline.queue);
+
+    // Same queue through the event loop, with an idle timer around
+    TestFuriEventLoopLatency latency = {0};
+    latency.event_loop = furi_event_loop_alloc();
+    latency.queue = furi_message_queue_alloc(1, sizeof(uint32_t));
+    furi_event_loop_subscribe_message_queue(
+        latency.event_loop, latency.queue, test_furi_event_loop_latency_callback, &latency);
+    FuriEventLoopTimer* timer = furi_event_loop_timer_alloc(
+        latency.event_loop,
+        test_furi_event_loop_idle_callback,
+        FuriEventLoopTimerTypeOnce,
+        NULL);
+    furi_event_loop_timer_start(timer, 60000);
+
+    producer = test_furi_event_loop_latency_producer_alloc(&latency);
+    furi_thread_start(producer);
+    latency.producer_id = furi_thread_get_id(producer);
+    furi_event_loop_run(latency.event_loop);
+    furi_thread_join(producer);
+    furi_thread_free(producer);
+
+    furi_event_loop_timer_free(timer);
+    furi_event_loop_unsubscribe(latency.event_loop, latency.queue);
+    furi_message_queue_free(latency.queue);
+    furi_event_loop_free(latency.event_loop);
+
+    mu_assert_int_eq(EVENT_LOOP_LATENCY_ROUNDS, baseline.rounds);
+    mu_assert_int_eq(EVENT_LOOP_LATENCY_ROUNDS, latency.rounds);
+
+    FURI_LOG_I(
+        TAG,
+        "Wakeup latency, us avg/max: queue get %lu/%lu, event loop %lu/%lu",
+        (uint32_t)(baseline.total / baseline.rounds / ipus),
+        baseline.max / ipus,
+        (uint32_t)(latency.total / latency.rounds / ipus),
+        latency.max / ipus);
+}
+
+void test_furi_stream_buffer_full() {
+    const uint8_t data[] = {0x11, 0x22, 0x33, 0x44};
+    uint8_t received[sizeof(data)] = {0};
+
+    // Trigger level equal to size, like LF RFID emulation streams
+    FuriStreamBuffer* stream_buffer = furi_stream_buffer_alloc(sizeof(data), sizeof(data));
+
+    mu_assert_int_eq(sizeof(data), furi_stream_buffer_send(stream_buffer, data, sizeof(data), 0));
+    mu_assert_int_eq(sizeof(data), furi_stream_buffer_bytes_available(stream_buffer));
+    mu_assert_int_eq(
+        sizeof(data), furi_stream_buffer_receive(stream_buffer, received, sizeof(data), 100));
+    mu_assert_mem_eq(data, received, sizeof(data));
+
+    furi_stream_buffer_free(stream_buffer);
+}
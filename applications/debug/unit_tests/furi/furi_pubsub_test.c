@@ -43,3 +43,120 @@ void test_furi_pubsub() {
     // delete pubsub case
     furi_pubsub_free(test_pubsub);
 }
+
+typedef struct {
+    FuriSemaphore* entered;
+    FuriSemaphore* gate;
+    uint32_t values[4];
+    uint32_t count;
+} TestPubSubAsync;
+
+void test_pubsub_async_handler(const void* arg, void* ctx) {
+    TestPubSubAsync* test = ctx;
+    if(test->count == 0) {
+        // Hold the dispatcher on the first message, so the queue fills up
+        furi_semaphore_release(test->entered);
+        furi_check(furi_semaphore_acquire(test->gate, FuriWaitForever) == FuriStatusOk);
+    }
+    if(test->count < COUNT_OF(test->values)) test->values[test->count] = *(uint32_t*)arg;
+    test->count++;
+}
+
+void test_furi_pubsub_async() {
+    TestPubSubAsync test = {0};
+    test.entered = furi_semaphore_alloc(1, 0);
+    test.gate = furi_semaphore_alloc(1, 0);
+    pubsub_value = 0;
+
+    FuriPubSub* test_pubsub = furi_pubsub_alloc_ex(sizeof(uint32_t), 2);
+    FuriPubSubSubscription* sync_subscription =
+        furi_pubsub_subscribe(test_pubsub, test_pubsub_handler, (void*)&context_value);
+    FuriPubSubSubscription* async_subscription = furi_pubsub_subscribe_ex(
+        test_pubsub, test_pubsub_async_handler, &test, FuriPubSubDeliveryAsync);
+
+    // First message is taken by the dispatcher, which then blocks in the callback
+    uint32_t value = 1;
+    furi_pubsub_publish(test_pubsub, &value);
+    mu_assert_int_eq(1, pubsub_value);
+    mu_assert_int_eq(FuriStatusOk, furi_semaphore_acquire(test.entered, furi_ms_to_ticks(1000)));
+
+    // Two more fit in the queue, the last one is dropped, publisher never waits
+    for(value = 2; value <= 4; value++) {
+        furi_pubsub_publish(test_pubsub, &value);
+        mu_assert_int_eq(value, pubsub_value);
+    }
+    mu_assert_int_eq(2, furi_pubsub_get_queue_count(test_pubsub));
+    mu_assert_int_eq(1, furi_pubsub_get_dropped_count(test_pubsub));
+
+    furi_semaphore_release(test.gate);
+    for(size_t i = 0; i < 100 && test.count < 3; i++) {
+        furi_delay_ms(10);
+    }
+
+    furi_pubsub_unsubscribe(test_pubsub, async_subscription);
+    furi_pubsub_unsubscribe(test_pubsub, sync_subscription);
+    furi_pubsub_free(test_pubsub);
+
+    mu_assert_int_eq(3, test.count);
+    mu_assert_int_eq(1, test.values[0]);
+    mu_assert_int_eq(2, test.values[1]);
+    mu_assert_int_eq(3, test.values[2]);
+
+    furi_semaphore_free(test.gate);
+    furi_semaphore_free(test.entered);
+}
+
+typedef struct {
+    FuriPubSub* pubsub;
+    FuriPubSubSubscription* subscription;
+    FuriSemaphore* done;
+    uint32_t count;
+} TestPubSubAsyncUnsubscribe;
+
+void test_pubsub_async_unsubscribe_handler(const void* arg, void* ctx) {
+    UNUSED(arg);
+    TestPubSubAsyncUnsubscribe* test = ctx;
+    test->count++;
+    // Unsubscribe itself while the dispatcher walks the list
+    furi_pubsub_unsubscribe(test->pubsub, test->subscription);
+    furi_semaphore_release(test->done);
+}
+
+void test_pubsub_async_counter_handler(const void* arg, void* ctx) {
+    UNUSED(arg);
+    TestPubSubAsyncUnsubscribe* test = ctx;
+    test->count++;
+    furi_semaphore_release(test->done);
+}
+
+void test_furi_pubsub_async_unsubscribe() {
+    TestPubSubAsyncUnsubscribe self = {0};
+    TestPubSubAsyncUnsubscribe other = {0};
+    self.done = furi_semaphore_alloc(2, 0);
+    other.done = furi_semaphore_alloc(2, 0);
+
+    FuriPubSub* test_pubsub = furi_pubsub_alloc_ex(sizeof(uint32_t), 4);
+    self.pubsub = test_pubsub;
+    FuriPubSubSubscription* other_subscription = furi_pubsub_subscribe_ex(
+        test_pubsub, test_pubsub_async_counter_handler, &other, FuriPubSubDeliveryAsync);
+    self.subscription = furi_pubsub_subscribe_ex(
+        test_pubsub, test_pubsub_async_unsubscribe_handler, &self, FuriPubSubDeliveryAsync);
+
+    uint32_t value = 1;
+    furi_pubsub_publish(test_pubsub, &value);
+    mu_assert_int_eq(FuriStatusOk, furi_semaphore_acquire(self.done, furi_ms_to_ticks(1000)));
+    mu_assert_int_eq(FuriStatusOk, furi_semaphore_acquire(other.done, furi_ms_to_ticks(1000)));
+
+    // Removed subscriber gets nothing, the other one still does
+    furi_pubsub_publish(test_pubsub, &value);
+    mu_assert_int_eq(FuriStatusOk, furi_semaphore_acquire(other.done, furi_ms_to_ticks(1000)));
+
+    furi_pubsub_unsubscribe(test_pubsub, other_subscription);
+    furi_pubsub_free(test_pubsub);
+
+    mu_assert_int_eq(1, self.count);
+    mu_assert_int_eq(2, other.count);
+
+    furi_semaphore_free(self.done);
+    furi_semaphore_free(other.done);
+}
@@ -7,6 +7,11 @@
 void test_furi_create_open();
 void test_furi_concurrent_access();
 void test_furi_pubsub();
+void test_furi_pubsub_async();
+void test_furi_pubsub_async_unsubscribe();
+void test_furi_event_loop();
+void test_furi_event_loop_latency();
+void test_furi_stream_buffer_full();
 
 void test_furi_memmgr();
 
@@ -33,6 +38,26 @@ MU_TEST(mu_test_furi_pubsub) {
     test_furi_pubsub();
 }
 
+MU_TEST(mu_test_furi_pubsub_async) {
+    test_furi_pubsub_async();
+}
+
+MU_TEST(mu_test_furi_pubsub_async_unsubscribe) {
+    test_furi_pubsub_async_unsubscribe();
+}
+
+MU_TEST(mu_test_furi_event_loop) {
+    test_furi_event_loop();
+}
+
+MU_TEST(mu_test_furi_event_loop_latency) {
+    test_furi_event_loop_latency();
+}
+
+MU_TEST(mu_test_furi_stream_buffer_full) {
+    test_furi_stream_buffer_full();
+}
+
 MU_TEST(mu_test_furi_memmgr) {
     // this test is not accurate, but gives a basic understanding
     // that memory management is working fine
@@ -47,6 +72,11 @@ MU_TEST_SUITE(test_suite) {
     // v2 tests
     MU_RUN_TEST(mu_test_furi_create_open);
     MU_RUN_TEST(mu_test_furi_pubsub);
+    MU_RUN_TEST(mu_test_furi_pubsub_async);
+    MU_RUN_TEST(mu_test_furi_pubsub_async_unsubscribe);
+    MU_RUN_TEST(mu_test_furi_event_loop);
+    MU_RUN_TEST(mu_test_furi_event_loop_latency);
+    MU_RUN_TEST(mu_test_furi_stream_buffer_full);
     MU_RUN_TEST(mu_test_furi_memmgr);
 }
 
@@ -0,0 +1,138 @@
+#include <furi.h>
+#include <gui/text_layout_i.h>
+#include <toolbox/stream/string_stream.h>
+#include "../minunit.h"
+
+#define TEXT_LAYOUT_TEST_WIDTH 120
+
+static const char* text_layout_test_texts[] = {
+    "",
+    "Short line",
+    "Line one\nLine two\n\nLine four\n",
+    "\n\n",
+    "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor "
+    "incididunt ut labore et dolore magna aliqua. Ut enim ad minim veniam, quis nostrud "
+    "exercitation ullamco laboris nisi ut aliquip ex ea commodo consequat.",
+    "WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW\nillllllllllll",
+    "\xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82, \xD0\xBC\xD0\xB8\xD1\x80! "
+    "\xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82, \xD0\xBC\xD0\xB8\xD1\x80!",
+    "Tabs\tand\tcontrol\x01\x02\x03 bytes\r\n",
+    // Over 64 bytes of zero width glyphs on one screen line
+    "\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01"
+    "\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01"
+    "\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01"
+    "\x01\x01\x01\x01\x01\x01\x01\x01\x01\x01 visible text after them",
+};
+
+static void text_layout_test_widths(uint8_t* widths) {
+    for(size_t i = 0; i < 256; i++) {
+        if(i < ' ' || i == 0x7F) {
+            widths[i] = 0;
+        } else if(i > 0x7F) {
+            widths[i] = 6;
+        } else if(strchr("il!.,'", (char)i)) {
+            widths[i] = 2;
+        } else if(strchr("MWmw", (char)i)) {
+            widths[i] = 6;
+        } else {
+            widths[i] = 5;
+        }
+    }
+}
+
+// TextBox wrapping before TextLayout: new line when glyph doesn't fit, glyphs are kept as is
+static void
+    text_layout_test_reference(const char* text, const uint8_t* widths, FuriString* result) {
+    size_t line_width = 0;
+    furi_string_reset(result);
+
+    for(size_t i = 0; text[i] != '\0'; i++) {
+        char symb = text[i];
+        if(symb != '\n') {
+            size_t glyph_width = widths[(uint8_t)symb];
+            if(line_width + glyph_width > TEXT_LAYOUT_TEST_WIDTH) {
+                line_width = 0;
+                furi_string_push_back(result, '\n');
+            }
+            line_width += glyph_width;
+        } else {
+            line_width = 0;
+        }
+        furi_string_push_back(result, symb);
+    }
+}
+
+static void text_layout_test_lines(TextLayout* layout, const char* text, FuriString* result) {
+    size_t size = strlen(text);
+    size_t start = 0;
+    furi_string_reset(result);
+
+    for(;;) {
+        size_t end;
+        size_t next = text_layout_get_line(layout, start, &end);
+        for(size_t i = start; i < end; i++) {
+            furi_string_push_back(result, text[i]);
+        }
+        if(next == start || (next == size && text[size - 1] != '\n')) break;
+        furi_string_push_back(result, '\n');
+        start = next;
+    }
+}
+
+MU_TEST(text_layout_test_text) {
+    uint8_t widths[256];
+    text_layout_test_widths(widths);
+    FuriString* expected = furi_string_alloc();
+    FuriString* result = furi_string_alloc();
+    TextLayout* layout = text_layout_alloc();
+    text_layout_set_width(layout, TEXT_LAYOUT_TEST_WIDTH);
+    text_layout_set_glyph_widths(layout, widths);
+
+    for(size_t i = 0; i < COUNT_OF(text_layout_test_texts); i++) {
+        const char* text = text_layout_test_texts[i];
+        text_layout_set_text(layout, text);
+        text_layout_test_reference(text, widths, expected);
+        text_layout_test_lines(layout, text, result);
+        mu_assert_string_eq(furi_string_get_cstr(expected), furi_string_get_cstr(result));
+    }
+
+    text_layout_free(layout);
+    furi_string_free(result);
+    furi_string_free(expected);
+}
+
+MU_TEST(text_layout_test_stream) {
+    uint8_t widths[256];
+    text_layout_test_widths(widths);
+    FuriString* expected = furi_string_alloc();
+    FuriString* result = furi_string_alloc();
+    Stream* stream = string_stream_alloc();
+    TextLayout* layout = text_layout_alloc();
+    text_layout_set_width(layout, TEXT_LAYOUT_TEST_WIDTH);
+    text_layout_set_glyph_widths(layout, widths);
+
+    for(size_t i = 0; i < COUNT_OF(text_layout_test_texts); i++) {
+        const char* text = text_layout_test_texts[i];
+        stream_clean(stream);
+        stream_write_cstring(stream, text);
+        text_layout_set_stream(layout, stream);
+        text_layout_test_reference(text, widths, expected);
+        text_layout_test_lines(layout, text, result);
+        mu_assert_string_eq(furi_string_get_cstr(expected), furi_string_get_cstr(result));
+    }
+
+    text_layout_free(layout);
+    stream_free(stream);
+    furi_string_free(result);
+    furi_string_free(expected);
+}
+
+MU_TEST_SUITE(test_text_layout_suite) {
+    MU_RUN_TEST(text_layout_test_text);
+    MU_RUN_TEST(text_layout_test_stream);
+}
+
+int run_minunit_test_text_layout() {
+    MU_RUN_SUITE(test_text_layout_suite);
+    return MU_EXIT_CODE;
+}
@@ -0,0 +1,134 @@
+#include <furi.h>
+#include <storage/storage.h>
+#include <lfrfid/lfrfid_raw_file.h>
+#include <lfrfid/tools/varint_pair.h>
+#include "../minunit.h"
+
+#define LFRFID_RAW_TEST_FILE_PATH EXT_PATH("unit_tests/lfrfid_raw_test.raw")
+#define LFRFID_RAW_TEST_PAIRS_COUNT 5000
+#define LFRFID_RAW_TEST_BUFFER_SIZE 256
+
+typedef void (*LFRFIDRawTestPair)(size_t index, uint32_t* pulse, uint32_t* duration);
+
+static void lfrfid_raw_test_pair(size_t index, uint32_t* pulse, uint32_t* duration) {
+    // EM4100-like timings with some jitter and rare long gaps
+    *duration = ((index % 3) == 0 ? 512 : 256) + (index * 7) % 13;
+    if(index % 1000 == 999) *duration = 100000;
+    *pulse = *duration / 2 - (index % 5);
+}
+
+static uint32_t lfrfid_raw_test_hash(uint32_t value) {
+    value ^= value >> 16;
+    value *= 0x7FEB352D;
+    value ^= value >> 15;
+    value *= 0x846CA68B;
+    value ^= value >> 16;
+    return value;
+}
+
+static void lfrfid_raw_test_pair_random(size_t index, uint32_t* pulse, uint32_t* duration) {
+    // Random full range values, blocks can't be compressed and are stored as is
+    *duration = lfrfid_raw_test_hash(index * 2);
+    *pulse = lfrfid_raw_test_hash(index * 2 + 1);
+}
+
+static void lfrfid_raw_test_write(
+    Storage* storage,
+    bool compressed,
+    LFRFIDRawTestPair test_pair) {
+    LFRFIDRawFile* file = lfrfid_raw_file_alloc(storage);
+    VarintPair* pair = varint_pair_alloc();
+    uint8_t* buffer = malloc(LFRFID_RAW_TEST_BUFFER_SIZE);
+    size_t buffer_size = 0;
+
+    mu_assert(lfrfid_raw_file_open_write(file, LFRFID_RAW_TEST_FILE_PATH), "open write failed");
+    lfrfid_raw_file_set_compressed(file, compressed);
+    mu_assert(
+        lfrfid_raw_file_write_header(file, 125000, 0.5, LFRFID_RAW_TEST_BUFFER_SIZE),
+        "write header failed");
+
+    for(size_t i = 0; i < LFRFID_RAW_TEST_PAIRS_COUNT; i++) {
+        uint32_t pulse, duration;
+        test_pair(i, &pulse, &duration);
+        varint_pair_pack(pair, true, pulse);
+        mu_assert(varint_pair_pack(pair, false, duration), "pair pack failed");
+
+        if(buffer_size + varint_pair_get_size(pair) > LFRFID_RAW_TEST_BUFFER_SIZE) {
+            mu_assert(lfrfid_raw_file_write_buffer(file, buffer, buffer_size), "write failed");
+            buffer_size = 0;
+        }
+
+        memcpy(&buffer[buffer_size], varint_pair_get_data(pair), varint_pair_get_size(pair));
+        buffer_size += varint_pair_get_size(pair);
+        varint_pair_reset(pair);
+    }
+
+    mu_assert(lfrfid_raw_file_write_buffer(file, buffer, buffer_size), "write failed");
+    mu_assert(lfrfid_raw_file_finalize(file), "finalize failed");
+
+    free(buffer);
+    varint_pair_free(pair);
+    lfrfid_raw_file_free(file);
+}
+
+static void lfrfid_raw_test_read(Storage* storage, LFRFIDRawTestPair test_pair) {
+    LFRFIDRawFile* file = lfrfid_raw_file_alloc(storage);
+    float frequency, duty_cycle;
+
+    mu_assert(lfrfid_raw_file_open_read(file, LFRFID_RAW_TEST_FILE_PATH), "open read failed");
+    mu_assert(lfrfid_raw_file_read_header(file, &frequency, &duty_cycle), "read header failed");
+    mu_assert_double_eq(125000, frequency);
+    mu_assert_double_eq(0.5, duty_cycle);
+
+    // read all pairs twice to check wrap around
+    for(size_t pass = 0; pass < 2; pass++) {
+        for(size_t i = 0; i < LFRFID_RAW_TEST_PAIRS_COUNT; i++) {
+            uint32_t expected_pulse, expected_duration;
+            uint32_t pulse, duration;
+            bool pass_end = false;
+            test_pair(i, &expected_pulse, &expected_duration);
+            mu_assert(
+                lfrfid_raw_file_read_pair(file, &duration, &pulse, &pass_end), "read failed");
+            mu_assert_int_eq(expected_pulse, pulse);
+            mu_assert_int_eq(expected_duration, duration);
+            mu_assert(pass_end == (pass == 1 && i == 0), "unexpected pass end");
+        }
+    }
+
+    lfrfid_raw_file_free(file);
+}
+
+MU_TEST(test_lfrfid_raw_file_plain) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    lfrfid_raw_test_write(storage, false, lfrfid_raw_test_pair);
+    lfrfid_raw_test_read(storage, lfrfid_raw_test_pair);
+    storage_simply_remove(storage, LFRFID_RAW_TEST_FILE_PATH);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(test_lfrfid_raw_file_compressed) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    lfrfid_raw_test_write(storage, true, lfrfid_raw_test_pair);
+    lfrfid_raw_test_read(storage, lfrfid_raw_test_pair);
+    storage_simply_remove(storage, LFRFID_RAW_TEST_FILE_PATH);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(test_lfrfid_raw_file_compressed_random) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    lfrfid_raw_test_write(storage, true, lfrfid_raw_test_pair_random);
+    lfrfid_raw_test_read(storage, lfrfid_raw_test_pair_random);
+    storage_simply_remove(storage, LFRFID_RAW_TEST_FILE_PATH);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST_SUITE(test_lfrfid_raw_file_suite) {
+    MU_RUN_TEST(test_lfrfid_raw_file_plain);
+    MU_RUN_TEST(test_lfrfid_raw_file_compressed);
+    MU_RUN_TEST(test_lfrfid_raw_file_compressed_random);
+}
+
+int run_minunit_test_lfrfid_raw_file() {
+    MU_RUN_SUITE(test_lfrfid_raw_file_suite);
+    return MU_EXIT_CODE;
+}
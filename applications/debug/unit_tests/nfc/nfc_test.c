@@ -9,6 +9,7 @@
 #include <lib/pulse_reader/pulse_reader.h>
 #include <lib/nfc/nfc_device.h>
 #include <lib/nfc/helpers/nfc_generators.h>
+#include <lib/nfc/protocols/crypto1.h>
 
 #include <lib/flipper_format/flipper_format_i.h>
 #include <lib/toolbox/stream/file_stream.h>
@@ -35,6 +36,9 @@ static const uint32_t nfc_test_file_version = 1;
 #define NFC_TEST_4_BYTE_BUILD_SIGNAL_TIM_MAX (110)
 #define NFC_TEST_16_BYTE_BUILD_SIGNAL_TIM_MAX (440)
 
+#define NFC_TEST_CRYPTO1_VECTORS (10000)
+#define NFC_TEST_CRYPTO1_BENCH_WORDS (20000)
+
 typedef struct {
     Storage* storage;
     NfcaSignal* signal;
@@ -702,6 +706,84 @@ MU_TEST(mf_classic_4k_7b_file_test) {
     mf_classic_generator_test(7, MfClassicType4k);
 }
 
+static uint8_t nfc_test_crypto1_byte_ref(Crypto1* crypto1, uint8_t in, int is_encrypted) {
+    uint8_t out = 0;
+    for(uint8_t i = 0; i < 8; i++) {
+        out |= crypto1_bit(crypto1, FURI_BIT(in, i), is_encrypted) << i;
+    }
+    return out;
+}
+
+static uint32_t nfc_test_crypto1_word_ref(Crypto1* crypto1, uint32_t in, int is_encrypted) {
+    uint32_t out = 0;
+    for(uint8_t i = 0; i < 32; i++) {
+        out |= (uint32_t)crypto1_bit(crypto1, FURI_BIT(in, i ^ 24), is_encrypted) << (24 ^ i);
+    }
+    return out;
+}
+
+MU_TEST(nfc_crypto1_keystream_test) {
+    // Known keystream vectors
+    Crypto1 crypto1 = {};
+    Crypto1 crypto1_ref = {};
+    crypto1_init(&crypto1, 0xFFFFFFFFFFFF);
+    mu_assert(crypto1_word(&crypto1, 0, 0) == 0xFF3FE936, "Crypto1 keystream mismatch\r\n");
+    mu_assert(crypto1_word(&crypto1, 0, 0) == 0xDBD948EB, "Crypto1 keystream mismatch\r\n");
+    crypto1_init(&crypto1, 0xA0A1A2A3A4A5);
+    mu_assert(crypto1_word(&crypto1, 0, 0) == 0x70FDEA9D, "Crypto1 keystream mismatch\r\n");
+
+    // Random states, inputs and modes must match bit by bit
+    for(size_t i = 0; i < NFC_TEST_CRYPTO1_VECTORS; i++) {
+        crypto1.odd = crypto1_ref.odd = furi_hal_random_get();
+        crypto1.even = crypto1_ref.even = furi_hal_random_get();
+        uint32_t in = furi_hal_random_get();
+        int is_encrypted = in & 1;
+
+        if(i & 1) {
+            uint8_t out = crypto1_byte(&crypto1, in, is_encrypted);
+            uint8_t out_ref = nfc_test_crypto1_byte_ref(&crypto1_ref, in, is_encrypted);
+            mu_assert(out == out_ref, "Crypto1 byte output mismatch\r\n");
+        } else {
+            uint32_t out = crypto1_word(&crypto1, in, is_encrypted);
+            uint32_t out_ref = nfc_test_crypto1_word_ref(&crypto1_ref, in, is_encrypted);
+            mu_assert(out == out_ref, "Crypto1 word output mismatch\r\n");
+        }
+        mu_assert(
+            (crypto1.odd == crypto1_ref.odd) && (crypto1.even == crypto1_ref.even),
+            "Crypto1 state mismatch\r\n");
+    }
+}
+
+MU_TEST(nfc_crypto1_benchmark_test) {
+    Crypto1 crypto1 = {};
+    uint32_t acc = 0;
+
+    crypto1_init(&crypto1, 0xA0A1A2A3A4A5);
+    FuriHalCortexTimer timer = furi_hal_cortex_timer_get(0);
+    for(size_t i = 0; i < NFC_TEST_CRYPTO1_BENCH_WORDS; i++) {
+        acc ^= crypto1_word(&crypto1, 0, 0);
+    }
+    uint32_t cycles = furi_hal_cortex_timer_get(0).start - timer.start;
+
+    crypto1_init(&crypto1, 0xA0A1A2A3A4A5);
+    timer = furi_hal_cortex_timer_get(0);
+    for(size_t i = 0; i < NFC_TEST_CRYPTO1_BENCH_WORDS; i++) {
+        acc ^= nfc_test_crypto1_word_ref(&crypto1, 0, 0);
+    }
+    uint32_t cycles_ref = furi_hal_cortex_timer_get(0).start - timer.start;
+
+    // Same key, same keystream: results cancel out
+    mu_assert(acc == 0, "Crypto1 keystream mismatch\r\n");
+
+    uint32_t ipus = furi_hal_cortex_instructions_per_microsecond();
+    FURI_LOG_I(
+        TAG,
+        "Crypto1 keystream: %lu KiB/s, bitwise %lu KiB/s",
+        (uint32_t)((uint64_t)NFC_TEST_CRYPTO1_BENCH_WORDS * 4 * ipus * 1000000 / 1024 / cycles),
+        (uint32_t)((uint64_t)NFC_TEST_CRYPTO1_BENCH_WORDS * 4 * ipus * 1000000 / 1024 /
+                   cycles_ref));
+}
+
 MU_TEST_SUITE(nfc) {
     nfc_test_alloc();
 
@@ -715,6 +797,8 @@ MU_TEST_SUITE(nfc) {
     MU_RUN_TEST(nfc_digital_signal_test);
     MU_RUN_TEST(mf_classic_dict_test);
     MU_RUN_TEST(mf_classic_dict_load_test);
+    MU_RUN_TEST(nfc_crypto1_keystream_test);
+    MU_RUN_TEST(nfc_crypto1_benchmark_test);
 
     nfc_test_free();
 }
@@ -13,6 +13,14 @@
 
 #define STORAGE_TEST_DIR UNIT_TESTS_PATH("test_dir")
 
+#define STORAGE_BATCH_DIR UNIT_TESTS_PATH("batch_dir")
+#define STORAGE_BATCH_FILES 64
+#define STORAGE_BATCH_ROUNDS 8
+#define STORAGE_BATCH_ENTRIES 16
+#define STORAGE_BATCH_NAMES_SIZE (STORAGE_DIR_BATCH_NAME_MAX * 4)
+
+#define TAG "StorageTest"
+
 static bool storage_file_create(Storage* storage, const char* path, const char* data) {
     File* file = storage_file_alloc(storage);
     bool result = false;
@@ -115,11 +123,102 @@ MU_TEST(storage_file_open_close) {
     furi_record_close(RECORD_STORAGE);
 }
 
+#define STORAGE_SEEK_FILE_A UNIT_TESTS_PATH("seek_a.test")
+#define STORAGE_SEEK_FILE_B UNIT_TESTS_PATH("seek_b.test")
+#define STORAGE_SEEK_BLOCK (4 * 1024)
+#define STORAGE_SEEK_CHUNK (32 * 1024)
+#define STORAGE_SEEK_CHUNKS 16
+#define STORAGE_SEEK_COUNT 256
+
+static bool storage_seek_write_chunk(File* file, uint32_t* buffer, uint32_t offset) {
+    for(size_t block = 0; block < STORAGE_SEEK_CHUNK / STORAGE_SEEK_BLOCK; block++) {
+        // Every word holds its own offset
+        for(size_t i = 0; i < STORAGE_SEEK_BLOCK / sizeof(uint32_t); i++) {
+            buffer[i] = offset + i * sizeof(uint32_t);
+        }
+        if(storage_file_write(file, buffer, STORAGE_SEEK_BLOCK) != STORAGE_SEEK_BLOCK) {
+            return false;
+        }
+        offset += STORAGE_SEEK_BLOCK;
+    }
+    return true;
+}
+
+static bool storage_seek_files_create(Storage* storage) {
+    File* file_a = storage_file_alloc(storage);
+    File* file_b = storage_file_alloc(storage);
+    uint32_t* buffer = malloc(STORAGE_SEEK_BLOCK);
+    bool result = storage_file_open(file_a, STORAGE_SEEK_FILE_A, FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+                  storage_file_open(file_b, STORAGE_SEEK_FILE_B, FSAM_WRITE, FSOM_CREATE_ALWAYS);
+
+    // Files grown in turns get interleaved clusters, so both are fragmented
+    for(size_t chunk = 0; result && chunk < STORAGE_SEEK_CHUNKS; chunk++) {
+        result = storage_seek_write_chunk(file_a, buffer, chunk * STORAGE_SEEK_CHUNK) &&
+                 storage_seek_write_chunk(file_b, buffer, chunk * STORAGE_SEEK_CHUNK);
+    }
+
+    storage_file_close(file_a);
+    storage_file_close(file_b);
+    free(buffer);
+    storage_file_free(file_a);
+    storage_file_free(file_b);
+    return result;
+}
+
+static void storage_seek_random(File* file, uint32_t* ticks) {
+    uint32_t seed = 0x13DA;
+
+    *ticks = furi_get_tick();
+    for(size_t i = 0; i < STORAGE_SEEK_COUNT; i++) {
+        seed = seed * 1664525 + 1013904223;
+        uint32_t offset = (seed >> 8) % (STORAGE_SEEK_CHUNK * STORAGE_SEEK_CHUNKS / 4) * 4;
+        uint32_t value = 0;
+        mu_check(storage_file_seek(file, offset, true));
+        mu_assert_int_eq(sizeof(value), storage_file_read(file, &value, sizeof(value)));
+        mu_assert_int_eq(offset, value);
+    }
+    *ticks = furi_get_tick() - *ticks;
+}
+
+MU_TEST(storage_fast_seek) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    File* file = storage_file_alloc(storage);
+    uint32_t chain_ticks = 0;
+    uint32_t map_ticks = 0;
+
+    mu_check(storage_seek_files_create(storage));
+
+    mu_check(storage_file_open(file, STORAGE_SEEK_FILE_A, FSAM_READ, FSOM_OPEN_EXISTING));
+    storage_seek_random(file, &chain_ticks);
+    storage_file_close(file);
+
+    mu_check(storage_file_open(
+        file, STORAGE_SEEK_FILE_A, FSAM_READ, FSOM_OPEN_EXISTING | FSOM_FAST_SEEK));
+    storage_seek_random(file, &map_ticks);
+    storage_file_close(file);
+
+    FURI_LOG_I(TAG, "Random seek: %lu ms FAT chain, %lu ms cluster map", chain_ticks, map_ticks);
+
+    // Flag is ignored for writing, file can still grow
+    mu_check(storage_file_open(
+        file, STORAGE_SEEK_FILE_B, FSAM_READ_WRITE, FSOM_OPEN_EXISTING | FSOM_FAST_SEEK));
+    mu_check(storage_file_seek(file, STORAGE_SEEK_CHUNK * STORAGE_SEEK_CHUNKS, true));
+    mu_assert_int_eq(4, storage_file_write(file, "tail", 4));
+    storage_file_close(file);
+    storage_file_free(file);
+
+    storage_common_remove(storage, STORAGE_SEEK_FILE_A);
+    storage_common_remove(storage, STORAGE_SEEK_FILE_B);
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(storage_file) {
     storage_file_open_lock_setup();
     MU_RUN_TEST(storage_file_open_close);
     MU_RUN_TEST(storage_file_open_lock);
     storage_file_open_lock_teardown();
+    MU_RUN_TEST(storage_fast_seek);
 }
 
 MU_TEST(storage_dir_open_close) {
@@ -200,6 +299,291 @@ MU_TEST_SUITE(storage_dir) {
     MU_RUN_TEST(storage_dir_exists_test);
 }
 
+static void storage_batch_setup() {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FuriString* path = furi_string_alloc();
+
+    storage_simply_remove_recursive(storage, STORAGE_BATCH_DIR);
+    storage_common_mkdir(storage, STORAGE_BATCH_DIR);
+    for(size_t i = 0; i < STORAGE_BATCH_FILES; i++) {
+        furi_string_printf(path, "%s/file_%02u.test", STORAGE_BATCH_DIR, i);
+        storage_file_create(storage, furi_string_get_cstr(path), "batch");
+    }
+
+    furi_string_free(path);
+    furi_record_close(RECORD_STORAGE);
+}
+
+static void storage_batch_teardown() {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove_recursive(storage, STORAGE_BATCH_DIR);
+    furi_record_close(RECORD_STORAGE);
+}
+
+// Round-trip benchmarks: same work with one request per item and with batched requests
+MU_TEST(storage_batch_dir_read) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    StorageDirEntry* entries = malloc(sizeof(StorageDirEntry) * STORAGE_BATCH_ENTRIES);
+    char* names = malloc(STORAGE_BATCH_NAMES_SIZE);
+    char name[STORAGE_DIR_BATCH_NAME_MAX];
+    FileInfo fileinfo;
+    size_t single_count = 0;
+    size_t batch_count = 0;
+
+    uint32_t single_ticks = furi_get_tick();
+    for(size_t round = 0; round < STORAGE_BATCH_ROUNDS; round++) {
+        mu_check(storage_dir_open(file, STORAGE_BATCH_DIR));
+        while(storage_dir_read(file, &fileinfo, name, sizeof(name))) {
+            single_count++;
+        }
+        mu_assert_int_eq(FSE_NOT_EXIST, storage_file_get_error(file));
+        storage_dir_close(file);
+    }
+    single_ticks = furi_get_tick() - single_ticks;
+
+    uint32_t batch_ticks = furi_get_tick();
+    for(size_t round = 0; round < STORAGE_BATCH_ROUNDS; round++) {
+        mu_check(storage_dir_open(file, STORAGE_BATCH_DIR));
+        do {
+            size_t count = storage_dir_read_batch(
+                file, entries, STORAGE_BATCH_ENTRIES, names, STORAGE_BATCH_NAMES_SIZE);
+            for(size_t i = 0; i < count; i++) {
+                mu_check(strncmp(entries[i].name, "file_", 5) == 0);
+                mu_check(!file_info_is_dir(&entries[i].fileinfo));
+                mu_assert_int_eq(strlen("batch"), entries[i].fileinfo.size);
+            }
+            batch_count += count;
+        } while(storage_file_get_error(file) == FSE_OK);
+        mu_assert_int_eq(FSE_NOT_EXIST, storage_file_get_error(file));
+        storage_dir_close(file);
+    }
+    batch_ticks = furi_get_tick() - batch_ticks;
+
+    mu_assert_int_eq(STORAGE_BATCH_FILES * STORAGE_BATCH_ROUNDS, single_count);
+    mu_assert_int_eq(single_count, batch_count);
+    FURI_LOG_I(TAG, "Dir read: %lu ms single, %lu ms batched", single_ticks, batch_ticks);
+
+    free(names);
+    free(entries);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(storage_batch_stat) {
+    const size_t count = STORAGE_BATCH_FILES + 1;
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FuriString** strings = malloc(sizeof(FuriString*) * count);
+    const char** paths = malloc(sizeof(const char*) * count);
+    FileInfo* fileinfos = malloc(sizeof(FileInfo) * count);
+    FS_Error* errors = malloc(sizeof(FS_Error) * count);
+
+    for(size_t i = 0; i < count; i++) {
+        // Last one does not exist
+        strings[i] = furi_string_alloc_printf("%s/file_%02u.test", STORAGE_BATCH_DIR, i);
+        paths[i] = furi_string_get_cstr(strings[i]);
+    }
+
+    uint32_t single_ticks = furi_get_tick();
+    for(size_t round = 0; round < STORAGE_BATCH_ROUNDS; round++) {
+        for(size_t i = 0; i < count; i++) {
+            errors[i] = storage_common_stat(storage, paths[i], &fileinfos[i]);
+        }
+    }
+    single_ticks = furi_get_tick() - single_ticks;
+
+    size_t found = 0;
+    uint32_t batch_ticks = furi_get_tick();
+    for(size_t round = 0; round < STORAGE_BATCH_ROUNDS; round++) {
+        found = storage_common_stat_batch(storage, paths, fileinfos, errors, count);
+    }
+    batch_ticks = furi_get_tick() - batch_ticks;
+
+    mu_assert_int_eq(STORAGE_BATCH_FILES, found);
+    for(size_t i = 0; i < STORAGE_BATCH_FILES; i++) {
+        mu_assert_int_eq(FSE_OK, errors[i]);
+        mu_assert_int_eq(strlen("batch"), fileinfos[i].size);
+    }
+    mu_assert_int_eq(FSE_NOT_EXIST, errors[STORAGE_BATCH_FILES]);
+    FURI_LOG_I(TAG, "Stat: %lu ms single, %lu ms batched", single_ticks, batch_ticks);
+
+    for(size_t i = 0; i < count; i++) {
+        furi_string_free(strings[i]);
+    }
+    free(errors);
+    free(fileinfos);
+    free(paths);
+    free(strings);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(storage_batch_readv_writev) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    const char* path = STORAGE_BATCH_DIR "/vector.test";
+    char header[4] = "HEAD";
+    char body[64];
+    char tail[3] = "END";
+    memset(body, 'b', sizeof(body));
+
+    StorageIoVec write_iov[] = {
+        {.buff = header, .size = sizeof(header)},
+        {.buff = body, .size = sizeof(body)},
+        {.buff = tail, .size = sizeof(tail)},
+    };
+    const size_t total = sizeof(header) + sizeof(body) + sizeof(tail);
+
+    mu_check(storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS));
+    mu_assert_int_eq(total, storage_file_writev(file, write_iov, COUNT_OF(write_iov)));
+    storage_file_close(file);
+
+    char read_header[4];
+    char read_body[64];
+    char read_tail[8]; // More than left in file
+    StorageIoVec read_iov[] = {
+        {.buff = read_header, .size = sizeof(read_header)},
+        {.buff = read_body, .size = sizeof(read_body)},
+        {.buff = read_tail, .size = sizeof(read_tail)},
+        {.buff = read_header, .size = sizeof(read_header)}, // Not reached
+    };
+
+    mu_check(storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING));
+    mu_assert_int_eq(total, storage_file_readv(file, read_iov, COUNT_OF(read_iov)));
+    storage_file_close(file);
+
+    mu_check(memcmp(read_header, header, sizeof(header)) == 0);
+    mu_check(memcmp(read_body, body, sizeof(body)) == 0);
+    mu_check(memcmp(read_tail, tail, sizeof(tail)) == 0);
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(storage_batch_load) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    const char* path = STORAGE_BATCH_DIR "/file_00.test";
+    char buffer[16];
+    size_t bytes_read = 0;
+
+    uint32_t single_ticks = furi_get_tick();
+    for(size_t round = 0; round < STORAGE_BATCH_FILES; round++) {
+        mu_check(storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING));
+        bytes_read = storage_file_read(file, buffer, sizeof(buffer));
+        storage_file_close(file);
+    }
+    single_ticks = furi_get_tick() - single_ticks;
+    mu_assert_int_eq(strlen("batch"), bytes_read);
+
+    uint32_t batch_ticks = furi_get_tick();
+    for(size_t round = 0; round < STORAGE_BATCH_FILES; round++) {
+        bytes_read = 0;
+        mu_assert_int_eq(
+            FSE_OK, storage_file_load(storage, path, buffer, sizeof(buffer), &bytes_read));
+    }
+    batch_ticks = furi_get_tick() - batch_ticks;
+    mu_assert_int_eq(strlen("batch"), bytes_read);
+    mu_check(memcmp(buffer, "batch", bytes_read) == 0);
+
+    // Buffer is smaller than file
+    mu_assert_int_eq(FSE_OK, storage_file_load(storage, path, buffer, 2, &bytes_read));
+    mu_assert_int_eq(2, bytes_read);
+
+    mu_assert_int_eq(
+        FSE_NOT_EXIST,
+        storage_file_load(
+            storage, STORAGE_BATCH_DIR "/missing.test", buffer, sizeof(buffer), &bytes_read));
+    mu_assert_int_eq(0, bytes_read);
+
+    // File must be closed after load
+    mu_check(storage_file_open(file, path, FSAM_WRITE, FSOM_OPEN_EXISTING));
+    storage_file_close(file);
+
+    FURI_LOG_I(TAG, "Open-read-close: %lu ms single, %lu ms load", single_ticks, batch_ticks);
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+#define STORAGE_ASYNC_CHUNK 512
+#define STORAGE_ASYNC_CHUNKS 16
+#define STORAGE_ASYNC_IN_FLIGHT 2
+
+static void storage_async_test_callback(StorageAsyncRequest* request, void* context) {
+    UNUSED(request);
+    uint32_t* completed = context;
+    (*completed)++;
+}
+
+MU_TEST(storage_async_write_read) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    const char* path = STORAGE_BATCH_DIR "/async.test";
+    uint8_t* buffers = malloc(STORAGE_ASYNC_CHUNK * STORAGE_ASYNC_IN_FLIGHT);
+    StorageAsyncRequest* requests[STORAGE_ASYNC_IN_FLIGHT];
+    uint32_t completed = 0;
+
+    // Double buffered write: fill one buffer while the other one is written
+    mu_check(storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS));
+    for(size_t i = 0; i < STORAGE_ASYNC_IN_FLIGHT; i++) {
+        requests[i] = storage_async_request_alloc(file);
+        storage_async_request_set_callback(requests[i], storage_async_test_callback, &completed);
+    }
+    for(size_t chunk = 0; chunk < STORAGE_ASYNC_CHUNKS; chunk++) {
+        size_t slot = chunk % STORAGE_ASYNC_IN_FLIGHT;
+        uint8_t* buffer = &buffers[slot * STORAGE_ASYNC_CHUNK];
+        mu_check(storage_async_request_wait(requests[slot], FuriWaitForever));
+        memset(buffer, chunk, STORAGE_ASYNC_CHUNK);
+        storage_file_write_async(requests[slot], buffer, STORAGE_ASYNC_CHUNK);
+    }
+    for(size_t i = 0; i < STORAGE_ASYNC_IN_FLIGHT; i++) {
+        mu_check(storage_async_request_wait(requests[i], FuriWaitForever));
+        mu_assert_int_eq(FSE_OK, storage_async_request_get_error(requests[i]));
+        mu_assert_int_eq(STORAGE_ASYNC_CHUNK, storage_async_request_get_bytes(requests[i]));
+        storage_async_request_free(requests[i]);
+    }
+    storage_file_close(file);
+    mu_assert_int_eq(STORAGE_ASYNC_CHUNKS, completed);
+
+    // Both reads are submitted before waiting, data must come back in order
+    mu_check(storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING));
+    mu_assert_int_eq(STORAGE_ASYNC_CHUNK * STORAGE_ASYNC_CHUNKS, storage_file_size(file));
+    for(size_t i = 0; i < STORAGE_ASYNC_IN_FLIGHT; i++) {
+        requests[i] = storage_async_request_alloc(file);
+        storage_file_read_async(
+            requests[i], &buffers[i * STORAGE_ASYNC_CHUNK], STORAGE_ASYNC_CHUNK);
+    }
+    for(size_t chunk = 0; chunk < STORAGE_ASYNC_CHUNKS; chunk++) {
+        size_t slot = chunk % STORAGE_ASYNC_IN_FLIGHT;
+        uint8_t* buffer = &buffers[slot * STORAGE_ASYNC_CHUNK];
+        mu_check(storage_async_request_wait(requests[slot], FuriWaitForever));
+        mu_assert_int_eq(STORAGE_ASYNC_CHUNK, storage_async_request_get_bytes(requests[slot]));
+        mu_check(buffer[0] == chunk && buffer[STORAGE_ASYNC_CHUNK - 1] == chunk);
+        storage_file_read_async(requests[slot], buffer, STORAGE_ASYNC_CHUNK);
+    }
+    for(size_t i = 0; i < STORAGE_ASYNC_IN_FLIGHT; i++) {
+        // Reads past the end
+        mu_check(storage_async_request_wait(requests[i], FuriWaitForever));
+        mu_assert_int_eq(0, storage_async_request_get_bytes(requests[i]));
+        storage_async_request_free(requests[i]);
+    }
+    storage_file_close(file);
+
+    free(buffers);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST_SUITE(storage_batch) {
+    storage_batch_setup();
+    MU_RUN_TEST(storage_batch_dir_read);
+    MU_RUN_TEST(storage_batch_stat);
+    MU_RUN_TEST(storage_batch_readv_writev);
+    MU_RUN_TEST(storage_batch_load);
+    MU_RUN_TEST(storage_async_write_read);
+    storage_batch_teardown();
+}
+
 static const char* const storage_copy_test_paths[] = {
     "1",
     "11",
@@ -594,6 +978,7 @@ MU_TEST_SUITE(test_storage_common) {
 int run_minunit_test_storage() {
     MU_RUN_SUITE(storage_file);
     MU_RUN_SUITE(storage_dir);
+    MU_RUN_SUITE(storage_batch);
     MU_RUN_SUITE(storage_rename);
     MU_RUN_SUITE(test_data_path);
     MU_RUN_SUITE(test_storage_common);
@@ -358,6 +358,59 @@ MU_TEST(subghz_hal_async_tx_test) {
         "Test furi_hal_async_tx reset end");
 }
 
+MU_TEST(subghz_registry_test) {
+    const SubGhzProtocolRegistry* registry = &subghz_protocol_registry;
+    size_t count = subghz_protocol_registry_count(registry);
+
+    // Name index must be sorted and cover every protocol
+    for(size_t i = 1; i < count; i++) {
+        const char* prev = registry->items[registry->name_index[i - 1]]->name;
+        const char* next = registry->items[registry->name_index[i]]->name;
+        mu_assert(strcmp(prev, next) < 0, "Protocol name index is not sorted\r\n");
+    }
+
+    for(size_t i = 0; i < count; i++) {
+        const SubGhzProtocol* protocol = subghz_protocol_registry_get_by_index(registry, i);
+        mu_assert(
+            subghz_protocol_registry_get_index_by_name(registry, protocol->name) == i,
+            "Protocol lookup by name failed\r\n");
+        mu_assert(
+            subghz_protocol_registry_get_by_name(registry, protocol->name) == protocol,
+            "Protocol get by name failed\r\n");
+    }
+
+    mu_assert(
+        subghz_protocol_registry_get_index_by_name(registry, "Unknown protocol") ==
+            SUBGHZ_PROTOCOL_REGISTRY_INDEX_INVALID,
+        "Unknown protocol found\r\n");
+    mu_assert(
+        subghz_protocol_registry_get_by_index(registry, SubGhzProtocolIdPrinceton) ==
+            &subghz_protocol_princeton,
+        "Protocol id mismatch\r\n");
+}
+
+MU_TEST(subghz_receiver_subset_test) {
+    const char* protocols[] = {
+        SUBGHZ_PROTOCOL_PRINCETON_NAME,
+        SUBGHZ_PROTOCOL_CAME_NAME,
+        "Unknown protocol",
+    };
+    SubGhzReceiver* receiver =
+        subghz_receiver_alloc_init_subset(environment_handler, protocols, COUNT_OF(protocols));
+
+    mu_assert(
+        subghz_receiver_search_decoder_base_by_name(receiver, SUBGHZ_PROTOCOL_PRINCETON_NAME),
+        "Subset receiver has no Princeton decoder\r\n");
+    mu_assert(
+        subghz_receiver_search_decoder_base_by_name(receiver, SUBGHZ_PROTOCOL_CAME_NAME),
+        "Subset receiver has no CAME decoder\r\n");
+    mu_assert(
+        !subghz_receiver_search_decoder_base_by_name(receiver, SUBGHZ_PROTOCOL_KEELOQ_NAME),
+        "Subset receiver has unexpected KeeLoq decoder\r\n");
+
+    subghz_receiver_free(receiver);
+}
+
 //test decoders
 MU_TEST(subghz_decoder_came_atomo_test) {
     mu_assert(
@@ -806,6 +859,9 @@ MU_TEST_SUITE(subghz) {
 
     MU_RUN_TEST(subghz_hal_async_tx_test);
 
+    MU_RUN_TEST(subghz_registry_test);
+    MU_RUN_TEST(subghz_receiver_subset_test);
+
     MU_RUN_TEST(subghz_decoder_came_atomo_test);
     MU_RUN_TEST(subghz_decoder_came_test);
     MU_RUN_TEST(subghz_decoder_came_twee_test);
@@ -0,0 +1,289 @@
+#include <furi.h>
+#include <storage/storage.h>
+#include <toolbox/tar/tar_archive.h>
+#include <toolbox/md5.h>
+#include <lib/heatshrink/heatshrink_encoder.h>
+#include "../minunit.h"
+
+#define TAR_TEST_DIR EXT_PATH("unit_tests_tmp/tar")
+#define TAR_TEST_SRC_DIR TAR_TEST_DIR "/src"
+#define TAR_TEST_DST_DIR TAR_TEST_DIR "/dst"
+#define TAR_TEST_ARCHIVE TAR_TEST_DIR "/test.tar"
+#define TAR_TEST_ARCHIVE_HS TAR_TEST_DIR "/test.tar.hs"
+#define TAR_TEST_ARCHIVE_BROKEN TAR_TEST_DIR "/broken.tar"
+#define TAR_TEST_SINGLE_FILE TAR_TEST_DIR "/single.bin"
+
+// Archive name over 100 characters, stored with ustar prefix
+#define TAR_TEST_LONG_PARENT "long_directory_name_for_ustar_prefix_0123456789"
+#define TAR_TEST_LONG_DIR TAR_TEST_LONG_PARENT "/second_long_directory_name_0123456789"
+#define TAR_TEST_LONG_NAME TAR_TEST_LONG_DIR "/file_with_a_long_name_0123456789.bin"
+
+#define TAR_TEST_HS_WINDOW 8
+#define TAR_TEST_HS_LOOKAHEAD 4
+#define TAR_TEST_BUFFER_SIZE 512
+
+typedef struct {
+    const char* name;
+    size_t size;
+} TarTestFile;
+
+static const char* const tar_test_dirs[] = {
+    "dir",
+    TAR_TEST_LONG_PARENT,
+    TAR_TEST_LONG_DIR,
+};
+
+static const TarTestFile tar_test_files[] = {
+    {.name = "empty.bin", .size = 0},
+    {.name = "block.bin", .size = 512},
+    {.name = "dir/odd.bin", .size = 1000},
+    {.name = TAR_TEST_LONG_NAME, .size = 5000},
+};
+
+typedef struct {
+    size_t hashed[COUNT_OF(tar_test_files)];
+    bool md5_ok;
+} TarTestHashContext;
+
+static uint8_t* tar_test_file_data(size_t index) {
+    const TarTestFile* file = &tar_test_files[index];
+    uint8_t* data = malloc(file->size + 1);
+    for(size_t i = 0; i < file->size; i++) {
+        data[i] = (uint8_t)(i * 7 + index);
+    }
+    return data;
+}
+
+static bool tar_test_hash_cb(const char* name, const uint8_t* md5_result, void* context) {
+    TarTestHashContext* hash_context = context;
+    for(size_t i = 0; i < COUNT_OF(tar_test_files); i++) {
+        if(strcmp(name, tar_test_files[i].name) != 0) continue;
+
+        uint8_t expected[16];
+        uint8_t* data = tar_test_file_data(i);
+        md5(data, tar_test_files[i].size, expected);
+        free(data);
+
+        hash_context->hashed[i]++;
+        if(memcmp(expected, md5_result, sizeof(expected)) != 0) {
+            hash_context->md5_ok = false;
+        }
+        return true;
+    }
+
+    hash_context->md5_ok = false;
+    return true;
+}
+
+static void tar_test_prepare(Storage* storage) {
+    FuriString* path = furi_string_alloc();
+
+    storage_simply_remove_recursive(storage, TAR_TEST_DIR);
+    mu_assert(storage_simply_mkdir(storage, TAR_TEST_DIR), "cannot create test dir");
+    mu_assert(storage_simply_mkdir(storage, TAR_TEST_SRC_DIR), "cannot create source dir");
+    for(size_t i = 0; i < COUNT_OF(tar_test_dirs); i++) {
+        furi_string_printf(path, "%s/%s", TAR_TEST_SRC_DIR, tar_test_dirs[i]);
+        mu_assert(storage_simply_mkdir(storage, furi_string_get_cstr(path)), "cannot create dir");
+    }
+
+    File* file = storage_file_alloc(storage);
+    for(size_t i = 0; i < COUNT_OF(tar_test_files); i++) {
+        furi_string_printf(path, "%s/%s", TAR_TEST_SRC_DIR, tar_test_files[i].name);
+        uint8_t* data = tar_test_file_data(i);
+        bool result =
+            storage_file_open(file, furi_string_get_cstr(path), FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+            storage_file_write(file, data, tar_test_files[i].size) == tar_test_files[i].size;
+        storage_file_close(file);
+        free(data);
+        mu_assert(result, "cannot write source file");
+    }
+    storage_file_free(file);
+
+    TarArchive* archive = tar_archive_alloc(storage);
+    bool result = tar_archive_open(archive, TAR_TEST_ARCHIVE, TAR_OPEN_MODE_WRITE) &&
+                  tar_archive_add_dir(archive, TAR_TEST_SRC_DIR, "") &&
+                  tar_archive_finalize(archive);
+    tar_archive_free(archive);
+    mu_assert(result, "cannot create archive");
+
+    furi_string_free(path);
+}
+
+static void tar_test_check_file(Storage* storage, const char* path, size_t index) {
+    File* file = storage_file_alloc(storage);
+    size_t size = tar_test_files[index].size;
+    uint8_t* expected = tar_test_file_data(index);
+    uint8_t* data = malloc(size + 1);
+
+    mu_assert(storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING), "cannot open file");
+    mu_assert_int_eq(size, storage_file_size(file));
+    mu_assert_int_eq(size, storage_file_read(file, data, size));
+    mu_assert_mem_eq(expected, data, size);
+
+    free(data);
+    free(expected);
+    storage_file_free(file);
+}
+
+static void tar_test_unpack(Storage* storage, const char* archive_path) {
+    FuriString* path = furi_string_alloc();
+    TarTestHashContext hash_context = {.md5_ok = true};
+
+    storage_simply_remove_recursive(storage, TAR_TEST_DST_DIR);
+    mu_assert(storage_simply_mkdir(storage, TAR_TEST_DST_DIR), "cannot create destination dir");
+
+    TarArchive* archive = tar_archive_alloc(storage);
+    tar_archive_set_hash_callback(archive, tar_test_hash_cb, &hash_context);
+    mu_assert(tar_archive_open(archive, archive_path, TAR_OPEN_MODE_READ), "cannot open archive");
+    mu_assert_int_eq(
+        COUNT_OF(tar_test_dirs) + COUNT_OF(tar_test_files),
+        tar_archive_get_entries_count(archive));
+    mu_assert(tar_archive_unpack_to(archive, TAR_TEST_DST_DIR, NULL), "cannot unpack archive");
+    mu_assert(
+        tar_archive_unpack_file(archive, TAR_TEST_LONG_NAME, TAR_TEST_SINGLE_FILE),
+        "cannot unpack single file");
+    mu_assert(
+        !tar_archive_unpack_file(archive, "missing.bin", TAR_TEST_SINGLE_FILE),
+        "missing file unpacked");
+    tar_archive_free(archive);
+
+    mu_assert(hash_context.md5_ok, "wrong md5");
+    for(size_t i = 0; i < COUNT_OF(tar_test_files); i++) {
+        // Single file unpacking reports its hash too
+        size_t expected_count = strcmp(tar_test_files[i].name, TAR_TEST_LONG_NAME) ? 1 : 2;
+        mu_assert_int_eq(expected_count, hash_context.hashed[i]);
+
+        furi_string_printf(path, "%s/%s", TAR_TEST_DST_DIR, tar_test_files[i].name);
+        tar_test_check_file(storage, furi_string_get_cstr(path), i);
+    }
+    tar_test_check_file(storage, TAR_TEST_SINGLE_FILE, COUNT_OF(tar_test_files) - 1);
+
+    furi_string_free(path);
+}
+
+static bool tar_test_encoder_drain(heatshrink_encoder* encoder, File* file, uint8_t* buffer) {
+    HSE_poll_res poll_res;
+    do {
+        size_t poll_size = 0;
+        poll_res = heatshrink_encoder_poll(encoder, buffer, TAR_TEST_BUFFER_SIZE, &poll_size);
+        if(poll_res < 0 || storage_file_write(file, buffer, poll_size) != poll_size) {
+            return false;
+        }
+    } while(poll_res == HSER_POLL_MORE);
+    return true;
+}
+
+// Same layout as produced by update.py --compress-resources
+static void tar_test_compress(Storage* storage, const char* src_path, const char* dst_path) {
+    const uint8_t header[] = {
+        'H', 'S', 'T', 'R', 1, TAR_TEST_HS_WINDOW, TAR_TEST_HS_LOOKAHEAD, 0};
+    File* src = storage_file_alloc(storage);
+    File* dst = storage_file_alloc(storage);
+    heatshrink_encoder* encoder =
+        heatshrink_encoder_alloc(TAR_TEST_HS_WINDOW, TAR_TEST_HS_LOOKAHEAD);
+    uint8_t* src_buffer = malloc(TAR_TEST_BUFFER_SIZE);
+    uint8_t* dst_buffer = malloc(TAR_TEST_BUFFER_SIZE);
+
+    bool result = storage_file_open(src, src_path, FSAM_READ, FSOM_OPEN_EXISTING) &&
+                  storage_file_open(dst, dst_path, FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+                  storage_file_write(dst, header, sizeof(header)) == sizeof(header);
+
+    size_t read_size;
+    while(result && (read_size = storage_file_read(src, src_buffer, TAR_TEST_BUFFER_SIZE))) {
+        for(size_t sunk = 0; result && sunk < read_size;) {
+            size_t sink_size = 0;
+            heatshrink_encoder_sink(encoder, &src_buffer[sunk], read_size - sunk, &sink_size);
+            sunk += sink_size;
+            result = tar_test_encoder_drain(encoder, dst, dst_buffer);
+        }
+    }
+    while(result && heatshrink_encoder_finish(encoder) == HSER_FINISH_MORE) {
+        result = tar_test_encoder_drain(encoder, dst, dst_buffer);
+    }
+
+    free(dst_buffer);
+    free(src_buffer);
+    heatshrink_encoder_free(encoder);
+    storage_file_free(dst);
+    storage_file_free(src);
+    mu_assert(result, "cannot compress archive");
+}
+
+// Copy of archive cut to size, with one byte flipped at offset if it is in range
+static void tar_test_damage(Storage* storage, size_t size, size_t offset) {
+    File* file = storage_file_alloc(storage);
+    uint8_t* data = malloc(size);
+
+    bool result = storage_file_open(file, TAR_TEST_ARCHIVE, FSAM_READ, FSOM_OPEN_EXISTING) &&
+                  storage_file_read(file, data, size) == size;
+    storage_file_close(file);
+    if(offset < size) {
+        data[offset] ^= 0x01;
+    }
+    result = result &&
+             storage_file_open(file, TAR_TEST_ARCHIVE_BROKEN, FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+             storage_file_write(file, data, size) == size;
+
+    free(data);
+    storage_file_free(file);
+    mu_assert(result, "cannot write damaged archive");
+}
+
+static void tar_test_unpack_fails(Storage* storage) {
+    storage_simply_remove_recursive(storage, TAR_TEST_DST_DIR);
+    mu_assert(storage_simply_mkdir(storage, TAR_TEST_DST_DIR), "cannot create destination dir");
+
+    TarArchive* archive = tar_archive_alloc(storage);
+    mu_assert(
+        tar_archive_open(archive, TAR_TEST_ARCHIVE_BROKEN, TAR_OPEN_MODE_READ),
+        "cannot open archive");
+    mu_assert_int_eq(-1, tar_archive_get_entries_count(archive));
+    mu_assert(!tar_archive_unpack_to(archive, TAR_TEST_DST_DIR, NULL), "broken archive unpacked");
+    tar_archive_free(archive);
+}
+
+MU_TEST(tar_archive_test_roundtrip) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    tar_test_prepare(storage);
+    tar_test_unpack(storage, TAR_TEST_ARCHIVE);
+    storage_simply_remove_recursive(storage, TAR_TEST_DIR);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(tar_archive_test_heatshrink) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    tar_test_prepare(storage);
+    tar_test_compress(storage, TAR_TEST_ARCHIVE, TAR_TEST_ARCHIVE_HS);
+    tar_test_unpack(storage, TAR_TEST_ARCHIVE_HS);
+    storage_simply_remove_recursive(storage, TAR_TEST_DIR);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(tar_archive_test_broken) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    tar_test_prepare(storage);
+    FileInfo file_info;
+    mu_assert_int_eq(FSE_OK, storage_common_stat(storage, TAR_TEST_ARCHIVE, &file_info));
+
+    // Cut in the middle of the last entry, end of archive blocks are lost too
+    tar_test_damage(storage, file_info.size - 2 * TAR_TEST_BUFFER_SIZE - 100, file_info.size);
+    tar_test_unpack_fails(storage);
+
+    // Header checksum doesn't match
+    tar_test_damage(storage, file_info.size, 0);
+    tar_test_unpack_fails(storage);
+
+    storage_simply_remove_recursive(storage, TAR_TEST_DIR);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST_SUITE(test_tar_archive_suite) {
+    MU_RUN_TEST(tar_archive_test_roundtrip);
+    MU_RUN_TEST(tar_archive_test_heatshrink);
+    MU_RUN_TEST(tar_archive_test_broken);
+}
+
+int run_minunit_test_tar_archive() {
+    MU_RUN_SUITE(test_tar_archive_suite);
+    return MU_EXIT_CODE;
+}
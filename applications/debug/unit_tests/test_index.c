@@ -23,10 +23,13 @@ int run_minunit_test_dirwalk();
 int run_minunit_test_power();
 int run_minunit_test_protocol_dict();
 int run_minunit_test_lfrfid_protocols();
+int run_minunit_test_lfrfid_raw_file();
 int run_minunit_test_nfc();
 int run_minunit_test_bit_lib();
 int run_minunit_test_float_tools();
 int run_minunit_test_bt();
+int run_minunit_test_text_layout();
+int run_minunit_test_tar_archive();
 
 typedef int (*UnitTestEntry)();
 
@@ -52,9 +55,12 @@ const UnitTest unit_tests[] = {
     {.name = "power", .entry = run_minunit_test_power},
     {.name = "protocol_dict", .entry = run_minunit_test_protocol_dict},
     {.name = "lfrfid", .entry = run_minunit_test_lfrfid_protocols},
+    {.name = "lfrfid_raw_file", .entry = run_minunit_test_lfrfid_raw_file},
     {.name = "bit_lib", .entry = run_minunit_test_bit_lib},
     {.name = "float_tools", .entry = run_minunit_test_float_tools},
     {.name = "bt", .entry = run_minunit_test_bt},
+    {.name = "text_layout", .entry = run_minunit_test_text_layout},
+    {.name = "tar_archive", .entry = run_minunit_test_tar_archive},
 };
 
 void minunit_print_progress() {
@@ -10,16 +10,25 @@
 
 static_assert(!has_hash_collisions(app_api_table), "Detected API method hash collision!");
 
-constexpr HashtableApiInterface applicaton_hashtable_api_interface{
+/* bucket index and bloom filter, built at compile time */
+static constexpr auto app_api_index = make_api_hashtable_index(app_api_table);
+
+constexpr BucketedHashtableApiInterface applicaton_hashtable_api_interface{
     {
-        .api_version_major = 0,
-        .api_version_minor = 0,
-        /* generic resolver using pre-sorted array */
-        .resolver_callback = &elf_resolve_from_hashtable,
+        {
+            .api_version_major = 0,
+            .api_version_minor = 0,
+            /* generic resolver using array in bucket order */
+            .resolver_callback = &elf_resolve_from_bucketed_hashtable,
+        },
+        /* pointers to application's API table boundaries */
+        .table_cbegin = app_api_table.cbegin(),
+        .table_cend = app_api_table.cend(),
     },
-    /* pointers to application's API table boundaries */
-    .table_cbegin = app_api_table.cbegin(),
-    .table_cend = app_api_table.cend(),
+    .buckets = app_api_index.buckets.data(),
+    .bucket_shift = app_api_index.bucket_shift,
+    .bloom = app_api_index.bloom.data(),
+    .bloom_mask = app_api_index.bloom_words - 1,
 };
 
 /* Casting to generic resolver to use in Composite API resolver */
@@ -10,4 +10,5 @@ static constexpr auto app_api_table = sort(create_array_t<sym_entry>(
     API_METHOD(app_api_accumulator_get, uint32_t, ()),
     API_METHOD(app_api_accumulator_add, void, (uint32_t)),
     API_METHOD(app_api_accumulator_sub, void, (uint32_t)),
-    API_METHOD(app_api_accumulator_mul, void, (uint32_t))));
\ No newline at end of file
+    API_METHOD(app_api_accumulator_mul, void, (uint32_t))),
+    sym_entry_bucket_order{});
\ No newline at end of file
@@ -19,8 +19,12 @@ int32_t example_advanced_plugins_app(void* p) {
     composite_api_resolver_add(resolver, firmware_api_interface);
     composite_api_resolver_add(resolver, application_api_interface);
 
-    PluginManager* manager = plugin_manager_alloc(
-        PLUGIN_APP_ID, PLUGIN_API_VERSION, composite_api_resolver_get(resolver));
+    // Plugins are mapped on first use and unmapped again if heap runs low
+    PluginManager* manager = plugin_manager_alloc_ex(
+        PLUGIN_APP_ID,
+        PLUGIN_API_VERSION,
+        composite_api_resolver_get(resolver),
+        PluginManagerFlagLazy | PluginManagerFlagEvict);
 
     do {
         if(plugin_manager_load_all(manager, APP_DATA_PATH("plugins")) != PluginManagerErrorNone) {
@@ -33,6 +37,10 @@ int32_t example_advanced_plugins_app(void* p) {
 
         for(uint32_t i = 0; i < plugin_count; i++) {
             const AdvancedPlugin* plugin = plugin_manager_get_ep(manager, i);
+            if(!plugin) {
+                FURI_LOG_E(TAG, "Failed to map plugin %lu", i);
+                continue;
+            }
             FURI_LOG_I(TAG, "plugin name: %s. Calling methods", plugin->name);
             plugin->method1(228);
             plugin->method2();
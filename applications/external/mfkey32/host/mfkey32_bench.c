@@ -0,0 +1,193 @@
+// Host benchmark for the mfkey32 solver, built from the same sources as the app:
+//   cc -O3 -pthread -I.. -o mfkey32_bench mfkey32_bench.c ../mfkey32_solver.c
+//   ./mfkey32_bench [threads] [msb_limit] [.mfkey32.log]
+// Without a log file the fixed corpus below is solved and checked against known keys.
+
+#include "mfkey32_solver.h"
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MFKEY32_BENCH_MAX_NONCES (1024)
+#define MFKEY32_BENCH_MAX_THREADS (64)
+
+typedef struct {
+    const char* line;
+    uint64_t key;
+} Mfkey32BenchVector;
+
+// Generated with known keys, the second nonce has the key of the first one.
+// It is deduplicated only if that key is found before the second nonce is taken,
+// which is certain with one thread only
+static const Mfkey32BenchVector mfkey32_bench_corpus[] = {
+    {"Sec 3 key A cuid 2a234f80 nt0 e60c220e nr0 90705e74 ar0 7aedeefa nt1 363a9f0b nr1 f1f782f6 "
+     "ar1 784d04a2",
+     0xA0A1A2A3A4A5ULL},
+    {"Sec 3 key A cuid 2a234f80 nt0 4e2b0474 nr0 2836fce8 ar0 7e8327d9 nt1 3e428de7 nr1 8d7c71cf "
+     "ar1 02e813b8",
+     0xA0A1A2A3A4A5ULL},
+    {"Sec 7 key A cuid 2a234f80 nt0 0e1e37aa nr0 a9d1291e ar0 21552d6f nt1 8936f80c nr1 6f41b1d6 "
+     "ar1 18a1fbbc",
+     0x4D3A99C351DDULL},
+    {"Sec 11 key A cuid 9c7d1e21 nt0 0e9c9edb nr0 365d8eec ar0 93f600cb nt1 bb87d768 nr1 a473c0d0 "
+     "ar1 d34198a5",
+     0x1A982C7E459AULL},
+    {"Sec 15 key A cuid 51e4a3b7 nt0 de5136db nr0 58c1013a ar0 0cbc317b nt1 132b355e nr1 ae301ec8 "
+     "ar1 f57f7025",
+     0xD3F7D3F7D3F7ULL},
+};
+
+typedef struct {
+    MfClassicNonce nonces[MFKEY32_BENCH_MAX_NONCES];
+    size_t nonces_count;
+    size_t next;
+    int msb_limit;
+
+    uint64_t keys[MFKEY32_BENCH_MAX_NONCES];
+    size_t keys_count;
+    size_t deduplicated;
+    size_t not_found;
+
+    pthread_mutex_t mutex;
+} Mfkey32Bench;
+
+static double mfkey32_bench_now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void* mfkey32_bench_worker(void* context) {
+    Mfkey32Bench* bench = context;
+
+    while(true) {
+        pthread_mutex_lock(&bench->mutex);
+        if(bench->next >= bench->nonces_count) {
+            pthread_mutex_unlock(&bench->mutex);
+            break;
+        }
+        MfClassicNonce nonce = bench->nonces[bench->next++];
+        bool known = mfkey32_nonce_key_known(bench->keys, bench->keys_count, &nonce);
+        if(known) bench->deduplicated++;
+        pthread_mutex_unlock(&bench->mutex);
+        if(known) continue;
+
+        uint64_t key = 0;
+        double start = mfkey32_bench_now();
+        Mfkey32SolverResult result =
+            mfkey32_solver_recover(&nonce, bench->msb_limit, 0, NULL, NULL, &key);
+        double elapsed = mfkey32_bench_now() - start;
+
+        pthread_mutex_lock(&bench->mutex);
+        if(result == Mfkey32SolverResultFound) {
+            printf("%08" PRIx32 " %08" PRIx32 ": %012" PRIX64 " in %.2fs\n",
+                   nonce.uid,
+                   nonce.ar1_enc,
+                   key,
+                   elapsed);
+            bool already_found = false;
+            for(size_t i = 0; i < bench->keys_count; i++) {
+                if(bench->keys[i] == key) already_found = true;
+            }
+            if(!already_found) bench->keys[bench->keys_count++] = key;
+        } else {
+            printf("%08" PRIx32 " %08" PRIx32 ": not found in %.2fs\n",
+                   nonce.uid,
+                   nonce.ar1_enc,
+                   elapsed);
+            bench->not_found++;
+        }
+        pthread_mutex_unlock(&bench->mutex);
+    }
+
+    return NULL;
+}
+
+static bool mfkey32_bench_load(Mfkey32Bench* bench, const char* path) {
+    FILE* file = fopen(path, "r");
+    if(!file) return false;
+
+    char line[256];
+    while(fgets(line, sizeof(line), file) && bench->nonces_count < MFKEY32_BENCH_MAX_NONCES) {
+        if(mfkey32_nonce_parse(line, &bench->nonces[bench->nonces_count])) {
+            bench->nonces_count++;
+        }
+    }
+    fclose(file);
+
+    return true;
+}
+
+int main(int argc, char** argv) {
+    static Mfkey32Bench bench;
+    int threads_count = argc > 1 ? atoi(argv[1]) : 1;
+    bench.msb_limit = argc > 2 ? atoi(argv[2]) : 16;
+    const char* path = argc > 3 ? argv[3] : NULL;
+
+    if(threads_count < 1 || threads_count > MFKEY32_BENCH_MAX_THREADS || bench.msb_limit < 1 ||
+       MFKEY32_MSB_TOTAL % bench.msb_limit) {
+        fprintf(stderr, "usage: %s [threads] [msb_limit] [.mfkey32.log]\n", argv[0]);
+        return 1;
+    }
+
+    if(path) {
+        if(!mfkey32_bench_load(&bench, path)) {
+            fprintf(stderr, "cannot open %s\n", path);
+            return 1;
+        }
+    } else {
+        for(size_t i = 0; i < sizeof(mfkey32_bench_corpus) / sizeof(mfkey32_bench_corpus[0]);
+            i++) {
+            if(!mfkey32_nonce_parse(mfkey32_bench_corpus[i].line, &bench.nonces[i])) return 1;
+            bench.nonces_count++;
+        }
+    }
+
+    pthread_mutex_init(&bench.mutex, NULL);
+    pthread_t threads[MFKEY32_BENCH_MAX_THREADS];
+    double start = mfkey32_bench_now();
+    for(int i = 0; i < threads_count; i++) {
+        pthread_create(&threads[i], NULL, mfkey32_bench_worker, &bench);
+    }
+    for(int i = 0; i < threads_count; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    double elapsed = mfkey32_bench_now() - start;
+    pthread_mutex_destroy(&bench.mutex);
+
+    printf("%zu nonces, %zu unique keys, %zu deduplicated, %zu not found\n",
+           bench.nonces_count,
+           bench.keys_count,
+           bench.deduplicated,
+           bench.not_found);
+    printf("%d threads, msb_limit %d: %.2fs\n", threads_count, bench.msb_limit, elapsed);
+
+    if(path) return 0;
+
+    // Every corpus key has to be recovered
+    int ret = 0;
+    if(threads_count == 1 && bench.deduplicated < 1) {
+        printf("corpus: second nonce was not deduplicated\n");
+        ret = 1;
+    }
+    for(size_t i = 0; i < bench.nonces_count; i++) {
+        if(!mfkey32_nonce_key_known(&mfkey32_bench_corpus[i].key, 1, &bench.nonces[i])) {
+            printf("corpus vector %zu: wrong key\n", i);
+            ret = 1;
+        }
+        bool recovered = false;
+        for(size_t j = 0; j < bench.keys_count; j++) {
+            if(bench.keys[j] == mfkey32_bench_corpus[i].key) recovered = true;
+        }
+        if(!recovered) {
+            printf("corpus key %012" PRIX64 " not recovered\n", mfkey32_bench_corpus[i].key);
+            ret = 1;
+        }
+    }
+
+    return ret;
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+// Mfkey32 key recovery core
+// Plain C with no firmware dependencies, so the same sources build for the
+// Flipper and for the host benchmark in host/mfkey32_bench.c
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Number of MSB values, search is split in 256 / msb_limit rounds
+#define MFKEY32_MSB_TOTAL (256)
+
+// TODO: Merge this with Crypto1Params?
+typedef struct {
+    uint32_t uid; // serial number
+    uint32_t nt0; // tag challenge first
+    uint32_t nt1; // tag challenge second
+    uint32_t nr0_enc; // first encrypted reader challenge
+    uint32_t ar0_enc; // first encrypted reader response
+    uint32_t nr1_enc; // second encrypted reader challenge
+    uint32_t ar1_enc; // second encrypted reader response
+} MfClassicNonce;
+
+typedef enum {
+    Mfkey32SolverResultFound,
+    Mfkey32SolverResultNotFound,
+    Mfkey32SolverResultAborted,
+} Mfkey32SolverResult;
+
+typedef enum {
+    Mfkey32SolverEventRoundStart, // round is about to be searched
+    Mfkey32SolverEventSync, // periodic call during the round
+    Mfkey32SolverEventRoundDone, // round searched without result
+} Mfkey32SolverEvent;
+
+/** Solver progress callback
+ *
+ * @param event Mfkey32SolverEvent
+ * @param round current round, 0 to (MFKEY32_MSB_TOTAL / msb_limit) - 1
+ * @param context callback context
+ *
+ * @return true to abort the search
+ */
+typedef bool (*Mfkey32SolverCallback)(Mfkey32SolverEvent event, int round, void* context);
+
+uint32_t prng_successor(uint32_t x, uint32_t n);
+
+int key_already_found_for_nonce(
+    const uint64_t* keyarray,
+    int keyarray_size,
+    uint32_t uid_xor_nt1,
+    uint32_t nr1_enc,
+    uint32_t p64b,
+    uint32_t ar1_enc);
+
+/** Check known keys against a nonce
+ *
+ * @param keys known keys
+ * @param count known keys count
+ * @param nonce MfClassicNonce
+ *
+ * @return true if one of the keys produces the nonce
+ */
+bool mfkey32_nonce_key_known(
+    const uint64_t* keys,
+    size_t count,
+    const MfClassicNonce* nonce);
+
+/** Parse a line of .mfkey32.log
+ *
+ * @param line "Sec ... cuid ... nt0 ... ar1 ..." line
+ * @param nonce parsed nonce
+ *
+ * @return true if line is a nonce line
+ */
+bool mfkey32_nonce_parse(const char* line, MfClassicNonce* nonce);
+
+/** Get nonce id, used to recognize already searched nonces across runs
+ *
+ * @param nonce MfClassicNonce
+ *
+ * @return 32-bit FNV-1a hash of the nonce
+ */
+uint32_t mfkey32_nonce_hash(const MfClassicNonce* nonce);
+
+/** Recover the key for a nonce
+ *
+ * Holds no global state, separate nonces can be solved from separate threads.
+ *
+ * @param nonce MfClassicNonce
+ * @param msb_limit chunk size in MSB values, lower uses less RAM
+ * @param first_round round to start from, used to resume a search
+ * @param callback Mfkey32SolverCallback, can be NULL
+ * @param context callback context
+ * @param key recovered key
+ *
+ * @return Mfkey32SolverResult
+ */
+Mfkey32SolverResult mfkey32_solver_recover(
+    const MfClassicNonce* nonce,
+    int msb_limit,
+    int first_round,
+    Mfkey32SolverCallback callback,
+    void* context,
+    uint64_t* key);
+
+#ifdef __cplusplus
+}
+#endif
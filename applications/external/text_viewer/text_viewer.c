@@ -4,6 +4,7 @@
 #include <text_viewer_icons.h>
 #include <gui/gui.h>
 #include <gui/elements.h>
+#include <gui/text_layout.h>
 #include <dialogs/dialogs.h>
 
 #include <storage/storage.h>
@@ -16,17 +17,13 @@
 #define TEXT_VIEWER_APP_PATH_FOLDER ANY_PATH("")
 #define TEXT_VIEWER_APP_EXTENSION "*"
 
-#define TEXT_VIEWER_BYTES_PER_LINE 20u
 #define TEXT_VIEWER_LINES_ON_SCREEN 5u
-#define TEXT_VIEWER_BUF_SIZE (TEXT_VIEWER_LINES_ON_SCREEN * TEXT_VIEWER_BYTES_PER_LINE)
+#define TEXT_VIEWER_LINE_WIDTH 120u
 
 typedef struct {
-    uint8_t file_bytes[TEXT_VIEWER_LINES_ON_SCREEN][TEXT_VIEWER_BYTES_PER_LINE];
-    uint32_t file_offset;
-    uint32_t file_read_bytes;
+    TextLayout* layout;
     uint32_t file_size;
     Stream* stream;
-    bool mode; // Print address or content
 } TextViewerModel;
 
 typedef struct {
@@ -47,52 +44,16 @@ static void render_callback(Canvas* canvas, void* ctx) {
     canvas_clear(canvas);
     canvas_set_color(canvas, ColorBlack);
 
-    //elements_button_left(canvas, text_viewer->model->mode ? "Addr" : "Text");
-    text_viewer->model->mode = 1; //text mode
-    //elements_button_right(canvas, "Info");
-
-    int ROW_HEIGHT = 12;
     int TOP_OFFSET = 10;
     int LEFT_OFFSET = 3;
 
-    uint32_t line_count = text_viewer->model->file_size / TEXT_VIEWER_BYTES_PER_LINE;
-    if(text_viewer->model->file_size % TEXT_VIEWER_BYTES_PER_LINE != 0) line_count += 1;
-    uint32_t first_line_on_screen = text_viewer->model->file_offset / TEXT_VIEWER_BYTES_PER_LINE;
-    if(line_count > TEXT_VIEWER_LINES_ON_SCREEN) {
-        uint8_t width = canvas_width(canvas);
-        elements_scrollbar_pos(
-            canvas,
-            width,
-            0,
-            ROW_HEIGHT * TEXT_VIEWER_LINES_ON_SCREEN,
-            first_line_on_screen, // TODO
-            line_count - (TEXT_VIEWER_LINES_ON_SCREEN - 1));
-    }
-
-    char temp_buf[32];
-    uint32_t row_iters = text_viewer->model->file_read_bytes / TEXT_VIEWER_BYTES_PER_LINE;
-    if(text_viewer->model->file_read_bytes % TEXT_VIEWER_BYTES_PER_LINE != 0) row_iters += 1;
-
-    for(uint32_t i = 0; i < row_iters; ++i) {
-        uint32_t bytes_left_per_row =
-            text_viewer->model->file_read_bytes - i * TEXT_VIEWER_BYTES_PER_LINE;
-        bytes_left_per_row = MIN(bytes_left_per_row, TEXT_VIEWER_BYTES_PER_LINE);
+    text_layout_draw(
+        text_viewer->model->layout, canvas, LEFT_OFFSET, TOP_OFFSET, TEXT_VIEWER_LINES_ON_SCREEN);
 
-        if(text_viewer->model->mode) {
-            memcpy(temp_buf, text_viewer->model->file_bytes[i], bytes_left_per_row);
-            temp_buf[bytes_left_per_row] = '\0';
-            for(uint32_t j = 0; j < bytes_left_per_row; ++j)
-                if(!isprint((int)temp_buf[j])) temp_buf[j] = ' ';
-
-            canvas_set_font(canvas, FontKeyboard);
-            canvas_draw_str(canvas, LEFT_OFFSET, TOP_OFFSET + i * ROW_HEIGHT, temp_buf);
-        } else {
-            uint32_t addr = text_viewer->model->file_offset + i * TEXT_VIEWER_BYTES_PER_LINE;
-            snprintf(temp_buf, 32, "%04lX", addr);
-
-            canvas_set_font(canvas, FontKeyboard);
-            canvas_draw_str(canvas, LEFT_OFFSET, TOP_OFFSET + i * ROW_HEIGHT, temp_buf);
-        }
+    uint16_t scroll_pos, scroll_total;
+    text_layout_get_scrollbar(text_viewer->model->layout, &scroll_pos, &scroll_total);
+    if(scroll_total) {
+        elements_scrollbar(canvas, scroll_pos, scroll_total);
     }
 
     furi_mutex_release(text_viewer->mutex);
@@ -110,6 +71,9 @@ static TextViewer* text_viewer_alloc() {
 
     instance->model = malloc(sizeof(TextViewerModel));
     memset(instance->model, 0x0, sizeof(TextViewerModel));
+    instance->model->layout = text_layout_alloc();
+    text_layout_set_font(instance->model->layout, FontKeyboard);
+    text_layout_set_width(instance->model->layout, TEXT_VIEWER_LINE_WIDTH);
 
     instance->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
 
@@ -138,7 +102,11 @@ static void text_viewer_free(TextViewer* instance) {
 
     furi_mutex_free(instance->mutex);
 
-    if(instance->model->stream) buffered_file_stream_close(instance->model->stream);
+    text_layout_free(instance->model->layout);
+    if(instance->model->stream) {
+        buffered_file_stream_close(instance->model->stream);
+        stream_free(instance->model->stream);
+    }
 
     free(instance->model);
     free(instance);
@@ -160,31 +128,7 @@ static bool text_viewer_open_file(TextViewer* text_viewer, const char* file_path
         }
 
         text_viewer->model->file_size = stream_size(text_viewer->model->stream);
-    } while(false);
-
-    return isOk;
-}
-
-static bool text_viewer_read_file(TextViewer* text_viewer) {
-    furi_assert(text_viewer);
-    furi_assert(text_viewer->model->stream);
-    furi_assert(text_viewer->model->file_offset % TEXT_VIEWER_BYTES_PER_LINE == 0);
-
-    memset(text_viewer->model->file_bytes, 0x0, TEXT_VIEWER_BUF_SIZE);
-    bool isOk = true;
-
-    do {
-        uint32_t offset = text_viewer->model->file_offset;
-        if(!stream_seek(text_viewer->model->stream, offset, true)) {
-            FURI_LOG_E(TAG, "Unable to seek stream");
-            isOk = false;
-            break;
-        }
-
-        text_viewer->model->file_read_bytes = stream_read(
-            text_viewer->model->stream,
-            (uint8_t*)text_viewer->model->file_bytes,
-            TEXT_VIEWER_BUF_SIZE);
+        text_layout_set_stream(text_viewer->model->layout, text_viewer->model->stream);
     } while(false);
 
     return isOk;
@@ -220,36 +164,16 @@ int32_t text_viewer_app(void* p) {
         FURI_LOG_I(TAG, "File selected: %s", furi_string_get_cstr(file_path));
 
         if(!text_viewer_open_file(text_viewer, furi_string_get_cstr(file_path))) break;
-        text_viewer_read_file(text_viewer);
 
         InputEvent input;
         while(furi_message_queue_get(text_viewer->input_queue, &input, FuriWaitForever) ==
               FuriStatusOk) {
             if(input.key == InputKeyBack) {
                 break;
-            } else if(input.key == InputKeyUp) {
-                furi_check(
-                    furi_mutex_acquire(text_viewer->mutex, FuriWaitForever) == FuriStatusOk);
-                if(text_viewer->model->file_offset > 0) {
-                    text_viewer->model->file_offset -= TEXT_VIEWER_BYTES_PER_LINE;
-                    if(!text_viewer_read_file(text_viewer)) break;
-                }
-                furi_mutex_release(text_viewer->mutex);
-            } else if(input.key == InputKeyDown) {
-                furi_check(
-                    furi_mutex_acquire(text_viewer->mutex, FuriWaitForever) == FuriStatusOk);
-                uint32_t last_byte_on_screen =
-                    text_viewer->model->file_offset + text_viewer->model->file_read_bytes;
-
-                if(text_viewer->model->file_size > last_byte_on_screen) {
-                    text_viewer->model->file_offset += TEXT_VIEWER_BYTES_PER_LINE;
-                    if(!text_viewer_read_file(text_viewer)) break;
-                }
-                furi_mutex_release(text_viewer->mutex);
-            } else if(input.key == InputKeyLeft) {
+            } else if(input.key == InputKeyUp || input.key == InputKeyDown) {
                 furi_check(
                     furi_mutex_acquire(text_viewer->mutex, FuriWaitForever) == FuriStatusOk);
-                text_viewer->model->mode = !text_viewer->model->mode;
+                text_layout_scroll(text_viewer->model->layout, input.key == InputKeyUp ? -1 : 1);
                 furi_mutex_release(text_viewer->mutex);
             } else if(input.key == InputKeyRight) {
                 FuriString* buffer;
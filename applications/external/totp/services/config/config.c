@@ -285,6 +285,7 @@ bool totp_config_file_update_user_settings(const PluginState* plugin_state) {
     FlipperFormat* file = plugin_state->config_file_context->config_file;
     flipper_format_rewind(file);
     bool update_result = false;
+    flipper_format_transaction_begin(file);
     do {
         if(!flipper_format_insert_or_update_float(
                file, TOTP_CONFIG_KEY_TIMEZONE, &plugin_state->timezone_offset, 1)) {
@@ -311,6 +312,13 @@ bool totp_config_file_update_user_settings(const PluginState* plugin_state) {
         update_result = true;
     } while(false);
 
+    if(update_result) {
+        update_result = flipper_format_transaction_commit(file);
+    }
+    if(!update_result) {
+        flipper_format_transaction_abort(file);
+    }
+
     return update_result;
 }
 
@@ -472,7 +480,10 @@ bool totp_config_file_load(PluginState* const plugin_state) {
         plugin_state->config_file_context->config_file = fff_data_file;
         plugin_state->config_file_context->token_info_iterator_context =
             totp_token_info_iterator_alloc(
-                storage, plugin_state->config_file_context->config_file, plugin_state->iv);
+                storage,
+                plugin_state->config_file_context->config_file,
+                CONFIG_FILE_PATH,
+                plugin_state->iv);
         result = true;
     } while(false);
 
@@ -484,6 +495,7 @@ bool totp_config_file_update_crypto_signatures(const PluginState* plugin_state)
     FlipperFormat* config_file = plugin_state->config_file_context->config_file;
     flipper_format_rewind(config_file);
     bool update_result = false;
+    flipper_format_transaction_begin(config_file);
     do {
         if(!flipper_format_insert_or_update_hex(
                config_file, TOTP_CONFIG_KEY_BASE_IV, plugin_state->base_iv, TOTP_IV_SIZE)) {
@@ -506,13 +518,22 @@ bool totp_config_file_update_crypto_signatures(const PluginState* plugin_state)
         update_result = true;
     } while(false);
 
+    if(update_result) {
+        update_result = flipper_format_transaction_commit(config_file);
+    }
+    if(!update_result) {
+        flipper_format_transaction_abort(config_file);
+    }
+
     return update_result;
 }
 
 void totp_config_file_close(PluginState* const plugin_state) {
     if(plugin_state->config_file_context == NULL) return;
-    totp_token_info_iterator_free(plugin_state->config_file_context->token_info_iterator_context);
     totp_close_config_file(plugin_state->config_file_context->config_file);
+    totp_token_info_iterator_save_index(
+        plugin_state->config_file_context->token_info_iterator_context);
+    totp_token_info_iterator_free(plugin_state->config_file_context->token_info_iterator_context);
     free(plugin_state->config_file_context);
     plugin_state->config_file_context = NULL;
     totp_close_storage();
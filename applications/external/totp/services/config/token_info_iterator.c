@@ -6,19 +6,33 @@
 #include "../../types/common.h"
 
 #define CONFIG_FILE_PART_FILE_PATH CONFIG_FILE_DIRECTORY_PATH "/totp.conf.part"
+#define CONFIG_FILE_INDEX_FILE_PATH CONFIG_FILE_DIRECTORY_PATH "/totp.conf.idx"
+#define CONFIG_FILE_INDEX_MAGIC (0x58444954)
+#define CONFIG_FILE_INDEX_VERSION (1)
 #define STREAM_COPY_BUFFER_SIZE 128
+#define TOKEN_START_MARKER "\n" TOTP_CONFIG_KEY_TOKEN_NAME ":"
+#define TOKEN_OFFSETS_CAPACITY_STEP 16
 
 struct TokenInfoIteratorContext {
     size_t total_count;
     size_t current_index;
-    size_t last_seek_offset;
-    size_t last_seek_index;
+    size_t* token_offsets;
+    size_t token_offsets_capacity;
     TokenInfo* current_token;
     FlipperFormat* config_file;
+    const char* config_file_path;
     uint8_t* iv;
     Storage* storage;
 };
 
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t config_file_size;
+    uint32_t config_file_timestamp;
+    uint32_t tokens_count;
+} TokenInfoIteratorIndexHeader;
+
 static bool
     flipper_format_seek_to_siblinig_token_start(Stream* stream, StreamDirection direction) {
     char buffer[sizeof(TOTP_CONFIG_KEY_TOKEN_NAME) + 1];
@@ -37,7 +51,7 @@ static bool
             break;
         }
 
-        if(strncmp(buffer, "\n" TOTP_CONFIG_KEY_TOKEN_NAME ":", sizeof(buffer)) == 0) {
+        if(strncmp(buffer, TOKEN_START_MARKER, sizeof(buffer)) == 0) {
             found = true;
         }
     }
@@ -45,55 +59,144 @@ static bool
     return found;
 }
 
-static bool seek_to_token(size_t token_index, TokenInfoIteratorContext* context) {
-    furi_check(context != NULL && context->config_file != NULL);
-    if(token_index >= context->total_count) {
-        return false;
+static void token_index_ensure_capacity(TokenInfoIteratorContext* context, size_t capacity) {
+    if(capacity <= context->token_offsets_capacity) return;
+    size_t new_capacity = (capacity + TOKEN_OFFSETS_CAPACITY_STEP - 1) /
+                          TOKEN_OFFSETS_CAPACITY_STEP * TOKEN_OFFSETS_CAPACITY_STEP;
+    context->token_offsets = realloc(context->token_offsets, new_capacity * sizeof(size_t));
+    furi_check(context->token_offsets != NULL);
+    context->token_offsets_capacity = new_capacity;
+}
+
+static void token_index_insert(TokenInfoIteratorContext* context, size_t index, size_t offset) {
+    furi_check(index <= context->total_count);
+    token_index_ensure_capacity(context, context->total_count + 1);
+    memmove(
+        &context->token_offsets[index + 1],
+        &context->token_offsets[index],
+        (context->total_count - index) * sizeof(size_t));
+    context->token_offsets[index] = offset;
+    context->total_count++;
+}
+
+static void token_index_remove(TokenInfoIteratorContext* context, size_t index) {
+    furi_check(index < context->total_count);
+    memmove(
+        &context->token_offsets[index],
+        &context->token_offsets[index + 1],
+        (context->total_count - index - 1) * sizeof(size_t));
+    context->total_count--;
+}
+
+static void token_index_shift(TokenInfoIteratorContext* context, size_t from_index, long delta) {
+    for(size_t i = from_index; i < context->total_count; i++) {
+        context->token_offsets[i] += delta;
+    }
+}
+
+static bool is_token_start_at(Stream* stream, size_t offset) {
+    char buffer[sizeof(TOKEN_START_MARKER) - 1];
+    return stream_seek(stream, offset, StreamOffsetFromStart) &&
+           stream_read(stream, (uint8_t*)&buffer[0], sizeof(buffer)) == sizeof(buffer) &&
+           memcmp(buffer, TOKEN_START_MARKER, sizeof(buffer)) == 0;
+}
+
+static void token_index_rebuild(TokenInfoIteratorContext* context) {
+    Stream* stream = flipper_format_get_raw_stream(context->config_file);
+    context->total_count = 0;
+    stream_rewind(stream);
+    while(flipper_format_seek_to_siblinig_token_start(stream, StreamDirectionForward)) {
+        token_index_insert(context, context->total_count, stream_tell(stream));
     }
+}
 
+/**
+ * @brief Re-aligns token offsets after the config file header has been changed
+ * by someone else (e.g. settings update), which shifts all the tokens uniformly
+ * @param context token info iterator context
+ * @return \c true if token offsets are valid after re-aligning; \c false otherwise
+ */
+static bool token_index_rebase(TokenInfoIteratorContext* context) {
+    if(context->total_count == 0) return false;
     Stream* stream = flipper_format_get_raw_stream(context->config_file);
-    long token_index_diff = (long)token_index - (long)context->last_seek_index;
-    size_t token_index_diff_weight = (size_t)labs(token_index_diff);
-    StreamDirection direction = token_index_diff >= 0 ? StreamDirectionForward :
-                                                        StreamDirectionBackward;
-    if(token_index_diff_weight > token_index || context->last_seek_offset == 0) {
-        context->last_seek_offset = 0;
-        context->last_seek_index = 0;
-        token_index_diff = token_index + 1;
-        direction = StreamDirectionForward;
-    } else if(token_index_diff_weight > (context->total_count - token_index - 1)) {
-        context->last_seek_offset = stream_size(stream);
-        context->last_seek_index = context->total_count - 1;
-        token_index_diff = -(long)(context->total_count - token_index);
-        direction = StreamDirectionBackward;
-    }
-
-    if(!stream_seek(stream, context->last_seek_offset, StreamOffsetFromStart)) {
+    if(!stream_rewind(stream) ||
+       !flipper_format_seek_to_siblinig_token_start(stream, StreamDirectionForward)) {
         return false;
     }
 
-    if(token_index_diff != 0) {
-        long i = 0;
-        long i_inc = token_index_diff >= 0 ? 1 : -1;
-        do {
-            if(!flipper_format_seek_to_siblinig_token_start(stream, direction)) {
-                break;
-            }
+    long delta = (long)stream_tell(stream) - (long)context->token_offsets[0];
+    token_index_shift(context, 0, delta);
+    return is_token_start_at(stream, context->token_offsets[context->total_count - 1]);
+}
 
-            i += i_inc;
-        } while((i_inc > 0 && i < token_index_diff) || (i_inc < 0 && i > token_index_diff));
+static bool token_index_load(TokenInfoIteratorContext* context) {
+    uint32_t config_file_timestamp;
+    if(storage_common_timestamp(
+           context->storage, context->config_file_path, &config_file_timestamp) != FSE_OK) {
+        return false;
+    }
 
-        if((i_inc > 0 && i < token_index_diff) || (i_inc < 0 && i > token_index_diff)) {
-            context->last_seek_offset = 0;
-            FURI_LOG_D(LOGGING_TAG, "Was not able to move");
-            return false;
+    Stream* stream = flipper_format_get_raw_stream(context->config_file);
+    File* file = storage_file_alloc(context->storage);
+    bool result = false;
+    do {
+        if(!storage_file_open(
+               file, CONFIG_FILE_INDEX_FILE_PATH, FSAM_READ, FSOM_OPEN_EXISTING)) {
+            break;
+        }
+
+        TokenInfoIteratorIndexHeader header;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header) ||
+           header.magic != CONFIG_FILE_INDEX_MAGIC ||
+           header.version != CONFIG_FILE_INDEX_VERSION ||
+           header.config_file_size != stream_size(stream) ||
+           header.config_file_timestamp != config_file_timestamp) {
+            break;
         }
 
-        context->last_seek_offset = stream_tell(stream);
-        context->last_seek_index = token_index;
+        token_index_ensure_capacity(context, header.tokens_count);
+        context->total_count = 0;
+        uint32_t offset;
+        while(context->total_count < header.tokens_count &&
+              storage_file_read(file, &offset, sizeof(offset)) == sizeof(offset)) {
+            context->token_offsets[context->total_count++] = offset;
+        }
+
+        if(context->total_count < header.tokens_count) {
+            break;
+        }
+
+        result = header.tokens_count == 0 ||
+                 is_token_start_at(stream, context->token_offsets[header.tokens_count - 1]);
+    } while(false);
+
+    storage_file_free(file);
+    if(!result) {
+        context->total_count = 0;
     }
 
-    return true;
+    return result;
+}
+
+static bool seek_to_token(size_t token_index, TokenInfoIteratorContext* context) {
+    furi_check(context != NULL && context->config_file != NULL);
+    if(token_index >= context->total_count) {
+        return false;
+    }
+
+    Stream* stream = flipper_format_get_raw_stream(context->config_file);
+    if(!is_token_start_at(stream, context->token_offsets[token_index])) {
+        FURI_LOG_D(LOGGING_TAG, "Token index is out of sync");
+        if(!token_index_rebase(context) ||
+           !is_token_start_at(stream, context->token_offsets[token_index])) {
+            token_index_rebuild(context);
+            if(token_index >= context->total_count) {
+                return false;
+            }
+        }
+    }
+
+    return stream_seek(stream, context->token_offsets[token_index], StreamOffsetFromStart);
 }
 
 static bool stream_insert_stream(Stream* dst, Stream* src) {
@@ -143,16 +246,15 @@ static bool
     }
 
     size_t offset_start = stream_tell(stream);
+    size_t original_size = stream_size(stream);
 
     size_t offset_end;
     if(is_new_token) {
         offset_end = offset_start;
     } else if(context->current_index + 1 >= context->total_count) {
-        offset_end = stream_size(stream);
-    } else if(seek_to_token(context->current_index + 1, context)) {
-        offset_end = stream_tell(stream);
+        offset_end = original_size;
     } else {
-        return false;
+        offset_end = context->token_offsets[context->current_index + 1];
     }
 
     FlipperFormat* temp_ff = flipper_format_file_alloc(context->storage);
@@ -221,7 +323,12 @@ static bool
         }
 
         if(is_new_token) {
-            context->total_count++;
+            token_index_insert(context, context->total_count, offset_start - 1);
+        } else {
+            token_index_shift(
+                context,
+                context->current_index + 1,
+                (long)stream_size(stream) - (long)original_size);
         }
 
         result = true;
@@ -231,39 +338,90 @@ static bool
     storage_common_remove(context->storage, CONFIG_FILE_PART_FILE_PATH);
 
     stream_seek(stream, offset_start, StreamOffsetFromStart);
-    context->last_seek_offset = offset_start;
-    context->last_seek_index = context->current_index;
 
     return result;
 }
 
-TokenInfoIteratorContext*
-    totp_token_info_iterator_alloc(Storage* storage, FlipperFormat* config_file, uint8_t* iv) {
-    Stream* stream = flipper_format_get_raw_stream(config_file);
-    stream_rewind(stream);
-    size_t tokens_count = 0;
-    while(true) {
-        if(!flipper_format_seek_to_siblinig_token_start(stream, StreamDirectionForward)) {
-            break;
-        }
-
-        tokens_count++;
-    }
-
+TokenInfoIteratorContext* totp_token_info_iterator_alloc(
+    Storage* storage,
+    FlipperFormat* config_file,
+    const char* config_file_path,
+    uint8_t* iv) {
     TokenInfoIteratorContext* context = malloc(sizeof(TokenInfoIteratorContext));
     furi_check(context != NULL);
 
-    context->total_count = tokens_count;
+    context->total_count = 0;
+    context->current_index = 0;
+    context->token_offsets = NULL;
+    context->token_offsets_capacity = 0;
     context->current_token = token_info_alloc();
     context->config_file = config_file;
+    context->config_file_path = config_file_path;
     context->iv = iv;
     context->storage = storage;
+
+    if(!token_index_load(context)) {
+        FURI_LOG_D(LOGGING_TAG, "Token index is missing or outdated, rebuilding");
+        token_index_rebuild(context);
+    }
+
     return context;
 }
 
+bool totp_token_info_iterator_save_index(const TokenInfoIteratorContext* context) {
+    FileInfo config_file_info;
+    uint32_t config_file_timestamp;
+    if(storage_common_stat(context->storage, context->config_file_path, &config_file_info) !=
+           FSE_OK ||
+       storage_common_timestamp(
+           context->storage, context->config_file_path, &config_file_timestamp) != FSE_OK) {
+        return false;
+    }
+
+    TokenInfoIteratorIndexHeader header = {
+        .magic = CONFIG_FILE_INDEX_MAGIC,
+        .version = CONFIG_FILE_INDEX_VERSION,
+        .config_file_size = config_file_info.size,
+        .config_file_timestamp = config_file_timestamp,
+        .tokens_count = context->total_count};
+
+    File* file = storage_file_alloc(context->storage);
+    bool result = false;
+    do {
+        if(!storage_file_open(
+               file, CONFIG_FILE_INDEX_FILE_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+            break;
+        }
+
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) {
+            break;
+        }
+
+        size_t i = 0;
+        while(i < context->total_count) {
+            uint32_t offset = context->token_offsets[i];
+            if(storage_file_write(file, &offset, sizeof(offset)) != sizeof(offset)) {
+                break;
+            }
+
+            i++;
+        }
+
+        result = i == context->total_count;
+    } while(false);
+
+    storage_file_free(file);
+    if(!result) {
+        storage_common_remove(context->storage, CONFIG_FILE_INDEX_FILE_PATH);
+    }
+
+    return result;
+}
+
 void totp_token_info_iterator_free(TokenInfoIteratorContext* context) {
     if(context == NULL) return;
     token_info_free(context->current_token);
+    free(context->token_offsets);
     free(context);
 }
 
@@ -281,10 +439,8 @@ bool totp_token_info_iterator_remove_current_token_info(TokenInfoIteratorContext
 
     if(context->current_index >= context->total_count - 1) {
         end_offset = stream_size(stream) - 1;
-    } else if(seek_to_token(context->current_index + 1, context)) {
-        end_offset = stream_tell(stream);
     } else {
-        return false;
+        end_offset = context->token_offsets[context->current_index + 1];
     }
 
     if(!stream_seek(stream, begin_offset, StreamOffsetFromStart) ||
@@ -292,7 +448,8 @@ bool totp_token_info_iterator_remove_current_token_info(TokenInfoIteratorContext
         return false;
     }
 
-    context->total_count--;
+    token_index_remove(context, context->current_index);
+    token_index_shift(context, context->current_index, -(long)(end_offset - begin_offset));
     if(context->current_index >= context->total_count) {
         context->current_index = context->total_count - 1;
     }
@@ -319,10 +476,8 @@ bool totp_token_info_iterator_move_current_token_info(
     size_t end_offset;
     if(context->current_index >= context->total_count - 1) {
         end_offset = stream_size(stream) - 1;
-    } else if(seek_to_token(context->current_index + 1, context)) {
-        end_offset = stream_tell(stream);
     } else {
-        return false;
+        end_offset = context->token_offsets[context->current_index + 1];
     }
 
     Stream* temp_stream = file_stream_alloc(context->storage);
@@ -356,24 +511,34 @@ bool totp_token_info_iterator_move_current_token_info(
             break;
         }
 
-        context->last_seek_offset = 0;
-        context->last_seek_index = 0;
-        if(new_index >= context->total_count - 1) {
-            if(!stream_seek(stream, stream_size(stream) - 1, StreamOffsetFromStart)) {
-                break;
-            }
-        } else if(!seek_to_token(new_index, context)) {
+        token_index_remove(context, context->current_index);
+        token_index_shift(context, context->current_index, -(long)moving_size);
+
+        size_t insert_offset;
+        if(new_index >= context->total_count) {
+            new_index = context->total_count;
+            insert_offset = stream_size(stream) - 1;
+        } else {
+            insert_offset = context->token_offsets[new_index];
+        }
+
+        if(!stream_seek(stream, insert_offset, StreamOffsetFromStart)) {
             break;
         }
 
         result = stream_insert_stream(stream, temp_stream);
+        if(result) {
+            token_index_shift(context, new_index, (long)moving_size);
+            token_index_insert(context, new_index, insert_offset);
+        }
     } while(false);
 
     stream_free(temp_stream);
     storage_common_remove(context->storage, CONFIG_FILE_PART_FILE_PATH);
 
-    context->last_seek_offset = 0;
-    context->last_seek_index = 0;
+    if(!result) {
+        token_index_rebuild(context);
+    }
 
     return result;
 }
@@ -25,14 +25,28 @@ enum TotpIteratorUpdateTokenResults {
 };
 
 /**
- * @brief Initializes a new token info iterator
+ * @brief Initializes a new token info iterator.
+ * Token offsets are loaded from the persisted token index if it is still valid for the given
+ * config file; otherwise config file is scanned and token index is rebuilt
  * @param storage storage reference
  * @param config_file config file to use
+ * @param config_file_path path to the config file, used to validate persisted token index
  * @param iv initialization vector (IV) to be used for encryption\decryption
  * @return Token info iterator context
  */
-TokenInfoIteratorContext*
-    totp_token_info_iterator_alloc(Storage* storage, FlipperFormat* config_file, uint8_t* iv);
+TokenInfoIteratorContext* totp_token_info_iterator_alloc(
+    Storage* storage,
+    FlipperFormat* config_file,
+    const char* config_file_path,
+    uint8_t* iv);
+
+/**
+ * @brief Persists token index so the next iterator allocation doesn't need to scan config file.
+ * Must be called once config file is closed, so its size and timestamp are final
+ * @param context token info iterator context
+ * @return \c true if token index has been saved; \c false otherwise
+ */
+bool totp_token_info_iterator_save_index(const TokenInfoIteratorContext* context);
 
 /**
  * @brief Navigates iterator to the token with given index
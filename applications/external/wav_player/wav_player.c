@@ -34,7 +34,11 @@ static bool open_wav_stream(Stream* stream) {
 
     furi_record_close(RECORD_DIALOGS);
     if(ret) {
-        if(!file_stream_open(stream, furi_string_get_cstr(path), FSAM_READ, FSOM_OPEN_EXISTING)) {
+        if(!file_stream_open(
+               stream,
+               furi_string_get_cstr(path),
+               FSAM_READ,
+               FSOM_OPEN_EXISTING | FSOM_FAST_SEEK)) {
             FURI_LOG_E(TAG, "Cannot open file \"%s\"", furi_string_get_cstr(path));
         } else {
             result = true;
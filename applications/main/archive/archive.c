@@ -23,6 +23,8 @@ static ArchiveApp* archive_alloc() {
 
     archive->fav_move_str = furi_string_alloc();
 
+    archive_favorites_init();
+
     archive->scene_manager = scene_manager_alloc(&archive_scene_handlers, archive);
     archive->view_dispatcher = view_dispatcher_alloc();
 
@@ -63,6 +65,9 @@ void archive_free(ArchiveApp* archive) {
     furi_assert(archive);
     ViewDispatcher* view_dispatcher = archive->view_dispatcher;
 
+    // Stop favorites worker before the browser and dispatcher it reports to
+    archive_favorites_free();
+
     // Loading
     loading_free(archive->loading);
 
@@ -4,260 +4,545 @@
 #include "archive_apps.h"
 #include "archive_browser.h"
 
-#define ARCHIVE_FAV_FILE_BUF_LEN 32
+#include <m-array.h>
+#include <m-dict.h>
+
+#define TAG "ArchiveFavorites"
+
+#define ARCHIVE_FAV_FILE_MAX_SIZE (16 * 1024)
+#define ARCHIVE_FAV_FLUSH_DELAY_MS 500
+#define ARCHIVE_FAV_WORKER_STACK_SIZE 2048
+
+typedef enum {
+    ArchiveFavoriteFlagVerified = (1 << 0),
+    ArchiveFavoriteFlagFolder = (1 << 1),
+} ArchiveFavoriteFlag;
+
+typedef enum {
+    ArchiveFavoritesEventExit = (1 << 0),
+    ArchiveFavoritesEventFlush = (1 << 1),
+    ArchiveFavoritesEventRescan = (1 << 2),
+} ArchiveFavoritesEvent;
+
+#define ARCHIVE_FAV_EVENT_ALL \
+    (ArchiveFavoritesEventExit | ArchiveFavoritesEventFlush | ArchiveFavoritesEventRescan)
+
+ARRAY_DEF(ArchiveFavoritesList, FuriString*, FURI_STRING_OPLIST)
+DICT_DEF2(ArchiveFavoritesDict, FuriString*, FURI_STRING_OPLIST, uint8_t, M_DEFAULT_OPLIST)
+
+typedef struct {
+    FuriMutex* mutex;
+    FuriThread* worker;
+    ArchiveBrowserView* browser;
+    // Favorites in display order, as persisted in ARCHIVE_FAV_PATH
+    ArchiveFavoritesList_t list;
+    // Path -> ArchiveFavoriteFlag, membership lookups
+    ArchiveFavoritesDict_t dict;
+    bool loaded;
+    bool dirty;
+    // File was not read completely, saving would drop the rest
+    bool incomplete;
+} ArchiveFavorites;
+
+static ArchiveFavorites* archive_favorites = NULL;
+
+static bool archive_favorites_is_app(const FuriString* path) {
+    return furi_string_search(path, "/app:") == 0;
+}
 
-static bool archive_favorites_read_line(File* file, FuriString* str_result) {
-    furi_string_reset(str_result);
-    uint8_t buffer[ARCHIVE_FAV_FILE_BUF_LEN];
-    bool result = false;
+static uint8_t archive_favorites_guess_flags(const FuriString* path) {
+    // Until the background check stats the entry, treat names without extension as folders
+    size_t dot = furi_string_search_rchar(path, '.');
+    size_t filename_start = furi_string_search_rchar(path, '/');
+    if((dot == FURI_STRING_FAILURE) || (filename_start > dot)) {
+        return ArchiveFavoriteFlagFolder;
+    }
+    return 0;
+}
 
-    do {
-        uint16_t read_count = storage_file_read(file, buffer, ARCHIVE_FAV_FILE_BUF_LEN);
-        if(storage_file_get_error(file) != FSE_OK) {
-            return false;
-        }
+static void archive_favorites_request(ArchiveFavoritesEvent event) {
+    furi_thread_flags_set(furi_thread_get_id(archive_favorites->worker), event);
+}
 
-        for(uint16_t i = 0; i < read_count; i++) {
-            if(buffer[i] == '\n') {
-                uint32_t position = storage_file_tell(file);
-                if(storage_file_get_error(file) != FSE_OK) {
-                    return false;
-                }
+static void archive_favorites_mark_dirty() {
+    archive_favorites->dirty = true;
+    archive_favorites_request(ArchiveFavoritesEventFlush);
+}
 
-                position = position - read_count + i + 1;
+static void archive_favorites_append(FuriString* path) {
+    if(ArchiveFavoritesDict_get(archive_favorites->dict, path)) {
+        return; // Skip duplicates
+    }
+    ArchiveFavoritesList_push_back(archive_favorites->list, path);
+    ArchiveFavoritesDict_set_at(
+        archive_favorites->dict, path, archive_favorites_guess_flags(path));
+}
 
-                storage_file_seek(file, position, true);
-                if(storage_file_get_error(file) != FSE_OK) {
-                    return false;
-                }
+static void archive_favorites_remove_at(size_t index) {
+    FuriString* path = *ArchiveFavoritesList_get(archive_favorites->list, index);
+    ArchiveFavoritesDict_erase(archive_favorites->dict, path);
+    ArchiveFavoritesList_remove_v(archive_favorites->list, index, index + 1);
+}
 
-                result = true;
-                break;
-            } else {
-                furi_string_push_back(str_result, buffer[i]);
-            }
+static bool archive_favorites_find(FuriString* path, size_t* index) {
+    if(!ArchiveFavoritesDict_get(archive_favorites->dict, path)) {
+        return false;
+    }
+    for(size_t i = 0; i < ArchiveFavoritesList_size(archive_favorites->list); i++) {
+        if(furi_string_equal(*ArchiveFavoritesList_get(archive_favorites->list, i), path)) {
+            *index = i;
+            return true;
         }
+    }
+    return false;
+}
 
-        if(result || read_count == 0) {
-            break;
+// Entries below a changed path are re-checked by the worker
+static void archive_favorites_invalidate_children(const char* path) {
+    size_t path_len = strlen(path);
+    bool invalidated = false;
+
+    ArchiveFavoritesDict_it_t it;
+    for(ArchiveFavoritesDict_it(it, archive_favorites->dict); !ArchiveFavoritesDict_end_p(it);
+        ArchiveFavoritesDict_next(it)) {
+        ArchiveFavoritesDict_itref_t* item = ArchiveFavoritesDict_ref(it);
+        if(furi_string_start_with_str(item->key, path) &&
+           furi_string_get_char(item->key, path_len) == '/') {
+            item->value &= ~ArchiveFavoriteFlagVerified;
+            invalidated = true;
         }
-    } while(true);
+    }
 
-    return result;
+    if(invalidated) {
+        archive_favorites_request(ArchiveFavoritesEventRescan);
+    }
 }
 
-uint16_t archive_favorites_count(void* context) {
-    furi_assert(context);
+static void archive_favorites_rename_children(const char* src, const char* dst) {
+    size_t src_len = strlen(src);
+    FuriString* path = furi_string_alloc();
 
-    Storage* fs_api = furi_record_open(RECORD_STORAGE);
-    File* file = storage_file_alloc(fs_api);
+    for(size_t i = 0; i < ArchiveFavoritesList_size(archive_favorites->list); i++) {
+        FuriString* item = *ArchiveFavoritesList_get(archive_favorites->list, i);
+        if(!furi_string_start_with_str(item, src) ||
+           furi_string_get_char(item, src_len) != '/') {
+            continue;
+        }
 
-    FuriString* buffer;
-    buffer = furi_string_alloc();
+        furi_string_printf(path, "%s%s", dst, furi_string_get_cstr(item) + src_len);
+        uint8_t flags = *ArchiveFavoritesDict_get(archive_favorites->dict, item);
+        ArchiveFavoritesDict_erase(archive_favorites->dict, item);
+        if(ArchiveFavoritesDict_get(archive_favorites->dict, path)) {
+            ArchiveFavoritesList_remove_v(archive_favorites->list, i, i + 1);
+            i--;
+        } else {
+            furi_string_set(item, path);
+            ArchiveFavoritesDict_set_at(archive_favorites->dict, path, flags);
+        }
+        archive_favorites->dirty = true;
+    }
 
-    bool result = storage_file_open(file, ARCHIVE_FAV_PATH, FSAM_READ, FSOM_OPEN_EXISTING);
-    uint16_t lines = 0;
+    furi_string_free(path);
+    if(archive_favorites->dirty) {
+        archive_favorites_request(ArchiveFavoritesEventFlush);
+    }
+}
 
-    if(result) {
-        while(1) {
-            if(!archive_favorites_read_line(file, buffer)) {
-                break;
-            }
-            if(!furi_string_size(buffer)) {
-                continue; // Skip empty lines
-            }
-            ++lines;
+static void archive_favorites_parse(FuriString* line, const char* content, size_t size) {
+    for(size_t i = 0; i < size; i++) {
+        if(content[i] != '\n') {
+            furi_string_push_back(line, content[i]);
+        } else if(furi_string_size(line)) { // Skip empty lines
+            archive_favorites_append(line);
+            furi_string_reset(line);
         }
     }
+}
 
-    storage_file_close(file);
+// Files over ARCHIVE_FAV_FILE_MAX_SIZE are read in chunks of that size
+static bool archive_favorites_read_chunked(Storage* storage, FuriString* line, uint64_t size) {
+    File* file = storage_file_alloc(storage);
+    char* content = malloc(ARCHIVE_FAV_FILE_MAX_SIZE);
+    uint64_t total = 0;
+
+    if(storage_file_open(file, ARCHIVE_FAV_PATH, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        while(total < size) {
+            size_t read = storage_file_read(file, content, ARCHIVE_FAV_FILE_MAX_SIZE);
+            if(!read) break;
+            archive_favorites_parse(line, content, read);
+            total += read;
+        }
+    }
 
-    furi_string_free(buffer);
+    free(content);
     storage_file_free(file);
-    furi_record_close(RECORD_STORAGE);
+    return total == size;
+}
 
-    return lines;
+// Backup exists only while flush swaps files, the temp file is complete then
+static void archive_favorites_recover(Storage* storage) {
+    if(storage_common_exists(storage, ARCHIVE_FAV_PATH) ||
+       !storage_common_exists(storage, ARCHIVE_FAV_BACKUP_PATH)) {
+        return;
+    }
+
+    if(storage_common_rename(storage, ARCHIVE_FAV_TEMP_PATH, ARCHIVE_FAV_PATH) == FSE_OK ||
+       storage_common_rename(storage, ARCHIVE_FAV_BACKUP_PATH, ARCHIVE_FAV_PATH) == FSE_OK) {
+        storage_common_remove(storage, ARCHIVE_FAV_BACKUP_PATH);
+    } else {
+        FURI_LOG_E(TAG, "Failed to restore favorites");
+    }
 }
 
-static bool archive_favourites_rescan() {
-    FuriString* buffer;
-    buffer = furi_string_alloc();
-    Storage* storage = furi_record_open(RECORD_STORAGE);
-    File* file = storage_file_alloc(storage);
+static void archive_favorites_load() {
+    if(archive_favorites->loaded) return;
 
-    bool result = storage_file_open(file, ARCHIVE_FAV_PATH, FSAM_READ, FSOM_OPEN_EXISTING);
-    if(result) {
-        while(1) {
-            if(!archive_favorites_read_line(file, buffer)) {
-                break;
-            }
-            if(!furi_string_size(buffer)) {
-                continue;
-            }
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FuriString* buffer = furi_string_alloc();
+    FileInfo file_info;
+    bool complete = true;
+
+    archive_favorites_recover(storage);
+
+    if(storage_common_stat(storage, ARCHIVE_FAV_PATH, &file_info) == FSE_OK && file_info.size) {
+        if(file_info.size <= ARCHIVE_FAV_FILE_MAX_SIZE) {
+            // Whole file is read with one storage request and split into lines here
+            size_t size = file_info.size;
+            char* content = malloc(size);
+            size_t read = 0;
+            storage_file_load(storage, ARCHIVE_FAV_PATH, content, size, &read);
+            archive_favorites_parse(buffer, content, read);
+            complete = (read == size);
+            free(content);
+        } else {
+            complete = archive_favorites_read_chunked(storage, buffer, file_info.size);
+        }
 
-            if(furi_string_search(buffer, "/app:") == 0) {
-                if(archive_app_is_available(NULL, furi_string_get_cstr(buffer))) {
-                    archive_file_append(
-                        ARCHIVE_FAV_TEMP_PATH, "%s\n", furi_string_get_cstr(buffer));
-                }
-            } else {
-                if(storage_file_exists(storage, furi_string_get_cstr(buffer))) {
-                    archive_file_append(
-                        ARCHIVE_FAV_TEMP_PATH, "%s\n", furi_string_get_cstr(buffer));
-                }
-            }
+        // Partial last line is dropped on failed read, it may be cut mid-path
+        if(complete && furi_string_size(buffer)) {
+            archive_favorites_append(buffer); // Last line without newline
         }
     }
 
     furi_string_free(buffer);
+    furi_record_close(RECORD_STORAGE);
 
-    storage_file_close(file);
-    storage_common_move(storage, ARCHIVE_FAV_TEMP_PATH, ARCHIVE_FAV_PATH);
+    if(!complete) {
+        FURI_LOG_E(TAG, "Favorites file read failed, changes won't be saved");
+    }
+    archive_favorites->incomplete = !complete;
+    archive_favorites->loaded = true;
+    if(ArchiveFavoritesList_size(archive_favorites->list)) {
+        archive_favorites_request(ArchiveFavoritesEventRescan);
+    }
+}
 
-    storage_file_free(file);
-    furi_record_close(RECORD_STORAGE);
+static void archive_favorites_lock() {
+    furi_assert(archive_favorites);
+    furi_check(furi_mutex_acquire(archive_favorites->mutex, FuriWaitForever) == FuriStatusOk);
+    archive_favorites_load();
+}
 
-    return result;
+static void archive_favorites_unlock() {
+    furi_check(furi_mutex_release(archive_favorites->mutex) == FuriStatusOk);
 }
 
-bool archive_favorites_read(void* context) {
-    furi_assert(context);
+static void archive_favorites_flush() {
+    FuriString* content = furi_string_alloc();
 
-    ArchiveBrowserView* browser = context;
-    Storage* storage = furi_record_open(RECORD_STORAGE);
-    File* file = storage_file_alloc(storage);
+    furi_check(furi_mutex_acquire(archive_favorites->mutex, FuriWaitForever) == FuriStatusOk);
+    bool dirty = archive_favorites->dirty;
+    // Rewriting from a partially read list would delete the rest of favorites
+    if(dirty && archive_favorites->incomplete) {
+        FURI_LOG_E(TAG, "Favorites were not loaded completely, not saving");
+        archive_favorites->dirty = false;
+        dirty = false;
+    }
+    if(dirty) {
+        ArchiveFavoritesList_it_t it;
+        for(ArchiveFavoritesList_it(it, archive_favorites->list); !ArchiveFavoritesList_end_p(it);
+            ArchiveFavoritesList_next(it)) {
+            furi_string_cat(content, *ArchiveFavoritesList_cref(it));
+            furi_string_push_back(content, '\n');
+        }
+        archive_favorites->dirty = false;
+    }
+    furi_check(furi_mutex_release(archive_favorites->mutex) == FuriStatusOk);
+
+    if(dirty) {
+        // Write the whole list to a temp file, move the old file to backup and the temp
+        // file in its place. After a power loss the load restores whichever is complete.
+        Storage* storage = furi_record_open(RECORD_STORAGE);
+        File* file = storage_file_alloc(storage);
+        bool result = false;
+
+        if(storage_file_open(file, ARCHIVE_FAV_TEMP_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+            size_t size = furi_string_size(content);
+            result = storage_file_write(file, furi_string_get_cstr(content), size) == size;
+        }
+        storage_file_close(file);
+        storage_file_free(file);
+
+        if(result) {
+            storage_common_remove(storage, ARCHIVE_FAV_BACKUP_PATH);
+            FS_Error error =
+                storage_common_rename(storage, ARCHIVE_FAV_PATH, ARCHIVE_FAV_BACKUP_PATH);
+            result = (error == FSE_OK || error == FSE_NOT_EXIST);
+        }
+        if(result) {
+            result = storage_common_rename(storage, ARCHIVE_FAV_TEMP_PATH, ARCHIVE_FAV_PATH) ==
+                     FSE_OK;
+            if(result) {
+                storage_common_remove(storage, ARCHIVE_FAV_BACKUP_PATH);
+            } else {
+                storage_common_rename(storage, ARCHIVE_FAV_BACKUP_PATH, ARCHIVE_FAV_PATH);
+            }
+        }
+        furi_record_close(RECORD_STORAGE);
 
-    FuriString* buffer;
-    FileInfo file_info;
-    buffer = furi_string_alloc();
+        if(!result) {
+            FURI_LOG_E(TAG, "Failed to save favorites");
+        }
+    }
 
-    bool need_refresh = false;
-    uint16_t file_count = 0;
+    furi_string_free(content);
+}
 
-    archive_file_array_rm_all(browser);
+static bool archive_favorites_is_visible(ArchiveBrowserView* browser) {
+    bool visible = false;
+    with_view_model(
+        browser->view,
+        ArchiveBrowserViewModel * model,
+        { visible = (model->tab_idx == ArchiveTabFavorites) && !model->move_fav; },
+        false);
+    return visible;
+}
 
-    bool result = storage_file_open(file, ARCHIVE_FAV_PATH, FSAM_READ, FSOM_OPEN_EXISTING);
+static void archive_favorites_rescan() {
+    ArchiveFavoritesList_t pending;
+    ArchiveFavoritesList_init(pending);
+
+    // Collect unverified entries, then check them all without holding the lock
+    furi_check(furi_mutex_acquire(archive_favorites->mutex, FuriWaitForever) == FuriStatusOk);
+    ArchiveFavoritesDict_it_t it;
+    for(ArchiveFavoritesDict_it(it, archive_favorites->dict); !ArchiveFavoritesDict_end_p(it);
+        ArchiveFavoritesDict_next(it)) {
+        const ArchiveFavoritesDict_itref_t* item = ArchiveFavoritesDict_cref(it);
+        if(!(item->value & ArchiveFavoriteFlagVerified)) {
+            ArchiveFavoritesList_push_back(pending, item->key);
+        }
+    }
+    furi_check(furi_mutex_release(archive_favorites->mutex) == FuriStatusOk);
 
-    if(result) {
-        while(1) {
-            if(!archive_favorites_read_line(file, buffer)) {
-                break;
-            }
-            if(!furi_string_size(buffer)) {
-                continue;
+    size_t count = ArchiveFavoritesList_size(pending);
+    if(!count) {
+        ArchiveFavoritesList_clear(pending);
+        return;
+    }
+
+    uint8_t* results = malloc(count);
+    const char** paths = malloc(sizeof(const char*) * count);
+    size_t* paths_index = malloc(sizeof(size_t) * count);
+    size_t paths_count = 0;
+    for(size_t i = 0; i < count; i++) {
+        FuriString* path = *ArchiveFavoritesList_get(pending, i);
+        results[i] = 0;
+        if(archive_favorites_is_app(path)) {
+            if(archive_app_is_available(NULL, furi_string_get_cstr(path))) {
+                results[i] = ArchiveFavoriteFlagVerified;
             }
+        } else {
+            paths[paths_count] = furi_string_get_cstr(path);
+            paths_index[paths_count++] = i;
+        }
+    }
 
-            if(furi_string_search(buffer, "/app:") == 0) {
-                if(archive_app_is_available(browser, furi_string_get_cstr(buffer))) {
-                    archive_add_app_item(browser, furi_string_get_cstr(buffer));
-                    file_count++;
-                } else {
-                    need_refresh = true;
-                }
-            } else {
-                if(storage_common_exists(storage, furi_string_get_cstr(buffer))) {
-                    storage_common_stat(storage, furi_string_get_cstr(buffer), &file_info);
-                    archive_add_file_item(
-                        browser, file_info_is_dir(&file_info), furi_string_get_cstr(buffer));
-                    file_count++;
-                } else {
-                    need_refresh = true;
-                }
+    // All files are checked with one storage request
+    FileInfo* file_infos = malloc(sizeof(FileInfo) * count);
+    FS_Error* errors = malloc(sizeof(FS_Error) * count);
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_common_stat_batch(storage, paths, file_infos, errors, paths_count);
+    furi_record_close(RECORD_STORAGE);
+    for(size_t i = 0; i < paths_count; i++) {
+        if(errors[i] == FSE_OK) {
+            uint8_t folder = file_info_is_dir(&file_infos[i]) ? ArchiveFavoriteFlagFolder : 0;
+            results[paths_index[i]] = ArchiveFavoriteFlagVerified | folder;
+        }
+    }
+    free(errors);
+    free(file_infos);
+    free(paths_index);
+    free(paths);
+
+    bool changed = false;
+    furi_check(furi_mutex_acquire(archive_favorites->mutex, FuriWaitForever) == FuriStatusOk);
+    for(size_t i = 0; i < count; i++) {
+        FuriString* path = *ArchiveFavoritesList_get(pending, i);
+        uint8_t* flags = ArchiveFavoritesDict_get(archive_favorites->dict, path);
+        if(!flags) {
+            continue; // Removed while we were checking
+        }
+        if(results[i] & ArchiveFavoriteFlagVerified) {
+            changed |= (*flags & ArchiveFavoriteFlagFolder) !=
+                       (results[i] & ArchiveFavoriteFlagFolder);
+            *flags = results[i];
+        } else {
+            size_t index;
+            if(archive_favorites_find(path, &index)) {
+                archive_favorites_remove_at(index);
+                archive_favorites->dirty = true;
+                changed = true;
             }
+        }
+    }
+    ArchiveBrowserView* browser = archive_favorites->browser;
+    furi_check(furi_mutex_release(archive_favorites->mutex) == FuriStatusOk);
+
+    free(results);
+    ArchiveFavoritesList_clear(pending);
+
+    if(changed && browser && browser->callback && archive_favorites_is_visible(browser)) {
+        browser->callback(ArchiveBrowserEventListRefresh, browser->context);
+    }
+}
+
+static int32_t archive_favorites_worker(void* context) {
+    UNUSED(context);
+    uint32_t pending = 0;
+
+    while(true) {
+        uint32_t flags = furi_thread_flags_wait(
+            ARCHIVE_FAV_EVENT_ALL,
+            FuriFlagWaitAny,
+            (pending & ArchiveFavoritesEventFlush) ? ARCHIVE_FAV_FLUSH_DELAY_MS : FuriWaitForever);
+
+        if(flags & FuriFlagError) {
+            // Write-behind delay elapsed with no further edits
+            archive_favorites_flush();
+            pending = 0;
+            continue;
+        }
 
-            furi_string_reset(buffer);
+        pending |= flags;
+        if(flags & ArchiveFavoritesEventRescan) {
+            archive_favorites_rescan();
+            pending |= ArchiveFavoritesEventFlush;
+        }
+        if(flags & ArchiveFavoritesEventExit) {
+            archive_favorites_flush();
+            break;
         }
     }
-    storage_file_close(file);
-    furi_string_free(buffer);
-    storage_file_free(file);
-    furi_record_close(RECORD_STORAGE);
 
-    archive_set_item_count(browser, file_count);
+    return 0;
+}
+
+void archive_favorites_init() {
+    furi_check(!archive_favorites);
+
+    archive_favorites = malloc(sizeof(ArchiveFavorites));
+    archive_favorites->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    ArchiveFavoritesList_init(archive_favorites->list);
+    ArchiveFavoritesDict_init(archive_favorites->dict);
+    archive_favorites->browser = NULL;
+    archive_favorites->loaded = false;
+    archive_favorites->incomplete = false;
+    archive_favorites->dirty = false;
+
+    archive_favorites->worker = furi_thread_alloc_ex(
+        "ArchiveFavWorker", ARCHIVE_FAV_WORKER_STACK_SIZE, archive_favorites_worker, NULL);
+    furi_thread_start(archive_favorites->worker);
+}
+
+void archive_favorites_free() {
+    furi_check(archive_favorites);
 
-    if(need_refresh) { //-V547
-        archive_favourites_rescan();
+    archive_favorites_request(ArchiveFavoritesEventExit);
+    furi_thread_join(archive_favorites->worker);
+    furi_thread_free(archive_favorites->worker);
+
+    ArchiveFavoritesDict_clear(archive_favorites->dict);
+    ArchiveFavoritesList_clear(archive_favorites->list);
+    furi_mutex_free(archive_favorites->mutex);
+    free(archive_favorites);
+    archive_favorites = NULL;
+}
+
+uint16_t archive_favorites_count(void* context) {
+    furi_assert(context);
+
+    archive_favorites_lock();
+    uint16_t count = ArchiveFavoritesList_size(archive_favorites->list);
+    archive_favorites_unlock();
+
+    return count;
+}
+
+bool archive_favorites_read(void* context) {
+    furi_assert(context);
+
+    ArchiveBrowserView* browser = context;
+    uint16_t file_count = 0;
+
+    archive_file_array_rm_all(browser);
+
+    archive_favorites_lock();
+    archive_favorites->browser = browser;
+
+    ArchiveFavoritesList_it_t it;
+    for(ArchiveFavoritesList_it(it, archive_favorites->list); !ArchiveFavoritesList_end_p(it);
+        ArchiveFavoritesList_next(it)) {
+        FuriString* path = *ArchiveFavoritesList_cref(it);
+        if(archive_favorites_is_app(path)) {
+            archive_add_app_item(browser, furi_string_get_cstr(path));
+        } else {
+            uint8_t* flags = ArchiveFavoritesDict_get(archive_favorites->dict, path);
+            archive_add_file_item(
+                browser, *flags & ArchiveFavoriteFlagFolder, furi_string_get_cstr(path));
+        }
+        file_count++;
     }
+    archive_favorites_unlock();
 
-    return result;
+    archive_set_item_count(browser, file_count);
+
+    return true;
 }
 
 bool archive_favorites_delete(const char* format, ...) {
-    FuriString* buffer;
     FuriString* filename;
     va_list args;
     va_start(args, format);
     filename = furi_string_alloc_vprintf(format, args);
     va_end(args);
 
-    buffer = furi_string_alloc();
-    Storage* fs_api = furi_record_open(RECORD_STORAGE);
-    File* file = storage_file_alloc(fs_api);
-
-    bool result = storage_file_open(file, ARCHIVE_FAV_PATH, FSAM_READ, FSOM_OPEN_EXISTING);
-
+    archive_favorites_lock();
+    size_t index;
+    bool result = archive_favorites_find(filename, &index);
     if(result) {
-        while(1) {
-            if(!archive_favorites_read_line(file, buffer)) {
-                break;
-            }
-            if(!furi_string_size(buffer)) {
-                continue;
-            }
-
-            if(furi_string_search(buffer, filename)) {
-                archive_file_append(ARCHIVE_FAV_TEMP_PATH, "%s\n", furi_string_get_cstr(buffer));
-            }
-        }
+        archive_favorites_remove_at(index);
+        archive_favorites_mark_dirty();
     }
+    archive_favorites_invalidate_children(furi_string_get_cstr(filename));
+    archive_favorites_unlock();
 
-    furi_string_free(buffer);
     furi_string_free(filename);
 
-    storage_file_close(file);
-    storage_common_move(fs_api, ARCHIVE_FAV_TEMP_PATH, ARCHIVE_FAV_PATH);
-
-    storage_file_free(file);
-    furi_record_close(RECORD_STORAGE);
-
     return result;
 }
 
 bool archive_is_favorite(const char* format, ...) {
-    FuriString* buffer;
     FuriString* filename;
     va_list args;
     va_start(args, format);
     filename = furi_string_alloc_vprintf(format, args);
     va_end(args);
 
-    buffer = furi_string_alloc();
-    Storage* fs_api = furi_record_open(RECORD_STORAGE);
-    File* file = storage_file_alloc(fs_api);
-
-    bool found = false;
-    bool result = storage_file_open(file, ARCHIVE_FAV_PATH, FSAM_READ, FSOM_OPEN_EXISTING);
+    archive_favorites_lock();
+    bool found = ArchiveFavoritesDict_get(archive_favorites->dict, filename) != NULL;
+    archive_favorites_unlock();
 
-    if(result) {
-        while(1) {
-            if(!archive_favorites_read_line(file, buffer)) {
-                break;
-            }
-            if(!furi_string_size(buffer)) {
-                continue;
-            }
-            if(!furi_string_search(buffer, filename)) {
-                found = true;
-                break;
-            }
-        }
-    }
-
-    storage_file_close(file);
-    furi_string_free(buffer);
     furi_string_free(filename);
-    storage_file_free(file);
-    furi_record_close(RECORD_STORAGE);
 
     return found;
 }
@@ -266,66 +551,69 @@ bool archive_favorites_rename(const char* src, const char* dst) {
     furi_assert(src);
     furi_assert(dst);
 
-    Storage* fs_api = furi_record_open(RECORD_STORAGE);
-    File* file = storage_file_alloc(fs_api);
-
-    FuriString* path;
-    FuriString* buffer;
-
-    buffer = furi_string_alloc();
-    path = furi_string_alloc();
-
-    furi_string_printf(path, "%s", src);
-    bool result = storage_file_open(file, ARCHIVE_FAV_PATH, FSAM_READ, FSOM_OPEN_EXISTING);
+    FuriString* path = furi_string_alloc_set(src);
 
+    archive_favorites_lock();
+    size_t index;
+    bool result = archive_favorites_find(path, &index);
     if(result) {
-        while(1) {
-            if(!archive_favorites_read_line(file, buffer)) {
-                break;
-            }
-            if(!furi_string_size(buffer)) {
-                continue;
-            }
-
-            archive_file_append(
-                ARCHIVE_FAV_TEMP_PATH,
-                "%s\n",
-                furi_string_search(buffer, path) ? furi_string_get_cstr(buffer) : dst);
+        uint8_t flags = *ArchiveFavoritesDict_get(archive_favorites->dict, path);
+        ArchiveFavoritesDict_erase(archive_favorites->dict, path);
+        furi_string_set(path, dst);
+        if(ArchiveFavoritesDict_get(archive_favorites->dict, path)) {
+            // Destination is already a favorite, drop the old entry
+            ArchiveFavoritesList_remove_v(archive_favorites->list, index, index + 1);
+        } else {
+            furi_string_set(*ArchiveFavoritesList_get(archive_favorites->list, index), dst);
+            ArchiveFavoritesDict_set_at(archive_favorites->dict, path, flags);
         }
+        archive_favorites_mark_dirty();
     }
+    archive_favorites_rename_children(src, dst);
+    archive_favorites_unlock();
 
-    furi_string_free(buffer);
     furi_string_free(path);
 
-    storage_file_close(file);
-    storage_common_move(fs_api, ARCHIVE_FAV_TEMP_PATH, ARCHIVE_FAV_PATH);
-
-    storage_file_free(file);
-    furi_record_close(RECORD_STORAGE);
-
     return result;
 }
 
 void archive_add_to_favorites(const char* file_path) {
     furi_assert(file_path);
 
-    archive_file_append(ARCHIVE_FAV_PATH, "%s\n", file_path);
+    FuriString* path = furi_string_alloc_set(file_path);
+
+    archive_favorites_lock();
+    if(!ArchiveFavoritesDict_get(archive_favorites->dict, path)) {
+        archive_favorites_append(path);
+        archive_favorites_mark_dirty();
+        archive_favorites_request(ArchiveFavoritesEventRescan);
+    }
+    archive_favorites_unlock();
+
+    furi_string_free(path);
 }
 
 void archive_favorites_save(void* context) {
     furi_assert(context);
 
     ArchiveBrowserView* browser = context;
-    Storage* fs_api = furi_record_open(RECORD_STORAGE);
-    File* file = storage_file_alloc(fs_api);
+
+    archive_favorites_lock();
+    ArchiveFavoritesDict_t dict;
+    ArchiveFavoritesDict_init_move(dict, archive_favorites->dict);
+    ArchiveFavoritesDict_init(archive_favorites->dict);
+    ArchiveFavoritesList_reset(archive_favorites->list);
 
     for(size_t i = 0; i < archive_file_get_array_size(browser); i++) {
         ArchiveFile_t* item = archive_get_file_at(browser, i);
-        archive_file_append(ARCHIVE_FAV_TEMP_PATH, "%s\n", furi_string_get_cstr(item->path));
+        uint8_t* flags = ArchiveFavoritesDict_get(dict, item->path);
+        archive_favorites_append(item->path);
+        if(flags) {
+            ArchiveFavoritesDict_set_at(archive_favorites->dict, item->path, *flags);
+        }
     }
 
-    storage_common_move(fs_api, ARCHIVE_FAV_TEMP_PATH, ARCHIVE_FAV_PATH);
-
-    storage_file_free(file);
-    furi_record_close(RECORD_STORAGE);
+    ArchiveFavoritesDict_clear(dict);
+    archive_favorites_mark_dirty();
+    archive_favorites_unlock();
 }
@@ -5,6 +5,15 @@
 #define ARCHIVE_FAV_OLD_PATH EXT_PATH("favorites.txt")
 #define ARCHIVE_FAV_PATH CFG_PATH("favorites.txt")
 #define ARCHIVE_FAV_TEMP_PATH CFG_PATH("favorites.tmp")
+#define ARCHIVE_FAV_BACKUP_PATH CFG_PATH("favorites.bak")
+
+/** Allocate favorites store and start its background worker
+ * Favorites are loaded on first use, edits are written back in the background
+ */
+void archive_favorites_init();
+
+/** Flush pending edits, stop background worker and free favorites store */
+void archive_favorites_free();
 
 uint16_t archive_favorites_count(void* context);
 bool archive_favorites_read(void* context);
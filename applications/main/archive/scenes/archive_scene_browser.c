@@ -139,7 +139,7 @@ bool archive_scene_browser_on_event(void* context, SceneManagerEvent event) {
                 if(archive_is_favorite("%s", name)) {
                     archive_favorites_delete("%s", name);
                 } else {
-                    archive_file_append(ARCHIVE_FAV_PATH, "%s\n", name);
+                    archive_add_to_favorites(name);
                 }
             }
             archive_show_file_menu(browser, false, false);
@@ -14,16 +14,16 @@ void archive_scene_show_widget_callback(GuiButtonType result, InputType type, vo
     }
 }
 
-static bool text_show_read_lines(File* file, FuriString* str_result) {
+static bool text_show_read_lines(Storage* storage, const char* path, FuriString* str_result) {
     //furi_string_reset(str_result);
     uint8_t buffer[SHOW_MAX_FILE_SIZE];
+    size_t read_count = 0;
 
-    uint16_t read_count = storage_file_read(file, buffer, SHOW_MAX_FILE_SIZE);
-    if(storage_file_get_error(file) != FSE_OK) {
+    if(storage_file_load(storage, path, buffer, SHOW_MAX_FILE_SIZE, &read_count) != FSE_OK) {
         return false;
     }
 
-    for(uint16_t i = 0; i < read_count; i++) {
+    for(size_t i = 0; i < read_count; i++) {
         furi_string_push_back(str_result, buffer[i]);
     }
 
@@ -42,29 +42,17 @@ void archive_scene_show_on_enter(void* context) {
 
     ArchiveFile_t* current = archive_get_current_file(instance->browser);
     Storage* fs_api = furi_record_open(RECORD_STORAGE);
-    File* file = storage_file_alloc(fs_api);
 
     FileInfo fileinfo;
     FS_Error error = storage_common_stat(fs_api, furi_string_get_cstr(current->path), &fileinfo);
     if(error == FSE_OK) {
         if((fileinfo.size < SHOW_MAX_FILE_SIZE) && (fileinfo.size > 2)) {
-            bool ok = storage_file_open(
-                file, furi_string_get_cstr(current->path), FSAM_READ, FSOM_OPEN_EXISTING);
-            if(ok) {
-                if(!text_show_read_lines(file, buffer)) {
-                    goto text_file_read_err;
-                }
-                if(!furi_string_size(buffer)) {
-                    goto text_file_read_err;
-                }
-
-                storage_file_seek(file, 0, true);
-
+            // Open, read and close in one storage request
+            bool ok = text_show_read_lines(fs_api, furi_string_get_cstr(current->path), buffer);
+            if(ok && furi_string_size(buffer)) {
                 widget_add_text_scroll_element(
                     instance->widget, 0, 0, 128, 64, furi_string_get_cstr(buffer));
-
             } else {
-            text_file_read_err:
                 widget_add_text_box_element(
                     instance->widget,
                     0,
@@ -76,7 +64,6 @@ void archive_scene_show_on_enter(void* context) {
                     "\e#Error:\nStorage file open error\e#",
                     false);
             }
-            storage_file_close(file);
         } else if(fileinfo.size < 2) {
             widget_add_text_box_element(
                 instance->widget,
@@ -120,7 +107,6 @@ void archive_scene_show_on_enter(void* context) {
 
     furi_string_free(buffer);
 
-    storage_file_free(file);
     furi_record_close(RECORD_STORAGE);
 
     furi_string_free(filename);
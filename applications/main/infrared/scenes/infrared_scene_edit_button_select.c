@@ -5,6 +5,15 @@ static void infrared_scene_edit_button_select_submenu_callback(void* context, ui
     view_dispatcher_send_custom_event(infrared->view_dispatcher, index);
 }
 
+static void infrared_scene_edit_button_select_submenu_label_callback(
+    void* context,
+    uint32_t index,
+    FuriString* label) {
+    Infrared* infrared = context;
+    InfraredRemoteButton* button = infrared_remote_get_button(infrared->remote, index);
+    furi_string_set(label, infrared_remote_button_get_name(button));
+}
+
 void infrared_scene_edit_button_select_on_enter(void* context) {
     Infrared* infrared = context;
     Submenu* submenu = infrared->submenu;
@@ -17,15 +26,12 @@ void infrared_scene_edit_button_select_on_enter(void* context) {
     submenu_set_header(submenu, header);
 
     const size_t button_count = infrared_remote_get_button_count(remote);
-    for(size_t i = 0; i < button_count; ++i) {
-        InfraredRemoteButton* button = infrared_remote_get_button(remote, i);
-        submenu_add_item(
-            submenu,
-            infrared_remote_button_get_name(button),
-            i,
-            infrared_scene_edit_button_select_submenu_callback,
-            context);
-    }
+    submenu_set_item_provider(
+        submenu,
+        button_count,
+        infrared_scene_edit_button_select_submenu_label_callback,
+        infrared_scene_edit_button_select_submenu_callback,
+        context);
 
     if(button_count && app_state->current_button_index != InfraredButtonIndexNone) {
         submenu_set_selected_item(submenu, app_state->current_button_index);
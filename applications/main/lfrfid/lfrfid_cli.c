@@ -27,7 +27,7 @@ static void lfrfid_cli_print_usage() {
     printf("Usage:\r\n");
     printf("rfid read <optional: normal | indala>\r\n");
     printf("rfid <write | emulate> <key_type> <key_data>\r\n");
-    printf("rfid raw_read <ask | psk> <filename>\r\n");
+    printf("rfid raw_read <ask | psk> <filename> <optional: compressed>\r\n");
     printf("rfid raw_emulate <filename>\r\n");
     printf("rfid raw_analyze <filename>\r\n");
 }
@@ -420,11 +420,22 @@ static void lfrfid_cli_raw_read(Cli* cli, FuriString* args) {
             break;
         }
 
+        bool compressed = false;
+        if(args_read_string_and_trim(args, type_string)) {
+            if(furi_string_cmp_str(type_string, "compressed") == 0) {
+                compressed = true;
+            } else {
+                lfrfid_cli_print_usage();
+                break;
+            }
+        }
+
         ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
         LFRFIDWorker* worker = lfrfid_worker_alloc(dict);
         FuriEventFlag* event = furi_event_flag_alloc();
 
         lfrfid_worker_start_thread(worker);
+        lfrfid_worker_read_raw_set_compression(worker, compressed);
 
         bool overrun = false;
 
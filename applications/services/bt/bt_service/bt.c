@@ -147,7 +147,8 @@ Bt* bt_alloc() {
     // Power
     bt->power = furi_record_open(RECORD_POWER);
     FuriPubSub* power_pubsub = power_get_pubsub(bt->power);
-    furi_pubsub_subscribe(power_pubsub, bt_battery_level_changed_callback, bt);
+    furi_pubsub_subscribe_ex(
+        power_pubsub, bt_battery_level_changed_callback, bt, FuriPubSubDeliveryAsync);
 
     // RPC
     bt->rpc = furi_record_open(RECORD_RPC);
@@ -20,6 +20,7 @@ const CanvasFontParameters canvas_font_params[FontTotalNumber] = {
 Canvas* canvas_init() {
     Canvas* canvas = malloc(sizeof(Canvas));
     canvas->compress_icon = compress_icon_alloc();
+    canvas->glyph_cache = canvas_glyph_cache_alloc();
 
     // Setup u8g2
     u8g2_Setup_st756x_flipper(&canvas->fb, U8G2_R0, u8x8_hw_spi_stm32, u8g2_gpio_and_delay_stm32);
@@ -29,6 +30,8 @@ Canvas* canvas_init() {
     // Wake up display
     u8g2_SetPowerSave(&canvas->fb, 0);
 
+    canvas->shadow = malloc(canvas_get_buffer_size(canvas));
+
     // Clear buffer and send to device
     canvas_clear(canvas);
     canvas_commit(canvas);
@@ -39,6 +42,8 @@ Canvas* canvas_init() {
 void canvas_free(Canvas* canvas) {
     furi_assert(canvas);
     compress_icon_free(canvas->compress_icon);
+    canvas_glyph_cache_free(canvas->glyph_cache);
+    free(canvas->shadow);
     free(canvas);
 }
 
@@ -54,7 +59,35 @@ void canvas_reset(Canvas* canvas) {
 
 void canvas_commit(Canvas* canvas) {
     furi_assert(canvas);
-    u8g2_SendBuffer(&canvas->fb);
+    uint8_t* buffer = canvas_get_buffer(canvas);
+    uint8_t tile_width = u8g2_GetBufferTileWidth(&canvas->fb);
+    uint8_t tile_height = u8g2_GetBufferTileHeight(&canvas->fb);
+    size_t page_size = tile_width * 8;
+
+    canvas->commit_pages = 0;
+    for(uint8_t page = 0; page < tile_height; page++) {
+        size_t offset = page * page_size;
+        if(canvas->shadow_valid &&
+           memcmp(&buffer[offset], &canvas->shadow[offset], page_size) == 0) {
+            continue;
+        }
+        u8g2_UpdateDisplayArea(&canvas->fb, 0, page, tile_width, 1);
+        memcpy(&canvas->shadow[offset], &buffer[offset], page_size);
+        canvas->commit_pages |= (1 << page);
+    }
+    canvas->shadow_valid = true;
+
+    if(canvas->commit_pages) u8x8_RefreshDisplay(u8g2_GetU8x8(&canvas->fb));
+}
+
+void canvas_commit_invalidate(Canvas* canvas) {
+    furi_assert(canvas);
+    canvas->shadow_valid = false;
+}
+
+uint8_t canvas_get_commit_pages(const Canvas* canvas) {
+    furi_assert(canvas);
+    return canvas->commit_pages;
 }
 
 uint8_t* canvas_get_buffer(Canvas* canvas) {
@@ -114,7 +147,18 @@ const CanvasFontParameters* canvas_get_font_params(const Canvas* canvas, Font fo
 
 void canvas_clear(Canvas* canvas) {
     furi_assert(canvas);
-    if(XTREME_SETTINGS()->dark_mode) {
+    if(canvas->clip) {
+        // Box is limited by clip window, unlike buffer fill
+        uint8_t color = u8g2_GetDrawColor(&canvas->fb);
+        u8g2_SetDrawColor(&canvas->fb, XTREME_SETTINGS()->dark_mode ? ColorBlack : ColorWhite);
+        u8g2_DrawBox(
+            &canvas->fb,
+            0,
+            0,
+            u8g2_GetDisplayWidth(&canvas->fb),
+            u8g2_GetDisplayHeight(&canvas->fb));
+        u8g2_SetDrawColor(&canvas->fb, color);
+    } else if(XTREME_SETTINGS()->dark_mode) {
         u8g2_FillBuffer(&canvas->fb);
     } else {
         u8g2_ClearBuffer(&canvas->fb);
@@ -173,12 +217,36 @@ void canvas_set_custom_u8g2_font(Canvas* canvas, const uint8_t* font) {
     u8g2_SetFont(&canvas->fb, font);
 }
 
+/** Pointer is in firmware flash, content never changes while we run */
+static bool canvas_is_static(const void* ptr) {
+    return (size_t)ptr >= furi_hal_flash_get_base() &&
+           ptr < furi_hal_flash_get_free_start_address();
+}
+
+static void canvas_draw_str_raw(Canvas* canvas, uint8_t x, uint8_t y, const char* str) {
+    // Fonts from applications live in RAM and may be gone with their owner
+    if(canvas_is_static(canvas->fb.font)) {
+        canvas_glyph_cache_draw_str(canvas->glyph_cache, &canvas->fb, x, y, str);
+    } else {
+        u8g2_DrawStr(&canvas->fb, x, y, str);
+    }
+}
+
+static u8g2_long_t canvas_str_width_raw(Canvas* canvas, const char* str) {
+    if(canvas_is_static(canvas->fb.font)) {
+        return canvas_glyph_cache_str_width(
+            canvas->glyph_cache, &canvas->fb, str, canvas_is_static(str));
+    } else {
+        return u8g2_GetStrWidth(&canvas->fb, str);
+    }
+}
+
 void canvas_draw_str(Canvas* canvas, uint8_t x, uint8_t y, const char* str) {
     furi_assert(canvas);
     if(!str) return;
     x += canvas->offset_x;
     y += canvas->offset_y;
-    u8g2_DrawStr(&canvas->fb, x, y, str);
+    canvas_draw_str_raw(canvas, x, y, str);
 }
 
 void canvas_draw_str_aligned(
@@ -197,10 +265,10 @@ void canvas_draw_str_aligned(
     case AlignLeft:
         break;
     case AlignRight:
-        x -= u8g2_GetStrWidth(&canvas->fb, str);
+        x -= canvas_str_width_raw(canvas, str);
         break;
     case AlignCenter:
-        x -= (u8g2_GetStrWidth(&canvas->fb, str) / 2);
+        x -= (canvas_str_width_raw(canvas, str) / 2);
         break;
     default:
         furi_crash(NULL);
@@ -221,13 +289,13 @@ void canvas_draw_str_aligned(
         break;
     }
 
-    u8g2_DrawStr(&canvas->fb, x, y, str);
+    canvas_draw_str_raw(canvas, x, y, str);
 }
 
 uint16_t canvas_string_width(Canvas* canvas, const char* str) {
     furi_assert(canvas);
     if(!str) return 0;
-    return u8g2_GetStrWidth(&canvas->fb, str);
+    return canvas_str_width_raw(canvas, str);
 }
 
 uint8_t canvas_glyph_width(Canvas* canvas, char symbol) {
@@ -548,6 +616,43 @@ void canvas_set_bitmap_mode(Canvas* canvas, bool alpha) {
     u8g2_SetBitmapMode(&canvas->fb, alpha ? 1 : 0);
 }
 
+// u8g2 clip window is in rotated coordinates
+static void canvas_clip_apply(Canvas* canvas) {
+    if(!canvas->clip || canvas->orientation == CanvasOrientationVertical ||
+       canvas->orientation == CanvasOrientationVerticalFlip) {
+        u8g2_SetMaxClipWindow(&canvas->fb);
+        return;
+    }
+
+    uint8_t x0 = canvas->clip_x;
+    uint8_t y0 = canvas->clip_y;
+    uint8_t x1 = canvas->clip_x + canvas->clip_width;
+    uint8_t y1 = canvas->clip_y + canvas->clip_height;
+    if(canvas->orientation == CanvasOrientationHorizontalFlip) {
+        uint8_t width = u8g2_GetDisplayWidth(&canvas->fb);
+        uint8_t height = u8g2_GetDisplayHeight(&canvas->fb);
+        u8g2_SetClipWindow(&canvas->fb, width - x1, height - y1, width - x0, height - y0);
+    } else {
+        u8g2_SetClipWindow(&canvas->fb, x0, y0, x1, y1);
+    }
+}
+
+void canvas_clip_set(Canvas* canvas, uint8_t x, uint8_t y, uint8_t width, uint8_t height) {
+    furi_assert(canvas);
+    canvas->clip = true;
+    canvas->clip_x = x;
+    canvas->clip_y = y;
+    canvas->clip_width = width;
+    canvas->clip_height = height;
+    canvas_clip_apply(canvas);
+}
+
+void canvas_clip_reset(Canvas* canvas) {
+    furi_assert(canvas);
+    canvas->clip = false;
+    canvas_clip_apply(canvas);
+}
+
 void canvas_set_orientation(Canvas* canvas, CanvasOrientation orientation) {
     furi_assert(canvas);
     const u8g2_cb_t* rotate_cb = NULL;
@@ -581,6 +686,7 @@ void canvas_set_orientation(Canvas* canvas, CanvasOrientation orientation) {
         if(need_swap) FURI_SWAP(canvas->width, canvas->height);
         u8g2_SetDisplayRotation(&canvas->fb, rotate_cb);
         canvas->orientation = orientation;
+        canvas_clip_apply(canvas);
     }
 }
 
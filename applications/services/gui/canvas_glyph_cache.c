@@ -0,0 +1,266 @@
+#include "canvas_glyph_cache.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define CANVAS_GLYPH_CACHE_SETS (16)
+#define CANVAS_GLYPH_CACHE_WAYS (4)
+#define CANVAS_GLYPH_CACHE_WIDTH_MEMO (16)
+
+// Bigger glyphs are measured from cache, but drawn by u8g2
+#define CANVAS_GLYPH_MAX_WIDTH (16)
+#define CANVAS_GLYPH_MAX_HEIGHT (16)
+
+// Decoder internals of u8g2_font.c, not exported by u8g2.h
+uint8_t u8g2_font_decode_get_unsigned_bits(u8g2_font_decode_t* f, uint8_t cnt);
+int8_t u8g2_font_decode_get_signed_bits(u8g2_font_decode_t* f, uint8_t cnt);
+const uint8_t* u8g2_font_get_glyph_data(u8g2_t* u8g2, uint16_t encoding);
+
+typedef struct {
+    const uint8_t* font;
+    uint32_t stamp;
+    uint16_t encoding;
+    bool found; // glyph is present in the font
+    bool bitmap; // rows hold the decoded glyph
+    uint8_t width;
+    uint8_t height;
+    int8_t x_offset;
+    int8_t y_offset;
+    int8_t delta_x;
+    uint16_t rows[CANVAS_GLYPH_MAX_HEIGHT]; // bit 0 is the leftmost pixel
+} CanvasGlyph;
+
+typedef struct {
+    const uint8_t* font;
+    const char* str;
+    u8g2_long_t width;
+} CanvasGlyphWidth;
+
+struct CanvasGlyphCache {
+    CanvasGlyph glyphs[CANVAS_GLYPH_CACHE_SETS][CANVAS_GLYPH_CACHE_WAYS];
+    CanvasGlyphWidth widths[CANVAS_GLYPH_CACHE_WIDTH_MEMO];
+    uint32_t stamp;
+    CanvasGlyphCacheStats stats;
+};
+
+CanvasGlyphCache* canvas_glyph_cache_alloc(void) {
+    CanvasGlyphCache* cache = malloc(sizeof(CanvasGlyphCache));
+    canvas_glyph_cache_reset(cache);
+    return cache;
+}
+
+void canvas_glyph_cache_free(CanvasGlyphCache* cache) {
+    free(cache);
+}
+
+void canvas_glyph_cache_reset(CanvasGlyphCache* cache) {
+    memset(cache, 0, sizeof(CanvasGlyphCache));
+}
+
+void canvas_glyph_cache_get_stats(CanvasGlyphCache* cache, CanvasGlyphCacheStats* stats) {
+    *stats = cache->stats;
+}
+
+static size_t canvas_glyph_cache_hash(const void* ptr, uint32_t value) {
+    uint32_t hash = ((uint32_t)(uintptr_t)ptr >> 2) ^ value;
+    return (uint32_t)(hash * 0x9E3779B1U) >> 28;
+}
+
+/** Same as u8g2_font_decode_len, but into the row bitmap */
+static bool canvas_glyph_decode_len(
+    CanvasGlyph* glyph,
+    uint8_t* lx,
+    uint8_t* ly,
+    uint8_t len,
+    bool is_foreground) {
+    uint8_t cnt = len;
+    uint8_t x = *lx;
+    uint8_t y = *ly;
+
+    for(;;) {
+        uint8_t rem = glyph->width - x;
+        uint8_t current = (cnt < rem) ? cnt : rem;
+
+        if(is_foreground && current) {
+            // u8g2 would draw below the glyph box, leave such glyphs to it
+            if(y >= glyph->height) return false;
+            glyph->rows[y] |= (uint16_t)(((1UL << current) - 1) << x);
+        }
+
+        if(cnt < rem) break;
+        cnt -= rem;
+        x = 0;
+        y++;
+    }
+
+    *lx = x + cnt;
+    *ly = y;
+    return true;
+}
+
+static void canvas_glyph_decode(u8g2_t* u8g2, CanvasGlyph* glyph) {
+    const u8g2_font_info_t* info = &u8g2->font_info;
+    const uint8_t* glyph_data = u8g2_font_get_glyph_data(u8g2, glyph->encoding);
+
+    glyph->found = glyph_data != NULL;
+    glyph->bitmap = false;
+    glyph->width = 0;
+    glyph->height = 0;
+    glyph->x_offset = 0;
+    glyph->y_offset = 0;
+    glyph->delta_x = 0;
+    if(!glyph->found) return;
+
+    u8g2_font_decode_t decode = {.decode_ptr = glyph_data};
+    glyph->width = u8g2_font_decode_get_unsigned_bits(&decode, info->bits_per_char_width);
+    glyph->height = u8g2_font_decode_get_unsigned_bits(&decode, info->bits_per_char_height);
+    glyph->x_offset = u8g2_font_decode_get_signed_bits(&decode, info->bits_per_char_x);
+    glyph->y_offset = u8g2_font_decode_get_signed_bits(&decode, info->bits_per_char_y);
+    glyph->delta_x = u8g2_font_decode_get_signed_bits(&decode, info->bits_per_delta_x);
+
+    if(glyph->width == 0) return;
+    if(glyph->width > CANVAS_GLYPH_MAX_WIDTH || glyph->height > CANVAS_GLYPH_MAX_HEIGHT) return;
+
+    memset(glyph->rows, 0, sizeof(glyph->rows));
+    uint8_t lx = 0;
+    uint8_t ly = 0;
+    for(;;) {
+        uint8_t a = u8g2_font_decode_get_unsigned_bits(&decode, info->bits_per_0);
+        uint8_t b = u8g2_font_decode_get_unsigned_bits(&decode, info->bits_per_1);
+        do {
+            if(!canvas_glyph_decode_len(glyph, &lx, &ly, a, false)) return;
+            if(!canvas_glyph_decode_len(glyph, &lx, &ly, b, true)) return;
+        } while(u8g2_font_decode_get_unsigned_bits(&decode, 1) != 0);
+
+        if(ly >= glyph->height) break;
+    }
+
+    glyph->bitmap = true;
+}
+
+static CanvasGlyph*
+    canvas_glyph_cache_get(CanvasGlyphCache* cache, u8g2_t* u8g2, uint16_t encoding) {
+    const uint8_t* font = u8g2->font;
+    CanvasGlyph* set = cache->glyphs[canvas_glyph_cache_hash(font, encoding)];
+    CanvasGlyph* victim = &set[0];
+
+    cache->stamp++;
+    for(size_t i = 0; i < CANVAS_GLYPH_CACHE_WAYS; i++) {
+        CanvasGlyph* glyph = &set[i];
+        if(glyph->font == font && glyph->encoding == encoding) {
+            glyph->stamp = cache->stamp;
+            cache->stats.hits++;
+            return glyph;
+        }
+        if(glyph->stamp < victim->stamp) victim = glyph;
+    }
+
+    cache->stats.misses++;
+    if(victim->font) cache->stats.evictions++;
+    victim->font = font;
+    victim->encoding = encoding;
+    victim->stamp = cache->stamp;
+    canvas_glyph_decode(u8g2, victim);
+
+    return victim;
+}
+
+/** Same as u8g2_font_draw_glyph for direction 0, y must already include font reference */
+static void
+    canvas_glyph_draw(u8g2_t* u8g2, const CanvasGlyph* glyph, u8g2_uint_t x, u8g2_uint_t y) {
+    if(glyph->width == 0) return;
+
+    u8g2_uint_t x0 = x + glyph->x_offset;
+    u8g2_uint_t y0 = y - (glyph->height + glyph->y_offset);
+    u8g2_uint_t x1 = x0 + glyph->width;
+    u8g2_uint_t y1 = y0 + glyph->height;
+    if(u8g2_IsIntersection(u8g2, x0, y0, x1, y1) == 0) return;
+
+    for(uint8_t row = 0; row < glyph->height; row++) {
+        uint32_t bits = glyph->rows[row];
+        uint8_t lx = 0;
+        while(bits) {
+            uint8_t skip = __builtin_ctz(bits);
+            bits >>= skip;
+            lx += skip;
+            uint8_t len = __builtin_ctz(~bits);
+            u8g2_DrawHVLine(u8g2, x0 + lx, y0 + row, len, 0);
+            bits >>= len;
+            lx += len;
+        }
+    }
+}
+
+u8g2_uint_t canvas_glyph_cache_draw_str(
+    CanvasGlyphCache* cache,
+    u8g2_t* u8g2,
+    u8g2_uint_t x,
+    u8g2_uint_t y,
+    const char* str) {
+    if(u8g2->font_decode.is_transparent == 0 || u8g2->font_decode.dir != 0) {
+        return u8g2_DrawStr(u8g2, x, y, str);
+    }
+
+    u8g2_uint_t ref_y = y + u8g2->font_calc_vref(u8g2);
+    u8g2_uint_t sum = 0;
+
+    // Same end of string as u8x8_ascii_next
+    for(; *str && *str != '\n'; str++) {
+        CanvasGlyph* glyph = canvas_glyph_cache_get(cache, u8g2, (uint8_t)*str);
+        if(glyph->bitmap) {
+            canvas_glyph_draw(u8g2, glyph, x, ref_y);
+        } else if(glyph->width) {
+            u8g2_DrawGlyph(u8g2, x, y, glyph->encoding);
+        }
+        x += (u8g2_uint_t)glyph->delta_x;
+        sum += (u8g2_uint_t)glyph->delta_x;
+    }
+
+    return sum;
+}
+
+u8g2_long_t canvas_glyph_cache_str_width(
+    CanvasGlyphCache* cache,
+    u8g2_t* u8g2,
+    const char* str,
+    bool memo) {
+    CanvasGlyphWidth* entry = NULL;
+    if(memo) {
+        entry = &cache->widths
+                     [canvas_glyph_cache_hash(str, 0) & (CANVAS_GLYPH_CACHE_WIDTH_MEMO - 1)];
+        if(entry->font == u8g2->font && entry->str == str) {
+            cache->stats.width_memo_hits++;
+            return entry->width;
+        }
+        entry->str = str;
+    }
+
+    // Same as u8g2_string_width, including the last glyph adjustment
+    u8g2_long_t width = 0;
+    u8g2_uint_t dx = 0;
+    uint8_t glyph_width = 0;
+    int8_t glyph_x_offset = 0;
+    for(; *str && *str != '\n'; str++) {
+        CanvasGlyph* glyph = canvas_glyph_cache_get(cache, u8g2, (uint8_t)*str);
+        dx = 0;
+        if(glyph->found) {
+            dx = (u8g2_uint_t)glyph->delta_x;
+            glyph_width = glyph->width;
+            glyph_x_offset = glyph->x_offset;
+        }
+        width += dx;
+    }
+
+    if(glyph_width != 0) {
+        width -= dx;
+        width += glyph_width;
+        width += glyph_x_offset;
+    }
+
+    if(entry) {
+        entry->font = u8g2->font;
+        entry->width = width;
+    }
+
+    return width;
+}
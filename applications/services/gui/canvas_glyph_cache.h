@@ -0,0 +1,92 @@
+/**
+ * @file canvas_glyph_cache.h
+ * GUI: decoded glyph cache for canvas text drawing
+ *
+ * Plain C with no firmware dependencies, so the same sources build for the
+ * Flipper and for the host benchmark in host/glyph_cache_bench.c
+ */
+
+#pragma once
+
+#include <u8g2.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct CanvasGlyphCache CanvasGlyphCache;
+
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t width_memo_hits;
+} CanvasGlyphCacheStats;
+
+/** Allocate glyph cache
+ *
+ * @return     CanvasGlyphCache instance
+ */
+CanvasGlyphCache* canvas_glyph_cache_alloc(void);
+
+/** Free glyph cache
+ *
+ * @param      cache  CanvasGlyphCache instance
+ */
+void canvas_glyph_cache_free(CanvasGlyphCache* cache);
+
+/** Drop all cached glyphs and widths
+ *
+ * @param      cache  CanvasGlyphCache instance
+ */
+void canvas_glyph_cache_reset(CanvasGlyphCache* cache);
+
+/** Draw string, same as u8g2_DrawStr
+ *
+ * Current u8g2 font must never change its content while cached, use only
+ * for fonts in read-only memory. Rotated and solid mode text is passed to
+ * u8g2 as is.
+ *
+ * @param      cache  CanvasGlyphCache instance
+ * @param      u8g2   u8g2 instance
+ * @param      x      x coordinate
+ * @param      y      y coordinate of the baseline
+ * @param      str    ASCII string
+ *
+ * @return     string advance width
+ */
+u8g2_uint_t canvas_glyph_cache_draw_str(
+    CanvasGlyphCache* cache,
+    u8g2_t* u8g2,
+    u8g2_uint_t x,
+    u8g2_uint_t y,
+    const char* str);
+
+/** Get string width, same as u8g2_GetStrWidth
+ *
+ * @param      cache  CanvasGlyphCache instance
+ * @param      u8g2   u8g2 instance
+ * @param      str    ASCII string
+ * @param      memo   remember result by string address, only for strings
+ *                    in read-only memory
+ *
+ * @return     string width
+ */
+u8g2_long_t canvas_glyph_cache_str_width(
+    CanvasGlyphCache* cache,
+    u8g2_t* u8g2,
+    const char* str,
+    bool memo);
+
+/** Get cache statistics
+ *
+ * @param      cache  CanvasGlyphCache instance
+ * @param      stats  CanvasGlyphCacheStats to fill
+ */
+void canvas_glyph_cache_get_stats(CanvasGlyphCache* cache, CanvasGlyphCacheStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
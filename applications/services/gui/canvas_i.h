@@ -6,6 +6,7 @@
 #pragma once
 
 #include "canvas.h"
+#include "canvas_glyph_cache.h"
 #include <u8g2.h>
 #include <toolbox/compress.h>
 
@@ -23,6 +24,19 @@ struct Canvas {
     uint8_t width;
     uint8_t height;
     CompressIcon* compress_icon;
+    CanvasGlyphCache* glyph_cache;
+
+    // Damage clip, in display coordinates
+    bool clip;
+    uint8_t clip_x;
+    uint8_t clip_y;
+    uint8_t clip_width;
+    uint8_t clip_height;
+
+    // Copy of display content, to send only changed pages on commit
+    uint8_t* shadow;
+    bool shadow_valid;
+    uint8_t commit_pages;
 };
 
 /** Allocate memory and initialize canvas
@@ -68,6 +82,40 @@ void canvas_frame_set(
     uint8_t width,
     uint8_t height);
 
+/** Limit drawing to a region of real screen buffer
+ *
+ * Everything outside of the region, including canvas_clear, is left
+ * untouched. Applies to horizontal orientations only, vertical orientations
+ * draw on the whole screen.
+ *
+ * @param      canvas  Canvas instance
+ * @param      x       x coordinate of the region
+ * @param      y       y coordinate of the region
+ * @param      width   width of the region
+ * @param      height  height of the region
+ */
+void canvas_clip_set(Canvas* canvas, uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+
+/** Remove drawing region limit
+ *
+ * @param      canvas  Canvas instance
+ */
+void canvas_clip_reset(Canvas* canvas);
+
+/** Forget last sent frame, so next canvas_commit sends every page
+ *
+ * @param      canvas  Canvas instance
+ */
+void canvas_commit_invalidate(Canvas* canvas);
+
+/** Get display pages sent by last canvas_commit
+ *
+ * @param      canvas  Canvas instance
+ *
+ * @return     bitmask of 8 pixel high pages, 0 if nothing changed
+ */
+uint8_t canvas_get_commit_pages(const Canvas* canvas);
+
 /** Set canvas orientation
  *
  * @param      canvas       Canvas instance
@@ -1,5 +1,6 @@
 #include <xtreme.h>
 #include "gui_i.h"
+#include <furi_hal_cortex.h>
 #include <assets_icons.h>
 #include <storage/storage.h>
 #include <storage/storage_i.h>
@@ -38,6 +39,12 @@ uint8_t gui_get_count_of_enabled_view_port_in_layer(Gui* gui, GuiLayer layer) {
 }
 
 void gui_update(Gui* gui) {
+    furi_assert(gui);
+    gui->redraw_full = true;
+    if(!gui->direct_draw) furi_thread_flags_set(gui->thread_id, GUI_THREAD_FLAG_DRAW);
+}
+
+void gui_update_damage(Gui* gui) {
     furi_assert(gui);
     if(!gui->direct_draw) furi_thread_flags_set(gui->thread_id, GUI_THREAD_FLAG_DRAW);
 }
@@ -274,6 +281,94 @@ static bool gui_redraw_desktop(Gui* gui) {
     return false;
 }
 
+typedef enum {
+    GuiDamageNone,
+    GuiDamagePartial,
+    GuiDamageFull,
+} GuiDamage;
+
+static void gui_rect_add(GuiRect* rect, uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
+    x1 = MIN(x1, GUI_DISPLAY_WIDTH);
+    y1 = MIN(y1, GUI_DISPLAY_HEIGHT);
+    if(x0 >= x1 || y0 >= y1) return;
+
+    if(rect->x0 >= rect->x1) {
+        *rect = (GuiRect){x0, y0, x1, y1};
+    } else {
+        rect->x0 = MIN(rect->x0, x0);
+        rect->y0 = MIN(rect->y0, y0);
+        rect->x1 = MAX(rect->x1, x1);
+        rect->y1 = MAX(rect->y1, y1);
+    }
+}
+
+static uint8_t gui_status_bar_y(void) {
+    // Flipped status bar is drawn at the bottom of the screen
+    return furi_hal_rtc_is_flag_set(FuriHalRtcFlagHandOrient) ?
+               GUI_DISPLAY_HEIGHT - GUI_STATUS_BAR_HEIGHT :
+               GUI_STATUS_BAR_Y;
+}
+
+static bool gui_rect_has_status_bar(const GuiRect* rect) {
+    uint8_t y = gui_status_bar_y();
+    return rect->y0 < y + GUI_STATUS_BAR_HEIGHT && rect->y1 > y;
+}
+
+// Collect damage of visible view ports, layer selection must match gui_redraw
+static GuiDamage gui_damage_collect(Gui* gui, GuiRect* rect) {
+    bool full = gui->redraw_full;
+    gui->redraw_full = false;
+    *rect = (GuiRect){0};
+
+    ViewPort* main_view_port = NULL;
+    GuiLayer main_layer = GuiLayerDesktop;
+    bool status_bar = (gui->hide_statusbar_count == 0);
+    if(gui->lockdown) {
+        main_view_port = gui_view_port_find_enabled(gui->layers[GuiLayerDesktop]);
+        status_bar &= XTREME_SETTINGS()->lockscreen_statusbar;
+    } else {
+        const GuiLayer layers[] = {GuiLayerFullscreen, GuiLayerWindow, GuiLayerDesktop};
+        for(size_t i = 0; i < COUNT_OF(layers) && !main_view_port; i++) {
+            main_layer = layers[i];
+            main_view_port = gui_view_port_find_enabled(gui->layers[main_layer]);
+        }
+        status_bar &= (main_layer != GuiLayerFullscreen);
+    }
+
+    for(size_t layer = 0; layer < GuiLayerMAX; layer++) {
+        bool is_status_bar = (layer == GuiLayerStatusBarLeft || layer == GuiLayerStatusBarRight);
+        ViewPortArray_it_t it;
+        for(ViewPortArray_it(it, gui->layers[layer]); !ViewPortArray_end_p(it);
+            ViewPortArray_next(it)) {
+            ViewPort* view_port = *ViewPortArray_ref(it);
+            bool view_port_full;
+            uint8_t x0, y0, x1, y1;
+            // Always taken, so hidden view ports don't carry stale damage
+            if(!view_port_damage_take(view_port, &view_port_full, &x0, &y0, &x1, &y1)) {
+                continue;
+            }
+
+            if(is_status_bar) {
+                if(!status_bar || !view_port_is_enabled(view_port)) continue;
+                // Status bar is laid out as a whole
+                uint8_t y = gui_status_bar_y();
+                gui_rect_add(rect, 0, y, GUI_DISPLAY_WIDTH, y + GUI_STATUS_BAR_HEIGHT);
+            } else if(view_port == main_view_port) {
+                if(view_port_full ||
+                   view_port_get_orientation(view_port) != ViewPortOrientationHorizontal) {
+                    full = true;
+                } else {
+                    uint8_t y = (main_layer == GuiLayerWindow) ? GUI_WINDOW_Y : 0;
+                    gui_rect_add(rect, x0, y + y0, x1, y + y1);
+                }
+            }
+        }
+    }
+
+    if(full) return GuiDamageFull;
+    return (rect->x0 < rect->x1) ? GuiDamagePartial : GuiDamageNone;
+}
+
 static void gui_redraw(Gui* gui) {
     furi_assert(gui);
     gui_lock(gui);
@@ -281,6 +376,21 @@ static void gui_redraw(Gui* gui) {
     do {
         if(gui->direct_draw) break;
 
+        uint32_t start = furi_hal_cortex_timer_get(0).start;
+
+        GuiRect rect;
+        GuiDamage damage = gui_damage_collect(gui, &rect);
+        if(damage == GuiDamageNone) {
+            gui->stats.skipped_frames++;
+            break;
+        }
+
+        // Everything outside of damaged region stays as it was
+        if(damage == GuiDamagePartial) {
+            canvas_clip_set(gui->canvas, rect.x0, rect.y0, rect.x1 - rect.x0, rect.y1 - rect.y0);
+        }
+        bool status_bar = (damage == GuiDamageFull) || gui_rect_has_status_bar(&rect);
+
         canvas_reset(gui->canvas);
 
         if(gui->lockdown) {
@@ -288,7 +398,7 @@ static void gui_redraw(Gui* gui) {
             bool need_attention =
                 (gui_view_port_find_enabled(gui->layers[GuiLayerWindow]) != 0 ||
                  gui_view_port_find_enabled(gui->layers[GuiLayerFullscreen]) != 0);
-            if(XTREME_SETTINGS()->lockscreen_statusbar) {
+            if(XTREME_SETTINGS()->lockscreen_statusbar && status_bar) {
                 gui_redraw_status_bar(gui, need_attention);
             }
         } else {
@@ -296,19 +406,33 @@ static void gui_redraw(Gui* gui) {
                 if(!gui_redraw_window(gui)) {
                     gui_redraw_desktop(gui);
                 }
-                gui_redraw_status_bar(gui, false);
+                if(status_bar) gui_redraw_status_bar(gui, false);
             }
         }
 
+        canvas_clip_reset(gui->canvas);
         canvas_commit(gui->canvas);
-        for
-            M_EACH(p, gui->canvas_callback_pair, CanvasCallbackPairArray_t) {
-                p->callback(
-                    canvas_get_buffer(gui->canvas),
-                    canvas_get_buffer_size(gui->canvas),
-                    canvas_get_orientation(gui->canvas),
-                    p->context);
-            }
+
+        // Framebuffer callbacks get only frames that changed
+        uint8_t pages = canvas_get_commit_pages(gui->canvas);
+        if(pages) {
+            for
+                M_EACH(p, gui->canvas_callback_pair, CanvasCallbackPairArray_t) {
+                    p->callback(
+                        canvas_get_buffer(gui->canvas),
+                        canvas_get_buffer_size(gui->canvas),
+                        canvas_get_orientation(gui->canvas),
+                        p->context);
+                }
+        }
+
+        uint32_t time_us = (furi_hal_cortex_timer_get(0).start - start) /
+                           furi_hal_cortex_instructions_per_microsecond();
+        gui->stats.frames++;
+        if(damage == GuiDamagePartial) gui->stats.partial_frames++;
+        gui->stats.pages_sent += __builtin_popcount(pages);
+        gui->stats.frame_time_us = time_us;
+        gui->stats.frame_time_max_us = MAX(gui->stats.frame_time_max_us, time_us);
     } while(false);
 
     gui_unlock(gui);
@@ -513,6 +637,8 @@ void gui_add_framebuffer_callback(Gui* gui, GuiCanvasCommitCallback callback, vo
     gui_lock(gui);
     furi_assert(!CanvasCallbackPairArray_count(gui->canvas_callback_pair, p));
     CanvasCallbackPairArray_push_back(gui->canvas_callback_pair, p);
+    // New subscriber needs a frame even if screen didn't change
+    canvas_commit_invalidate(gui->canvas);
     gui_unlock(gui);
 
     // Request redraw
@@ -530,6 +656,15 @@ void gui_remove_framebuffer_callback(Gui* gui, GuiCanvasCommitCallback callback,
     gui_unlock(gui);
 }
 
+void gui_get_stats(Gui* gui, GuiStats* stats) {
+    furi_assert(gui);
+    furi_assert(stats);
+
+    gui_lock(gui);
+    *stats = gui->stats;
+    gui_unlock(gui);
+}
+
 size_t gui_get_framebuffer_size(const Gui* gui) {
     furi_assert(gui);
     return canvas_get_buffer_size(gui->canvas);
@@ -599,6 +734,7 @@ Gui* gui_alloc() {
     }
     // Drawing canvas
     gui->canvas = canvas_init();
+    gui->redraw_full = true;
     CanvasCallbackPairArray_init(gui->canvas_callback_pair);
 
     // Input
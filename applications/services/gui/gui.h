@@ -33,6 +33,16 @@ typedef void (*GuiCanvasCommitCallback)(
     CanvasOrientation orientation,
     void* context);
 
+/** Gui redraw statistics */
+typedef struct {
+    uint32_t frames; /**< Frames composed and committed */
+    uint32_t partial_frames; /**< Frames limited to damaged region */
+    uint32_t skipped_frames; /**< Redraw requests with nothing visible damaged */
+    uint32_t pages_sent; /**< 8 pixel high pages sent to display */
+    uint32_t frame_time_us; /**< Last frame compose and commit time */
+    uint32_t frame_time_max_us; /**< Longest frame compose and commit time */
+} GuiStats;
+
 #define RECORD_GUI "gui"
 
 typedef struct Gui Gui;
@@ -143,6 +153,15 @@ void gui_direct_draw_release(Gui* gui);
 
 uint8_t gui_get_count_of_enabled_view_port_in_layer(Gui* gui, GuiLayer layer);
 
+/** Get redraw statistics
+ *
+ * @remark     thread safe
+ *
+ * @param      gui    Gui instance
+ * @param      stats  GuiStats to fill
+ */
+void gui_get_stats(Gui* gui, GuiStats* stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -55,6 +55,14 @@ ARRAY_DEF(CanvasCallbackPairArray, CanvasCallbackPair, M_POD_OPLIST);
 
 ALGO_DEF(CanvasCallbackPairArray, CanvasCallbackPairArray_t);
 
+/** Damaged screen region, right and bottom edges excluded */
+typedef struct {
+    uint8_t x0;
+    uint8_t y0;
+    uint8_t x1;
+    uint8_t y1;
+} GuiRect;
+
 /** Gui structure */
 struct Gui {
     // Thread and lock
@@ -69,6 +77,10 @@ struct Gui {
     Canvas* canvas;
     CanvasCallbackPairArray_t canvas_callback_pair;
 
+    // Damage tracking
+    volatile bool redraw_full;
+    GuiStats stats;
+
     // Input
     FuriMessageQueue* input_queue;
     FuriPubSub* input_events;
@@ -78,12 +90,20 @@ struct Gui {
 
 ViewPort* gui_view_port_find_enabled(ViewPortArray_t array);
 
-/** Update GUI, request redraw
+/** Update GUI, request full redraw
+ *
+ * Used on view port tree changes.
  *
  * @param      gui   Gui instance
  */
 void gui_update(Gui* gui);
 
+/** Update GUI, request redraw of damaged view ports
+ *
+ * @param      gui   Gui instance
+ */
+void gui_update_damage(Gui* gui);
+
 void gui_input_events_callback(const void* value, void* ctx);
 
 void gui_lock(Gui* gui);
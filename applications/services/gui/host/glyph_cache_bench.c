@@ -0,0 +1,250 @@
+// Host benchmark for the canvas glyph cache, built from the same sources as the firmware:
+//   cc -O2 -ffunction-sections -Wl,--gc-sections -I.. -I../../../../lib/u8g2
+//      -o glyph_cache_bench glyph_cache_bench.c ../canvas_glyph_cache.c
+//      $(ls ../../../../lib/u8g2/*.c | grep -v u8g2_glue)
+//   ./glyph_cache_bench [frames]
+// Renders submenu, variable item list and file browser like frames with both u8g2 and the
+// cache, checks that the frame buffers are identical and prints time per frame.
+
+#include "canvas_glyph_cache.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define GLYPH_CACHE_BENCH_WIDTH (128)
+#define GLYPH_CACHE_BENCH_HEIGHT (64)
+#define GLYPH_CACHE_BENCH_BUFFER_SIZE (GLYPH_CACHE_BENCH_WIDTH * GLYPH_CACHE_BENCH_HEIGHT / 8)
+#define GLYPH_CACHE_BENCH_ITEMS_ON_SCREEN (4)
+
+typedef struct {
+    CanvasGlyphCache* cache; // NULL: plain u8g2
+    u8g2_t u8g2;
+} GlyphCacheBench;
+
+typedef void (*GlyphCacheBenchFrame)(GlyphCacheBench* bench, size_t position);
+
+static const u8x8_display_info_t glyph_cache_bench_display_info = {
+    .tile_width = GLYPH_CACHE_BENCH_WIDTH / 8,
+    .tile_height = GLYPH_CACHE_BENCH_HEIGHT / 8,
+    .pixel_width = GLYPH_CACHE_BENCH_WIDTH,
+    .pixel_height = GLYPH_CACHE_BENCH_HEIGHT,
+};
+
+static const char* const glyph_cache_bench_menu[] = {
+    "Sub-GHz",  "125 kHz RFID", "NFC",   "Infrared",    "GPIO",     "iButton",
+    "Bad USB",  "U2F",          "Apps",  "Settings",    "Archive",  "Bluetooth",
+    "Display",  "Sound",        "Power", "System",      "Storage",  "About",
+    "Passport", "Desktop",      "Clock", "Calculator",  "Snake",    "Tetris",
+};
+
+#define GLYPH_CACHE_BENCH_MENU_COUNT \
+    (sizeof(glyph_cache_bench_menu) / sizeof(glyph_cache_bench_menu[0]))
+
+static const char* const glyph_cache_bench_values[] = {
+    "OFF", "ON", "Auto", "10s", "30s", "1min", "Never", "100%", "75%", "Default",
+};
+
+static uint8_t glyph_cache_bench_display_cb(
+    u8x8_t* u8x8,
+    uint8_t msg,
+    uint8_t arg_int,
+    void* arg_ptr) {
+    (void)arg_int;
+    (void)arg_ptr;
+    if(msg == U8X8_MSG_DISPLAY_SETUP_MEMORY) {
+        u8x8_d_helper_display_setup_memory(u8x8, &glyph_cache_bench_display_info);
+    }
+    return 1;
+}
+
+static void glyph_cache_bench_draw_str(GlyphCacheBench* bench, int x, int y, const char* str) {
+    if(bench->cache) {
+        canvas_glyph_cache_draw_str(bench->cache, &bench->u8g2, x, y, str);
+    } else {
+        u8g2_DrawStr(&bench->u8g2, x, y, str);
+    }
+}
+
+static int glyph_cache_bench_str_width(GlyphCacheBench* bench, const char* str, bool is_static) {
+    if(bench->cache) {
+        return canvas_glyph_cache_str_width(bench->cache, &bench->u8g2, str, is_static);
+    } else {
+        return u8g2_GetStrWidth(&bench->u8g2, str);
+    }
+}
+
+static void glyph_cache_bench_submenu(GlyphCacheBench* bench, size_t position) {
+    u8g2_t* u8g2 = &bench->u8g2;
+    size_t selected = position % GLYPH_CACHE_BENCH_MENU_COUNT;
+    size_t first = selected > 1 ? selected - 1 : 0;
+
+    u8g2_SetFont(u8g2, u8g2_font_helvB08_tr);
+    const char* header = "Main Menu";
+    int header_width = glyph_cache_bench_str_width(bench, header, true);
+    glyph_cache_bench_draw_str(bench, (GLYPH_CACHE_BENCH_WIDTH - header_width) / 2, 9, header);
+
+    u8g2_SetFont(u8g2, u8g2_font_haxrcorp4089_tr);
+    for(size_t i = 0; i < GLYPH_CACHE_BENCH_ITEMS_ON_SCREEN; i++) {
+        size_t index = (first + i) % GLYPH_CACHE_BENCH_MENU_COUNT;
+        int y = 12 + i * 13;
+        if(index == selected) {
+            u8g2_DrawRBox(u8g2, 0, y, 123, 13, 2);
+            u8g2_SetDrawColor(u8g2, 0);
+        }
+        glyph_cache_bench_draw_str(bench, 6, y + 10, glyph_cache_bench_menu[index]);
+        u8g2_SetDrawColor(u8g2, 1);
+    }
+}
+
+static void glyph_cache_bench_variable_item_list(GlyphCacheBench* bench, size_t position) {
+    u8g2_t* u8g2 = &bench->u8g2;
+    size_t selected = position % GLYPH_CACHE_BENCH_MENU_COUNT;
+
+    u8g2_SetFont(u8g2, u8g2_font_haxrcorp4089_tr);
+    for(size_t i = 0; i < GLYPH_CACHE_BENCH_ITEMS_ON_SCREEN; i++) {
+        size_t index = (selected + i) % GLYPH_CACHE_BENCH_MENU_COUNT;
+        const char* value = glyph_cache_bench_values[(index + position) % 10];
+        int y = i * 14;
+        if(i == 0) {
+            u8g2_DrawRBox(u8g2, 0, y, 123, 15, 2);
+            u8g2_SetDrawColor(u8g2, 0);
+        }
+        glyph_cache_bench_draw_str(bench, 6, y + 11, glyph_cache_bench_menu[index]);
+        int value_width = glyph_cache_bench_str_width(bench, value, true);
+        glyph_cache_bench_draw_str(bench, 115 - value_width, y + 11, value);
+        glyph_cache_bench_draw_str(bench, 115 - value_width - 6, y + 11, "<");
+        glyph_cache_bench_draw_str(bench, 117, y + 11, ">");
+        u8g2_SetDrawColor(u8g2, 1);
+    }
+}
+
+static void glyph_cache_bench_file_browser(GlyphCacheBench* bench, size_t position) {
+    u8g2_t* u8g2 = &bench->u8g2;
+    char name[32];
+
+    u8g2_SetFont(u8g2, u8g2_font_helvB08_tr);
+    glyph_cache_bench_draw_str(bench, 2, 9, "/ext/subghz");
+
+    u8g2_SetFont(u8g2, u8g2_font_haxrcorp4089_tr);
+    for(size_t i = 0; i < GLYPH_CACHE_BENCH_ITEMS_ON_SCREEN; i++) {
+        size_t index = position + i;
+        // Names are built every frame, like paths read from storage
+        snprintf(
+            name,
+            sizeof(name),
+            "%s_%03zu.sub",
+            glyph_cache_bench_menu[index % GLYPH_CACHE_BENCH_MENU_COUNT],
+            index);
+        int y = 12 + i * 13;
+        if(i == 1) {
+            u8g2_DrawBox(u8g2, 0, y, 128, 13);
+            u8g2_SetDrawColor(u8g2, 0);
+        }
+        // Trim name to fit, the same way elements_string_fit_width does
+        size_t len = strlen(name);
+        while(len > 1 && glyph_cache_bench_str_width(bench, name, false) > 100) {
+            name[--len] = '\0';
+        }
+        glyph_cache_bench_draw_str(bench, 15, y + 10, name);
+        u8g2_SetDrawColor(u8g2, 1);
+    }
+}
+
+static double glyph_cache_bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double glyph_cache_bench_run(
+    GlyphCacheBench* bench,
+    GlyphCacheBenchFrame frame,
+    size_t frames,
+    uint8_t* buffers) {
+    double start = glyph_cache_bench_now();
+    for(size_t i = 0; i < frames; i++) {
+        u8g2_ClearBuffer(&bench->u8g2);
+        frame(bench, i);
+        if(buffers) {
+            memcpy(
+                &buffers[i * GLYPH_CACHE_BENCH_BUFFER_SIZE],
+                u8g2_GetBufferPtr(&bench->u8g2),
+                GLYPH_CACHE_BENCH_BUFFER_SIZE);
+        }
+    }
+    return (glyph_cache_bench_now() - start) / frames;
+}
+
+int main(int argc, char** argv) {
+    size_t frames = argc > 1 ? strtoul(argv[1], NULL, 10) : 10000;
+    if(frames == 0) frames = 1;
+
+    static uint8_t buffer[GLYPH_CACHE_BENCH_BUFFER_SIZE];
+    GlyphCacheBench bench = {0};
+    u8g2_SetupDisplay(
+        &bench.u8g2, glyph_cache_bench_display_cb, u8x8_dummy_cb, u8x8_dummy_cb, u8x8_dummy_cb);
+    u8g2_SetupBuffer(
+        &bench.u8g2,
+        buffer,
+        GLYPH_CACHE_BENCH_HEIGHT / 8,
+        u8g2_ll_hvline_vertical_top_lsb,
+        U8G2_R0);
+    u8g2_SetFontMode(&bench.u8g2, 1);
+    u8g2_SetDrawColor(&bench.u8g2, 1);
+
+    const struct {
+        const char* name;
+        GlyphCacheBenchFrame frame;
+    } scenes[] = {
+        {"submenu", glyph_cache_bench_submenu},
+        {"variable_item_list", glyph_cache_bench_variable_item_list},
+        {"file_browser", glyph_cache_bench_file_browser},
+    };
+
+    // One scrolling pass is compared pixel by pixel, then both paths are timed
+    size_t check_frames = GLYPH_CACHE_BENCH_MENU_COUNT * 4;
+    uint8_t* expected = malloc(check_frames * GLYPH_CACHE_BENCH_BUFFER_SIZE);
+    uint8_t* actual = malloc(check_frames * GLYPH_CACHE_BENCH_BUFFER_SIZE);
+    int result = 0;
+
+    for(size_t i = 0; i < sizeof(scenes) / sizeof(scenes[0]); i++) {
+        CanvasGlyphCache* cache = canvas_glyph_cache_alloc();
+
+        bench.cache = NULL;
+        glyph_cache_bench_run(&bench, scenes[i].frame, check_frames, expected);
+        bench.cache = cache;
+        glyph_cache_bench_run(&bench, scenes[i].frame, check_frames, actual);
+        bool match =
+            memcmp(expected, actual, check_frames * GLYPH_CACHE_BENCH_BUFFER_SIZE) == 0;
+        if(!match) result = 1;
+
+        bench.cache = NULL;
+        double u8g2_time = glyph_cache_bench_run(&bench, scenes[i].frame, frames, NULL);
+        bench.cache = cache;
+        canvas_glyph_cache_reset(cache);
+        double cache_time = glyph_cache_bench_run(&bench, scenes[i].frame, frames, NULL);
+
+        CanvasGlyphCacheStats stats;
+        canvas_glyph_cache_get_stats(cache, &stats);
+        uint32_t lookups = stats.hits + stats.misses;
+        printf(
+            "%-20s %s  u8g2 %7.2f us/frame  cache %7.2f us/frame  x%.2f  "
+            "hit %.1f%%  evictions %u  width memo hits %u\n",
+            scenes[i].name,
+            match ? "ok      " : "MISMATCH",
+            u8g2_time * 1e6,
+            cache_time * 1e6,
+            u8g2_time / cache_time,
+            lookups ? 100.0 * stats.hits / lookups : 0.0,
+            stats.evictions,
+            stats.width_memo_hits);
+
+        canvas_glyph_cache_free(cache);
+    }
+
+    free(expected);
+    free(actual);
+    return result;
+}
@@ -16,8 +16,9 @@
 
 #define ASSETS_DIR "assets"
 #define BROWSER_ROOT STORAGE_ANY_PATH_PREFIX
-#define FILE_NAME_LEN_MAX 256
 #define LONG_LOAD_THRESHOLD 100
+#define DIR_BATCH_ENTRIES 16
+#define DIR_BATCH_NAMES_SIZE (STORAGE_DIR_BATCH_NAME_MAX * 4)
 
 typedef enum {
     WorkerEvtStop = (1 << 0),
@@ -132,6 +133,57 @@ static bool browser_folder_check_and_switch(FuriString* path) {
     return is_root;
 }
 
+// Folder listing, entries are read by batches to save storage round-trips
+typedef struct {
+    File* directory;
+    StorageDirEntry* entries;
+    char* names;
+    size_t count;
+    size_t position;
+    FS_Error error;
+} BrowserDirReader;
+
+static BrowserDirReader* browser_dir_reader_alloc(Storage* storage) {
+    BrowserDirReader* reader = malloc(sizeof(BrowserDirReader));
+    reader->directory = storage_file_alloc(storage);
+    reader->entries = malloc(sizeof(StorageDirEntry) * DIR_BATCH_ENTRIES);
+    reader->names = malloc(DIR_BATCH_NAMES_SIZE);
+    reader->count = 0;
+    reader->position = 0;
+    reader->error = FSE_OK;
+    return reader;
+}
+
+static void browser_dir_reader_free(BrowserDirReader* reader) {
+    storage_dir_close(reader->directory);
+    storage_file_free(reader->directory);
+    free(reader->entries);
+    free(reader->names);
+    free(reader);
+}
+
+static bool browser_dir_reader_open(BrowserDirReader* reader, FuriString* path) {
+    return storage_dir_open(reader->directory, furi_string_get_cstr(path));
+}
+
+// Next entry or NULL on the end of folder and on error, valid until next call
+static StorageDirEntry* browser_dir_reader_next(BrowserDirReader* reader) {
+    while(reader->position == reader->count) {
+        if(reader->error != FSE_OK) {
+            return NULL;
+        }
+        reader->count = storage_dir_read_batch(
+            reader->directory,
+            reader->entries,
+            DIR_BATCH_ENTRIES,
+            reader->names,
+            DIR_BATCH_NAMES_SIZE);
+        reader->position = 0;
+        reader->error = storage_file_get_error(reader->directory);
+    }
+    return &reader->entries[reader->position++];
+}
+
 static bool browser_folder_init(
     BrowserWorker* browser,
     FuriString* path,
@@ -139,29 +191,26 @@ static bool browser_folder_init(
     uint32_t* item_cnt,
     int32_t* file_idx) {
     bool state = false;
-    FileInfo file_info;
+    StorageDirEntry* entry;
     uint32_t total_files_cnt = 0;
 
     Storage* storage = furi_record_open(RECORD_STORAGE);
-    File* directory = storage_file_alloc(storage);
+    BrowserDirReader* reader = browser_dir_reader_alloc(storage);
 
-    char name_temp[FILE_NAME_LEN_MAX];
     FuriString* name_str;
     name_str = furi_string_alloc();
 
     *item_cnt = 0;
     *file_idx = -1;
 
-    if(storage_dir_open(directory, furi_string_get_cstr(path))) {
+    if(browser_dir_reader_open(reader, path)) {
         state = true;
-        while(1) {
-            if(!storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX)) {
-                break;
-            }
-            if((storage_file_get_error(directory) == FSE_OK) && (name_temp[0] != '\0')) {
+        while((entry = browser_dir_reader_next(reader)) != NULL) {
+            if(entry->name[0] != '\0') {
                 total_files_cnt++;
-                furi_string_set(name_str, name_temp);
-                if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
+                furi_string_set(name_str, entry->name);
+                if(browser_filter_by_name(
+                       browser, name_str, file_info_is_dir(&entry->fileinfo))) {
                     if(!furi_string_empty(filename)) {
                         if(furi_string_cmp(name_str, filename) == 0) {
                             *file_idx = *item_cnt;
@@ -181,8 +230,7 @@ static bool browser_folder_init(
 
     furi_string_free(name_str);
 
-    storage_dir_close(directory);
-    storage_file_free(directory);
+    browser_dir_reader_free(reader);
 
     furi_record_close(RECORD_STORAGE);
 
@@ -195,34 +243,29 @@ static bool browser_folder_load_chunked(
     FuriString* path,
     uint32_t offset,
     uint32_t count) {
-    FileInfo file_info;
+    StorageDirEntry* entry;
 
     Storage* storage = furi_record_open(RECORD_STORAGE);
-    File* directory = storage_file_alloc(storage);
+    BrowserDirReader* reader = browser_dir_reader_alloc(storage);
 
-    char name_temp[FILE_NAME_LEN_MAX];
     FuriString* name_str;
     name_str = furi_string_alloc();
 
     uint32_t items_cnt = 0;
 
     do {
-        if(!storage_dir_open(directory, furi_string_get_cstr(path))) {
+        if(!browser_dir_reader_open(reader, path)) {
             break;
         }
 
         items_cnt = 0;
         while(items_cnt < offset) {
-            if(!storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX)) {
+            if((entry = browser_dir_reader_next(reader)) == NULL) {
                 break;
             }
-            if(storage_file_get_error(directory) == FSE_OK) {
-                furi_string_set(name_str, name_temp);
-                if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
-                    items_cnt++;
-                }
-            } else {
-                break;
+            furi_string_set(name_str, entry->name);
+            if(browser_filter_by_name(browser, name_str, file_info_is_dir(&entry->fileinfo))) {
+                items_cnt++;
             }
         }
         if(items_cnt != offset) {
@@ -235,25 +278,21 @@ static bool browser_folder_load_chunked(
 
         items_cnt = 0;
         while(items_cnt < count) {
-            if(!storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX)) {
+            if((entry = browser_dir_reader_next(reader)) == NULL) {
                 break;
             }
-            if(storage_file_get_error(directory) == FSE_OK) {
-                furi_string_set(name_str, name_temp);
-                if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
-                    furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), name_temp);
-                    if(browser->list_item_cb) {
-                        browser->list_item_cb(
-                            browser->cb_ctx,
-                            name_str,
-                            items_cnt,
-                            file_info_is_dir(&file_info),
-                            false);
-                    }
-                    items_cnt++;
+            furi_string_set(name_str, entry->name);
+            if(browser_filter_by_name(browser, name_str, file_info_is_dir(&entry->fileinfo))) {
+                furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), entry->name);
+                if(browser->list_item_cb) {
+                    browser->list_item_cb(
+                        browser->cb_ctx,
+                        name_str,
+                        items_cnt,
+                        file_info_is_dir(&entry->fileinfo),
+                        false);
                 }
-            } else {
-                break;
+                items_cnt++;
             }
         }
         if(browser->list_item_cb) {
@@ -263,8 +302,7 @@ static bool browser_folder_load_chunked(
 
     furi_string_free(name_str);
 
-    storage_dir_close(directory);
-    storage_file_free(directory);
+    browser_dir_reader_free(reader);
 
     furi_record_close(RECORD_STORAGE);
 
@@ -273,12 +311,11 @@ static bool browser_folder_load_chunked(
 
 // Load all files at once, may cause memory overflow so need to limit that to about 400 files
 static bool browser_folder_load_full(BrowserWorker* browser, FuriString* path) {
-    FileInfo file_info;
+    StorageDirEntry* entry;
 
     Storage* storage = furi_record_open(RECORD_STORAGE);
-    File* directory = storage_file_alloc(storage);
+    BrowserDirReader* reader = browser_dir_reader_alloc(storage);
 
-    char name_temp[FILE_NAME_LEN_MAX];
     FuriString* name_str;
     name_str = furi_string_alloc();
 
@@ -286,20 +323,19 @@ static bool browser_folder_load_full(BrowserWorker* browser, FuriString* path) {
 
     bool ret = false;
     do {
-        if(!storage_dir_open(directory, furi_string_get_cstr(path))) {
+        if(!browser_dir_reader_open(reader, path)) {
             break;
         }
         if(browser->list_load_cb) {
             browser->list_load_cb(browser->cb_ctx, 0);
         }
-        while(storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX) &&
-              storage_file_get_error(directory) == FSE_OK) {
-            furi_string_set(name_str, name_temp);
-            if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
-                furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), name_temp);
+        while((entry = browser_dir_reader_next(reader)) != NULL) {
+            furi_string_set(name_str, entry->name);
+            bool is_dir = file_info_is_dir(&entry->fileinfo);
+            if(browser_filter_by_name(browser, name_str, is_dir)) {
+                furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), entry->name);
                 if(browser->list_item_cb) {
-                    browser->list_item_cb(
-                        browser->cb_ctx, name_str, items_cnt, file_info_is_dir(&file_info), false);
+                    browser->list_item_cb(browser->cb_ctx, name_str, items_cnt, is_dir, false);
                 }
                 items_cnt++;
             }
@@ -312,8 +348,7 @@ static bool browser_folder_load_full(BrowserWorker* browser, FuriString* path) {
 
     furi_string_free(name_str);
 
-    storage_dir_close(directory);
-    storage_file_free(directory);
+    browser_dir_reader_free(reader);
 
     furi_record_close(RECORD_STORAGE);
 
@@ -60,8 +60,23 @@ ARRAY_DEF(
      INIT_SET(API_6(SubmenuItem_init_set)),
      CLEAR(API_2(SubmenuItem_clear))))
 
+// Rows on screen plus the ones around them, so scrolling by one hits cache
+#define SUBMENU_ROW_CACHE_SIZE (8)
+
+typedef struct {
+    size_t position; // SIZE_MAX: empty
+    uint8_t width;
+    bool locked;
+    FuriString* text; // label fitted to width
+} SubmenuRow;
+
 typedef struct {
     SubmenuItemArray_t items;
+    SubmenuItemLabelCallback label_callback; // set: items are provided
+    SubmenuItemCallback provider_callback;
+    void* provider_context;
+    size_t provider_count;
+    SubmenuRow rows[SUBMENU_ROW_CACHE_SIZE];
     FuriString* header;
     size_t position;
     size_t window_position;
@@ -72,6 +87,42 @@ static void submenu_process_up(Submenu* submenu);
 static void submenu_process_down(Submenu* submenu);
 static void submenu_process_ok(Submenu* submenu);
 
+static size_t submenu_items_count(SubmenuModel* model) {
+    if(model->label_callback) {
+        return model->provider_count;
+    } else {
+        return SubmenuItemArray_size(model->items);
+    }
+}
+
+static void submenu_rows_invalidate(SubmenuModel* model) {
+    for(size_t i = 0; i < SUBMENU_ROW_CACHE_SIZE; i++) {
+        model->rows[i].position = SIZE_MAX;
+    }
+}
+
+static const SubmenuRow*
+    submenu_row_get(SubmenuModel* model, Canvas* canvas, size_t position, uint8_t item_width) {
+    SubmenuRow* row = &model->rows[position % SUBMENU_ROW_CACHE_SIZE];
+
+    if(row->position != position || row->width != item_width) {
+        if(model->label_callback) {
+            furi_string_reset(row->text);
+            model->label_callback(model->provider_context, position, row->text);
+            row->locked = false;
+        } else {
+            const SubmenuItem* item = SubmenuItemArray_cget(model->items, position);
+            furi_string_set(row->text, item->label);
+            row->locked = item->locked;
+        }
+        elements_string_fit_width(canvas, row->text, item_width - (row->locked ? 25 : 11));
+        row->position = position;
+        row->width = item_width;
+    }
+
+    return row;
+}
+
 static void submenu_view_draw_callback(Canvas* canvas, void* _model) {
     SubmenuModel* model = _model;
 
@@ -92,54 +143,45 @@ static void submenu_view_draw_callback(Canvas* canvas, void* _model) {
 
     canvas_set_font(canvas, FontSecondary);
 
-    size_t position = 0;
-    SubmenuItemArray_it_t it;
-    for(SubmenuItemArray_it(it, model->items); !SubmenuItemArray_end_p(it);
-        SubmenuItemArray_next(it)) {
-        const size_t item_position = position - model->window_position;
-        const size_t items_on_screen = furi_string_empty(model->header) ? 4 : 3;
-        uint8_t y_offset = furi_string_empty(model->header) ? 0 : 16;
-
-        if(item_position < items_on_screen) {
-            if(position == model->position) {
-                canvas_set_color(canvas, ColorBlack);
-                elements_slightly_rounded_box(
-                    canvas,
-                    0,
-                    y_offset + (item_position * item_height) + 1,
-                    item_width,
-                    item_height - 2);
-                canvas_set_color(canvas, ColorWhite);
-            } else {
-                canvas_set_color(canvas, ColorBlack);
-            }
+    const size_t items_size = submenu_items_count(model);
+    const size_t items_on_screen = furi_string_empty(model->header) ? 4 : 3;
+    uint8_t y_offset = furi_string_empty(model->header) ? 0 : 16;
 
-            if(SubmenuItemArray_cref(it)->locked) {
-                canvas_draw_icon(
-                    canvas,
-                    110,
-                    y_offset + (item_position * item_height) + item_height - 12,
-                    &I_Lock_7x8);
-            }
+    for(size_t item_position = 0; item_position < items_on_screen; item_position++) {
+        const size_t position = model->window_position + item_position;
+        if(position >= items_size) break;
 
-            FuriString* disp_str;
-            disp_str = furi_string_alloc_set(SubmenuItemArray_cref(it)->label);
-            elements_string_fit_width(
-                canvas, disp_str, item_width - (SubmenuItemArray_cref(it)->locked ? 25 : 11));
+        const SubmenuRow* row = submenu_row_get(model, canvas, position, item_width);
 
-            canvas_draw_str(
+        if(position == model->position) {
+            canvas_set_color(canvas, ColorBlack);
+            elements_slightly_rounded_box(
                 canvas,
-                6,
-                y_offset + (item_position * item_height) + item_height - 4,
-                furi_string_get_cstr(disp_str));
+                0,
+                y_offset + (item_position * item_height) + 1,
+                item_width,
+                item_height - 2);
+            canvas_set_color(canvas, ColorWhite);
+        } else {
+            canvas_set_color(canvas, ColorBlack);
+        }
 
-            furi_string_free(disp_str);
+        if(row->locked) {
+            canvas_draw_icon(
+                canvas,
+                110,
+                y_offset + (item_position * item_height) + item_height - 12,
+                &I_Lock_7x8);
         }
 
-        position++;
+        canvas_draw_str(
+            canvas,
+            6,
+            y_offset + (item_position * item_height) + item_height - 4,
+            furi_string_get_cstr(row->text));
     }
 
-    elements_scrollbar(canvas, model->position, SubmenuItemArray_size(model->items));
+    elements_scrollbar(canvas, model->position, items_size);
 
     if(model->locked_message_visible) {
         canvas_set_color(canvas, ColorWhite);
@@ -229,6 +271,16 @@ Submenu* submenu_alloc() {
         SubmenuModel * model,
         {
             SubmenuItemArray_init(model->items);
+            model->label_callback = NULL;
+            model->provider_callback = NULL;
+            model->provider_context = NULL;
+            model->provider_count = 0;
+            for(size_t i = 0; i < SUBMENU_ROW_CACHE_SIZE; i++) {
+                model->rows[i].width = 0;
+                model->rows[i].locked = false;
+                model->rows[i].text = furi_string_alloc();
+            }
+            submenu_rows_invalidate(model);
             model->position = 0;
             model->window_position = 0;
             model->header = furi_string_alloc();
@@ -246,6 +298,9 @@ void submenu_free(Submenu* submenu) {
         SubmenuModel * model,
         {
             furi_string_free(model->header);
+            for(size_t i = 0; i < SUBMENU_ROW_CACHE_SIZE; i++) {
+                furi_string_free(model->rows[i].text);
+            }
             SubmenuItemArray_clear(model->items);
         },
         true);
@@ -309,6 +364,9 @@ void submenu_reset(Submenu* submenu) {
         SubmenuModel * model,
         {
             SubmenuItemArray_reset(model->items);
+            model->label_callback = NULL;
+            model->provider_count = 0;
+            submenu_rows_invalidate(model);
             model->position = 0;
             model->window_position = 0;
             furi_string_reset(model->header);
@@ -322,16 +380,20 @@ void submenu_set_selected_item(Submenu* submenu, uint32_t index) {
         SubmenuModel * model,
         {
             size_t position = 0;
-            SubmenuItemArray_it_t it;
-            for(SubmenuItemArray_it(it, model->items); !SubmenuItemArray_end_p(it);
-                SubmenuItemArray_next(it)) {
-                if(index == SubmenuItemArray_cref(it)->index) {
-                    break;
+            if(model->label_callback) {
+                position = index;
+            } else {
+                SubmenuItemArray_it_t it;
+                for(SubmenuItemArray_it(it, model->items); !SubmenuItemArray_end_p(it);
+                    SubmenuItemArray_next(it)) {
+                    if(index == SubmenuItemArray_cref(it)->index) {
+                        break;
+                    }
+                    position++;
                 }
-                position++;
             }
 
-            const size_t items_size = SubmenuItemArray_size(model->items);
+            const size_t items_size = submenu_items_count(model);
 
             if(position >= items_size) {
                 position = 0;
@@ -364,7 +426,7 @@ void submenu_process_up(Submenu* submenu) {
         SubmenuModel * model,
         {
             const size_t items_on_screen = furi_string_empty(model->header) ? 4 : 3;
-            const size_t items_size = SubmenuItemArray_size(model->items);
+            const size_t items_size = submenu_items_count(model);
 
             if(model->position > 0) {
                 model->position--;
@@ -387,7 +449,7 @@ void submenu_process_down(Submenu* submenu) {
         SubmenuModel * model,
         {
             const size_t items_on_screen = furi_string_empty(model->header) ? 4 : 3;
-            const size_t items_size = SubmenuItemArray_size(model->items);
+            const size_t items_size = submenu_items_count(model);
 
             if(model->position < items_size - 1) {
                 model->position++;
@@ -405,13 +467,22 @@ void submenu_process_down(Submenu* submenu) {
 
 void submenu_process_ok(Submenu* submenu) {
     SubmenuItem* item = NULL;
+    SubmenuItemCallback provider_callback = NULL;
+    void* provider_context = NULL;
+    uint32_t provider_index = 0;
 
     with_view_model(
         submenu->view,
         SubmenuModel * model,
         {
-            const size_t items_size = SubmenuItemArray_size(model->items);
-            if(model->position < items_size) {
+            const size_t items_size = submenu_items_count(model);
+            if(model->label_callback) {
+                if(model->position < items_size) {
+                    provider_callback = model->provider_callback;
+                    provider_context = model->provider_context;
+                    provider_index = model->position;
+                }
+            } else if(model->position < items_size) {
                 item = SubmenuItemArray_get(model->items, model->position);
             }
             if(item && item->locked) {
@@ -423,9 +494,73 @@ void submenu_process_ok(Submenu* submenu) {
 
     if(item && !item->locked && item->callback) {
         item->callback(item->callback_context, item->index);
+    } else if(provider_callback) {
+        provider_callback(provider_context, provider_index);
     }
 }
 
+void submenu_set_item_provider(
+    Submenu* submenu,
+    uint32_t count,
+    SubmenuItemLabelCallback label_callback,
+    SubmenuItemCallback callback,
+    void* callback_context) {
+    furi_assert(submenu);
+    furi_assert(label_callback);
+
+    with_view_model(
+        submenu->view,
+        SubmenuModel * model,
+        {
+            model->label_callback = label_callback;
+            model->provider_callback = callback;
+            model->provider_context = callback_context;
+            model->provider_count = count;
+            submenu_rows_invalidate(model);
+            model->position = 0;
+            model->window_position = 0;
+        },
+        true);
+}
+
+void submenu_set_item_count(Submenu* submenu, uint32_t count) {
+    furi_assert(submenu);
+
+    with_view_model(
+        submenu->view,
+        SubmenuModel * model,
+        {
+            const size_t items_on_screen = furi_string_empty(model->header) ? 4 : 3;
+
+            model->provider_count = count;
+            submenu_rows_invalidate(model);
+            if(model->position >= count) {
+                model->position = count > 0 ? count - 1 : 0;
+            }
+            if(count <= items_on_screen) {
+                model->window_position = 0;
+            } else if(model->window_position > count - items_on_screen) {
+                model->window_position = count - items_on_screen;
+            }
+        },
+        true);
+}
+
+void submenu_update_item(Submenu* submenu, uint32_t index) {
+    furi_assert(submenu);
+
+    with_view_model(
+        submenu->view,
+        SubmenuModel * model,
+        {
+            SubmenuRow* row = &model->rows[index % SUBMENU_ROW_CACHE_SIZE];
+            if(row->position == index) {
+                row->position = SIZE_MAX;
+            }
+        },
+        true);
+}
+
 void submenu_set_header(Submenu* submenu, const char* header) {
     furi_assert(submenu);
 
@@ -15,6 +15,13 @@ extern "C" {
 typedef struct Submenu Submenu;
 typedef void (*SubmenuItemCallback)(void* context, uint32_t index);
 
+/** Item label callback, fills label of item at index
+ *
+ * Called from draw with submenu model locked, only for items on screen that
+ * are not cached already. Must not call Submenu API.
+ */
+typedef void (*SubmenuItemLabelCallback)(void* context, uint32_t index, FuriString* label);
+
 /** Allocate and initialize submenu 
  * 
  * This submenu is used to select one option
@@ -73,6 +80,43 @@ void submenu_add_lockable_item(
     bool locked,
     const char* locked_message);
 
+/** Provide submenu items on demand instead of adding them
+ *
+ * Only labels of items on screen are requested and a few of them are
+ * cached, so menus of any size take constant memory and open instantly.
+ * Item index is its position, provided items are never locked.
+ * Items added with submenu_add_item are not shown while provider is set,
+ * submenu_reset removes provider.
+ *
+ * @param      submenu           Submenu instance
+ * @param      count             items count
+ * @param      label_callback    item label callback
+ * @param      callback          item callback
+ * @param      callback_context  context for both callbacks
+ */
+void submenu_set_item_provider(
+    Submenu* submenu,
+    uint32_t count,
+    SubmenuItemLabelCallback label_callback,
+    SubmenuItemCallback callback,
+    void* callback_context);
+
+/** Change provided items count, cached labels are dropped
+ *
+ * @param      submenu  Submenu instance
+ * @param      count    items count
+ */
+void submenu_set_item_count(Submenu* submenu, uint32_t count);
+
+/** Notify submenu that provided item label changed
+ *
+ * Drops cached label of the item, it is requested again if on screen.
+ *
+ * @param      submenu  Submenu instance
+ * @param      index    item index
+ */
+void submenu_update_item(Submenu* submenu, uint32_t index);
+
 /** Remove all items from submenu
  *
  * @param      submenu  Submenu instance
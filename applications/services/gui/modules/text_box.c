@@ -1,6 +1,7 @@
 #include "text_box.h"
 #include <gui/canvas.h>
 #include <gui/elements.h>
+#include <gui/text_layout.h>
 #include <furi.h>
 #include <stdint.h>
 
@@ -9,110 +10,44 @@ struct TextBox {
 };
 
 typedef struct {
-    const char* text;
-    char* text_pos;
-    FuriString* text_formatted;
-    int32_t scroll_pos;
-    int32_t scroll_num;
+    FuriString* text;
+    TextLayout* layout;
     TextBoxFont font;
     TextBoxFocus focus;
     bool formatted;
 } TextBoxModel;
 
-static void text_box_process_down(TextBox* text_box) {
+static void text_box_scroll(TextBox* text_box, int32_t lines) {
     with_view_model(
-        text_box->view,
-        TextBoxModel * model,
-        {
-            if(model->scroll_pos < model->scroll_num - 1) {
-                model->scroll_pos++;
-                // Search next line start
-                while(*model->text_pos++ != '\n')
-                    ;
-            }
-        },
-        true);
-}
-
-static void text_box_process_up(TextBox* text_box) {
-    with_view_model(
-        text_box->view,
-        TextBoxModel * model,
-        {
-            if(model->scroll_pos > 0) {
-                model->scroll_pos--;
-                // Reach last symbol of previous line
-                model->text_pos--;
-                // Search previous line start
-                while((model->text_pos != model->text) && (*(--model->text_pos) != '\n'))
-                    ;
-                if(*model->text_pos == '\n') {
-                    model->text_pos++;
-                }
-            }
-        },
-        true);
-}
-
-static void text_box_insert_endline(Canvas* canvas, TextBoxModel* model) {
-    size_t i = 0;
-    size_t line_width = 0;
-    const char* str = model->text;
-    size_t line_num = 0;
-
-    const size_t text_width = 120;
-
-    while(str[i] != '\0') {
-        char symb = str[i++];
-        if(symb != '\n') {
-            size_t glyph_width = canvas_glyph_width(canvas, symb);
-            if(line_width + glyph_width > text_width) {
-                line_num++;
-                line_width = 0;
-                furi_string_push_back(model->text_formatted, '\n');
-            }
-            line_width += glyph_width;
-        } else {
-            line_num++;
-            line_width = 0;
-        }
-        furi_string_push_back(model->text_formatted, symb);
-    }
-    line_num++;
-    model->text = furi_string_get_cstr(model->text_formatted);
-    model->text_pos = (char*)model->text;
-    if(model->focus == TextBoxFocusEnd && line_num > 5) {
-        // Set text position to 5th line from the end
-        for(uint8_t i = 0; i < line_num - 5; i++) {
-            while(*model->text_pos++ != '\n') {
-            }
-        }
-        model->scroll_num = line_num - 4;
-        model->scroll_pos = line_num - 5;
-    } else {
-        model->scroll_num = MAX(line_num - 4, 0u);
-        model->scroll_pos = 0;
-    }
+        text_box->view, TextBoxModel * model, { text_layout_scroll(model->layout, lines); }, true);
 }
 
 static void text_box_view_draw_callback(Canvas* canvas, void* _model) {
     TextBoxModel* model = _model;
 
     canvas_clear(canvas);
-    if(model->font == TextBoxFontText) {
-        canvas_set_font(canvas, FontSecondary);
-    } else if(model->font == TextBoxFontHex) {
-        canvas_set_font(canvas, FontKeyboard);
+    Font font = FontSecondary;
+    if(model->font == TextBoxFontHex) {
+        font = FontKeyboard;
     }
+    canvas_set_font(canvas, font);
+    text_layout_set_font(model->layout, font);
 
     if(!model->formatted) {
-        text_box_insert_endline(canvas, model);
+        if(model->focus == TextBoxFocusEnd) {
+            text_layout_scroll_to_end(model->layout);
+        }
         model->formatted = true;
     }
 
+    // Lines with baseline above the bottom edge
+    uint8_t lines = (canvas_height(canvas) - 12) / canvas_current_font_height(canvas) + 1;
     elements_slightly_rounded_frame(canvas, 0, 0, 124, 64);
-    elements_multiline_text(canvas, 3, 11, model->text_pos);
-    elements_scrollbar(canvas, model->scroll_pos, model->scroll_num);
+    text_layout_draw(model->layout, canvas, 3, 11, lines);
+
+    uint16_t scroll_pos, scroll_num;
+    text_layout_get_scrollbar(model->layout, &scroll_pos, &scroll_num);
+    elements_scrollbar(canvas, scroll_pos, scroll_num);
 }
 
 static bool text_box_view_input_callback(InputEvent* event, void* context) {
@@ -122,10 +57,10 @@ static bool text_box_view_input_callback(InputEvent* event, void* context) {
     bool consumed = false;
     if(event->type == InputTypeShort) {
         if(event->key == InputKeyDown) {
-            text_box_process_down(text_box);
+            text_box_scroll(text_box, 1);
             consumed = true;
         } else if(event->key == InputKeyUp) {
-            text_box_process_up(text_box);
+            text_box_scroll(text_box, -1);
             consumed = true;
         }
     }
@@ -144,8 +79,9 @@ TextBox* text_box_alloc() {
         text_box->view,
         TextBoxModel * model,
         {
-            model->text = NULL;
-            model->text_formatted = furi_string_alloc_set("");
+            model->text = furi_string_alloc();
+            model->layout = text_layout_alloc();
+            text_layout_set_width(model->layout, 120);
             model->formatted = false;
             model->font = TextBoxFontText;
         },
@@ -158,7 +94,13 @@ void text_box_free(TextBox* text_box) {
     furi_assert(text_box);
 
     with_view_model(
-        text_box->view, TextBoxModel * model, { furi_string_free(model->text_formatted); }, true);
+        text_box->view,
+        TextBoxModel * model,
+        {
+            text_layout_free(model->layout);
+            furi_string_free(model->text);
+        },
+        true);
     view_free(text_box->view);
     free(text_box);
 }
@@ -175,10 +117,11 @@ void text_box_reset(TextBox* text_box) {
         text_box->view,
         TextBoxModel * model,
         {
-            model->text = NULL;
-            furi_string_set(model->text_formatted, "");
+            furi_string_reset(model->text);
+            text_layout_set_text(model->layout, furi_string_get_cstr(model->text));
             model->font = TextBoxFontText;
             model->focus = TextBoxFocusStart;
+            model->formatted = false;
         },
         true);
 }
@@ -191,9 +134,9 @@ void text_box_set_text(TextBox* text_box, const char* text) {
         text_box->view,
         TextBoxModel * model,
         {
-            model->text = text;
-            furi_string_reset(model->text_formatted);
-            furi_string_reserve(model->text_formatted, strlen(text));
+            // Own copy, callers reuse their buffers
+            furi_string_set(model->text, text);
+            text_layout_set_text(model->layout, furi_string_get_cstr(model->text));
             model->formatted = false;
         },
         true);
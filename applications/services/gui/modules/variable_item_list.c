@@ -8,6 +8,8 @@
 
 struct VariableItem {
     const char* label;
+    FuriString* label_text; // owns label set by variable_item_set_label
+    uint32_t position; // UINT32_MAX: empty cache row
     uint8_t current_value_index;
     FuriString* current_value_text;
     uint8_t values_count;
@@ -27,10 +29,17 @@ struct VariableItemList {
     FuriTimer* locked_timer;
 };
 
+// Rows on screen plus the ones around them, so scrolling by one hits cache
+#define VARIABLE_ITEM_LIST_ROW_CACHE_SIZE (8)
+
 typedef struct {
     VariableItemArray_t items;
-    uint8_t position;
-    uint8_t window_position;
+    VariableItemListItemCallback item_callback; // set: items are provided
+    void* item_context;
+    uint32_t item_count;
+    VariableItem rows[VARIABLE_ITEM_LIST_ROW_CACHE_SIZE]; // provided items by position
+    uint32_t position;
+    uint32_t window_position;
     size_t scroll_counter;
     bool locked_message_visible;
 } VariableItemListModel;
@@ -41,6 +50,43 @@ static void variable_item_list_process_left(VariableItemList* variable_item_list
 static void variable_item_list_process_right(VariableItemList* variable_item_list);
 static void variable_item_list_process_ok(VariableItemList* variable_item_list);
 
+static uint32_t variable_item_list_items_count(VariableItemListModel* model) {
+    if(model->item_callback) {
+        return model->item_count;
+    } else {
+        return VariableItemArray_size(model->items);
+    }
+}
+
+static void variable_item_list_rows_invalidate(VariableItemListModel* model) {
+    for(size_t i = 0; i < VARIABLE_ITEM_LIST_ROW_CACHE_SIZE; i++) {
+        model->rows[i].position = UINT32_MAX;
+    }
+}
+
+static VariableItem* variable_item_list_get_item(VariableItemListModel* model, uint32_t position) {
+    if(!model->item_callback) {
+        return VariableItemArray_get(model->items, position);
+    }
+
+    VariableItem* item = &model->rows[position % VARIABLE_ITEM_LIST_ROW_CACHE_SIZE];
+    if(item->position != position) {
+        furi_string_reset(item->label_text);
+        item->label = furi_string_get_cstr(item->label_text);
+        item->position = position;
+        item->current_value_index = 0;
+        furi_string_reset(item->current_value_text);
+        item->values_count = 0;
+        item->change_callback = NULL;
+        item->locked = false;
+        furi_string_reset(item->locked_message);
+        item->context = model->item_context;
+        model->item_callback(model->item_context, position, item);
+    }
+
+    return item;
+}
+
 static void variable_item_list_draw_callback(Canvas* canvas, void* _model) {
     VariableItemListModel* model = _model;
 
@@ -49,71 +95,66 @@ static void variable_item_list_draw_callback(Canvas* canvas, void* _model) {
 
     canvas_clear(canvas);
 
-    uint8_t position = 0;
-    VariableItemArray_it_t it;
+    const uint32_t items_count = variable_item_list_items_count(model);
+    const uint8_t items_on_screen = 4;
+    const uint8_t y_offset = 0;
 
     canvas_set_font(canvas, FontSecondary);
-    for(VariableItemArray_it(it, model->items); !VariableItemArray_end_p(it);
-        VariableItemArray_next(it)) {
-        uint8_t item_position = position - model->window_position;
-        uint8_t items_on_screen = 4;
-        uint8_t y_offset = 0;
-
-        if(item_position < items_on_screen) {
-            const VariableItem* item = VariableItemArray_cref(it);
-            uint8_t item_y = y_offset + (item_position * item_height);
-            uint8_t item_text_y = item_y + item_height - 4;
-            size_t scroll_counter = 0;
-
-            if(position == model->position) {
-                canvas_set_color(canvas, ColorBlack);
-                elements_slightly_rounded_box(canvas, 0, item_y + 1, item_width, item_height - 2);
-                canvas_set_color(canvas, ColorWhite);
-                scroll_counter = model->scroll_counter;
-                if(scroll_counter < 1) {
-                    scroll_counter = 0;
-                } else {
-                    scroll_counter -= 1;
-                }
-            } else {
-                canvas_set_color(canvas, ColorBlack);
-            }
+    for(uint8_t item_position = 0; item_position < items_on_screen; item_position++) {
+        const uint32_t position = model->window_position + item_position;
+        if(position >= items_count) break;
+
+        const VariableItem* item = variable_item_list_get_item(model, position);
+        uint8_t item_y = y_offset + (item_position * item_height);
+        uint8_t item_text_y = item_y + item_height - 4;
+        size_t scroll_counter = 0;
 
-            if(item->current_value_index == 0 && furi_string_empty(item->current_value_text)) {
-                // Only left text, no right text
-                canvas_draw_str(canvas, 6, item_text_y, item->label);
+        if(position == model->position) {
+            canvas_set_color(canvas, ColorBlack);
+            elements_slightly_rounded_box(canvas, 0, item_y + 1, item_width, item_height - 2);
+            canvas_set_color(canvas, ColorWhite);
+            scroll_counter = model->scroll_counter;
+            if(scroll_counter < 1) {
+                scroll_counter = 0;
             } else {
-                elements_scrollable_text_line_str(
-                    canvas, 6, item_text_y, 66, item->label, scroll_counter, false, false);
+                scroll_counter -= 1;
             }
+        } else {
+            canvas_set_color(canvas, ColorBlack);
+        }
 
-            if(item->locked) {
-                canvas_draw_icon(canvas, 110, item_text_y - 8, &I_Lock_7x8);
-            } else {
-                if(item->current_value_index > 0) {
-                    canvas_draw_str(canvas, 73, item_text_y, "<");
-                }
+        if(item->current_value_index == 0 && furi_string_empty(item->current_value_text)) {
+            // Only left text, no right text
+            canvas_draw_str(canvas, 6, item_text_y, item->label);
+        } else {
+            elements_scrollable_text_line_str(
+                canvas, 6, item_text_y, 66, item->label, scroll_counter, false, false);
+        }
 
-                elements_scrollable_text_line(
-                    canvas,
-                    (115 + 73) / 2 + 1,
-                    item_text_y,
-                    37,
-                    item->current_value_text,
-                    scroll_counter,
-                    false,
-                    true);
-
-                if(item->current_value_index < (item->values_count - 1)) {
-                    canvas_draw_str(canvas, 115, item_text_y, ">");
-                }
+        if(item->locked) {
+            canvas_draw_icon(canvas, 110, item_text_y - 8, &I_Lock_7x8);
+        } else {
+            if(item->current_value_index > 0) {
+                canvas_draw_str(canvas, 73, item_text_y, "<");
             }
-        }
 
-        position++;
+            elements_scrollable_text_line(
+                canvas,
+                (115 + 73) / 2 + 1,
+                item_text_y,
+                37,
+                item->current_value_text,
+                scroll_counter,
+                false,
+                true);
+
+            if(item->current_value_index < (item->values_count - 1)) {
+                canvas_draw_str(canvas, 115, item_text_y, ">");
+            }
+        }
     }
 
-    elements_scrollbar(canvas, model->position, VariableItemArray_size(model->items));
+    elements_scrollbar(canvas, model->position, items_count);
 
     if(model->locked_message_visible) {
         canvas_set_color(canvas, ColorWhite);
@@ -129,17 +170,27 @@ static void variable_item_list_draw_callback(Canvas* canvas, void* _model) {
             AlignCenter,
             AlignCenter,
             furi_string_get_cstr(
-                VariableItemArray_get(model->items, model->position)->locked_message));
+                variable_item_list_get_item(model, model->position)->locked_message));
     }
 }
 
 void variable_item_list_set_selected_item(VariableItemList* variable_item_list, uint8_t index) {
+    variable_item_list_set_selected_position(variable_item_list, index);
+}
+
+uint8_t variable_item_list_get_selected_item_index(VariableItemList* variable_item_list) {
+    return variable_item_list_get_selected_position(variable_item_list);
+}
+
+void variable_item_list_set_selected_position(
+    VariableItemList* variable_item_list,
+    uint32_t position) {
     with_view_model(
         variable_item_list->view,
         VariableItemListModel * model,
         {
-            uint8_t position = index;
-            if(position >= VariableItemArray_size(model->items)) {
+            const uint32_t items_count = variable_item_list_items_count(model);
+            if(position >= items_count) {
                 position = 0;
             }
 
@@ -150,22 +201,22 @@ void variable_item_list_set_selected_item(VariableItemList* variable_item_list,
                 model->window_position -= 1;
             }
 
-            if(VariableItemArray_size(model->items) <= 4) {
+            if(items_count <= 4) {
                 model->window_position = 0;
             } else {
-                if(model->window_position >= (VariableItemArray_size(model->items) - 4)) {
-                    model->window_position = (VariableItemArray_size(model->items) - 4);
+                if(model->window_position >= (items_count - 4)) {
+                    model->window_position = (items_count - 4);
                 }
             }
         },
         true);
 }
 
-uint8_t variable_item_list_get_selected_item_index(VariableItemList* variable_item_list) {
+uint32_t variable_item_list_get_selected_position(VariableItemList* variable_item_list) {
     VariableItemListModel* model = view_get_model(variable_item_list->view);
-    uint8_t idx = model->position;
+    uint32_t position = model->position;
     view_commit_model(variable_item_list->view, false);
-    return idx;
+    return position;
 }
 
 static bool variable_item_list_input_callback(InputEvent* event, void* context) {
@@ -243,7 +294,7 @@ void variable_item_list_process_up(VariableItemList* variable_item_list) {
         variable_item_list->view,
         VariableItemListModel * model,
         {
-            uint8_t items_on_screen = 4;
+            const uint32_t items_on_screen = 4;
             if(model->position > 0) {
                 model->position--;
 
@@ -251,7 +302,7 @@ void variable_item_list_process_up(VariableItemList* variable_item_list) {
                     model->window_position--;
                 }
             } else {
-                model->position = VariableItemArray_size(model->items) - 1;
+                model->position = variable_item_list_items_count(model) - 1;
                 if(model->position > (items_on_screen - 1)) {
                     model->window_position = model->position - (items_on_screen - 1);
                 }
@@ -266,12 +317,12 @@ void variable_item_list_process_down(VariableItemList* variable_item_list) {
         variable_item_list->view,
         VariableItemListModel * model,
         {
-            uint8_t items_on_screen = 4;
-            if(model->position < (VariableItemArray_size(model->items) - 1)) {
+            const uint32_t items_on_screen = 4;
+            const uint32_t items_count = variable_item_list_items_count(model);
+            if(model->position < (items_count - 1)) {
                 model->position++;
                 if((model->position - model->window_position) > (items_on_screen - 2) &&
-                   model->window_position <
-                       (VariableItemArray_size(model->items) - items_on_screen)) {
+                   model->window_position < (items_count - items_on_screen)) {
                     model->window_position++;
                 }
             } else {
@@ -284,22 +335,8 @@ void variable_item_list_process_down(VariableItemList* variable_item_list) {
 }
 
 VariableItem* variable_item_list_get_selected_item(VariableItemListModel* model) {
-    VariableItem* item = NULL;
-
-    VariableItemArray_it_t it;
-    uint8_t position = 0;
-    for(VariableItemArray_it(it, model->items); !VariableItemArray_end_p(it);
-        VariableItemArray_next(it)) {
-        if(position == model->position) {
-            break;
-        }
-        position++;
-    }
-
-    item = VariableItemArray_ref(it);
-
-    furi_assert(item);
-    return item;
+    furi_assert(model->position < variable_item_list_items_count(model));
+    return variable_item_list_get_item(model, model->position);
 }
 
 void variable_item_list_process_left(VariableItemList* variable_item_list) {
@@ -381,6 +418,14 @@ void variable_item_list_locked_timer_callback(void* context) {
         true);
 }
 
+static void variable_item_free_strings(VariableItem* item) {
+    if(item->label_text) {
+        furi_string_free(item->label_text);
+    }
+    furi_string_free(item->current_value_text);
+    furi_string_free(item->locked_message);
+}
+
 VariableItemList* variable_item_list_alloc() {
     VariableItemList* variable_item_list = malloc(sizeof(VariableItemList));
     variable_item_list->view = view_alloc();
@@ -398,6 +443,15 @@ VariableItemList* variable_item_list_alloc() {
         VariableItemListModel * model,
         {
             VariableItemArray_init(model->items);
+            model->item_callback = NULL;
+            model->item_context = NULL;
+            model->item_count = 0;
+            for(size_t i = 0; i < VARIABLE_ITEM_LIST_ROW_CACHE_SIZE; i++) {
+                model->rows[i].label_text = furi_string_alloc();
+                model->rows[i].current_value_text = furi_string_alloc();
+                model->rows[i].locked_message = furi_string_alloc();
+            }
+            variable_item_list_rows_invalidate(model);
             model->position = 0;
             model->window_position = 0;
             model->scroll_counter = 0;
@@ -420,10 +474,12 @@ void variable_item_list_free(VariableItemList* variable_item_list) {
             VariableItemArray_it_t it;
             for(VariableItemArray_it(it, model->items); !VariableItemArray_end_p(it);
                 VariableItemArray_next(it)) {
-                furi_string_free(VariableItemArray_ref(it)->current_value_text);
-                furi_string_free(VariableItemArray_ref(it)->locked_message);
+                variable_item_free_strings(VariableItemArray_ref(it));
             }
             VariableItemArray_clear(model->items);
+            for(size_t i = 0; i < VARIABLE_ITEM_LIST_ROW_CACHE_SIZE; i++) {
+                variable_item_free_strings(&model->rows[i]);
+            }
         },
         false);
     furi_timer_stop(variable_item_list->scroll_timer);
@@ -444,10 +500,12 @@ void variable_item_list_reset(VariableItemList* variable_item_list) {
             VariableItemArray_it_t it;
             for(VariableItemArray_it(it, model->items); !VariableItemArray_end_p(it);
                 VariableItemArray_next(it)) {
-                furi_string_free(VariableItemArray_ref(it)->current_value_text);
-                furi_string_free(VariableItemArray_ref(it)->locked_message);
+                variable_item_free_strings(VariableItemArray_ref(it));
             }
             VariableItemArray_reset(model->items);
+            model->item_callback = NULL;
+            model->item_count = 0;
+            variable_item_list_rows_invalidate(model);
         },
         false);
 }
@@ -473,6 +531,8 @@ VariableItem* variable_item_list_add(
         {
             item = VariableItemArray_push_new(model->items);
             item->label = label;
+            item->label_text = NULL;
+            item->position = VariableItemArray_size(model->items) - 1;
             item->values_count = values_count;
             item->change_callback = change_callback;
             item->context = context;
@@ -502,6 +562,76 @@ void variable_item_list_set_enter_callback(
         false);
 }
 
+void variable_item_list_set_item_provider(
+    VariableItemList* variable_item_list,
+    uint32_t count,
+    VariableItemListItemCallback callback,
+    void* context) {
+    furi_assert(variable_item_list);
+    furi_assert(callback);
+
+    with_view_model(
+        variable_item_list->view,
+        VariableItemListModel * model,
+        {
+            model->item_callback = callback;
+            model->item_context = context;
+            model->item_count = count;
+            variable_item_list_rows_invalidate(model);
+            model->position = 0;
+            model->window_position = 0;
+            model->scroll_counter = 0;
+        },
+        true);
+}
+
+void variable_item_list_set_item_count(VariableItemList* variable_item_list, uint32_t count) {
+    furi_assert(variable_item_list);
+
+    with_view_model(
+        variable_item_list->view,
+        VariableItemListModel * model,
+        {
+            const uint32_t items_on_screen = 4;
+
+            model->item_count = count;
+            variable_item_list_rows_invalidate(model);
+            if(model->position >= count) {
+                model->position = count > 0 ? count - 1 : 0;
+            }
+            if(count <= items_on_screen) {
+                model->window_position = 0;
+            } else if(model->window_position > count - items_on_screen) {
+                model->window_position = count - items_on_screen;
+            }
+        },
+        true);
+}
+
+void variable_item_list_update_item(VariableItemList* variable_item_list, uint32_t position) {
+    furi_assert(variable_item_list);
+
+    with_view_model(
+        variable_item_list->view,
+        VariableItemListModel * model,
+        {
+            VariableItem* item = &model->rows[position % VARIABLE_ITEM_LIST_ROW_CACHE_SIZE];
+            if(item->position == position) {
+                item->position = UINT32_MAX;
+            }
+        },
+        true);
+}
+
+void variable_item_set_label(VariableItem* item, const char* label) {
+    furi_assert(label);
+    if(!item->label_text) {
+        item->label_text = furi_string_alloc();
+    }
+    furi_string_set_str(item->label_text, label);
+    item->label = furi_string_get_cstr(item->label_text);
+}
+
 void variable_item_set_current_value_index(VariableItem* item, uint8_t current_value_index) {
     item->current_value_index = current_value_index;
 }
@@ -529,3 +659,7 @@ uint8_t variable_item_get_current_value_index(VariableItem* item) {
 void* variable_item_get_context(VariableItem* item) {
     return item->context;
 }
+
+uint32_t variable_item_get_position(VariableItem* item) {
+    return item->position;
+}
@@ -16,6 +16,14 @@ typedef struct VariableItem VariableItem;
 typedef void (*VariableItemChangeCallback)(VariableItem* item);
 typedef void (*VariableItemListEnterCallback)(void* context, uint32_t index);
 
+/** Item callback, fills item at position
+ *
+ * Called with VariableItemList model locked, only for items on screen that
+ * are not cached already. Item comes empty, with context set to provider
+ * context, fill it with variable_item setters.
+ */
+typedef void (*VariableItemListItemCallback)(void* context, uint32_t position, VariableItem* item);
+
 /** Allocate and initialize VariableItemList
  *
  * @return     VariableItemList*
@@ -70,10 +78,74 @@ void variable_item_list_set_enter_callback(
     VariableItemListEnterCallback callback,
     void* context);
 
+/** Provide items on demand instead of adding them
+ *
+ * Only items on screen are requested and a few of them are cached, so lists
+ * of any size take constant memory and open instantly. Cached item may be
+ * requested again any time, so value changes made in item change callback
+ * must be saved by the owner and given back on next request.
+ * Items added with variable_item_list_add are not shown while provider is
+ * set, variable_item_list_reset removes provider. Lists can be longer than
+ * 255 items, use variable_item_list_set_selected_position and
+ * variable_item_list_get_selected_position with them.
+ *
+ * @param      variable_item_list  VariableItemList instance
+ * @param      count               items count
+ * @param      callback            VariableItemListItemCallback instance
+ * @param      context             pointer to context
+ */
+void variable_item_list_set_item_provider(
+    VariableItemList* variable_item_list,
+    uint32_t count,
+    VariableItemListItemCallback callback,
+    void* context);
+
+/** Change provided items count, cached items are dropped
+ *
+ * @param      variable_item_list  VariableItemList instance
+ * @param      count               items count
+ */
+void variable_item_list_set_item_count(VariableItemList* variable_item_list, uint32_t count);
+
+/** Notify list that provided item changed
+ *
+ * Drops cached item, it is requested again if on screen.
+ *
+ * @param      variable_item_list  VariableItemList instance
+ * @param      position            item position
+ */
+void variable_item_list_update_item(VariableItemList* variable_item_list, uint32_t position);
+
 void variable_item_list_set_selected_item(VariableItemList* variable_item_list, uint8_t index);
 
 uint8_t variable_item_list_get_selected_item_index(VariableItemList* variable_item_list);
 
+/** Set selected item position, for lists longer than 255 items
+ *
+ * @param      variable_item_list  VariableItemList instance
+ * @param      position            item position, first item is selected if out of range
+ */
+void variable_item_list_set_selected_position(
+    VariableItemList* variable_item_list,
+    uint32_t position);
+
+/** Get selected item position, for lists longer than 255 items
+ *
+ * @param      variable_item_list  VariableItemList instance
+ *
+ * @return     selected item position
+ */
+uint32_t variable_item_list_get_selected_position(VariableItemList* variable_item_list);
+
+/** Set item label
+ *
+ * Label is copied, unlike the one given to variable_item_list_add
+ *
+ * @param      item                 VariableItem* instance
+ * @param      label                item name
+ */
+void variable_item_set_label(VariableItem* item, const char* label);
+
 /** Set item current selected index
  *
  * @param      item                 VariableItem* instance
@@ -119,6 +191,14 @@ uint8_t variable_item_get_current_value_index(VariableItem* item);
  */
 void* variable_item_get_context(VariableItem* item);
 
+/** Get item position in list
+ *
+ * @param      item  VariableItem* instance
+ *
+ * @return     uint32_t item position
+ */
+uint32_t variable_item_get_position(VariableItem* item);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,400 @@
+#include "text_layout_i.h"
+
+#include <furi.h>
+#include <toolbox/stream/stream.h>
+
+#define TAG "TextLayout"
+
+#define TEXT_LAYOUT_WINDOW_SIZE (512)
+#define TEXT_LAYOUT_LINE_CACHE_SIZE (16)
+#define TEXT_LAYOUT_DRAW_CHUNK_SIZE (32)
+#define TEXT_LAYOUT_STATS_MAX_LINES (1024)
+
+#define TEXT_LAYOUT_GLYPH_COUNT (256)
+
+struct TextLayout {
+    // Source: text in memory or stream read through the window
+    const char* text;
+    Stream* stream;
+    size_t size;
+    uint8_t* window;
+    size_t window_offset;
+    size_t window_size;
+
+    // Metrics, glyph widths are taken from canvas on draw
+    Font font;
+    uint8_t width;
+    bool measured;
+    uint8_t glyph_width[TEXT_LAYOUT_GLYPH_COUNT];
+
+    // Position
+    size_t top;
+    int32_t scroll;
+    bool scroll_to_end;
+
+    // Consecutive line starts, ascending
+    size_t line_cache[TEXT_LAYOUT_LINE_CACHE_SIZE];
+    size_t line_cache_count;
+
+    // Laid out bytes and lines, for line count estimate
+    size_t stats_bytes;
+    size_t stats_lines;
+
+    // Scrollbar as of last draw
+    uint16_t scrollbar_pos;
+    uint16_t scrollbar_total;
+};
+
+TextLayout* text_layout_alloc(void) {
+    TextLayout* layout = malloc(sizeof(TextLayout));
+    layout->font = FontSecondary;
+    layout->width = 120;
+    layout->measured = false;
+    layout->window = NULL;
+    text_layout_set_text(layout, "");
+    return layout;
+}
+
+void text_layout_free(TextLayout* layout) {
+    furi_assert(layout);
+    free(layout->window);
+    free(layout);
+}
+
+static void text_layout_reset(TextLayout* layout) {
+    layout->window_offset = 0;
+    layout->window_size = 0;
+    layout->top = 0;
+    layout->scroll = 0;
+    layout->scroll_to_end = false;
+    layout->line_cache_count = 0;
+    layout->stats_bytes = 0;
+    layout->stats_lines = 0;
+    layout->scrollbar_pos = 0;
+    layout->scrollbar_total = 0;
+}
+
+void text_layout_set_text(TextLayout* layout, const char* text) {
+    furi_assert(layout);
+    furi_assert(text);
+    layout->text = text;
+    layout->stream = NULL;
+    layout->size = strlen(text);
+    free(layout->window);
+    layout->window = NULL;
+    text_layout_reset(layout);
+}
+
+void text_layout_set_stream(TextLayout* layout, Stream* stream) {
+    furi_assert(layout);
+    furi_assert(stream);
+    layout->text = NULL;
+    layout->stream = stream;
+    layout->size = stream_size(stream);
+    if(!layout->window) layout->window = malloc(TEXT_LAYOUT_WINDOW_SIZE);
+    text_layout_reset(layout);
+}
+
+void text_layout_set_font(TextLayout* layout, Font font) {
+    furi_assert(layout);
+    if(layout->font == font) return;
+    layout->font = font;
+    layout->measured = false;
+    layout->line_cache_count = 0;
+}
+
+void text_layout_set_width(TextLayout* layout, uint8_t width) {
+    furi_assert(layout);
+    if(layout->width == width) return;
+    layout->width = width;
+    layout->line_cache_count = 0;
+}
+
+void text_layout_scroll(TextLayout* layout, int32_t lines) {
+    furi_assert(layout);
+    layout->scroll += lines;
+}
+
+void text_layout_scroll_to_end(TextLayout* layout) {
+    furi_assert(layout);
+    layout->scroll = 0;
+    layout->scroll_to_end = true;
+}
+
+void text_layout_get_scrollbar(TextLayout* layout, uint16_t* pos, uint16_t* total) {
+    furi_assert(layout);
+    *pos = layout->scrollbar_pos;
+    *total = layout->scrollbar_total;
+}
+
+static char text_layout_get_char(TextLayout* layout, size_t offset) {
+    if(layout->text) return layout->text[offset];
+
+    if(offset < layout->window_offset || offset >= layout->window_offset + layout->window_size) {
+        // Keep some bytes behind forward scans and more behind backward ones
+        size_t behind = offset < layout->window_offset ? TEXT_LAYOUT_WINDOW_SIZE * 3 / 4 :
+                                                         TEXT_LAYOUT_WINDOW_SIZE / 4;
+        size_t start = offset - MIN(offset, behind);
+        layout->window_offset = start;
+        layout->window_size = 0;
+        if(stream_seek(layout->stream, start, StreamOffsetFromStart)) {
+            layout->window_size =
+                stream_read(layout->stream, layout->window, TEXT_LAYOUT_WINDOW_SIZE);
+        }
+        if(offset >= layout->window_offset + layout->window_size) {
+            FURI_LOG_E(TAG, "Read failed at %zu", offset);
+            return ' ';
+        }
+    }
+
+    return layout->window[offset - layout->window_offset];
+}
+
+static uint8_t text_layout_get_glyph_width(TextLayout* layout, char symbol) {
+    return layout->glyph_width[(uint8_t)symbol];
+}
+
+static bool text_layout_line_exists(TextLayout* layout, size_t start) {
+    // Empty text and text ending with new line have an empty last line
+    if(start < layout->size) return true;
+    if(start > layout->size) return false;
+    return start == 0 || text_layout_get_char(layout, start - 1) == '\n';
+}
+
+/** Find line end and start of the next line
+ *
+ * @return     next line start, same as start for the last line
+ */
+static size_t text_layout_line_scan(TextLayout* layout, size_t start, size_t* end) {
+    size_t offset = start;
+    size_t width = 0;
+
+    for(;;) {
+        if(offset >= layout->size) break;
+        if(offset != start && offset % TEXT_LAYOUT_SEGMENT_SIZE == 0) break;
+
+        char symbol = text_layout_get_char(layout, offset);
+        if(symbol == '\n') {
+            if(end) *end = offset;
+            return offset + 1;
+        }
+
+        uint8_t glyph_width = text_layout_get_glyph_width(layout, symbol);
+        if(offset != start && width + glyph_width > layout->width) {
+            break;
+        }
+        width += glyph_width;
+        offset++;
+    }
+
+    if(end) *end = offset;
+    return offset;
+}
+
+static size_t text_layout_line_scan_stats(TextLayout* layout, size_t start, size_t* end) {
+    size_t next = text_layout_line_scan(layout, start, end);
+    if(layout->stats_lines == TEXT_LAYOUT_STATS_MAX_LINES) {
+        layout->stats_bytes /= 2;
+        layout->stats_lines /= 2;
+    }
+    layout->stats_bytes += next - start;
+    layout->stats_lines++;
+    return next;
+}
+
+static void text_layout_line_cache_push(TextLayout* layout, size_t start) {
+    if(layout->line_cache_count == TEXT_LAYOUT_LINE_CACHE_SIZE) {
+        memmove(
+            &layout->line_cache[0],
+            &layout->line_cache[1],
+            sizeof(size_t) * (TEXT_LAYOUT_LINE_CACHE_SIZE - 1));
+        layout->line_cache_count--;
+    }
+    layout->line_cache[layout->line_cache_count++] = start;
+}
+
+static bool text_layout_line_cache_find(TextLayout* layout, size_t start, size_t* index) {
+    for(size_t i = 0; i < layout->line_cache_count; i++) {
+        if(layout->line_cache[i] == start) {
+            *index = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+/** Get start of the line that contains offset, lines on the way are cached */
+static size_t text_layout_line_find(TextLayout* layout, size_t offset) {
+    if(offset == layout->size && !text_layout_line_exists(layout, offset)) offset--;
+
+    // Lines are laid out from the paragraph or segment start
+    size_t start = offset - offset % TEXT_LAYOUT_SEGMENT_SIZE;
+    for(size_t i = offset; i > start; i--) {
+        if(text_layout_get_char(layout, i - 1) == '\n') {
+            start = i;
+            break;
+        }
+    }
+
+    layout->line_cache_count = 0;
+    for(;;) {
+        text_layout_line_cache_push(layout, start);
+        size_t next = text_layout_line_scan(layout, start, NULL);
+        if(next > offset || next == start) break;
+        start = next;
+    }
+
+    return start;
+}
+
+static size_t text_layout_line_next(TextLayout* layout, size_t start) {
+    size_t index;
+    bool found = text_layout_line_cache_find(layout, start, &index);
+    if(found && index + 1 < layout->line_cache_count) return layout->line_cache[index + 1];
+
+    size_t next = text_layout_line_scan(layout, start, NULL);
+    if(next == start) return next;
+    if(!found) {
+        layout->line_cache_count = 0;
+        text_layout_line_cache_push(layout, start);
+    }
+    text_layout_line_cache_push(layout, next);
+    return next;
+}
+
+static size_t text_layout_line_prev(TextLayout* layout, size_t start) {
+    if(start == 0) return 0;
+
+    size_t index;
+    if(text_layout_line_cache_find(layout, start, &index) && index > 0) {
+        return layout->line_cache[index - 1];
+    }
+
+    size_t prev = text_layout_line_find(layout, start - 1);
+    text_layout_line_cache_push(layout, start);
+    return prev;
+}
+
+static bool text_layout_can_scroll_down(TextLayout* layout, uint8_t lines) {
+    size_t start = layout->top;
+    for(uint8_t i = 0; i < lines; i++) {
+        size_t next = text_layout_line_next(layout, start);
+        if(next == start) return false;
+        start = next;
+    }
+    return text_layout_line_exists(layout, start);
+}
+
+static void text_layout_measure(TextLayout* layout, Canvas* canvas) {
+    for(size_t i = 0; i < TEXT_LAYOUT_GLYPH_COUNT; i++) {
+        layout->glyph_width[i] = canvas_glyph_width(canvas, (char)i);
+    }
+    layout->measured = true;
+}
+
+void text_layout_set_glyph_widths(TextLayout* layout, const uint8_t* widths) {
+    furi_assert(layout);
+    furi_assert(widths);
+    memcpy(layout->glyph_width, widths, sizeof(layout->glyph_width));
+    layout->measured = true;
+    layout->line_cache_count = 0;
+}
+
+size_t text_layout_get_line(TextLayout* layout, size_t start, size_t* end) {
+    furi_assert(layout);
+    furi_assert(end);
+    return text_layout_line_scan(layout, start, end);
+}
+
+static void
+    text_layout_update_scrollbar(TextLayout* layout, uint8_t lines, size_t bottom, bool at_end) {
+    size_t visible = bottom - layout->top;
+
+    if(layout->top == 0 && at_end) {
+        layout->scrollbar_pos = 0;
+        layout->scrollbar_total = 0;
+        return;
+    }
+
+    // Estimate line count from bytes per line seen so far
+    uint64_t line_count =
+        (uint64_t)layout->size * layout->stats_lines / MAX(layout->stats_bytes, 1u);
+    uint64_t total = line_count > lines ? line_count - lines + 1 : 2;
+    total = CLAMP(total, (uint64_t)UINT16_MAX, 2u);
+
+    uint64_t pos = total - 1;
+    size_t last_top = layout->size > visible ? layout->size - visible : 0;
+    if(!at_end && layout->top < last_top) {
+        pos = MIN((uint64_t)layout->top * (total - 1) / last_top, total - 2);
+    }
+
+    layout->scrollbar_pos = pos;
+    layout->scrollbar_total = total;
+}
+
+void text_layout_draw(TextLayout* layout, Canvas* canvas, uint8_t x, uint8_t y, uint8_t lines) {
+    furi_assert(layout);
+    furi_assert(canvas);
+    furi_assert(lines);
+
+    canvas_set_font(canvas, layout->font);
+    if(!layout->measured) {
+        text_layout_measure(layout, canvas);
+    }
+
+    // Font or width change, top must still be a line start
+    if(layout->line_cache_count == 0) {
+        layout->top = text_layout_line_find(layout, layout->top);
+    }
+
+    if(layout->scroll_to_end) {
+        layout->top = text_layout_line_find(layout, layout->size);
+        layout->scroll = 1 - lines;
+        layout->scroll_to_end = false;
+    }
+    while(layout->scroll > 0 && text_layout_can_scroll_down(layout, lines)) {
+        layout->top = text_layout_line_next(layout, layout->top);
+        layout->scroll--;
+    }
+    while(layout->scroll < 0 && layout->top > 0) {
+        layout->top = text_layout_line_prev(layout, layout->top);
+        layout->scroll++;
+    }
+    layout->scroll = 0;
+
+    uint8_t font_height = canvas_current_font_height(canvas);
+    char chunk[TEXT_LAYOUT_DRAW_CHUNK_SIZE + 1];
+    size_t start = layout->top;
+    bool at_end = false;
+    for(uint8_t i = 0; i < lines; i++) {
+        size_t end;
+        size_t next = text_layout_line_scan_stats(layout, start, &end);
+        // Zero width glyphs make line length unbounded, it is drawn in chunks
+        uint8_t chunk_x = x;
+        uint8_t chunk_width = 0;
+        size_t len = 0;
+        for(size_t offset = start; offset < end; offset++) {
+            char symbol = text_layout_get_char(layout, offset);
+            if(symbol != '\0') {
+                chunk[len++] = symbol;
+                chunk_width += text_layout_get_glyph_width(layout, symbol);
+            }
+            if(len == TEXT_LAYOUT_DRAW_CHUNK_SIZE || (len && (!symbol || offset + 1 == end))) {
+                chunk[len] = '\0';
+                canvas_draw_str(canvas, chunk_x, y + i * font_height, chunk);
+                chunk_x += chunk_width;
+                chunk_width = 0;
+                len = 0;
+            }
+        }
+
+        if(next == start || !text_layout_line_exists(layout, next)) {
+            at_end = true;
+            start = layout->size;
+            break;
+        }
+        start = next;
+    }
+
+    text_layout_update_scrollbar(layout, lines, start, at_end);
+}
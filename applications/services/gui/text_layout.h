@@ -0,0 +1,120 @@
+/**
+ * @file text_layout.h
+ * GUI: TextLayout API
+ *
+ * Wraps text into lines of given pixel width and draws part of it. Only lines
+ * around the visible ones are laid out, recently found line starts are cached,
+ * so scrolling costs O(visible lines) regardless of text size.
+ *
+ * Text is either a string in memory or a Stream, stream is read through a small
+ * window, so files of any size are shown with bounded RAM.
+ *
+ * Lines are broken on '\n' and by width, per symbol like TextBox always did.
+ * Bytes are drawn as is with their font glyphs, line length is not limited.
+ * Very long lines are additionally broken every TEXT_LAYOUT_SEGMENT_SIZE bytes
+ * of the text, this bounds backward search when scrolling up.
+ *
+ * TextLayout is not thread safe, owner must guard it.
+ */
+
+#pragma once
+
+#include "canvas.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TEXT_LAYOUT_SEGMENT_SIZE (2048)
+
+/** TextLayout anonymous structure */
+typedef struct TextLayout TextLayout;
+
+typedef struct Stream Stream;
+
+/** Allocate TextLayout
+ *
+ * Font is FontSecondary, width is 120 pixels.
+ *
+ * @return     TextLayout instance
+ */
+TextLayout* text_layout_alloc(void);
+
+/** Free TextLayout
+ *
+ * @param      layout  TextLayout instance
+ */
+void text_layout_free(TextLayout* layout);
+
+/** Set text from memory and scroll to start
+ *
+ * @param      layout  TextLayout instance
+ * @param      text    null terminated text, must be valid while in use
+ */
+void text_layout_set_text(TextLayout* layout, const char* text);
+
+/** Set text from stream and scroll to start
+ *
+ * Stream is only seeked and read, its size is taken once here.
+ *
+ * @param      layout  TextLayout instance
+ * @param      stream  Stream instance, must be valid while in use
+ */
+void text_layout_set_stream(TextLayout* layout, Stream* stream);
+
+/** Set font
+ *
+ * @param      layout  TextLayout instance
+ * @param      font    Font
+ */
+void text_layout_set_font(TextLayout* layout, Font font);
+
+/** Set line width
+ *
+ * @param      layout  TextLayout instance
+ * @param      width   line width in pixels
+ */
+void text_layout_set_width(TextLayout* layout, uint8_t width);
+
+/** Scroll by lines
+ *
+ * Applied on next draw, scrolling stops at the first line and at the line
+ * that puts the last line at the bottom.
+ *
+ * @param      layout  TextLayout instance
+ * @param      lines   lines to scroll, negative is up
+ */
+void text_layout_scroll(TextLayout* layout, int32_t lines);
+
+/** Scroll to the last lines, applied on next draw
+ *
+ * @param      layout  TextLayout instance
+ */
+void text_layout_scroll_to_end(TextLayout* layout);
+
+/** Draw visible lines
+ *
+ * Sets layout font on canvas, line spacing is the font height.
+ *
+ * @param      layout  TextLayout instance
+ * @param      canvas  Canvas instance
+ * @param      x       x coordinate of lines
+ * @param      y       baseline of the first line
+ * @param      lines   lines on screen
+ */
+void text_layout_draw(TextLayout* layout, Canvas* canvas, uint8_t x, uint8_t y, uint8_t lines);
+
+/** Get scrollbar position as of last draw, for elements_scrollbar
+ *
+ * Line count of the whole text is not known, it is estimated from the
+ * visible part. Total is 0 when all text fits on screen.
+ *
+ * @param      layout  TextLayout instance
+ * @param      pos     scrollbar position
+ * @param      total   scrollbar total
+ */
+void text_layout_get_scrollbar(TextLayout* layout, uint16_t* pos, uint16_t* total);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,35 @@
+/**
+ * @file text_layout_i.h
+ * GUI: internal TextLayout API
+ */
+
+#pragma once
+
+#include "text_layout.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Set glyph widths instead of measuring font on next draw
+ *
+ * For laying out text without canvas, until font changes.
+ *
+ * @param      layout  TextLayout instance
+ * @param      widths  256 glyph widths, indexed by byte value
+ */
+void text_layout_set_glyph_widths(TextLayout* layout, const uint8_t* widths);
+
+/** Lay out one line
+ *
+ * @param      layout  TextLayout instance
+ * @param      start   line start
+ * @param      end     line end, without '\n'
+ *
+ * @return     next line start, same as start at the end of text
+ */
+size_t text_layout_get_line(TextLayout* layout, size_t start, size_t* end);
+
+#ifdef __cplusplus
+}
+#endif
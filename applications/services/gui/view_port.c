@@ -154,7 +154,66 @@ void view_port_input_callback_set(
 
 void view_port_update(ViewPort* view_port) {
     furi_assert(view_port);
-    if(view_port->gui && view_port->is_enabled) gui_update(view_port->gui);
+
+    FURI_CRITICAL_ENTER();
+    view_port->damaged = true;
+    view_port->damage_full = true;
+    FURI_CRITICAL_EXIT();
+
+    if(view_port->gui && view_port->is_enabled) gui_update_damage(view_port->gui);
+}
+
+void view_port_update_region(
+    ViewPort* view_port,
+    uint8_t x,
+    uint8_t y,
+    uint8_t width,
+    uint8_t height) {
+    furi_assert(view_port);
+    if(!width || !height) return;
+
+    uint8_t x1 = MIN(x + width, UINT8_MAX);
+    uint8_t y1 = MIN(y + height, UINT8_MAX);
+
+    FURI_CRITICAL_ENTER();
+    if(!view_port->damaged) {
+        view_port->damaged = true;
+        view_port->damage_x0 = x;
+        view_port->damage_y0 = y;
+        view_port->damage_x1 = x1;
+        view_port->damage_y1 = y1;
+    } else if(!view_port->damage_full) {
+        view_port->damage_x0 = MIN(view_port->damage_x0, x);
+        view_port->damage_y0 = MIN(view_port->damage_y0, y);
+        view_port->damage_x1 = MAX(view_port->damage_x1, x1);
+        view_port->damage_y1 = MAX(view_port->damage_y1, y1);
+    }
+    FURI_CRITICAL_EXIT();
+
+    if(view_port->gui && view_port->is_enabled) gui_update_damage(view_port->gui);
+}
+
+bool view_port_damage_take(
+    ViewPort* view_port,
+    bool* full,
+    uint8_t* x0,
+    uint8_t* y0,
+    uint8_t* x1,
+    uint8_t* y1) {
+    furi_assert(view_port);
+
+    FURI_CRITICAL_ENTER();
+    bool damaged = view_port->damaged;
+    *full = view_port->damage_full;
+    *x0 = view_port->damage_x0;
+    *y0 = view_port->damage_y0;
+    *x1 = view_port->damage_x1;
+    *y1 = view_port->damage_y1;
+    view_port->damaged = false;
+    view_port->damage_full = false;
+    FURI_CRITICAL_EXIT();
+
+    return damaged;
 }
 
 void view_port_gui_set(ViewPort* view_port, Gui* gui) {
@@ -97,6 +97,25 @@ void view_port_input_callback_set(
  */
 void view_port_update(ViewPort* view_port);
 
+/** Emit update signal for a region of view port to GUI system.
+ *
+ * Same as view_port_update, but GUI may redraw and send to display only the
+ * region. Draw callback is still called, drawing outside of the region is
+ * discarded. Use when the rest of the view port didn't change.
+ *
+ * @param      view_port  ViewPort instance
+ * @param      x          x coordinate of the region
+ * @param      y          y coordinate of the region
+ * @param      width      width of the region
+ * @param      height     height of the region
+ */
+void view_port_update_region(
+    ViewPort* view_port,
+    uint8_t x,
+    uint8_t y,
+    uint8_t width,
+    uint8_t height);
+
 /** Set ViewPort orientation.
  *
  * @param      view_port    ViewPort instance
@@ -21,6 +21,14 @@ struct ViewPort {
 
     ViewPortInputCallback input_callback;
     void* input_callback_context;
+
+    // Damage since last redraw, in view port coordinates
+    bool damaged;
+    bool damage_full;
+    uint8_t damage_x0;
+    uint8_t damage_y0;
+    uint8_t damage_x1;
+    uint8_t damage_y1;
 };
 
 /** Set GUI reference.
@@ -41,6 +49,27 @@ void view_port_gui_set(ViewPort* view_port, Gui* gui);
  */
 void view_port_draw(ViewPort* view_port, Canvas* canvas);
 
+/** Take damage reported since last call
+ *
+ * To be used by GUI, called on tree redraw.
+ *
+ * @param      view_port  ViewPort instance
+ * @param      full       set to true if whole view port is damaged
+ * @param      x0         left edge of damaged region
+ * @param      y0         top edge of damaged region
+ * @param      x1         right edge of damaged region, excluded
+ * @param      y1         bottom edge of damaged region, excluded
+ *
+ * @return     true if view port was damaged
+ */
+bool view_port_damage_take(
+    ViewPort* view_port,
+    bool* full,
+    uint8_t* x0,
+    uint8_t* y0,
+    uint8_t* x1,
+    uint8_t* y1);
+
 /** Process input. Calls input callback.
  *
  * To be used by GUI, called on input dispatch.
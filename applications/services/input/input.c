@@ -72,7 +72,7 @@ int32_t input_srv(void* p) {
     UNUSED(p);
     input = malloc(sizeof(Input));
     input->thread_id = furi_thread_get_current_id();
-    input->event_pubsub = furi_pubsub_alloc();
+    input->event_pubsub = furi_pubsub_alloc_ex(sizeof(InputEvent), INPUT_EVENT_QUEUE_SIZE);
     furi_record_create(RECORD_INPUT_EVENTS, input->event_pubsub);
 
 #if INPUT_DEBUG
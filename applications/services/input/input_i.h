@@ -17,6 +17,7 @@
 #define INPUT_PRESS_TICKS 150
 #define INPUT_LONG_PRESS_COUNTS 2
 #define INPUT_THREAD_FLAG_ISR 0x00000001
+#define INPUT_EVENT_QUEUE_SIZE 16
 
 /** Input pin state */
 typedef struct {
@@ -10,14 +10,22 @@
 
 static_assert(!has_hash_collisions(elf_api_table), "Detected API method hash collision!");
 
-constexpr HashtableApiInterface elf_api_interface{
+static constexpr auto elf_api_index = make_api_hashtable_index(elf_api_table);
+
+constexpr BucketedHashtableApiInterface elf_api_interface{
     {
-        .api_version_major = (elf_api_version >> 16),
-        .api_version_minor = (elf_api_version & 0xFFFF),
-        .resolver_callback = &elf_resolve_from_hashtable,
+        {
+            .api_version_major = (elf_api_version >> 16),
+            .api_version_minor = (elf_api_version & 0xFFFF),
+            .resolver_callback = &elf_resolve_from_bucketed_hashtable,
+        },
+        .table_cbegin = elf_api_table.cbegin(),
+        .table_cend = elf_api_table.cend(),
     },
-    .table_cbegin = elf_api_table.cbegin(),
-    .table_cend = elf_api_table.cend(),
+    .buckets = elf_api_index.buckets.data(),
+    .bucket_shift = elf_api_index.bucket_shift,
+    .bloom = elf_api_index.bloom.data(),
+    .bloom_mask = elf_api_index.bloom_words - 1,
 };
 
 const ElfApiInterface* const firmware_api_interface = &elf_api_interface;
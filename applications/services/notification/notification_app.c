@@ -472,7 +472,9 @@ static NotificationApp* notification_app_alloc() {
 
     // display backlight control
     app->event_record = furi_record_open(RECORD_INPUT_EVENTS);
-    furi_pubsub_subscribe(app->event_record, input_event_callback, app);
+    // Async, so a full notification queue never holds up input delivery
+    furi_pubsub_subscribe_ex(
+        app->event_record, input_event_callback, app, FuriPubSubDeliveryAsync);
     notification_message(app, &sequence_display_backlight_on);
 
     return app;
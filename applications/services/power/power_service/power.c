@@ -322,7 +322,7 @@ Power* power_alloc() {
     power->gui = furi_record_open(RECORD_GUI);
 
     // Pubsub
-    power->event_pubsub = furi_pubsub_alloc();
+    power->event_pubsub = furi_pubsub_alloc_ex(sizeof(PowerEvent), POWER_EVENT_QUEUE_SIZE);
     power->settings_events = furi_pubsub_alloc();
     power->loader = furi_record_open(RECORD_LOADER);
     power->input_events_pubsub = furi_record_open(RECORD_INPUT_EVENTS);
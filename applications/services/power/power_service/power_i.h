@@ -16,6 +16,7 @@
 #include <notification/notification_messages.h>
 
 #define POWER_BATTERY_HEALTHY_LEVEL 70
+#define POWER_EVENT_QUEUE_SIZE 8
 
 typedef enum {
     PowerStateNotCharging,
@@ -20,6 +20,7 @@ typedef enum {
     FSOM_OPEN_APPEND = 4, /**< Open file. Create new file if not exist. Set R/W pointer to EOF */
     FSOM_CREATE_NEW = 8, /**< Creates a new file. Fails if the file is exist */
     FSOM_CREATE_ALWAYS = 16, /**< Creates a new file. If file exist, truncate to zero size */
+    FSOM_FAST_SEEK = 32, /**< Flag: map clusters of read only SD file for fast seeks */
 } FS_OpenMode;
 
 /** API errors enumeration */
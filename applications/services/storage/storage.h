@@ -1,5 +1,6 @@
 #pragma once
 #include <stdint.h>
+#include <stddef.h>
 #include "filesystem_api_defines.h"
 #include "storage_sd_api.h"
 
@@ -54,6 +55,21 @@ typedef struct {
  */
 FuriPubSub* storage_get_pubsub(Storage* storage);
 
+/** Buffer description for storage_file_readv and storage_file_writev */
+typedef struct {
+    void* buff;
+    uint16_t size;
+} StorageIoVec;
+
+/** Directory entry filled by storage_dir_read_batch */
+typedef struct {
+    FileInfo fileinfo;
+    const char* name; /**< null terminated, points into caller names buffer */
+} StorageDirEntry;
+
+/** Names buffer space needed for one entry in storage_dir_read_batch */
+#define STORAGE_DIR_BATCH_NAME_MAX (256)
+
 /******************* File Functions *******************/
 
 /** Opens an existing file or create a new one.
@@ -161,6 +177,118 @@ bool storage_file_exists(Storage* storage, const char* path);
  */
 bool storage_file_copy_to_file(File* source, File* destination, uint32_t size);
 
+/** Reads bytes from a file into several buffers in one request
+ * Buffers are filled in order, reading stops on first short read or error.
+ * @param file pointer to file object.
+ * @param iov buffers to fill
+ * @param iov_count buffers count
+ * @return size_t total number of bytes read
+ */
+size_t storage_file_readv(File* file, const StorageIoVec* iov, size_t iov_count);
+
+/** Writes bytes from several buffers to a file in one request
+ * Buffers are written in order, writing stops on first short write or error.
+ * @param file pointer to file object.
+ * @param iov buffers to write
+ * @param iov_count buffers count
+ * @return size_t total number of bytes written
+ */
+size_t storage_file_writev(File* file, const StorageIoVec* iov, size_t iov_count);
+
+/** Opens an existing file, reads it from the start and closes it in one request
+ * Meant for small files, reads up to size bytes. Waits if the file is already open.
+ * @param storage pointer to the api
+ * @param path path to file
+ * @param buff buffer to read into
+ * @param size buffer size
+ * @param bytes_read number of bytes read, may be NULL
+ * @return FS_Error operation result
+ */
+FS_Error storage_file_load(
+    Storage* storage,
+    const char* path,
+    void* buff,
+    size_t size,
+    size_t* bytes_read);
+
+/******************* Async File Functions *******************/
+
+/** Asynchronous file request, reusable once completed */
+typedef struct StorageAsyncRequest StorageAsyncRequest;
+
+/** Completion callback, called from the storage thread
+ * Must be short and must not call storage API, including submitting requests.
+ */
+typedef void (*StorageAsyncCallback)(StorageAsyncRequest* request, void* context);
+
+/** Allocates an asynchronous request for an open file
+ * Several requests may be in flight for one file, the storage thread processes
+ * them in submission order. The file must stay open until all of them complete.
+ * @param file pointer to file object.
+ * @return StorageAsyncRequest* request instance
+ */
+StorageAsyncRequest* storage_async_request_alloc(File* file);
+
+/** Frees the request, it must not be pending
+ * @param request request instance
+ */
+void storage_async_request_free(StorageAsyncRequest* request);
+
+/** Sets completion callback, must not be pending
+ * @param request request instance
+ * @param callback callback, may be NULL
+ * @param context callback context
+ */
+void storage_async_request_set_callback(
+    StorageAsyncRequest* request,
+    StorageAsyncCallback callback,
+    void* context);
+
+/** Submits a read, returns without waiting
+ * @param request request instance, must not be pending
+ * @param buff buffer to read into, must be valid until completion
+ * @param bytes_to_read number of bytes to read
+ */
+void storage_file_read_async(StorageAsyncRequest* request, void* buff, uint16_t bytes_to_read);
+
+/** Submits a write, returns without waiting
+ * @param request request instance, must not be pending
+ * @param buff buffer to write, must be valid until completion
+ * @param bytes_to_write number of bytes to write
+ */
+void storage_file_write_async(
+    StorageAsyncRequest* request,
+    const void* buff,
+    uint16_t bytes_to_write);
+
+/** Tells if the request is submitted and not completed yet
+ * @param request request instance
+ * @return bool pending flag
+ */
+bool storage_async_request_is_pending(StorageAsyncRequest* request);
+
+/** Waits for the request to complete
+ * @param request request instance
+ * @param timeout timeout in ticks
+ * @return bool true if the request is completed, false on timeout
+ */
+bool storage_async_request_wait(StorageAsyncRequest* request, uint32_t timeout);
+
+/** Gets the number of bytes transferred by the last completed request
+ * Also valid in completion callback.
+ * @param request request instance
+ * @return uint16_t bytes read or written
+ */
+uint16_t storage_async_request_get_bytes(StorageAsyncRequest* request);
+
+/** Gets the error of the last completed request
+ * File error id is shared by all requests of the file, this one is not.
+ * Also valid in completion callback.
+ * @param request request instance
+ * @return FS_Error error id
+ */
+FS_Error storage_async_request_get_error(StorageAsyncRequest* request);
+
 /******************* Dir Functions *******************/
 
 /** Opens a directory to get objects from it
@@ -186,6 +314,24 @@ bool storage_dir_close(File* file);
  */
 bool storage_dir_read(File* file, FileInfo* fileinfo, char* name, uint16_t name_length);
 
+/** Reads several next objects in the directory in one request
+ * Names are packed one after another into names buffer, reading stops when
+ * less than STORAGE_DIR_BATCH_NAME_MAX bytes are left in it.
+ * @param file pointer to file object.
+ * @param entries entries to fill
+ * @param count entries count
+ * @param names names buffer, at least STORAGE_DIR_BATCH_NAME_MAX bytes
+ * @param names_size names buffer size
+ * @return size_t number of entries read. File error id is FSE_OK if more objects may follow,
+ * FSE_NOT_EXIST if the end of directory is reached, entries read before it are still valid.
+ */
+size_t storage_dir_read_batch(
+    File* file,
+    StorageDirEntry* entries,
+    size_t count,
+    char* names,
+    size_t names_size);
+
 /** Rewinds the read pointer to first item in the directory
  * @param file pointer to file object.
  * @return bool success flag
@@ -221,6 +367,21 @@ FS_Error storage_common_timestamp(Storage* storage, const char* path, uint32_t*
  */
 FS_Error storage_common_stat(Storage* storage, const char* path, FileInfo* fileinfo);
 
+/** Retrieves information about several files/directories in one request
+ * @param storage pointer to the api
+ * @param paths paths to files/directories
+ * @param fileinfos FileInfo array to fill, may be NULL
+ * @param errors FS_Error array to fill with result for each path
+ * @param count paths count
+ * @return size_t number of paths with FSE_OK result
+ */
+size_t storage_common_stat_batch(
+    Storage* storage,
+    const char* const* paths,
+    FileInfo* fileinfos,
+    FS_Error* errors,
+    size_t count);
+
 /** Removes a file/directory from the repository, the directory must be empty and the file/directory must not be open
  * @param app pointer to the api
  * @param path 
@@ -8,6 +8,7 @@
 #include <storage/storage.h>
 #include <storage/storage_sd_api.h>
 #include <power/power_service/power.h>
+#include <sector_cache.h>
 
 #define MAX_NAME_LENGTH 255
 
@@ -80,6 +81,18 @@ static void storage_cli_info(Cli* cli, FuriString* path) {
                 sd_info.product_serial_number,
                 sd_info.manufacturing_month,
                 sd_info.manufacturing_year);
+
+            SectorCacheStats cache_stats;
+            sector_cache_get_stats(&cache_stats);
+            printf(
+                "Cache: %lu sectors, %lu hits, %lu misses, %lu evictions\r\n"
+                "Read-ahead: %lu sectors, %lu hits\r\n",
+                cache_stats.sectors,
+                cache_stats.hits,
+                cache_stats.misses,
+                cache_stats.evictions,
+                cache_stats.read_ahead,
+                cache_stats.read_ahead_hits);
         }
     } else {
         storage_cli_print_usage();
@@ -43,6 +43,7 @@
 #define S_RETURN_BOOL (return_data.bool_value);
 #define S_RETURN_UINT16 (return_data.uint16_value);
 #define S_RETURN_UINT64 (return_data.uint64_value);
+#define S_RETURN_SIZE (return_data.size_value);
 #define S_RETURN_ERROR (return_data.error_value);
 #define S_RETURN_CSTRING (return_data.cstring_value);
 
@@ -179,6 +180,46 @@ uint16_t storage_file_write(File* file, const void* buff, uint16_t bytes_to_writ
     return S_RETURN_UINT16;
 }
 
+size_t storage_file_readv(File* file, const StorageIoVec* iov, size_t iov_count) {
+    if(iov_count == 0) {
+        return 0;
+    }
+
+    S_FILE_API_PROLOGUE;
+    S_API_PROLOGUE;
+
+    SAData data = {
+        .fiovec = {
+            .file = file,
+            .iov = iov,
+            .iov_count = iov_count,
+        }};
+
+    S_API_MESSAGE(StorageCommandFileReadV);
+    S_API_EPILOGUE;
+    return S_RETURN_SIZE;
+}
+
+size_t storage_file_writev(File* file, const StorageIoVec* iov, size_t iov_count) {
+    if(iov_count == 0) {
+        return 0;
+    }
+
+    S_FILE_API_PROLOGUE;
+    S_API_PROLOGUE;
+
+    SAData data = {
+        .fiovec = {
+            .file = file,
+            .iov = iov,
+            .iov_count = iov_count,
+        }};
+
+    S_API_MESSAGE(StorageCommandFileWriteV);
+    S_API_EPILOGUE;
+    return S_RETURN_SIZE;
+}
+
 bool storage_file_seek(File* file, uint32_t offset, bool from_start) {
     S_FILE_API_PROLOGUE;
     S_API_PROLOGUE;
@@ -240,6 +281,63 @@ bool storage_file_eof(File* file) {
     return S_RETURN_BOOL;
 }
 
+static FS_Error storage_file_load_internal(
+    Storage* storage,
+    const char* path,
+    void* buff,
+    size_t size,
+    size_t* bytes_read) {
+    S_API_PROLOGUE;
+
+    SAData data = {
+        .fload = {
+            .path = path,
+            .buff = buff,
+            .size = size,
+            .bytes_read = bytes_read,
+            .thread_id = furi_thread_get_current_id(),
+        }};
+
+    S_API_MESSAGE(StorageCommandFileLoad);
+    S_API_EPILOGUE;
+    return S_RETURN_ERROR;
+}
+
+FS_Error storage_file_load(
+    Storage* storage,
+    const char* path,
+    void* buff,
+    size_t size,
+    size_t* bytes_read) {
+    FS_Error error;
+    size_t read = 0;
+    FuriEventFlag* event = furi_event_flag_alloc();
+    FuriPubSubSubscription* subscription =
+        furi_pubsub_subscribe(storage_get_pubsub(storage), storage_file_close_callback, event);
+
+    do {
+        error = storage_file_load_internal(storage, path, buff, size, &read);
+
+        if(error == FSE_ALREADY_OPEN) {
+            furi_event_flag_wait(
+                event, StorageEventFlagFileClose, FuriFlagWaitAny, FuriWaitForever);
+        } else {
+            break;
+        }
+    } while(true);
+
+    furi_pubsub_unsubscribe(storage_get_pubsub(storage), subscription);
+    furi_event_flag_free(event);
+
+    FURI_LOG_T(TAG, "File load (%s): %u bytes", path, read);
+
+    if(bytes_read != NULL) {
+        *bytes_read = read;
+    }
+
+    return error;
+}
+
 bool storage_file_exists(Storage* storage, const char* path) {
     bool exist = false;
     FileInfo fileinfo;
@@ -272,6 +370,94 @@ bool storage_file_copy_to_file(File* source, File* destination, uint32_t size) {
     return size == 0;
 }
 
+/****************** ASYNC ******************/
+
+StorageAsyncRequest* storage_async_request_alloc(File* file) {
+    StorageAsyncRequest* request = malloc(sizeof(StorageAsyncRequest));
+    request->file = file;
+    request->bytes = 0;
+    request->error = FSE_OK;
+    request->callback = NULL;
+    request->context = NULL;
+    request->event = furi_event_flag_alloc();
+    furi_event_flag_set(request->event, STORAGE_ASYNC_FLAG_DONE);
+    return request;
+}
+
+void storage_async_request_free(StorageAsyncRequest* request) {
+    furi_check(!storage_async_request_is_pending(request));
+    furi_event_flag_free(request->event);
+    free(request);
+}
+
+void storage_async_request_set_callback(
+    StorageAsyncRequest* request,
+    StorageAsyncCallback callback,
+    void* context) {
+    furi_check(!storage_async_request_is_pending(request));
+    request->callback = callback;
+    request->context = context;
+}
+
+static void storage_async_request_submit(StorageAsyncRequest* request, StorageCommand command) {
+    Storage* storage = request->file->storage;
+    furi_assert(storage);
+
+    StorageMessage message = {
+        .lock = NULL,
+        .command = command,
+        .data = &request->data,
+        .return_data = &request->return_data,
+        .async = request,
+    };
+
+    furi_event_flag_clear(request->event, STORAGE_ASYNC_FLAG_DONE);
+    furi_check(
+        furi_message_queue_put(storage->message_queue, &message, FuriWaitForever) ==
+        FuriStatusOk);
+}
+
+void storage_file_read_async(StorageAsyncRequest* request, void* buff, uint16_t bytes_to_read) {
+    furi_check(!storage_async_request_is_pending(request));
+
+    request->data.fread.file = request->file;
+    request->data.fread.buff = buff;
+    request->data.fread.bytes_to_read = bytes_to_read;
+
+    storage_async_request_submit(request, StorageCommandFileRead);
+}
+
+void storage_file_write_async(
+    StorageAsyncRequest* request,
+    const void* buff,
+    uint16_t bytes_to_write) {
+    furi_check(!storage_async_request_is_pending(request));
+
+    request->data.fwrite.file = request->file;
+    request->data.fwrite.buff = buff;
+    request->data.fwrite.bytes_to_write = bytes_to_write;
+
+    storage_async_request_submit(request, StorageCommandFileWrite);
+}
+
+bool storage_async_request_is_pending(StorageAsyncRequest* request) {
+    return !(furi_event_flag_get(request->event) & STORAGE_ASYNC_FLAG_DONE);
+}
+
+bool storage_async_request_wait(StorageAsyncRequest* request, uint32_t timeout) {
+    uint32_t flags = furi_event_flag_wait(
+        request->event, STORAGE_ASYNC_FLAG_DONE, FuriFlagWaitAny | FuriFlagNoClear, timeout);
+    return !(flags & FuriFlagError);
+}
+
+uint16_t storage_async_request_get_bytes(StorageAsyncRequest* request) {
+    return request->bytes;
+}
+
+FS_Error storage_async_request_get_error(StorageAsyncRequest* request) {
+    return request->error;
+}
+
 /****************** DIR ******************/
 
 static bool storage_dir_open_internal(File* file, const char* path) {
@@ -357,6 +543,31 @@ bool storage_dir_read(File* file, FileInfo* fileinfo, char* name, uint16_t name_
     return S_RETURN_BOOL;
 }
 
+size_t storage_dir_read_batch(
+    File* file,
+    StorageDirEntry* entries,
+    size_t count,
+    char* names,
+    size_t names_size) {
+    furi_check(names_size >= STORAGE_DIR_BATCH_NAME_MAX);
+
+    S_FILE_API_PROLOGUE;
+    S_API_PROLOGUE;
+
+    SAData data = {
+        .dreadbatch = {
+            .file = file,
+            .entries = entries,
+            .count = count,
+            .names = names,
+            .names_size = names_size,
+        }};
+
+    S_API_MESSAGE(StorageCommandDirReadBatch);
+    S_API_EPILOGUE;
+    return S_RETURN_SIZE;
+}
+
 bool storage_dir_rewind(File* file) {
     S_FILE_API_PROLOGUE;
     S_API_PROLOGUE;
@@ -408,6 +619,31 @@ FS_Error storage_common_stat(Storage* storage, const char* path, FileInfo* filei
     return S_RETURN_ERROR;
 }
 
+size_t storage_common_stat_batch(
+    Storage* storage,
+    const char* const* paths,
+    FileInfo* fileinfos,
+    FS_Error* errors,
+    size_t count) {
+    if(count == 0) {
+        return 0;
+    }
+
+    S_API_PROLOGUE;
+    SAData data = {
+        .cstatbatch = {
+            .paths = paths,
+            .fileinfos = fileinfos,
+            .errors = errors,
+            .count = count,
+            .thread_id = furi_thread_get_current_id(),
+        }};
+
+    S_API_MESSAGE(StorageCommandCommonStatBatch);
+    S_API_EPILOGUE;
+    return S_RETURN_SIZE;
+}
+
 FS_Error storage_common_remove(Storage* storage, const char* path) {
     S_API_PROLOGUE;
     SAData data = {
@@ -32,6 +32,20 @@ typedef struct {
     bool from_start;
 } SADataFSeek;
 
+typedef struct {
+    File* file;
+    const StorageIoVec* iov;
+    size_t iov_count;
+} SADataFIoVec;
+
+typedef struct {
+    const char* path;
+    void* buff;
+    size_t size;
+    size_t* bytes_read;
+    FuriThreadId thread_id;
+} SADataFLoad;
+
 typedef struct {
     File* file;
     const char* path;
@@ -45,6 +59,14 @@ typedef struct {
     uint16_t name_length;
 } SADataDRead;
 
+typedef struct {
+    File* file;
+    StorageDirEntry* entries;
+    size_t count;
+    char* names;
+    size_t names_size;
+} SADataDReadBatch;
+
 typedef struct {
     const char* path;
     uint32_t* timestamp;
@@ -57,6 +79,14 @@ typedef struct {
     FuriThreadId thread_id;
 } SADataCStat;
 
+typedef struct {
+    const char* const* paths;
+    FileInfo* fileinfos;
+    FS_Error* errors;
+    size_t count;
+    FuriThreadId thread_id;
+} SADataCStatBatch;
+
 typedef struct {
     const char* fs_path;
     uint64_t* total_space;
@@ -97,12 +127,16 @@ typedef union {
     SADataFRead fread;
     SADataFWrite fwrite;
     SADataFSeek fseek;
+    SADataFIoVec fiovec;
+    SADataFLoad fload;
 
     SADataDOpen dopen;
     SADataDRead dread;
+    SADataDReadBatch dreadbatch;
 
     SADataCTimestamp ctimestamp;
     SADataCStat cstat;
+    SADataCStatBatch cstatbatch;
     SADataCFSInfo cfsinfo;
     SADataCResolvePath cresolvepath;
 
@@ -119,6 +153,7 @@ typedef union {
     bool bool_value;
     uint16_t uint16_value;
     uint64_t uint64_value;
+    size_t size_value;
     FS_Error error_value;
     const char* cstring_value;
 } SAReturn;
@@ -149,13 +184,32 @@ typedef enum {
     StorageCommandSDInfo,
     StorageCommandSDStatus,
     StorageCommandCommonResolvePath,
+    StorageCommandFileReadV,
+    StorageCommandFileWriteV,
+    StorageCommandFileLoad,
+    StorageCommandDirReadBatch,
+    StorageCommandCommonStatBatch,
 } StorageCommand;
 
+#define STORAGE_ASYNC_FLAG_DONE (1 << 0)
+
+struct StorageAsyncRequest {
+    File* file;
+    SAData data;
+    SAReturn return_data;
+    uint16_t bytes;
+    FS_Error error;
+    StorageAsyncCallback callback;
+    void* context;
+    FuriEventFlag* event; /**< STORAGE_ASYNC_FLAG_DONE is set while not pending */
+};
+
 typedef struct {
     FuriApiLock lock;
     StorageCommand command;
     SAData* data;
     SAReturn* return_data;
+    StorageAsyncRequest* async; /**< completed instead of unlocking if not NULL */
 } StorageMessage;
 
 #ifdef __cplusplus
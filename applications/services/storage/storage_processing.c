@@ -528,8 +528,133 @@ void storage_process_alias(
     }
 }
 
+/******************* Batched Functions *******************/
+
+static size_t storage_process_file_readv(
+    Storage* app,
+    File* file,
+    const StorageIoVec* iov,
+    const size_t iov_count) {
+    size_t ret = 0;
+
+    for(size_t i = 0; i < iov_count; i++) {
+        uint16_t read = storage_process_file_read(app, file, iov[i].buff, iov[i].size);
+        ret += read;
+        if(read != iov[i].size || file->error_id != FSE_OK) break;
+    }
+
+    return ret;
+}
+
+static size_t storage_process_file_writev(
+    Storage* app,
+    File* file,
+    const StorageIoVec* iov,
+    const size_t iov_count) {
+    size_t ret = 0;
+
+    for(size_t i = 0; i < iov_count; i++) {
+        uint16_t written = storage_process_file_write(app, file, iov[i].buff, iov[i].size);
+        ret += written;
+        if(written != iov[i].size || file->error_id != FSE_OK) break;
+    }
+
+    return ret;
+}
+
+static FS_Error storage_process_file_load(
+    Storage* app,
+    FuriString* path,
+    void* buff,
+    const size_t size,
+    size_t* bytes_read) {
+    // Lives only within this request, caller never sees it
+    File file = {
+        .type = FileTypeOpenFile,
+        .storage = app,
+    };
+
+    *bytes_read = 0;
+    storage_process_file_open(app, &file, path, FSAM_READ, FSOM_OPEN_EXISTING);
+    FS_Error ret = file.error_id;
+    if(ret == FSE_ALREADY_OPEN) {
+        return ret;
+    }
+
+    while(ret == FSE_OK && *bytes_read < size) {
+        uint16_t to_read = MIN(size - *bytes_read, (size_t)UINT16_MAX);
+        uint16_t read =
+            storage_process_file_read(app, &file, (uint8_t*)buff + *bytes_read, to_read);
+        ret = file.error_id;
+        *bytes_read += read;
+        if(read != to_read) break;
+    }
+
+    storage_process_file_close(app, &file);
+
+    return ret;
+}
+
+static size_t storage_process_dir_read_batch(
+    Storage* app,
+    File* file,
+    StorageDirEntry* entries,
+    const size_t count,
+    char* names,
+    const size_t names_size) {
+    size_t ret = 0;
+    size_t names_used = 0;
+
+    while(ret < count && names_size - names_used >= STORAGE_DIR_BATCH_NAME_MAX) {
+        char* name = names + names_used;
+        if(!storage_process_dir_read(
+               app, file, &entries[ret].fileinfo, name, STORAGE_DIR_BATCH_NAME_MAX)) {
+            break;
+        }
+
+        entries[ret].name = name;
+        names_used += strlen(name) + 1;
+        ret++;
+    }
+
+    return ret;
+}
+
+static size_t storage_process_common_stat_batch(
+    Storage* app,
+    const char* const* paths,
+    FileInfo* fileinfos,
+    FS_Error* errors,
+    const size_t count,
+    FuriThreadId thread_id) {
+    size_t ret = 0;
+    FuriString* path = furi_string_alloc();
+
+    for(size_t i = 0; i < count; i++) {
+        furi_string_set(path, paths[i]);
+        storage_process_alias(app, path, thread_id, false);
+        errors[i] = storage_process_common_stat(app, path, fileinfos ? &fileinfos[i] : NULL);
+        if(errors[i] == FSE_OK) ret++;
+    }
+
+    furi_string_free(path);
+    return ret;
+}
+
 /****************** API calls processing ******************/
 
+static void storage_process_async_complete(StorageAsyncRequest* request) {
+    request->bytes = request->return_data.uint16_value;
+    request->error = request->file->error_id;
+
+    if(request->callback) {
+        request->callback(request, request->context);
+    }
+
+    // Last touch, request may be freed right after
+    furi_event_flag_set(request->event, STORAGE_ASYNC_FLAG_DONE);
+}
+
 void storage_process_message_internal(Storage* app, StorageMessage* message) {
     FuriString* path = NULL;
     FuriString* opath = NULL;
@@ -590,6 +715,30 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
     case StorageCommandFileEof:
         message->return_data->bool_value = storage_process_file_eof(app, message->data->file.file);
         break;
+    case StorageCommandFileReadV:
+        message->return_data->size_value = storage_process_file_readv(
+            app,
+            message->data->fiovec.file,
+            message->data->fiovec.iov,
+            message->data->fiovec.iov_count);
+        break;
+    case StorageCommandFileWriteV:
+        message->return_data->size_value = storage_process_file_writev(
+            app,
+            message->data->fiovec.file,
+            message->data->fiovec.iov,
+            message->data->fiovec.iov_count);
+        break;
+    case StorageCommandFileLoad:
+        path = furi_string_alloc_set(message->data->fload.path);
+        storage_process_alias(app, path, message->data->fload.thread_id, false);
+        message->return_data->error_value = storage_process_file_load(
+            app,
+            path,
+            message->data->fload.buff,
+            message->data->fload.size,
+            message->data->fload.bytes_read);
+        break;
 
     // Dir operations
     case StorageCommandDirOpen:
@@ -614,6 +763,15 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
         message->return_data->bool_value =
             storage_process_dir_rewind(app, message->data->file.file);
         break;
+    case StorageCommandDirReadBatch:
+        message->return_data->size_value = storage_process_dir_read_batch(
+            app,
+            message->data->dreadbatch.file,
+            message->data->dreadbatch.entries,
+            message->data->dreadbatch.count,
+            message->data->dreadbatch.names,
+            message->data->dreadbatch.names_size);
+        break;
 
     // Common operations
     case StorageCommandCommonTimestamp:
@@ -628,6 +786,15 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
         message->return_data->error_value =
             storage_process_common_stat(app, path, message->data->cstat.fileinfo);
         break;
+    case StorageCommandCommonStatBatch:
+        message->return_data->size_value = storage_process_common_stat_batch(
+            app,
+            message->data->cstatbatch.paths,
+            message->data->cstatbatch.fileinfos,
+            message->data->cstatbatch.errors,
+            message->data->cstatbatch.count,
+            message->data->cstatbatch.thread_id);
+        break;
     case StorageCommandCommonRemove:
         path = furi_string_alloc_set(message->data->path.path);
         storage_process_alias(app, path, message->data->path.thread_id, false);
@@ -687,7 +854,11 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
         furi_string_free(opath);
     }
 
-    api_lock_unlock(message->lock);
+    if(message->async != NULL) {
+        storage_process_async_complete(message->async);
+    } else {
+        api_lock_unlock(message->lock);
+    }
 }
 
 void storage_process_message(Storage* app, StorageMessage* message) {
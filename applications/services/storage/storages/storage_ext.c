@@ -12,6 +12,10 @@ typedef FRESULT SDError;
 
 #define TAG "StorageExt"
 
+// Cluster link map table size in DWORDs: 2 per fragment plus 2, files more fragmented seek slowly
+#define STORAGE_EXT_CLMT_SIZE_MIN 16
+#define STORAGE_EXT_CLMT_SIZE_MAX 256
+
 /********************* Definitions ********************/
 
 typedef struct {
@@ -306,6 +310,32 @@ static FS_Error storage_ext_parse_error(SDError error) {
 
 /******************* File Functions *******************/
 
+static void storage_ext_file_map_clusters(SDFile* file_data) {
+    DWORD size = STORAGE_EXT_CLMT_SIZE_MIN;
+
+    while(true) {
+        DWORD* table = malloc(size * sizeof(DWORD));
+        table[0] = size;
+        file_data->cltbl = table;
+
+        SDError error = f_lseek(file_data, CREATE_LINKMAP);
+        if(error == FR_OK) {
+            FURI_LOG_D(TAG, "Cluster map: %lu fragments", (table[0] - 2) / 2);
+            break;
+        }
+
+        // On FR_NOT_ENOUGH_CORE table[0] holds required size
+        DWORD required = table[0];
+        free(table);
+        file_data->cltbl = NULL;
+        if(error != FR_NOT_ENOUGH_CORE || required > STORAGE_EXT_CLMT_SIZE_MAX) {
+            FURI_LOG_D(TAG, "Cluster map: not used, %d", error);
+            break;
+        }
+        size = required;
+    }
+}
+
 static bool storage_ext_file_open(
     void* ctx,
     File* file,
@@ -324,10 +354,18 @@ static bool storage_ext_file_open(
     if(open_mode & FSOM_CREATE_ALWAYS) _mode |= FA_CREATE_ALWAYS;
 
     SDFile* file_data = malloc(sizeof(SDFile));
+    file_data->cltbl = NULL;
     storage_set_storage_file_data(file, file_data, storage);
 
     file->internal_error_id = f_open(file_data, path, _mode);
     file->error_id = storage_ext_parse_error(file->internal_error_id);
+
+    // Fast seek can not extend files, so it is for read only access
+    if(file->error_id == FSE_OK && (open_mode & FSOM_FAST_SEEK) && !(access_mode & FSAM_WRITE) &&
+       f_size(file_data) > 0) {
+        storage_ext_file_map_clusters(file_data);
+    }
+
     return (file->error_id == FSE_OK);
 }
 
@@ -336,6 +374,7 @@ static bool storage_ext_file_close(void* ctx, File* file) {
     SDFile* file_data = storage_get_storage_file_data(file, storage);
     file->internal_error_id = f_close(file_data);
     file->error_id = storage_ext_parse_error(file->internal_error_id);
+    free(file_data->cltbl);
     free(file_data);
     storage_set_storage_file_data(file, NULL, storage);
     return (file->error_id == FSE_OK);
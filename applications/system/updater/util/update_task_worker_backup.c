@@ -12,6 +12,7 @@
 #include <update_util/resources/manifest.h>
 #include <toolbox/tar/tar_archive.h>
 #include <toolbox/crc32_calc.h>
+#include <m-array.h>
 
 #define XFWFIRSTBOOT_FLAG_PATH CFG_PATH("xfwfirstboot.flag")
 
@@ -51,9 +52,13 @@ typedef enum {
 
 #define UPDATE_TASK_RESOURCES_FILE_TO_TOTAL_PERCENT 90
 
+/* Unpacked file record, CRC32 of name in upper half and MD5 prefix in lower one */
+ARRAY_DEF(ResourceHashArray, uint64_t, M_POD_OPLIST);
+
 typedef struct {
     UpdateTask* update_task;
     int32_t total_files, processed_files;
+    ResourceHashArray_t hashes;
 } TarUnpackProgress;
 
 static bool update_task_resource_unpack_cb(const char* name, bool is_directory, void* context) {
@@ -71,6 +76,81 @@ static bool update_task_resource_unpack_cb(const char* name, bool is_directory,
     return true;
 }
 
+static uint64_t update_task_resource_hash_key(const char* name, const uint8_t* md5) {
+    uint32_t md5_prefix;
+    memcpy(&md5_prefix, md5, sizeof(md5_prefix));
+    return ((uint64_t)crc32_calc_buffer(0, name, strlen(name)) << 32) | md5_prefix;
+}
+
+static bool update_task_resource_hash_cb(const char* name, const uint8_t* md5, void* context) {
+    TarUnpackProgress* unpack_progress = context;
+    ResourceHashArray_push_back(unpack_progress->hashes, update_task_resource_hash_key(name, md5));
+    return true;
+}
+
+static int update_task_resource_hash_compare(const void* a, const void* b) {
+    const uint64_t left = *(const uint64_t*)a;
+    const uint64_t right = *(const uint64_t*)b;
+    return (left > right) - (left < right);
+}
+
+/* Check MD5 of unpacked files against new manifest. Files missing from manifest are not
+ * checked, bundle may have files added after manifest was generated */
+static bool update_task_verify_resources(UpdateTask* update_task, ResourceHashArray_t hashes) {
+    ResourceManifestReader* manifest_reader = resource_manifest_reader_alloc(update_task->storage);
+    const size_t count = ResourceHashArray_size(hashes);
+    bool success = true;
+
+    do {
+        if(!resource_manifest_reader_open(manifest_reader, EXT_PATH("Manifest"))) {
+            FURI_LOG_W(TAG, "No manifest in bundle, not verifying");
+            break;
+        }
+
+        if(count) {
+            qsort(
+                ResourceHashArray_get(hashes, 0),
+                count,
+                sizeof(uint64_t),
+                update_task_resource_hash_compare);
+        }
+        const uint64_t* keys = count ? ResourceHashArray_cget(hashes, 0) : NULL;
+
+        uint32_t n_verified = 0;
+        ResourceManifestEntry* entry_ptr = NULL;
+        while((entry_ptr = resource_manifest_reader_next(manifest_reader))) {
+            if(entry_ptr->type != ResourceManifestEntryTypeFile) {
+                continue;
+            }
+
+            const char* name = furi_string_get_cstr(entry_ptr->name);
+            const uint64_t key = update_task_resource_hash_key(name, entry_ptr->hash);
+
+            size_t lo = 0, hi = count;
+            while(lo < hi) {
+                size_t mid = lo + (hi - lo) / 2;
+                if(keys[mid] < key) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+
+            if(lo == count || keys[lo] != key) {
+                FURI_LOG_E(TAG, "%s: missing or hash mismatch", name);
+                success = false;
+                continue;
+            }
+            n_verified++;
+        }
+
+        FURI_LOG_I(TAG, "Verified %lu files", n_verified);
+    } while(false);
+
+    resource_manifest_reader_free(manifest_reader);
+    return success;
+}
+
 static void update_task_cleanup_resources(UpdateTask* update_task, const uint32_t n_tar_entries) {
     ResourceManifestReader* manifest_reader = resource_manifest_reader_alloc(update_task->storage);
     do {
@@ -178,6 +258,7 @@ static bool update_task_post_update(UpdateTask* update_task) {
                 .total_files = 0,
                 .processed_files = 0,
             };
+            ResourceHashArray_init(progress.hashes);
             update_task_set_progress(update_task, UpdateTaskStageResourcesUpdate, 0);
 
             path_concat(
@@ -186,15 +267,23 @@ static bool update_task_post_update(UpdateTask* update_task) {
                 file_path);
 
             tar_archive_set_file_callback(archive, update_task_resource_unpack_cb, &progress);
-            CHECK_RESULT(
-                tar_archive_open(archive, furi_string_get_cstr(file_path), TAR_OPEN_MODE_READ));
+            tar_archive_set_hash_callback(archive, update_task_resource_hash_cb, &progress);
+            bool resources_success =
+                tar_archive_open(archive, furi_string_get_cstr(file_path), TAR_OPEN_MODE_READ);
 
-            progress.total_files = tar_archive_get_entries_count(archive);
-            if(progress.total_files > 0) {
+            if(resources_success) {
+                progress.total_files = tar_archive_get_entries_count(archive);
+            }
+            if(resources_success && progress.total_files > 0) {
                 update_task_cleanup_resources(update_task, progress.total_files);
 
-                CHECK_RESULT(tar_archive_unpack_to(archive, STORAGE_EXT_PATH_PREFIX, NULL));
+                resources_success =
+                    tar_archive_unpack_to(archive, STORAGE_EXT_PATH_PREFIX, NULL) &&
+                    update_task_verify_resources(update_task, progress.hashes);
             }
+
+            ResourceHashArray_clear(progress.hashes);
+            CHECK_RESULT(resources_success);
         }
 
         if(update_task->state.groups & UpdateTaskStageGroupSplashscreen) {
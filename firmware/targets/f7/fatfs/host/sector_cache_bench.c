@@ -0,0 +1,266 @@
+// Host trace replay benchmark for the SD sector cache, built from the firmware sources:
+//   cc -O2 -I.. -I../../../../../furi [-DSECTOR_CACHE_SECTORS=16]
+//      -o sector_cache_bench sector_cache_bench.c ../sector_cache.c
+//   ./sector_cache_bench [trace.log]
+// Trace is a CLI log recorded with `log trace` while using the SD card, only SdDiskio lines
+// "read <sector> <count> <meta|data>" and "write <sector> <count> <meta|data>" are used.
+// Without trace a synthetic directory listing and file reading workload is replayed.
+// Requests are replayed the same way user_diskio.c does, sector contents are checked and
+// card commands are compared with the old 8 sector FIFO cache.
+
+#include "sector_cache.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SECTOR_CACHE_BENCH_SECTOR_SIZE (512)
+#define SECTOR_CACHE_BENCH_VERSIONS (1 << 16)
+#define SECTOR_CACHE_BENCH_FIFO_SECTORS (8)
+#define SECTOR_CACHE_BENCH_MAX_COUNT (128)
+
+typedef struct {
+    uint32_t requests;
+    uint32_t sectors;
+    uint32_t commands; // card read commands
+    uint32_t card_sectors; // sectors read from card
+} SectorCacheBenchCounters;
+
+typedef struct {
+    uint32_t sectors[SECTOR_CACHE_BENCH_FIFO_SECTORS];
+    bool valid[SECTOR_CACHE_BENCH_FIFO_SECTORS];
+    uint32_t itr;
+} SectorCacheBenchFifo;
+
+typedef struct {
+    uint32_t sector[SECTOR_CACHE_BENCH_VERSIONS];
+    uint32_t version[SECTOR_CACHE_BENCH_VERSIONS];
+    bool used[SECTOR_CACHE_BENCH_VERSIONS];
+} SectorCacheBenchDisk;
+
+static SectorCacheBenchDisk disk;
+static SectorCacheBenchFifo fifo;
+static SectorCacheBenchCounters counters;
+static SectorCacheBenchCounters fifo_counters;
+static uint32_t mismatches;
+
+// Memory pool glue, the firmware gets it from furi
+void* memmgr_alloc_from_pool(size_t size) {
+    return malloc(size);
+}
+
+size_t memmgr_pool_get_max_block(void) {
+    return SIZE_MAX;
+}
+
+static uint32_t* sector_cache_bench_version(uint32_t sector) {
+    size_t index = (sector * 0x9E3779B1U) & (SECTOR_CACHE_BENCH_VERSIONS - 1);
+    while(disk.used[index] && disk.sector[index] != sector) {
+        index = (index + 1) & (SECTOR_CACHE_BENCH_VERSIONS - 1);
+    }
+    if(!disk.used[index]) {
+        disk.used[index] = true;
+        disk.sector[index] = sector;
+        disk.version[index] = 0;
+    }
+    return &disk.version[index];
+}
+
+static void sector_cache_bench_fill(uint8_t* data, uint32_t sector) {
+    uint32_t version = *sector_cache_bench_version(sector);
+    for(size_t i = 0; i < SECTOR_CACHE_BENCH_SECTOR_SIZE; i += 8) {
+        memcpy(&data[i], &sector, 4);
+        memcpy(&data[i + 4], &version, 4);
+    }
+}
+
+static void sector_cache_bench_card_read(uint8_t* data, uint32_t sector, uint32_t count) {
+    counters.commands++;
+    counters.card_sectors += count;
+    for(uint32_t i = 0; i < count; i++) {
+        sector_cache_bench_fill(&data[i * SECTOR_CACHE_BENCH_SECTOR_SIZE], sector + i);
+    }
+}
+
+static void sector_cache_bench_check(const uint8_t* data, uint32_t sector) {
+    uint8_t expected[SECTOR_CACHE_BENCH_SECTOR_SIZE];
+    sector_cache_bench_fill(expected, sector);
+    if(memcmp(data, expected, SECTOR_CACHE_BENCH_SECTOR_SIZE) != 0) mismatches++;
+}
+
+/** Same as driver_read in user_diskio.c */
+static void sector_cache_bench_read(uint32_t sector, uint32_t count, bool metadata) {
+    static uint8_t buff[SECTOR_CACHE_BENCH_MAX_COUNT * SECTOR_CACHE_BENCH_SECTOR_SIZE];
+    bool single_sector = count == 1;
+    uint32_t read_ahead = metadata ? 0 : sector_cache_read_ahead(sector, count);
+
+    counters.requests++;
+    counters.sectors += count;
+
+    uint8_t* cached = single_sector ? sector_cache_get(sector) : NULL;
+    if(cached) {
+        memcpy(buff, cached, SECTOR_CACHE_BENCH_SECTOR_SIZE);
+    } else if(single_sector && read_ahead > 1) {
+        uint8_t* read_ahead_buff = sector_cache_get_read_ahead_buffer();
+        sector_cache_bench_card_read(read_ahead_buff, sector, read_ahead);
+        sector_cache_put_read_ahead(sector, read_ahead);
+        memcpy(buff, read_ahead_buff, SECTOR_CACHE_BENCH_SECTOR_SIZE);
+    } else {
+        sector_cache_bench_card_read(buff, sector, count);
+        if(single_sector) sector_cache_put(sector, buff, metadata);
+    }
+
+    for(uint32_t i = 0; i < count; i++) {
+        sector_cache_bench_check(&buff[i * SECTOR_CACHE_BENCH_SECTOR_SIZE], sector + i);
+    }
+}
+
+/** Old cache: 8 sectors FIFO, single sector reads only */
+static void sector_cache_bench_fifo_read(uint32_t sector, uint32_t count) {
+    fifo_counters.requests++;
+    fifo_counters.sectors += count;
+
+    if(count == 1) {
+        for(size_t i = 0; i < SECTOR_CACHE_BENCH_FIFO_SECTORS; i++) {
+            if(fifo.valid[i] && fifo.sectors[i] == sector) return;
+        }
+    }
+
+    fifo_counters.commands++;
+    fifo_counters.card_sectors += count;
+
+    if(count == 1) {
+        fifo.sectors[fifo.itr % SECTOR_CACHE_BENCH_FIFO_SECTORS] = sector;
+        fifo.valid[fifo.itr % SECTOR_CACHE_BENCH_FIFO_SECTORS] = true;
+        fifo.itr++;
+    }
+}
+
+static void sector_cache_bench_write(uint32_t sector, uint32_t count, bool metadata) {
+    static uint8_t buff[SECTOR_CACHE_BENCH_SECTOR_SIZE];
+
+    sector_cache_invalidate_range(sector, sector + count);
+    for(size_t i = 0; i < SECTOR_CACHE_BENCH_FIFO_SECTORS; i++) {
+        if(fifo.sectors[i] >= sector && fifo.sectors[i] <= sector + count) fifo.valid[i] = false;
+    }
+
+    for(uint32_t i = 0; i < count; i++) {
+        (*sector_cache_bench_version(sector + i))++;
+    }
+
+    if(count == 1 && metadata) {
+        sector_cache_bench_fill(buff, sector);
+        sector_cache_put(sector, buff, true);
+    }
+}
+
+static void
+    sector_cache_bench_request(bool write, uint32_t sector, uint32_t count, bool metadata) {
+    if(count == 0 || count > SECTOR_CACHE_BENCH_MAX_COUNT) return;
+    if(write) {
+        sector_cache_bench_write(sector, count, metadata);
+    } else {
+        sector_cache_bench_read(sector, count, metadata);
+        sector_cache_bench_fifo_read(sector, count);
+    }
+}
+
+static size_t sector_cache_bench_replay(FILE* trace) {
+    char line[256];
+    size_t lines = 0;
+
+    while(fgets(line, sizeof(line), trace)) {
+        char* request = strstr(line, "[SdDiskio] ");
+        request = request ? request + strlen("[SdDiskio] ") : line;
+
+        char op[8];
+        char kind[8];
+        unsigned long sector;
+        unsigned count;
+        if(sscanf(request, "%7s %lu %u %7s", op, &sector, &count, kind) != 4) continue;
+
+        bool write = strcmp(op, "write") == 0;
+        if(!write && strcmp(op, "read") != 0) continue;
+
+        sector_cache_bench_request(write, sector, count, strcmp(kind, "meta") == 0);
+        lines++;
+    }
+
+    return lines;
+}
+
+/** Listing of a big directory and reading of some files in it, like file browser does */
+static void sector_cache_bench_synthetic() {
+    const uint32_t fat = 2048;
+    const uint32_t dir = 40000;
+    const uint32_t dir_sectors = 64;
+    const uint32_t data = 100000;
+
+    for(uint32_t pass = 0; pass < 20; pass++) {
+        // Directory is read for listing and then for each opened file
+        for(uint32_t file = 0; file < 16; file++) {
+            for(uint32_t i = 0; i < dir_sectors / 4; i++) {
+                sector_cache_bench_request(false, dir + (file * 3 + i) % dir_sectors, 1, true);
+                sector_cache_bench_request(false, fat + i / 8, 1, true);
+            }
+
+            // Small file read by 64 byte chunks, FatFs asks for each sector once
+            uint32_t start = data + (pass * 16 + file) * 64;
+            for(uint32_t i = 0; i < 24; i++) {
+                sector_cache_bench_request(false, start + i, 1, false);
+                if(i % 8 == 7) sector_cache_bench_request(false, fat + start / 128 % 8, 1, true);
+            }
+        }
+
+        // Settings file saved once per pass
+        sector_cache_bench_request(true, dir + pass % dir_sectors, 1, true);
+        sector_cache_bench_request(true, data + 5000 + pass, 1, false);
+    }
+}
+
+static void sector_cache_bench_print(const char* name, const SectorCacheBenchCounters* c) {
+    printf(
+        "%-22s %7u requests %8u sectors  card: %7u commands %8u sectors  x%.2f commands\n",
+        name,
+        c->requests,
+        c->sectors,
+        c->commands,
+        c->card_sectors,
+        c->commands ? (double)fifo_counters.commands / c->commands : 0.0);
+}
+
+int main(int argc, char** argv) {
+    sector_cache_init();
+
+    if(argc > 1) {
+        FILE* trace = fopen(argv[1], "r");
+        if(!trace) {
+            perror(argv[1]);
+            return 2;
+        }
+        size_t lines = sector_cache_bench_replay(trace);
+        fclose(trace);
+        printf("trace %s: %zu lines\n", argv[1], lines);
+    } else {
+        sector_cache_bench_synthetic();
+        printf("synthetic workload\n");
+    }
+
+    SectorCacheStats stats;
+    sector_cache_get_stats(&stats);
+
+    sector_cache_bench_print("fifo, 8 sectors", &fifo_counters);
+    char name[32];
+    snprintf(name, sizeof(name), "lru, %u sectors", stats.sectors);
+    sector_cache_bench_print(name, &counters);
+    printf(
+        "hits %u misses %u evictions %u read-ahead %u (%u hit) data mismatches %u\n",
+        stats.hits,
+        stats.misses,
+        stats.evictions,
+        stats.read_ahead,
+        stats.read_ahead_hits,
+        mismatches);
+
+    return mismatches ? 1 : 0;
+}
@@ -1,56 +1,284 @@
 #include "sector_cache.h"
 
 #include <stddef.h>
-#include <stdio.h>
 #include <string.h>
-#include <furi.h>
-#include <furi_hal_memory.h>
+#include <core/memmgr.h>
 
 #define SECTOR_SIZE 512
-#define N_SECTORS 8
+#define SECTOR_CACHE_MIN_SECTORS 8
+#define SECTOR_CACHE_NONE UINT16_MAX
+// Reads that continue previous one before read-ahead kicks in
+#define SECTOR_CACHE_SEQUENTIAL_STREAK 2
+
+typedef enum {
+    SectorCacheListFree,
+    SectorCacheListData,
+    SectorCacheListPinned,
+    SectorCacheListCount,
+} SectorCacheList;
+
+typedef struct {
+    uint32_t sector;
+    uint16_t hash_next;
+    uint16_t prev; // towards most recently used
+    uint16_t next; // towards least recently used
+    uint8_t list;
+    bool read_ahead; // read ahead and not requested yet
+} SectorCacheEntry;
+
+typedef struct {
+    uint16_t head; // most recently used
+    uint16_t tail; // least recently used
+    uint16_t count;
+} SectorCacheLru;
 
 typedef struct {
-    uint32_t itr;
-    uint32_t sectors[N_SECTORS];
-    uint8_t sector_data[N_SECTORS][SECTOR_SIZE];
+    uint32_t sectors;
+    uint32_t next_sector;
+    uint32_t streak;
+    SectorCacheLru lists[SectorCacheListCount];
+    uint8_t* data;
+    uint8_t* read_ahead_data;
+    SectorCacheEntry* entries;
+    uint16_t* buckets;
+    SectorCacheStats stats;
 } SectorCache;
 
 static SectorCache* cache = NULL;
 
+static size_t sector_cache_size(uint32_t sectors) {
+    return sizeof(SectorCache) + (sectors + SECTOR_CACHE_READ_AHEAD) * SECTOR_SIZE +
+           sectors * (sizeof(SectorCacheEntry) + sizeof(uint16_t));
+}
+
+static void sector_cache_unlink(uint16_t index) {
+    SectorCacheEntry* entry = &cache->entries[index];
+    SectorCacheLru* lru = &cache->lists[entry->list];
+
+    if(entry->prev != SECTOR_CACHE_NONE) {
+        cache->entries[entry->prev].next = entry->next;
+    } else {
+        lru->head = entry->next;
+    }
+
+    if(entry->next != SECTOR_CACHE_NONE) {
+        cache->entries[entry->next].prev = entry->prev;
+    } else {
+        lru->tail = entry->prev;
+    }
+
+    lru->count--;
+}
+
+static void sector_cache_link(uint16_t index, SectorCacheList list) {
+    SectorCacheEntry* entry = &cache->entries[index];
+    SectorCacheLru* lru = &cache->lists[list];
+
+    entry->list = list;
+    entry->prev = SECTOR_CACHE_NONE;
+    entry->next = lru->head;
+
+    if(lru->head != SECTOR_CACHE_NONE) {
+        cache->entries[lru->head].prev = index;
+    } else {
+        lru->tail = index;
+    }
+
+    lru->head = index;
+    lru->count++;
+}
+
+static uint16_t* sector_cache_bucket(uint32_t n_sector) {
+    return &cache->buckets[n_sector & (cache->sectors - 1)];
+}
+
+static uint16_t sector_cache_find(uint32_t n_sector) {
+    uint16_t index = *sector_cache_bucket(n_sector);
+    while(index != SECTOR_CACHE_NONE && cache->entries[index].sector != n_sector) {
+        index = cache->entries[index].hash_next;
+    }
+    return index;
+}
+
+static void sector_cache_remove(uint16_t index) {
+    SectorCacheEntry* entry = &cache->entries[index];
+
+    uint16_t* link = sector_cache_bucket(entry->sector);
+    while(*link != index) {
+        link = &cache->entries[*link].hash_next;
+    }
+    *link = entry->hash_next;
+
+    sector_cache_unlink(index);
+    sector_cache_link(index, SectorCacheListFree);
+}
+
+static uint16_t sector_cache_victim() {
+    const SectorCacheLru* lists = cache->lists;
+
+    if(lists[SectorCacheListFree].count > 0) {
+        return lists[SectorCacheListFree].tail;
+    }
+
+    // Pinned sectors win over data ones, but never take the whole cache
+    if(lists[SectorCacheListData].count == 0 ||
+       lists[SectorCacheListPinned].count > cache->sectors * 3 / 4) {
+        return lists[SectorCacheListPinned].tail;
+    }
+
+    return lists[SectorCacheListData].tail;
+}
+
+static uint8_t* sector_cache_insert(uint32_t n_sector, bool pinned) {
+    uint16_t index = sector_cache_find(n_sector);
+
+    if(index == SECTOR_CACHE_NONE) {
+        index = sector_cache_victim();
+        if(cache->entries[index].list != SectorCacheListFree) {
+            sector_cache_remove(index);
+            cache->stats.evictions++;
+        }
+
+        uint16_t* bucket = sector_cache_bucket(n_sector);
+        cache->entries[index].sector = n_sector;
+        cache->entries[index].hash_next = *bucket;
+        *bucket = index;
+    } else if(cache->entries[index].list == SectorCacheListPinned) {
+        pinned = true;
+    }
+
+    sector_cache_unlink(index);
+    sector_cache_link(index, pinned ? SectorCacheListPinned : SectorCacheListData);
+    cache->entries[index].read_ahead = false;
+
+    return &cache->data[index * SECTOR_SIZE];
+}
+
+static void sector_cache_reset() {
+    for(size_t i = 0; i < SectorCacheListCount; i++) {
+        cache->lists[i].head = SECTOR_CACHE_NONE;
+        cache->lists[i].tail = SECTOR_CACHE_NONE;
+        cache->lists[i].count = 0;
+    }
+
+    for(uint16_t i = 0; i < cache->sectors; i++) {
+        cache->buckets[i] = SECTOR_CACHE_NONE;
+        cache->entries[i].sector = 0;
+        cache->entries[i].hash_next = SECTOR_CACHE_NONE;
+        cache->entries[i].read_ahead = false;
+        sector_cache_link(i, SectorCacheListFree);
+    }
+
+    cache->next_sector = 0;
+    cache->streak = 0;
+}
+
 void sector_cache_init() {
     if(cache == NULL) {
-        cache = memmgr_alloc_from_pool(sizeof(SectorCache));
+        // Memory pool is shared with thread stacks, take at most half of it
+        size_t budget = memmgr_pool_get_max_block() / 2;
+        uint32_t sectors = SECTOR_CACHE_SECTORS;
+        while(sectors > SECTOR_CACHE_MIN_SECTORS && sector_cache_size(sectors) > budget) {
+            sectors /= 2;
+        }
+
+        uint8_t* memory = memmgr_alloc_from_pool(sector_cache_size(sectors));
+        if(memory != NULL) {
+            cache = (SectorCache*)memory;
+            memset(cache, 0, sizeof(SectorCache));
+            cache->sectors = sectors;
+            cache->data = memory + sizeof(SectorCache);
+            cache->read_ahead_data = cache->data + sectors * SECTOR_SIZE;
+            uint8_t* entries = cache->read_ahead_data + SECTOR_CACHE_READ_AHEAD * SECTOR_SIZE;
+            cache->entries = (SectorCacheEntry*)entries;
+            cache->buckets = (uint16_t*)(cache->entries + sectors);
+            cache->stats.sectors = sectors;
+        }
     }
 
     if(cache != NULL) {
-        memset(cache, 0, sizeof(SectorCache));
+        sector_cache_reset();
     }
 }
 
 uint8_t* sector_cache_get(uint32_t n_sector) {
-    if(cache != NULL && n_sector != 0) {
-        for(int sector_i = 0; sector_i < N_SECTORS; ++sector_i) {
-            if(cache->sectors[sector_i] == n_sector) {
-                return cache->sector_data[sector_i];
-            }
-        }
+    if(cache == NULL) return NULL;
+
+    uint16_t index = sector_cache_find(n_sector);
+    if(index == SECTOR_CACHE_NONE) {
+        cache->stats.misses++;
+        return NULL;
+    }
+
+    SectorCacheEntry* entry = &cache->entries[index];
+    cache->stats.hits++;
+    if(entry->read_ahead) {
+        entry->read_ahead = false;
+        cache->stats.read_ahead_hits++;
     }
-    return NULL;
+
+    sector_cache_unlink(index);
+    sector_cache_link(index, entry->list);
+
+    return &cache->data[index * SECTOR_SIZE];
 }
 
-void sector_cache_put(uint32_t n_sector, uint8_t* data) {
+void sector_cache_put(uint32_t n_sector, const uint8_t* data, bool pinned) {
     if(cache == NULL) return;
-    cache->sectors[cache->itr % N_SECTORS] = n_sector;
-    memcpy(cache->sector_data[cache->itr % N_SECTORS], data, SECTOR_SIZE);
-    cache->itr++;
+    memcpy(sector_cache_insert(n_sector, pinned), data, SECTOR_SIZE);
 }
 
 void sector_cache_invalidate_range(uint32_t start_sector, uint32_t end_sector) {
     if(cache == NULL) return;
-    for(int sector_i = 0; sector_i < N_SECTORS; ++sector_i) {
-        if((cache->sectors[sector_i] >= start_sector) &&
-           (cache->sectors[sector_i] <= end_sector)) {
-            cache->sectors[sector_i] = 0;
+    for(uint16_t i = 0; i < cache->sectors; i++) {
+        SectorCacheEntry* entry = &cache->entries[i];
+        if((entry->list != SectorCacheListFree) && (entry->sector >= start_sector) &&
+           (entry->sector <= end_sector)) {
+            sector_cache_remove(i);
         }
     }
-}
\ No newline at end of file
+}
+
+uint32_t sector_cache_read_ahead(uint32_t n_sector, uint32_t count) {
+    if(cache == NULL) return 0;
+
+    if(n_sector == cache->next_sector) {
+        if(cache->streak < UINT32_MAX) cache->streak++;
+    } else {
+        cache->streak = 0;
+    }
+    cache->next_sector = n_sector + count;
+
+    if(count != 1 || cache->streak < SECTOR_CACHE_SEQUENTIAL_STREAK) return 0;
+
+    // Small cache would evict sectors read ahead before they are requested
+    uint32_t read_ahead = cache->sectors / 4;
+    return read_ahead < SECTOR_CACHE_READ_AHEAD ? read_ahead : SECTOR_CACHE_READ_AHEAD;
+}
+
+uint8_t* sector_cache_get_read_ahead_buffer() {
+    if(cache == NULL) return NULL;
+    return cache->read_ahead_data;
+}
+
+void sector_cache_put_read_ahead(uint32_t n_sector, uint32_t count) {
+    if(cache == NULL) return;
+
+    for(uint32_t i = 0; i < count && i < SECTOR_CACHE_READ_AHEAD; i++) {
+        uint8_t* data = sector_cache_insert(n_sector + i, false);
+        memcpy(data, &cache->read_ahead_data[i * SECTOR_SIZE], SECTOR_SIZE);
+        if(i > 0) {
+            // First one is the sector that was requested
+            cache->entries[(data - cache->data) / SECTOR_SIZE].read_ahead = true;
+            cache->stats.read_ahead++;
+        }
+    }
+}
+
+void sector_cache_get_stats(SectorCacheStats* stats) {
+    if(cache == NULL) {
+        memset(stats, 0, sizeof(SectorCacheStats));
+    } else {
+        *stats = cache->stats;
+    }
+}
@@ -1,12 +1,30 @@
 #pragma once
+#include <stdbool.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/** Cache capacity in sectors, power of 2, reduced at init if memory pool is short */
+#ifndef SECTOR_CACHE_SECTORS
+#define SECTOR_CACHE_SECTORS 32
+#endif
+
+/** Sectors read in one go when sequential reads are detected */
+#define SECTOR_CACHE_READ_AHEAD 4
+
+typedef struct {
+    uint32_t sectors;
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t read_ahead;
+    uint32_t read_ahead_hits;
+} SectorCacheStats;
+
 /**
- * @brief Init sector cache system
+ * @brief Init sector cache system, drops all cached sectors
  */
 void sector_cache_init();
 
@@ -21,8 +39,9 @@ uint8_t* sector_cache_get(uint32_t n_sector);
  * @brief Put sector data to cache
  * @param n_sector Sector number
  * @param data Pointer to sector data
+ * @param pinned Filesystem metadata (FAT, directory), kept in cache with priority
  */
-void sector_cache_put(uint32_t n_sector, uint8_t* data);
+void sector_cache_put(uint32_t n_sector, const uint8_t* data, bool pinned);
 
 /**
  * @brief Invalidate sector cache for given range
@@ -31,6 +50,33 @@ void sector_cache_put(uint32_t n_sector, uint8_t* data);
  */
 void sector_cache_invalidate_range(uint32_t start_sector, uint32_t end_sector);
 
+/**
+ * @brief Track data read and decide on read-ahead
+ * @param n_sector First sector of read
+ * @param count Sectors count
+ * @return Sectors to read from n_sector at once, 0 if access is not sequential
+ */
+uint32_t sector_cache_read_ahead(uint32_t n_sector, uint32_t count);
+
+/**
+ * @brief Get read-ahead buffer
+ * @return Buffer for SECTOR_CACHE_READ_AHEAD sectors or NULL if cache is not available
+ */
+uint8_t* sector_cache_get_read_ahead_buffer();
+
+/**
+ * @brief Put sectors read ahead to cache
+ * @param n_sector First sector in read-ahead buffer
+ * @param count Sectors count in read-ahead buffer
+ */
+void sector_cache_put_read_ahead(uint32_t n_sector, uint32_t count);
+
+/**
+ * @brief Get cache statistics, kept across init
+ * @param stats Stats to fill
+ */
+void sector_cache_get_stats(SectorCacheStats* stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -20,8 +20,11 @@
 
 #include "user_diskio.h"
 #include <furi_hal.h>
+#include "fatfs.h"
 #include "sector_cache.h"
 
+#define TAG "SdDiskio"
+
 static DSTATUS driver_check_status(BYTE lun) {
     UNUSED(lun);
     DSTATUS status = 0;
@@ -55,8 +58,8 @@ static inline bool sd_cache_get(uint32_t address, uint32_t* data) {
     return false;
 }
 
-static inline void sd_cache_put(uint32_t address, uint32_t* data) {
-    sector_cache_put(address, (uint8_t*)data);
+static inline void sd_cache_put(uint32_t address, uint32_t* data, bool pinned) {
+    sector_cache_put(address, (uint8_t*)data, pinned);
 }
 
 static inline void sd_cache_invalidate_range(uint32_t start_sector, uint32_t end_sector) {
@@ -159,6 +162,11 @@ static DRESULT driver_read(BYTE pdrv, BYTE* buff, DWORD sector, UINT count) {
 
     bool result;
     bool single_sector = count == 1;
+    // FatFs reads FAT and directory sectors through its window, file data elsewhere
+    bool metadata = buff == fatfs_object.win;
+    uint32_t read_ahead = metadata ? 0 : sector_cache_read_ahead(sector, count);
+
+    FURI_LOG_T(TAG, "read %lu %u %s", sector, count, metadata ? "meta" : "data");
 
     if(single_sector) {
         if(sd_cache_get(sector, (uint32_t*)buff)) {
@@ -166,6 +174,15 @@ static DRESULT driver_read(BYTE pdrv, BYTE* buff, DWORD sector, UINT count) {
         }
     }
 
+    if(single_sector && read_ahead > 1) {
+        uint8_t* read_ahead_buff = sector_cache_get_read_ahead_buffer();
+        if(sd_device_read((uint32_t*)read_ahead_buff, (uint32_t)(sector), read_ahead)) {
+            sector_cache_put_read_ahead(sector, read_ahead);
+            memcpy(buff, read_ahead_buff, SD_BLOCK_SIZE);
+            return RES_OK;
+        }
+    }
+
     result = sd_device_read((uint32_t*)buff, (uint32_t)(sector), count);
 
     if(!result) {
@@ -189,7 +206,7 @@ static DRESULT driver_read(BYTE pdrv, BYTE* buff, DWORD sector, UINT count) {
     }
 
     if(single_sector && result == true) {
-        sd_cache_put(sector, (uint32_t*)buff);
+        sd_cache_put(sector, (uint32_t*)buff, metadata);
     }
 
     return result ? RES_OK : RES_ERROR;
@@ -206,6 +223,9 @@ static DRESULT driver_read(BYTE pdrv, BYTE* buff, DWORD sector, UINT count) {
 static DRESULT driver_write(BYTE pdrv, const BYTE* buff, DWORD sector, UINT count) {
     UNUSED(pdrv);
     bool result;
+    bool metadata = buff == fatfs_object.win;
+
+    FURI_LOG_T(TAG, "write %lu %u %s", sector, count, metadata ? "meta" : "data");
 
     sd_cache_invalidate_range(sector, sector + count);
 
@@ -231,6 +251,11 @@ static DRESULT driver_write(BYTE pdrv, const BYTE* buff, DWORD sector, UINT coun
         }
     }
 
+    // Keep metadata cached across FatFs window flushes
+    if(count == 1 && metadata && result == true) {
+        sd_cache_put(sector, (uint32_t*)buff, true);
+    }
+
     return result ? RES_OK : RES_ERROR;
 }
 
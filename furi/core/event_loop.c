@@ -0,0 +1,449 @@
+#include "event_loop_i.h"
+#include "check.h"
+#include "common_defines.h"
+#include "kernel.h"
+#include "memmgr.h"
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+typedef enum {
+    FuriEventLoopFlagEvent = (1 << 0),
+    FuriEventLoopFlagThreadFlags = (1 << 1),
+    FuriEventLoopFlagStop = (1 << 2),
+} FuriEventLoopFlag;
+
+#define FuriEventLoopFlagAll \
+    (FuriEventLoopFlagEvent | FuriEventLoopFlagThreadFlags | FuriEventLoopFlagStop)
+
+typedef enum {
+    FuriEventLoopItemTypeMessageQueue,
+    FuriEventLoopItemTypeStreamBuffer,
+} FuriEventLoopItemType;
+
+struct FuriEventLoopItem {
+    FuriEventLoop* owner;
+    FuriEventLoopItemType type;
+    void* object;
+    FuriEventLoopLink* link;
+
+    union {
+        FuriEventLoopMessageQueueCallback message_queue;
+        FuriEventLoopStreamBufferCallback stream_buffer;
+    } callback;
+    void* context;
+
+    // Set by producers under critical section
+    volatile bool pending;
+    // Snapshot of pending for the current dispatch pass
+    bool ready;
+
+    FuriEventLoopItem* next;
+};
+
+struct FuriEventLoopTimer {
+    FuriEventLoop* owner;
+    FuriEventLoopTimerCallback callback;
+    void* context;
+    FuriEventLoopTimerType type;
+
+    uint32_t interval;
+    uint32_t next_tick;
+    bool running;
+    bool ready;
+
+    FuriEventLoopTimer* next;
+};
+
+struct FuriEventLoop {
+    FuriThread* thread;
+    FuriThreadId thread_id;
+
+    FuriEventLoopItem* items;
+    // Item whose callback is running, reset if it unsubscribes itself
+    FuriEventLoopItem* current_item;
+    FuriEventLoopTimer* timers;
+
+    uint32_t thread_flags;
+    FuriEventLoopThreadFlagsCallback thread_flags_callback;
+    void* thread_flags_context;
+};
+
+static void furi_event_loop_notify(FuriThreadId thread_id, uint32_t flags) {
+    TaskHandle_t task = (TaskHandle_t)thread_id;
+
+    if(FURI_IS_ISR()) {
+        BaseType_t yield = pdFALSE;
+        (void)xTaskNotifyIndexedFromISR(
+            task, FURI_EVENT_LOOP_NOTIFY_INDEX, flags, eSetBits, &yield);
+        portYIELD_FROM_ISR(yield);
+    } else {
+        (void)xTaskNotifyIndexed(task, FURI_EVENT_LOOP_NOTIFY_INDEX, flags, eSetBits);
+    }
+}
+
+static bool furi_event_loop_item_has_data(FuriEventLoopItem* item) {
+    if(item->type == FuriEventLoopItemTypeMessageQueue) {
+        return furi_message_queue_get_count(item->object) > 0;
+    } else {
+        size_t trigger_level = furi_stream_buffer_get_trigger_level(item->object);
+        size_t available = furi_stream_buffer_bytes_available(item->object);
+        return available && (available >= trigger_level);
+    }
+}
+
+// Level triggered: keep item pending while there is something left to read
+static void furi_event_loop_item_rearm(FuriEventLoopItem* item) {
+    if(furi_event_loop_item_has_data(item)) {
+        FURI_CRITICAL_ENTER();
+        item->pending = true;
+        FURI_CRITICAL_EXIT();
+        furi_event_loop_notify(item->owner->thread_id, FuriEventLoopFlagEvent);
+    }
+}
+
+void furi_event_loop_link_notify(FuriEventLoopLink* link) {
+    furi_assert(link);
+
+    // Cheap unlocked check, subscribe checks the level on its own
+    if(!link->item) return;
+
+    FURI_CRITICAL_ENTER();
+    FuriEventLoopItem* item = link->item;
+    if(item) {
+        item->pending = true;
+        furi_event_loop_notify(item->owner->thread_id, FuriEventLoopFlagEvent);
+    }
+    FURI_CRITICAL_EXIT();
+}
+
+void furi_event_loop_thread_flags_notify(FuriThreadId thread_id) {
+    furi_event_loop_notify(thread_id, FuriEventLoopFlagThreadFlags);
+}
+
+FuriEventLoop* furi_event_loop_alloc() {
+    FuriThread* thread = furi_thread_get_current();
+    furi_check(thread);
+    furi_check(furi_thread_get_event_loop(thread) == NULL);
+
+    FuriEventLoop* instance = malloc(sizeof(FuriEventLoop));
+    instance->thread = thread;
+    instance->thread_id = furi_thread_get_current_id();
+
+    // Drop notifications left from a previous loop of this thread
+    (void)xTaskNotifyStateClearIndexed(NULL, FURI_EVENT_LOOP_NOTIFY_INDEX);
+    (void)ulTaskNotifyValueClearIndexed(NULL, FURI_EVENT_LOOP_NOTIFY_INDEX, FuriEventLoopFlagAll);
+
+    furi_thread_set_event_loop(thread, instance);
+
+    return instance;
+}
+
+void furi_event_loop_free(FuriEventLoop* instance) {
+    furi_assert(instance);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+    furi_check(instance->items == NULL);
+    furi_check(instance->timers == NULL);
+
+    furi_thread_set_event_loop(instance->thread, NULL);
+
+    free(instance);
+}
+
+static void furi_event_loop_process_items(FuriEventLoop* instance) {
+    FURI_CRITICAL_ENTER();
+    for(FuriEventLoopItem* item = instance->items; item; item = item->next) {
+        item->ready = item->pending;
+        item->pending = false;
+    }
+    FURI_CRITICAL_EXIT();
+
+    // Rescan after every callback, it can unsubscribe any item
+    while(true) {
+        FuriEventLoopItem* item = instance->items;
+        while(item && !item->ready) item = item->next;
+        if(!item) break;
+
+        item->ready = false;
+        instance->current_item = item;
+        if(item->type == FuriEventLoopItemTypeMessageQueue) {
+            item->callback.message_queue(item->object, item->context);
+        } else {
+            item->callback.stream_buffer(item->object, item->context);
+        }
+
+        if(instance->current_item) {
+            furi_event_loop_item_rearm(item);
+        }
+        instance->current_item = NULL;
+    }
+}
+
+static void furi_event_loop_process_thread_flags(FuriEventLoop* instance) {
+    if(!instance->thread_flags_callback) return;
+
+    uint32_t flags = furi_thread_flags_get();
+    if(flags & FuriFlagError) return;
+
+    flags &= instance->thread_flags;
+    if(flags) {
+        furi_thread_flags_clear(flags);
+        instance->thread_flags_callback(flags, instance->thread_flags_context);
+    }
+}
+
+static uint32_t furi_event_loop_get_timeout(FuriEventLoop* instance) {
+    uint32_t timeout = FuriWaitForever;
+    uint32_t now = furi_get_tick();
+
+    for(FuriEventLoopTimer* timer = instance->timers; timer; timer = timer->next) {
+        if(!timer->running) continue;
+        int32_t remaining = (int32_t)(timer->next_tick - now);
+        if(remaining <= 0) return 0;
+        if((uint32_t)remaining < timeout) timeout = remaining;
+    }
+
+    return timeout;
+}
+
+static void furi_event_loop_process_timers(FuriEventLoop* instance) {
+    uint32_t now = furi_get_tick();
+
+    for(FuriEventLoopTimer* timer = instance->timers; timer; timer = timer->next) {
+        timer->ready = timer->running && ((int32_t)(now - timer->next_tick) >= 0);
+    }
+
+    // Rescan after every callback, it can free or restart any timer
+    while(true) {
+        FuriEventLoopTimer* timer = instance->timers;
+        while(timer && !timer->ready) timer = timer->next;
+        if(!timer) break;
+
+        timer->ready = false;
+        if(timer->type == FuriEventLoopTimerTypePeriodic) {
+            timer->next_tick += timer->interval;
+            // Skip missed periods instead of firing them back to back
+            if((int32_t)(now - timer->next_tick) >= 0) {
+                timer->next_tick = now + timer->interval;
+            }
+        } else {
+            timer->running = false;
+        }
+        timer->callback(timer->context);
+    }
+}
+
+void furi_event_loop_run(FuriEventLoop* instance) {
+    furi_assert(instance);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+
+    while(true) {
+        uint32_t flags = 0;
+        uint32_t timeout = furi_event_loop_get_timeout(instance);
+
+        if(xTaskNotifyWaitIndexed(
+               FURI_EVENT_LOOP_NOTIFY_INDEX, 0, FuriEventLoopFlagAll, &flags, timeout) ==
+           pdTRUE) {
+            if(flags & FuriEventLoopFlagStop) {
+                // Keep the rest for the next run
+                flags &= ~FuriEventLoopFlagStop;
+                if(flags) furi_event_loop_notify(instance->thread_id, flags);
+                break;
+            }
+            if(flags & FuriEventLoopFlagThreadFlags) {
+                furi_event_loop_process_thread_flags(instance);
+            }
+            if(flags & FuriEventLoopFlagEvent) {
+                furi_event_loop_process_items(instance);
+            }
+        }
+
+        furi_event_loop_process_timers(instance);
+    }
+}
+
+void furi_event_loop_stop(FuriEventLoop* instance) {
+    furi_assert(instance);
+    furi_event_loop_notify(instance->thread_id, FuriEventLoopFlagStop);
+}
+
+static FuriEventLoopItem* furi_event_loop_item_alloc(
+    FuriEventLoop* instance,
+    FuriEventLoopItemType type,
+    void* object,
+    FuriEventLoopLink* link,
+    void* context) {
+    furi_assert(instance);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+    furi_assert(object);
+
+    FuriEventLoopItem* item = malloc(sizeof(FuriEventLoopItem));
+    item->owner = instance;
+    item->type = type;
+    item->object = object;
+    item->link = link;
+    item->context = context;
+
+    return item;
+}
+
+static void furi_event_loop_item_add(FuriEventLoop* instance, FuriEventLoopItem* item) {
+    // Append, so items are dispatched in subscription order
+    FuriEventLoopItem** tail = &instance->items;
+    while(*tail) tail = &(*tail)->next;
+    *tail = item;
+
+    FURI_CRITICAL_ENTER();
+    furi_check(item->link->item == NULL);
+    item->link->item = item;
+    FURI_CRITICAL_EXIT();
+
+    // Data sent before subscription would never notify
+    furi_event_loop_item_rearm(item);
+}
+
+void furi_event_loop_subscribe_message_queue(
+    FuriEventLoop* instance,
+    FuriMessageQueue* queue,
+    FuriEventLoopMessageQueueCallback callback,
+    void* context) {
+    furi_assert(callback);
+
+    FuriEventLoopItem* item = furi_event_loop_item_alloc(
+        instance,
+        FuriEventLoopItemTypeMessageQueue,
+        queue,
+        furi_message_queue_get_event_loop_link(queue),
+        context);
+    item->callback.message_queue = callback;
+
+    furi_event_loop_item_add(instance, item);
+}
+
+void furi_event_loop_subscribe_stream_buffer(
+    FuriEventLoop* instance,
+    FuriStreamBuffer* stream_buffer,
+    FuriEventLoopStreamBufferCallback callback,
+    void* context) {
+    furi_assert(callback);
+
+    FuriEventLoopItem* item = furi_event_loop_item_alloc(
+        instance,
+        FuriEventLoopItemTypeStreamBuffer,
+        stream_buffer,
+        furi_stream_buffer_get_event_loop_link(stream_buffer),
+        context);
+    item->callback.stream_buffer = callback;
+
+    furi_event_loop_item_add(instance, item);
+}
+
+void furi_event_loop_unsubscribe(FuriEventLoop* instance, void* object) {
+    furi_assert(instance);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+
+    FuriEventLoopItem** it = &instance->items;
+    while(*it && (*it)->object != object) it = &(*it)->next;
+    furi_check(*it);
+
+    FuriEventLoopItem* item = *it;
+    *it = item->next;
+
+    FURI_CRITICAL_ENTER();
+    item->link->item = NULL;
+    FURI_CRITICAL_EXIT();
+
+    if(instance->current_item == item) {
+        instance->current_item = NULL;
+    }
+
+    free(item);
+}
+
+void furi_event_loop_subscribe_thread_flags(
+    FuriEventLoop* instance,
+    uint32_t flags,
+    FuriEventLoopThreadFlagsCallback callback,
+    void* context) {
+    furi_assert(instance);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+    furi_check(instance->thread_flags_callback == NULL);
+    furi_assert(flags);
+    furi_assert(callback);
+
+    instance->thread_flags = flags;
+    instance->thread_flags_callback = callback;
+    instance->thread_flags_context = context;
+
+    // Flags set before subscription would never notify
+    furi_event_loop_notify(instance->thread_id, FuriEventLoopFlagThreadFlags);
+}
+
+void furi_event_loop_unsubscribe_thread_flags(FuriEventLoop* instance) {
+    furi_assert(instance);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+
+    instance->thread_flags = 0;
+    instance->thread_flags_callback = NULL;
+    instance->thread_flags_context = NULL;
+}
+
+FuriEventLoopTimer* furi_event_loop_timer_alloc(
+    FuriEventLoop* instance,
+    FuriEventLoopTimerCallback callback,
+    FuriEventLoopTimerType type,
+    void* context) {
+    furi_assert(instance);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+    furi_assert(callback);
+
+    FuriEventLoopTimer* timer = malloc(sizeof(FuriEventLoopTimer));
+    timer->owner = instance;
+    timer->callback = callback;
+    timer->context = context;
+    timer->type = type;
+
+    FuriEventLoopTimer** tail = &instance->timers;
+    while(*tail) tail = &(*tail)->next;
+    *tail = timer;
+
+    return timer;
+}
+
+void furi_event_loop_timer_free(FuriEventLoopTimer* timer) {
+    furi_assert(timer);
+    FuriEventLoop* instance = timer->owner;
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+
+    FuriEventLoopTimer** it = &instance->timers;
+    while(*it && *it != timer) it = &(*it)->next;
+    furi_check(*it);
+    *it = timer->next;
+
+    free(timer);
+}
+
+void furi_event_loop_timer_start(FuriEventLoopTimer* timer, uint32_t interval) {
+    furi_assert(timer);
+    furi_check(timer->owner->thread_id == furi_thread_get_current_id());
+    // Deadlines are compared as signed tick differences
+    furi_assert((interval > 0) && (interval <= INT32_MAX));
+
+    timer->interval = interval;
+    timer->next_tick = furi_get_tick() + interval;
+    timer->running = true;
+    timer->ready = false;
+}
+
+void furi_event_loop_timer_stop(FuriEventLoopTimer* timer) {
+    furi_assert(timer);
+    furi_check(timer->owner->thread_id == furi_thread_get_current_id());
+
+    timer->running = false;
+    timer->ready = false;
+}
+
+bool furi_event_loop_timer_is_running(FuriEventLoopTimer* timer) {
+    furi_assert(timer);
+    return timer->running;
+}
@@ -0,0 +1,190 @@
+/**
+ * @file event_loop.h
+ * FuriEventLoop
+ *
+ * Lets a single thread wait on several event sources at once: message queues,
+ * stream buffers, thread flags and timers. Each source has its own callback,
+ * all callbacks are called from the thread that runs the loop.
+ *
+ * Loop is woken up through a dedicated FreeRTOS task notification, so senders
+ * wake it directly and no helper threads or FreeRTOS timers are involved.
+ */
+#pragma once
+
+#include "core/base.h"
+#include "core/message_queue.h"
+#include "core/stream_buffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** FuriEventLoop type */
+typedef struct FuriEventLoop FuriEventLoop;
+
+/** FuriEventLoopTimer type */
+typedef struct FuriEventLoopTimer FuriEventLoopTimer;
+
+/** Message queue callback, must read at least one message from the queue
+ *
+ * Called again while the queue is not empty.
+ */
+typedef void (*FuriEventLoopMessageQueueCallback)(FuriMessageQueue* queue, void* context);
+
+/** Stream buffer callback, must read data from the stream buffer
+ *
+ * Called again while the stream buffer holds trigger level bytes or more.
+ */
+typedef void (*FuriEventLoopStreamBufferCallback)(FuriStreamBuffer* stream_buffer, void* context);
+
+/** Thread flags callback, flags are cleared before the call */
+typedef void (*FuriEventLoopThreadFlagsCallback)(uint32_t flags, void* context);
+
+/** Timer callback */
+typedef void (*FuriEventLoopTimerCallback)(void* context);
+
+typedef enum {
+    FuriEventLoopTimerTypeOnce = 0, ///< One-shot timer.
+    FuriEventLoopTimerTypePeriodic = 1, ///< Repeating timer.
+} FuriEventLoopTimerType;
+
+/** Allocate FuriEventLoop, bound to the current thread
+ *
+ * Only one event loop per thread.
+ *
+ * @return     pointer to FuriEventLoop instance
+ */
+FuriEventLoop* furi_event_loop_alloc();
+
+/** Free FuriEventLoop
+ *
+ * Must be called from the owner thread, all sources must be unsubscribed
+ * and all timers freed.
+ *
+ * @param      instance  pointer to FuriEventLoop instance
+ */
+void furi_event_loop_free(FuriEventLoop* instance);
+
+/** Run FuriEventLoop until furi_event_loop_stop is called
+ *
+ * Must be called from the owner thread.
+ *
+ * @param      instance  pointer to FuriEventLoop instance
+ */
+void furi_event_loop_run(FuriEventLoop* instance);
+
+/** Stop FuriEventLoop
+ *
+ * Threadsafe, can be called from ISR.
+ *
+ * @param      instance  pointer to FuriEventLoop instance
+ */
+void furi_event_loop_stop(FuriEventLoop* instance);
+
+/** Subscribe to message queue
+ *
+ * Queue can be subscribed by one event loop at a time.
+ *
+ * @param      instance  pointer to FuriEventLoop instance
+ * @param      queue     pointer to FuriMessageQueue instance
+ * @param      callback  FuriEventLoopMessageQueueCallback
+ * @param      context   callback context
+ */
+void furi_event_loop_subscribe_message_queue(
+    FuriEventLoop* instance,
+    FuriMessageQueue* queue,
+    FuriEventLoopMessageQueueCallback callback,
+    void* context);
+
+/** Subscribe to stream buffer
+ *
+ * Stream buffer can be subscribed by one event loop at a time.
+ *
+ * @param      instance       pointer to FuriEventLoop instance
+ * @param      stream_buffer  pointer to FuriStreamBuffer instance
+ * @param      callback       FuriEventLoopStreamBufferCallback
+ * @param      context        callback context
+ */
+void furi_event_loop_subscribe_stream_buffer(
+    FuriEventLoop* instance,
+    FuriStreamBuffer* stream_buffer,
+    FuriEventLoopStreamBufferCallback callback,
+    void* context);
+
+/** Unsubscribe from message queue or stream buffer
+ *
+ * Can be called from any callback of the same loop.
+ *
+ * @param      instance  pointer to FuriEventLoop instance
+ * @param      object    FuriMessageQueue or FuriStreamBuffer instance
+ */
+void furi_event_loop_unsubscribe(FuriEventLoop* instance, void* object);
+
+/** Subscribe to owner thread flags
+ *
+ * @param      instance  pointer to FuriEventLoop instance
+ * @param      flags     flags to wait for
+ * @param      callback  FuriEventLoopThreadFlagsCallback
+ * @param      context   callback context
+ */
+void furi_event_loop_subscribe_thread_flags(
+    FuriEventLoop* instance,
+    uint32_t flags,
+    FuriEventLoopThreadFlagsCallback callback,
+    void* context);
+
+/** Unsubscribe from owner thread flags
+ *
+ * @param      instance  pointer to FuriEventLoop instance
+ */
+void furi_event_loop_unsubscribe_thread_flags(FuriEventLoop* instance);
+
+/** Allocate FuriEventLoopTimer
+ *
+ * Timers are run by the loop itself, callback is called from the owner thread.
+ *
+ * @param      instance  pointer to FuriEventLoop instance
+ * @param      callback  FuriEventLoopTimerCallback
+ * @param      type      FuriEventLoopTimerType
+ * @param      context   callback context
+ *
+ * @return     pointer to FuriEventLoopTimer instance
+ */
+FuriEventLoopTimer* furi_event_loop_timer_alloc(
+    FuriEventLoop* instance,
+    FuriEventLoopTimerCallback callback,
+    FuriEventLoopTimerType type,
+    void* context);
+
+/** Free FuriEventLoopTimer
+ *
+ * Can be called from any callback of the same loop.
+ *
+ * @param      timer  pointer to FuriEventLoopTimer instance
+ */
+void furi_event_loop_timer_free(FuriEventLoopTimer* timer);
+
+/** Start or restart FuriEventLoopTimer
+ *
+ * @param      timer     pointer to FuriEventLoopTimer instance
+ * @param[in]  interval  interval in ticks, 1 to INT32_MAX
+ */
+void furi_event_loop_timer_start(FuriEventLoopTimer* timer, uint32_t interval);
+
+/** Stop FuriEventLoopTimer
+ *
+ * @param      timer  pointer to FuriEventLoopTimer instance
+ */
+void furi_event_loop_timer_stop(FuriEventLoopTimer* timer);
+
+/** Is FuriEventLoopTimer running
+ *
+ * @param      timer  pointer to FuriEventLoopTimer instance
+ *
+ * @return     true if running
+ */
+bool furi_event_loop_timer_is_running(FuriEventLoopTimer* timer);
+
+#ifdef __cplusplus
+}
+#endif
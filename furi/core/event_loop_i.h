@@ -0,0 +1,52 @@
+/**
+ * @file event_loop_i.h
+ * FuriEventLoop internals shared with the event sources
+ */
+#pragma once
+
+#include "event_loop.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Index 0 is used for stream buffers, 1 for thread flags
+#define FURI_EVENT_LOOP_NOTIFY_INDEX (2)
+
+typedef struct FuriEventLoopItem FuriEventLoopItem;
+
+/** Part of every object that can be subscribed to */
+typedef struct {
+    FuriEventLoopItem* item;
+} FuriEventLoopLink;
+
+/** Notify subscribed event loop, if any, about new data in the object
+ *
+ * Threadsafe, can be called from ISR.
+ *
+ * @param      link  pointer to FuriEventLoopLink of the object
+ */
+void furi_event_loop_link_notify(FuriEventLoopLink* link);
+
+/** Notify event loop of the thread that its thread flags were set
+ *
+ * Threadsafe, can be called from ISR.
+ *
+ * @param      thread_id  FuriThreadId of the thread
+ */
+void furi_event_loop_thread_flags_notify(FuriThreadId thread_id);
+
+FuriEventLoopLink* furi_message_queue_get_event_loop_link(FuriMessageQueue* instance);
+
+FuriEventLoopLink* furi_stream_buffer_get_event_loop_link(FuriStreamBuffer* stream_buffer);
+
+size_t furi_stream_buffer_get_trigger_level(FuriStreamBuffer* stream_buffer);
+
+void furi_thread_set_event_loop(FuriThread* thread, FuriEventLoop* event_loop);
+
+FuriEventLoop* furi_thread_get_event_loop(FuriThread* thread);
+
+#ifdef __cplusplus
+}
+#endif
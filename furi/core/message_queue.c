@@ -1,14 +1,27 @@
 #include "kernel.h"
 #include "message_queue.h"
+#include "event_loop_i.h"
+#include "memmgr.h"
 #include <FreeRTOS.h>
 #include <queue.h>
 #include "check.h"
 
+// Queue control block goes first, so instance is also a valid QueueHandle_t
+typedef struct {
+    StaticQueue_t container;
+    FuriEventLoopLink event_loop_link;
+    uint8_t buffer[];
+} FuriMessageQueueInternal;
+
 FuriMessageQueue* furi_message_queue_alloc(uint32_t msg_count, uint32_t msg_size) {
     furi_assert((furi_kernel_is_irq_or_masked() == 0U) && (msg_count > 0U) && (msg_size > 0U));
 
-    QueueHandle_t handle = xQueueCreate(msg_count, msg_size);
-    furi_check(handle);
+    FuriMessageQueueInternal* instance =
+        malloc(sizeof(FuriMessageQueueInternal) + msg_count * msg_size);
+
+    QueueHandle_t handle =
+        xQueueCreateStatic(msg_count, msg_size, instance->buffer, &instance->container);
+    furi_check(handle == (QueueHandle_t)instance);
 
     return ((FuriMessageQueue*)handle);
 }
@@ -17,7 +30,11 @@ void furi_message_queue_free(FuriMessageQueue* instance) {
     furi_assert(furi_kernel_is_irq_or_masked() == 0U);
     furi_assert(instance);
 
+    // Must be unsubscribed from event loop first
+    furi_check(((FuriMessageQueueInternal*)instance)->event_loop_link.item == NULL);
+
     vQueueDelete((QueueHandle_t)instance);
+    free(instance);
 }
 
 FuriStatus
@@ -37,6 +54,7 @@ FuriStatus
             if(xQueueSendToBackFromISR(hQueue, msg_ptr, &yield) != pdTRUE) {
                 stat = FuriStatusErrorResource;
             } else {
+                furi_event_loop_link_notify(furi_message_queue_get_event_loop_link(instance));
                 portYIELD_FROM_ISR(yield);
             }
         }
@@ -50,6 +68,8 @@ FuriStatus
                 } else {
                     stat = FuriStatusErrorResource;
                 }
+            } else {
+                furi_event_loop_link_notify(furi_message_queue_get_event_loop_link(instance));
             }
         }
     }
@@ -179,3 +199,8 @@ FuriStatus furi_message_queue_reset(FuriMessageQueue* instance) {
     /* Return execution status */
     return (stat);
 }
+
+FuriEventLoopLink* furi_message_queue_get_event_loop_link(FuriMessageQueue* instance) {
+    furi_assert(instance);
+    return &((FuriMessageQueueInternal*)instance)->event_loop_link;
+}
@@ -2,12 +2,19 @@
 #include "memmgr.h"
 #include "check.h"
 #include "mutex.h"
+#include "message_queue.h"
+#include "thread.h"
 
 #include <m-list.h>
 
+#define FURI_PUBSUB_DISPATCHER_STACK_SIZE (1024)
+
 struct FuriPubSubSubscription {
     FuriPubSubCallback callback;
     void* callback_context;
+    FuriPubSubDelivery delivery;
+    // Unsubscribed from async callback, removed after the walk
+    bool removed;
 };
 
 LIST_DEF(FuriPubSubSubscriptionList, FuriPubSubSubscription, M_POD_OPLIST);
@@ -15,6 +22,16 @@ LIST_DEF(FuriPubSubSubscriptionList, FuriPubSubSubscription, M_POD_OPLIST);
 struct FuriPubSub {
     FuriPubSubSubscriptionList_t items;
     FuriMutex* mutex;
+
+    // Async delivery, only with furi_pubsub_alloc_ex
+    FuriPubSubSubscriptionList_t async_items;
+    FuriMutex* async_mutex;
+    FuriMessageQueue* queue;
+    void* message;
+    FuriThread* dispatcher;
+    volatile bool dispatcher_stop;
+    bool dispatching;
+    uint32_t dropped_count;
 };
 
 FuriPubSub* furi_pubsub_alloc() {
@@ -24,6 +41,22 @@ FuriPubSub* furi_pubsub_alloc() {
     furi_assert(pubsub->mutex);
 
     FuriPubSubSubscriptionList_init(pubsub->items);
+    FuriPubSubSubscriptionList_init(pubsub->async_items);
+
+    return pubsub;
+}
+
+FuriPubSub* furi_pubsub_alloc_ex(size_t message_size, uint32_t queue_size) {
+    furi_assert(message_size);
+    furi_assert(queue_size);
+
+    FuriPubSub* pubsub = furi_pubsub_alloc();
+
+    // Recursive, so async callbacks can unsubscribe. Removal is deferred while the
+    // dispatcher walks the list, see furi_pubsub_unsubscribe
+    pubsub->async_mutex = furi_mutex_alloc(FuriMutexTypeRecursive);
+    pubsub->queue = furi_message_queue_alloc(queue_size, message_size);
+    pubsub->message = malloc(message_size);
 
     return pubsub;
 }
@@ -32,57 +65,163 @@ void furi_pubsub_free(FuriPubSub* pubsub) {
     furi_assert(pubsub);
 
     furi_check(FuriPubSubSubscriptionList_size(pubsub->items) == 0);
+    furi_check(FuriPubSubSubscriptionList_size(pubsub->async_items) == 0);
+
+    if(pubsub->dispatcher) {
+        // Wake the dispatcher, nobody is subscribed so the message goes nowhere
+        pubsub->dispatcher_stop = true;
+        furi_check(
+            furi_message_queue_put(pubsub->queue, pubsub->message, FuriWaitForever) ==
+            FuriStatusOk);
+        furi_thread_join(pubsub->dispatcher);
+        furi_thread_free(pubsub->dispatcher);
+    }
 
     FuriPubSubSubscriptionList_clear(pubsub->items);
+    FuriPubSubSubscriptionList_clear(pubsub->async_items);
+
+    if(pubsub->queue) {
+        furi_message_queue_free(pubsub->queue);
+        furi_mutex_free(pubsub->async_mutex);
+        free(pubsub->message);
+    }
 
     furi_mutex_free(pubsub->mutex);
 
     free(pubsub);
 }
 
+static int32_t furi_pubsub_dispatcher(void* context) {
+    FuriPubSub* pubsub = context;
+
+    while(true) {
+        furi_check(
+            furi_message_queue_get(pubsub->queue, pubsub->message, FuriWaitForever) ==
+            FuriStatusOk);
+        if(pubsub->dispatcher_stop) break;
+
+        furi_check(furi_mutex_acquire(pubsub->async_mutex, FuriWaitForever) == FuriStatusOk);
+
+        FuriPubSubSubscriptionList_it_t it;
+        pubsub->dispatching = true;
+        for(FuriPubSubSubscriptionList_it(it, pubsub->async_items);
+            !FuriPubSubSubscriptionList_end_p(it);
+            FuriPubSubSubscriptionList_next(it)) {
+            const FuriPubSubSubscription* item = FuriPubSubSubscriptionList_cref(it);
+            if(!item->removed) {
+                item->callback(pubsub->message, item->callback_context);
+            }
+        }
+        pubsub->dispatching = false;
+
+        // Sweep subscriptions removed by callbacks
+        FuriPubSubSubscriptionList_it(it, pubsub->async_items);
+        while(!FuriPubSubSubscriptionList_end_p(it)) {
+            if(FuriPubSubSubscriptionList_cref(it)->removed) {
+                FuriPubSubSubscriptionList_remove(pubsub->async_items, it);
+            } else {
+                FuriPubSubSubscriptionList_next(it);
+            }
+        }
+
+        furi_check(furi_mutex_release(pubsub->async_mutex) == FuriStatusOk);
+    }
+
+    return 0;
+}
+
 FuriPubSubSubscription*
     furi_pubsub_subscribe(FuriPubSub* pubsub, FuriPubSubCallback callback, void* callback_context) {
-    furi_check(furi_mutex_acquire(pubsub->mutex, FuriWaitForever) == FuriStatusOk);
+    return furi_pubsub_subscribe_ex(pubsub, callback, callback_context, FuriPubSubDeliverySync);
+}
+
+FuriPubSubSubscription* furi_pubsub_subscribe_ex(
+    FuriPubSub* pubsub,
+    FuriPubSubCallback callback,
+    void* callback_context,
+    FuriPubSubDelivery delivery) {
+    furi_assert(pubsub);
+
+    bool async = (delivery == FuriPubSubDeliveryAsync);
+    // Publisher must declare message size with furi_pubsub_alloc_ex
+    if(async) furi_check(pubsub->queue);
+    FuriMutex* mutex = async ? pubsub->async_mutex : pubsub->mutex;
+
+    furi_check(furi_mutex_acquire(mutex, FuriWaitForever) == FuriStatusOk);
     // put uninitialized item to the list
-    FuriPubSubSubscription* item = FuriPubSubSubscriptionList_push_raw(pubsub->items);
+    FuriPubSubSubscription* item =
+        FuriPubSubSubscriptionList_push_raw(async ? pubsub->async_items : pubsub->items);
 
     // initialize item
     item->callback = callback;
     item->callback_context = callback_context;
+    item->delivery = delivery;
+    item->removed = false;
+
+    // Dispatcher is started with the first async subscriber
+    if(async && !pubsub->dispatcher) {
+        pubsub->dispatcher = furi_thread_alloc_ex(
+            "PubSubDispatcher", FURI_PUBSUB_DISPATCHER_STACK_SIZE, furi_pubsub_dispatcher, pubsub);
+        furi_thread_start(pubsub->dispatcher);
+    }
 
-    furi_check(furi_mutex_release(pubsub->mutex) == FuriStatusOk);
+    furi_check(furi_mutex_release(mutex) == FuriStatusOk);
 
     return item;
 }
 
-void furi_pubsub_unsubscribe(FuriPubSub* pubsub, FuriPubSubSubscription* pubsub_subscription) {
-    furi_assert(pubsub);
-    furi_assert(pubsub_subscription);
-
-    furi_check(furi_mutex_acquire(pubsub->mutex, FuriWaitForever) == FuriStatusOk);
-    bool result = false;
-
+static bool furi_pubsub_remove(
+    FuriPubSubSubscriptionList_t items,
+    FuriPubSubSubscription* pubsub_subscription) {
     // iterate over items
     FuriPubSubSubscriptionList_it_t it;
-    for(FuriPubSubSubscriptionList_it(it, pubsub->items); !FuriPubSubSubscriptionList_end_p(it);
+    for(FuriPubSubSubscriptionList_it(it, items); !FuriPubSubSubscriptionList_end_p(it);
         FuriPubSubSubscriptionList_next(it)) {
         const FuriPubSubSubscription* item = FuriPubSubSubscriptionList_cref(it);
 
         // if the iterator is equal to our element
         if(item == pubsub_subscription) {
-            FuriPubSubSubscriptionList_remove(pubsub->items, it);
-            result = true;
-            break;
+            FuriPubSubSubscriptionList_remove(items, it);
+            return true;
         }
     }
 
-    furi_check(furi_mutex_release(pubsub->mutex) == FuriStatusOk);
+    return false;
+}
+
+void furi_pubsub_unsubscribe(FuriPubSub* pubsub, FuriPubSubSubscription* pubsub_subscription) {
+    furi_assert(pubsub);
+    furi_assert(pubsub_subscription);
+
+    bool async = (pubsub_subscription->delivery == FuriPubSubDeliveryAsync);
+    FuriMutex* mutex = async ? pubsub->async_mutex : pubsub->mutex;
+
+    // Waits for the dispatcher, no async callback runs after return
+    furi_check(furi_mutex_acquire(mutex, FuriWaitForever) == FuriStatusOk);
+    bool result;
+    if(async && pubsub->dispatching) {
+        // Called from async callback, the dispatcher is iterating over the list
+        furi_check(!pubsub_subscription->removed);
+        pubsub_subscription->removed = true;
+        result = true;
+    } else {
+        result =
+            furi_pubsub_remove(async ? pubsub->async_items : pubsub->items, pubsub_subscription);
+    }
+    furi_check(furi_mutex_release(mutex) == FuriStatusOk);
     furi_check(result);
 }
 
 void furi_pubsub_publish(FuriPubSub* pubsub, void* message) {
     furi_check(furi_mutex_acquire(pubsub->mutex, FuriWaitForever) == FuriStatusOk);
 
+    // Copy for async subscribers, never wait for the dispatcher
+    if(pubsub->dispatcher) {
+        if(furi_message_queue_put(pubsub->queue, message, 0) != FuriStatusOk) {
+            pubsub->dropped_count++;
+        }
+    }
+
     // iterate over subscribers
     FuriPubSubSubscriptionList_it_t it;
     for(FuriPubSubSubscriptionList_it(it, pubsub->items); !FuriPubSubSubscriptionList_end_p(it);
@@ -93,3 +232,13 @@ void furi_pubsub_publish(FuriPubSub* pubsub, void* message) {
 
     furi_check(furi_mutex_release(pubsub->mutex) == FuriStatusOk);
 }
+
+uint32_t furi_pubsub_get_queue_count(FuriPubSub* pubsub) {
+    furi_assert(pubsub);
+    return pubsub->queue ? furi_message_queue_get_count(pubsub->queue) : 0;
+}
+
+uint32_t furi_pubsub_get_dropped_count(FuriPubSub* pubsub) {
+    furi_assert(pubsub);
+    return pubsub->dropped_count;
+}
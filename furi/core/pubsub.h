@@ -4,6 +4,9 @@
  */
 #pragma once
 
+#include "core/base.h"
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -17,6 +20,12 @@ typedef struct FuriPubSub FuriPubSub;
 /** FuriPubSubSubscription type */
 typedef struct FuriPubSubSubscription FuriPubSubSubscription;
 
+/** FuriPubSub delivery mode */
+typedef enum {
+    FuriPubSubDeliverySync, ///< Called from publisher thread, publish waits for callback
+    FuriPubSubDeliveryAsync, ///< Called from dispatcher thread with a copy of the message
+} FuriPubSubDelivery;
+
 /** Allocate FuriPubSub
  *
  * Reentrable, Not threadsafe, one owner
@@ -25,6 +34,19 @@ typedef struct FuriPubSubSubscription FuriPubSubSubscription;
  */
 FuriPubSub* furi_pubsub_alloc();
 
+/** Allocate FuriPubSub with async delivery support
+ *
+ * Published messages are copied into a bounded queue for async subscribers,
+ * dispatcher thread is started with the first async subscriber. Messages that
+ * do not fit in the queue are dropped and counted.
+ *
+ * @param[in]  message_size  size of published message
+ * @param[in]  queue_size    maximum messages waiting for async subscribers
+ *
+ * @return     pointer to FuriPubSub instance
+ */
+FuriPubSub* furi_pubsub_alloc_ex(size_t message_size, uint32_t queue_size);
+
 /** Free FuriPubSub
  * 
  * @param      pubsub  FuriPubSub instance
@@ -44,10 +66,34 @@ void furi_pubsub_free(FuriPubSub* pubsub);
 FuriPubSubSubscription*
     furi_pubsub_subscribe(FuriPubSub* pubsub, FuriPubSubCallback callback, void* callback_context);
 
+/** Subscribe to FuriPubSub with chosen delivery mode
+ *
+ * Threadsafe, Reentrable
+ *
+ * FuriPubSubDeliveryAsync requires FuriPubSub allocated with
+ * furi_pubsub_alloc_ex. Message pointer passed to async callback is valid
+ * only during the call.
+ *
+ * @param      pubsub            pointer to FuriPubSub instance
+ * @param[in]  callback          The callback
+ * @param      callback_context  The callback context
+ * @param[in]  delivery          FuriPubSubDelivery
+ *
+ * @return     pointer to FuriPubSubSubscription instance
+ */
+FuriPubSubSubscription* furi_pubsub_subscribe_ex(
+    FuriPubSub* pubsub,
+    FuriPubSubCallback callback,
+    void* callback_context,
+    FuriPubSubDelivery delivery);
+
 /** Unsubscribe from FuriPubSub
  * 
  * No use of `pubsub_subscription` allowed after call of this method
- * Threadsafe, Reentrable.
+ * Callback is not called after return, even with async delivery.
+ * Threadsafe, Reentrable. Async callbacks may unsubscribe any async
+ * subscription, removal is deferred until the dispatcher ends its walk.
+ * Sync callbacks must not unsubscribe.
  *
  * @param      pubsub               pointer to FuriPubSub instance
  * @param      pubsub_subscription  pointer to FuriPubSubSubscription instance
@@ -57,12 +103,30 @@ void furi_pubsub_unsubscribe(FuriPubSub* pubsub, FuriPubSubSubscription* pubsub_
 /** Publish message to FuriPubSub
  *
  * Threadsafe, Reentrable.
+ * Sync subscribers are called before return, async subscribers get a copy
+ * of the message later, publish never waits for them.
  * 
  * @param      pubsub   pointer to FuriPubSub instance
  * @param      message  message pointer to publish
  */
 void furi_pubsub_publish(FuriPubSub* pubsub, void* message);
 
+/** Get count of messages waiting for async subscribers
+ *
+ * @param      pubsub  pointer to FuriPubSub instance
+ *
+ * @return     queue depth, 0 if async delivery is not supported
+ */
+uint32_t furi_pubsub_get_queue_count(FuriPubSub* pubsub);
+
+/** Get count of messages dropped because async queue was full
+ *
+ * @param      pubsub  pointer to FuriPubSub instance
+ *
+ * @return     dropped messages count
+ */
+uint32_t furi_pubsub_get_dropped_count(FuriPubSub* pubsub);
+
 #ifdef __cplusplus
 }
 #endif
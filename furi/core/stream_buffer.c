@@ -2,26 +2,50 @@
 #include "check.h"
 #include "stream_buffer.h"
 #include "common_defines.h"
+#include "event_loop_i.h"
+#include "memmgr.h"
 #include <FreeRTOS.h>
 #include <FreeRTOS-Kernel/include/stream_buffer.h>
 
+// Stream buffer control block goes first, so instance is also a valid StreamBufferHandle_t
+typedef struct {
+    StaticStreamBuffer_t container;
+    FuriEventLoopLink event_loop_link;
+    size_t trigger_level;
+    uint8_t buffer[];
+} FuriStreamBufferInternal;
+
 FuriStreamBuffer* furi_stream_buffer_alloc(size_t size, size_t trigger_level) {
     furi_assert(size != 0);
 
-    StreamBufferHandle_t handle = xStreamBufferCreate(size, trigger_level);
-    furi_check(handle);
+    // Static stream buffer holds one byte less than its storage, so add one for full size
+    FuriStreamBufferInternal* instance = malloc(sizeof(FuriStreamBufferInternal) + size + 1);
+    instance->trigger_level = trigger_level;
+
+    StreamBufferHandle_t handle = xStreamBufferCreateStatic(
+        size + 1, trigger_level, instance->buffer, &instance->container);
+    furi_check(handle == (StreamBufferHandle_t)instance);
 
     return handle;
 };
 
 void furi_stream_buffer_free(FuriStreamBuffer* stream_buffer) {
     furi_assert(stream_buffer);
+
+    // Must be unsubscribed from event loop first
+    furi_check(((FuriStreamBufferInternal*)stream_buffer)->event_loop_link.item == NULL);
+
     vStreamBufferDelete(stream_buffer);
+    free(stream_buffer);
 };
 
 bool furi_stream_set_trigger_level(FuriStreamBuffer* stream_buffer, size_t trigger_level) {
     furi_assert(stream_buffer);
-    return xStreamBufferSetTriggerLevel(stream_buffer, trigger_level) == pdTRUE;
+    bool ret = xStreamBufferSetTriggerLevel(stream_buffer, trigger_level) == pdTRUE;
+    if(ret) {
+        ((FuriStreamBufferInternal*)stream_buffer)->trigger_level = trigger_level;
+    }
+    return ret;
 };
 
 size_t furi_stream_buffer_send(
@@ -39,6 +63,12 @@ size_t furi_stream_buffer_send(
         ret = xStreamBufferSend(stream_buffer, data, length, timeout);
     }
 
+    FuriStreamBufferInternal* instance = stream_buffer;
+    if(ret && instance->event_loop_link.item &&
+       (xStreamBufferBytesAvailable(stream_buffer) >= instance->trigger_level)) {
+        furi_event_loop_link_notify(&instance->event_loop_link);
+    }
+
     return ret;
 };
 
@@ -82,4 +112,14 @@ FuriStatus furi_stream_buffer_reset(FuriStreamBuffer* stream_buffer) {
     } else {
         return FuriStatusError;
     }
-}
\ No newline at end of file
+}
+
+FuriEventLoopLink* furi_stream_buffer_get_event_loop_link(FuriStreamBuffer* stream_buffer) {
+    furi_assert(stream_buffer);
+    return &((FuriStreamBufferInternal*)stream_buffer)->event_loop_link;
+}
+
+size_t furi_stream_buffer_get_trigger_level(FuriStreamBuffer* stream_buffer) {
+    furi_assert(stream_buffer);
+    return ((FuriStreamBufferInternal*)stream_buffer)->trigger_level;
+}
@@ -6,6 +6,7 @@
 #include "common_defines.h"
 #include "mutex.h"
 #include "string.h"
+#include "event_loop_i.h"
 
 #include <task.h>
 #include "log.h"
@@ -43,6 +44,8 @@ struct FuriThread {
 
     FuriThreadStdout output;
 
+    FuriEventLoop* event_loop;
+
     // Keep all non-alignable byte types in one place,
     // this ensures that the size of this structure is minimal
     bool is_service;
@@ -333,6 +336,16 @@ FuriThreadId furi_thread_get_current_id() {
     return xTaskGetCurrentTaskHandle();
 }
 
+void furi_thread_set_event_loop(FuriThread* thread, FuriEventLoop* event_loop) {
+    furi_assert(thread);
+    thread->event_loop = event_loop;
+}
+
+FuriEventLoop* furi_thread_get_event_loop(FuriThread* thread) {
+    furi_assert(thread);
+    return thread->event_loop;
+}
+
 FuriThread* furi_thread_get_current() {
     FuriThread* thread = pvTaskGetThreadLocalStoragePointer(NULL, 0);
     return thread;
@@ -372,6 +385,12 @@ uint32_t furi_thread_flags_set(FuriThreadId thread_id, uint32_t flags) {
             (void)xTaskNotifyIndexed(hTask, THREAD_NOTIFY_INDEX, flags, eSetBits);
             (void)xTaskNotifyAndQueryIndexed(hTask, THREAD_NOTIFY_INDEX, 0, eNoAction, &rflags);
         }
+
+        // Event loop waits on its own notification index
+        FuriThread* thread = pvTaskGetThreadLocalStoragePointer(hTask, 0);
+        if(thread && thread->event_loop) {
+            furi_event_loop_thread_flags_notify(thread_id);
+        }
     }
     /* Return flags after setting */
     return (rflags);
@@ -36,3 +36,43 @@ bool elf_resolve_from_hashtable(
 
     return result;
 }
+
+bool elf_resolve_from_bucketed_hashtable(
+    const ElfApiInterface* interface,
+    const char* name,
+    Elf32_Addr* address) {
+    const BucketedHashtableApiInterface* hashtable_interface =
+        static_cast<const BucketedHashtableApiInterface*>(interface);
+    uint32_t gnu_sym_hash = elf_gnu_hash(name);
+
+    // Most of missing symbols are rejected without search, composite resolvers
+    // ask each table in turn, so misses are common and not worth a warning
+    const uint32_t bloom_bits = sym_entry_bloom_bits(gnu_sym_hash);
+    const uint32_t bloom_word = hashtable_interface->bloom[sym_entry_bloom_word(
+        gnu_sym_hash, hashtable_interface->bloom_mask)];
+    if((bloom_word & bloom_bits) != bloom_bits) {
+        FURI_LOG_T(TAG, "No symbol '%s' @ %p", name, hashtable_interface->table_cbegin);
+        return false;
+    }
+
+    const uint32_t bucket =
+        sym_entry_bucket_key(gnu_sym_hash) >> hashtable_interface->bucket_shift;
+    const sym_entry* bucket_begin =
+        hashtable_interface->table_cbegin + hashtable_interface->buckets[bucket];
+    const sym_entry* bucket_end =
+        hashtable_interface->table_cbegin + hashtable_interface->buckets[bucket + 1];
+
+    sym_entry key = {
+        .hash = gnu_sym_hash,
+        .address = 0,
+    };
+
+    auto find_res = std::lower_bound(bucket_begin, bucket_end, key, sym_entry_bucket_order{});
+    if(find_res == bucket_end || find_res->hash != gnu_sym_hash) {
+        FURI_LOG_T(TAG, "No symbol '%s' @ %p", name, hashtable_interface->table_cbegin);
+        return false;
+    }
+
+    *address = find_res->address;
+    return true;
+}
@@ -28,6 +28,19 @@ bool elf_resolve_from_hashtable(
     const char* name,
     Elf32_Addr* address);
 
+/**
+ * @brief Resolver for API entries using a table in bucket order with bucket
+ * index and bloom filter, see BucketedHashtableApiInterface
+ * @param interface pointer to BucketedHashtableApiInterface
+ * @param name function name
+ * @param address output for function address
+ * @return true if the table contains a function
+ */
+bool elf_resolve_from_bucketed_hashtable(
+    const ElfApiInterface* interface,
+    const char* name,
+    Elf32_Addr* address);
+
 #ifdef __cplusplus
 }
 
@@ -43,6 +56,19 @@ struct HashtableApiInterface : public ElfApiInterface {
     const sym_entry *table_cbegin, *table_cend;
 };
 
+/**
+ * @brief  BucketedHashtableApiInterface is a HashtableApiInterface that rejects
+ * missing symbols with a bloom filter and searches only one bucket of the table.
+ * Table must be sorted in sym_entry_bucket_order, buckets and bloom are made by
+ * make_api_hashtable_index from the same table.
+ */
+struct BucketedHashtableApiInterface : public HashtableApiInterface {
+    const uint16_t* buckets;
+    uint32_t bucket_shift;
+    const uint32_t* bloom;
+    uint32_t bloom_mask;
+};
+
 #define API_METHOD(x, ret_type, args_type)                                                     \
     sym_entry {                                                                                \
         .hash = elf_gnu_hash(#x), .address = (uint32_t)(static_cast<ret_type(*) args_type>(x)) \
@@ -82,4 +108,91 @@ constexpr bool has_hash_collisions(const std::array<sym_entry, N>& api_methods)
     return false;
 }
 
-#endif
\ No newline at end of file
+/**
+ * @brief Bucket key of a hash. Multiplication spreads GNU hash bits, so top
+ * bits of the key select evenly filled buckets. It is a bijection, equal keys
+ * mean equal hashes.
+ */
+constexpr uint32_t sym_entry_bucket_key(uint32_t hash) {
+    return hash * 0x9E3779B1U;
+}
+
+/**
+ * @brief Table order for BucketedHashtableApiInterface, use with sort()
+ */
+struct sym_entry_bucket_order {
+    constexpr bool operator()(const sym_entry& k1, const sym_entry& k2) const {
+        return sym_entry_bucket_key(k1.hash) < sym_entry_bucket_key(k2.hash);
+    }
+};
+
+/* Bloom filter sets two bits of one word per symbol */
+constexpr uint32_t sym_entry_bloom_word(uint32_t hash, uint32_t bloom_mask) {
+    return (hash >> 5) & bloom_mask;
+}
+
+constexpr uint32_t sym_entry_bloom_bits(uint32_t hash) {
+    return (1UL << (hash & 31)) | (1UL << ((hash >> 26) & 31));
+}
+
+constexpr std::size_t api_hashtable_pow2(std::size_t n) {
+    std::size_t result = 1;
+    while(result < n) {
+        result <<= 1;
+    }
+    return result;
+}
+
+constexpr uint32_t api_hashtable_log2(std::size_t n) {
+    uint32_t result = 0;
+    while(n > 1) {
+        n >>= 1;
+        result++;
+    }
+    return result;
+}
+
+/**
+ * @brief Bucket index and bloom filter of a table with N entries.
+ * About 4 entries per bucket and 8 bloom bits per entry.
+ */
+template <std::size_t N>
+struct ApiHashtableIndex {
+    static constexpr std::size_t bucket_count = api_hashtable_pow2(N / 4 > 2 ? N / 4 : 2);
+    static constexpr uint32_t bucket_shift = 32 - api_hashtable_log2(bucket_count);
+    static constexpr std::size_t bloom_words = api_hashtable_pow2(N / 4 > 1 ? N / 4 : 1);
+
+    std::array<uint16_t, bucket_count + 1> buckets;
+    std::array<uint32_t, bloom_words> bloom;
+};
+
+/**
+ * @brief Build bucket index and bloom filter at compile time
+ * @param table table sorted in sym_entry_bucket_order
+ * @return ApiHashtableIndex
+ */
+template <std::size_t N>
+constexpr auto make_api_hashtable_index(const std::array<sym_entry, N>& table) {
+    static_assert(N < UINT16_MAX, "API table is too big for bucket index");
+    using Index = ApiHashtableIndex<N>;
+    Index index{};
+
+    // Bucket b spans from buckets[b] to buckets[b + 1]
+    std::size_t entry = 0;
+    for(std::size_t bucket = 0; bucket <= Index::bucket_count; bucket++) {
+        while(entry < N && (sym_entry_bucket_key(table[entry].hash) >> Index::bucket_shift) <
+                               bucket) {
+            entry++;
+        }
+        index.buckets[bucket] = entry;
+    }
+
+    for(const sym_entry& sym : table) {
+        index.bloom[sym_entry_bloom_word(sym.hash, Index::bloom_words - 1)] |=
+            sym_entry_bloom_bits(sym.hash);
+    }
+
+    return index;
+}
+
+#endif
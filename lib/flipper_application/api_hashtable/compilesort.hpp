@@ -73,6 +73,12 @@ constexpr auto sort(Range&& range) {
     return range;
 }
 
+template <typename Range, class Compare>
+constexpr auto sort(Range&& range, Compare cmp) {
+    quick_sort(std::begin(range), std::end(range), cmp);
+    return range;
+}
+
 template <typename V, typename... T>
 constexpr auto array_of(T&&... t) -> std::array<V, sizeof...(T)> {
     return {{std::forward<T>(t)...}};
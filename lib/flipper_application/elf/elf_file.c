@@ -3,12 +3,23 @@
 #include "elf_file_i.h"
 #include "elf_api_interface.h"
 
+#include <lib/heatshrink/heatshrink_decoder.h>
+
 #define TAG "elf"
 
 #define ELF_NAME_BUFFER_LEN 32
 #define SECTION_OFFSET(e, n) ((e)->section_table + (n) * sizeof(Elf32_Shdr))
 #define IS_FLAGS_SET(v, m) (((v) & (m)) == (m))
 #define RESOLVER_THREAD_YIELD_STEP 30
+#define RELOCATION_READ_BATCH_SIZE 32
+/* Tables are bulk-loaded only if they take no more than this fraction of the biggest free block */
+#define TABLES_ARENA_HEAP_DIVIDER 4
+
+/* Heatshrink compressed sections, parameters must match scripts/fbt/elfcompress.py */
+#define ELF_COMPRESS_HEATSHRINK (ELFCOMPRESS_LOOS + 0x4853)
+#define ELF_COMPRESS_WINDOW_SZ2 10
+#define ELF_COMPRESS_LOOKAHEAD_SZ2 5
+#define ELF_COMPRESS_READ_SIZE 512
 
 // #define ELF_DEBUG_LOG 1
 
@@ -106,15 +117,54 @@ static bool elf_read_string_from_offset(ELFFile* elf, off_t offset, FuriString*
     return result;
 }
 
+static bool elf_read_string_from_table(
+    const char* table,
+    size_t table_size,
+    off_t offset,
+    FuriString* name) {
+    if(offset < 0 || (size_t)offset >= table_size) {
+        return false;
+    }
+
+    const char* string = table + offset;
+    size_t max_length = table_size - offset;
+    if(strnlen(string, max_length) == max_length) {
+        // not null-terminated within the table
+        return false;
+    }
+
+    furi_string_cat_str(name, string);
+    return true;
+}
+
 static bool elf_read_section_name(ELFFile* elf, off_t offset, FuriString* name) {
+    if(elf->arena.section_names) {
+        return elf_read_string_from_table(
+            elf->arena.section_names, elf->arena.section_names_size, offset, name);
+    }
+
     return elf_read_string_from_offset(elf, elf->section_table_strings + offset, name);
 }
 
 static bool elf_read_symbol_name(ELFFile* elf, off_t offset, FuriString* name) {
+    if(elf->arena.symbol_names) {
+        return elf_read_string_from_table(
+            elf->arena.symbol_names, elf->arena.symbol_names_size, offset, name);
+    }
+
     return elf_read_string_from_offset(elf, elf->symbol_table_strings + offset, name);
 }
 
 static bool elf_read_section_header(ELFFile* elf, size_t section_idx, Elf32_Shdr* section_header) {
+    if(elf->arena.section_headers) {
+        if(section_idx >= elf->sections_count) {
+            return false;
+        }
+
+        *section_header = elf->arena.section_headers[section_idx];
+        return true;
+    }
+
     off_t offset = SECTION_OFFSET(elf, section_idx);
     return storage_file_seek(elf->fd, offset, true) &&
            storage_file_read(elf->fd, section_header, sizeof(Elf32_Shdr)) == sizeof(Elf32_Shdr);
@@ -137,6 +187,20 @@ static bool elf_read_section(
 }
 
 static bool elf_read_symbol(ELFFile* elf, int n, Elf32_Sym* sym, FuriString* name) {
+    if(elf->arena.symbols) {
+        if(n < 0 || (size_t)n >= elf->symbol_count) {
+            return false;
+        }
+
+        *sym = elf->arena.symbols[n];
+        if(sym->st_name) {
+            return elf_read_symbol_name(elf, sym->st_name, name);
+        } else {
+            Elf32_Shdr shdr;
+            return elf_read_section(elf, sym->st_shndx, &shdr, name);
+        }
+    }
+
     bool success = false;
     off_t old = storage_file_tell(elf->fd);
     off_t pos = elf->symbol_table + n * sizeof(Elf32_Sym);
@@ -153,6 +217,60 @@ static bool elf_read_symbol(ELFFile* elf, int n, Elf32_Sym* sym, FuriString* nam
     return success;
 }
 
+/**************************************************************************************************/
+/****************************************** Tables arena ******************************************/
+/**************************************************************************************************/
+
+static bool elf_tables_arena_can_fit(size_t size) {
+    return size <= memmgr_heap_get_max_free_block() / TABLES_ARENA_HEAP_DIVIDER;
+}
+
+static void* elf_tables_arena_read(ELFFile* elf, off_t offset, size_t size) {
+    void* data = malloc(size);
+    if(!storage_file_seek(elf->fd, offset, true) ||
+       storage_file_read(elf->fd, data, size) != size) {
+        free(data);
+        return NULL;
+    }
+
+    return data;
+}
+
+static void elf_tables_arena_load_headers(ELFFile* elf) {
+    size_t headers_size = elf->sections_count * sizeof(Elf32_Shdr);
+    if(!elf_tables_arena_can_fit(headers_size + elf->section_table_strings_size)) {
+        FURI_LOG_D(TAG, "Not enough memory to preload section headers");
+        return;
+    }
+
+    elf->arena.section_headers = elf_tables_arena_read(elf, elf->section_table, headers_size);
+    elf->arena.section_names = elf_tables_arena_read(
+        elf, elf->section_table_strings, elf->section_table_strings_size);
+    elf->arena.section_names_size = elf->section_table_strings_size;
+}
+
+static void elf_tables_arena_load_symbols(ELFFile* elf) {
+    size_t symbols_size = elf->symbol_count * sizeof(Elf32_Sym);
+    if(!elf_tables_arena_can_fit(symbols_size + elf->symbol_table_strings_size)) {
+        FURI_LOG_D(TAG, "Not enough memory to preload symbol table");
+        return;
+    }
+
+    elf->arena.symbols = elf_tables_arena_read(elf, elf->symbol_table, symbols_size);
+    elf->arena.symbol_names = elf_tables_arena_read(
+        elf, elf->symbol_table_strings, elf->symbol_table_strings_size);
+    elf->arena.symbol_names_size = elf->symbol_table_strings_size;
+}
+
+static void elf_tables_arena_free(ELFFile* elf) {
+    // free() is fine with NULL, so partially loaded arena is not a problem
+    free(elf->arena.section_headers);
+    free(elf->arena.section_names);
+    free(elf->arena.symbols);
+    free(elf->arena.symbol_names);
+    memset(&elf->arena, 0, sizeof(ELFTablesArena));
+}
+
 static ELFSection* elf_section_of(ELFFile* elf, int index) {
     ELFSectionDict_it_t it;
     for(ELFSectionDict_it(it, elf->sections); !ELFSectionDict_end_p(it); ELFSectionDict_next(it)) {
@@ -340,10 +458,11 @@ static bool elf_relocate_symbol(ELFFile* elf, Elf32_Addr relAddr, int type, Elf3
 
 static bool elf_relocate(ELFFile* elf, ELFSection* s) {
     if(s->data) {
-        Elf32_Rel rel;
+        Elf32_Rel rel_batch[RELOCATION_READ_BATCH_SIZE];
+        size_t rel_batch_count = 0;
+        size_t rel_batch_pos = 0;
         size_t relEntries = s->rel_count;
         size_t relCount;
-        (void)storage_file_seek(elf->fd, s->rel_offset, true);
         FURI_LOG_D(TAG, " Offset   Info     Type             Name");
 
         int relocate_result = true;
@@ -356,12 +475,21 @@ static bool elf_relocate(ELFFile* elf, ELFSection* s) {
                 furi_delay_tick(1);
             }
 
-            if(storage_file_read(elf->fd, &rel, sizeof(Elf32_Rel)) != sizeof(Elf32_Rel)) {
-                FURI_LOG_E(TAG, "  reloc read fail");
-                furi_string_free(symbol_name);
-                return false;
+            if(rel_batch_pos >= rel_batch_count) {
+                rel_batch_count = MIN(relEntries - relCount, (size_t)RELOCATION_READ_BATCH_SIZE);
+                rel_batch_pos = 0;
+                size_t rel_batch_size = rel_batch_count * sizeof(Elf32_Rel);
+                // Symbol and section name lookups may move file position, seek each batch
+                off_t rel_batch_offset = s->rel_offset + relCount * sizeof(Elf32_Rel);
+                if(!storage_file_seek(elf->fd, rel_batch_offset, true) ||
+                   storage_file_read(elf->fd, rel_batch, rel_batch_size) != rel_batch_size) {
+                    FURI_LOG_E(TAG, "  reloc read fail");
+                    furi_string_free(symbol_name);
+                    return false;
+                }
             }
 
+            const Elf32_Rel rel = rel_batch[rel_batch_pos++];
             Elf32_Addr symAddr;
 
             int symEntry = ELF32_R_SYM(rel.r_info);
@@ -441,27 +569,123 @@ static bool str_prefix(const char* str, const char* prefix) {
     return strncmp(prefix, str, strlen(prefix)) == 0;
 }
 
+/* Decode into section data, any output past its end means that data is corrupted */
+static bool
+    elf_decompress_poll(heatshrink_decoder* decoder, ELFSection* section, size_t* decoded) {
+    HSD_poll_res poll_res;
+    do {
+        uint8_t overflow;
+        size_t left = section->size - *decoded;
+        uint8_t* out = left ? (uint8_t*)section->data + *decoded : &overflow;
+        size_t poll_size = 0;
+
+        poll_res = heatshrink_decoder_poll(decoder, out, left ? left : 1, &poll_size);
+        if(poll_res < 0 || (left == 0 && poll_size > 0)) {
+            return false;
+        }
+        *decoded += poll_size;
+    } while(poll_res == HSDR_POLL_MORE);
+
+    return true;
+}
+
+/* Read compressed data in chunks and decompress it straight into section data */
+static bool elf_decompress_section_data(ELFFile* elf, ELFSection* section, size_t size) {
+    heatshrink_decoder* decoder = heatshrink_decoder_alloc(
+        ELF_COMPRESS_READ_SIZE, ELF_COMPRESS_WINDOW_SZ2, ELF_COMPRESS_LOOKAHEAD_SZ2);
+    uint8_t* buffer = malloc(ELF_COMPRESS_READ_SIZE);
+    size_t decoded = 0;
+    bool success = true;
+
+    while(success && size > 0) {
+        size_t chunk_size = MIN(size, (size_t)ELF_COMPRESS_READ_SIZE);
+        if(storage_file_read(elf->fd, buffer, chunk_size) != chunk_size) {
+            success = false;
+            break;
+        }
+        size -= chunk_size;
+
+        size_t sunk = 0;
+        while(success && sunk < chunk_size) {
+            size_t sink_size = 0;
+            if(heatshrink_decoder_sink(decoder, &buffer[sunk], chunk_size - sunk, &sink_size) <
+               0) {
+                success = false;
+                break;
+            }
+            sunk += sink_size;
+            success = elf_decompress_poll(decoder, section, &decoded);
+        }
+    }
+
+    while(success) {
+        HSD_finish_res finish_res = heatshrink_decoder_finish(decoder);
+        if(finish_res < 0) {
+            success = false;
+        } else if(finish_res == HSDR_FINISH_DONE) {
+            break;
+        } else {
+            success = elf_decompress_poll(decoder, section, &decoded);
+        }
+    }
+
+    heatshrink_decoder_free(decoder);
+    free(buffer);
+
+    return success && decoded == section->size;
+}
+
 static bool elf_load_section_data(ELFFile* elf, ELFSection* section, Elf32_Shdr* section_header) {
     if(section_header->sh_size == 0) {
         FURI_LOG_D(TAG, "No data for section");
         return true;
     }
 
-    section->data = aligned_malloc(section_header->sh_size, section_header->sh_addralign);
-    section->size = section_header->sh_size;
-
     if(section_header->sh_type == SHT_NOBITS) {
         // BSS section, no data to load
+        section->data = aligned_malloc(section_header->sh_size, section_header->sh_addralign);
+        section->size = section_header->sh_size;
         return true;
     }
 
-    if((!storage_file_seek(elf->fd, section_header->sh_offset, true)) ||
-       (storage_file_read(elf->fd, section->data, section_header->sh_size) !=
-        section_header->sh_size)) {
-        FURI_LOG_E(TAG, "    seek/read fail");
+    if(!storage_file_seek(elf->fd, section_header->sh_offset, true)) {
+        FURI_LOG_E(TAG, "    seek fail");
         return false;
     }
 
+    elf->section_data_read += section_header->sh_size;
+
+    if(section_header->sh_flags & SHF_COMPRESSED) {
+        Elf32_Chdr compression_header;
+        if(storage_file_read(elf->fd, &compression_header, sizeof(Elf32_Chdr)) !=
+               sizeof(Elf32_Chdr) ||
+           compression_header.ch_type != ELF_COMPRESS_HEATSHRINK ||
+           section_header->sh_size < sizeof(Elf32_Chdr)) {
+            FURI_LOG_E(TAG, "    unsupported compression");
+            return false;
+        }
+
+        section->data =
+            aligned_malloc(compression_header.ch_size, compression_header.ch_addralign);
+        section->size = compression_header.ch_size;
+        elf->compressed_sections_count++;
+
+        if(!elf_decompress_section_data(
+               elf, section, section_header->sh_size - sizeof(Elf32_Chdr))) {
+            FURI_LOG_E(TAG, "    decompression fail");
+            return false;
+        }
+    } else {
+        section->data = aligned_malloc(section_header->sh_size, section_header->sh_addralign);
+        section->size = section_header->sh_size;
+
+        if(storage_file_read(elf->fd, section->data, section_header->sh_size) !=
+           section_header->sh_size) {
+            FURI_LOG_E(TAG, "    read fail");
+            return false;
+        }
+    }
+
     FURI_LOG_D(TAG, "0x%p", section->data);
     return true;
 }
@@ -486,7 +710,7 @@ static SectionType elf_preload_section(
     if(section_header->sh_flags & SHF_OS_NONCONFORMING) furi_string_cat(flags_string, "O");
     if(section_header->sh_flags & SHF_GROUP) furi_string_cat(flags_string, "G");
     if(section_header->sh_flags & SHF_TLS) furi_string_cat(flags_string, "T");
-    if(section_header->sh_flags & SHF_COMPRESSED) furi_string_cat(flags_string, "T");
+    if(section_header->sh_flags & SHF_COMPRESSED) furi_string_cat(flags_string, "C");
     if(section_header->sh_flags & SHF_MASKOS) furi_string_cat(flags_string, "o");
     if(section_header->sh_flags & SHF_MASKPROC) furi_string_cat(flags_string, "p");
     if(section_header->sh_flags & SHF_ORDERED) furi_string_cat(flags_string, "R");
@@ -555,6 +779,7 @@ static SectionType elf_preload_section(
     if(strcmp(name, ".strtab") == 0) {
         FURI_LOG_D(TAG, "Found .strtab section");
         elf->symbol_table_strings = section_header->sh_offset;
+        elf->symbol_table_strings_size = section_header->sh_size;
         return SectionTypeStrTab;
     }
 
@@ -610,6 +835,10 @@ ELFFile* elf_file_alloc(Storage* storage, const ElfApiInterface* api_interface)
     elf->api_interface = api_interface;
     ELFSectionDict_init(elf->sections);
     AddressCache_init(elf->trampoline_cache);
+    memset(&elf->arena, 0, sizeof(ELFTablesArena));
+    memset(&elf->load_timings, 0, sizeof(ELFLoadTimings));
+    elf->section_data_read = 0;
+    elf->compressed_sections_count = 0;
     elf->init_array_called = false;
     return elf;
 }
@@ -652,6 +881,8 @@ void elf_file_free(ELFFile* elf) {
         free(elf->debug_link_info.debug_link);
     }
 
+    elf_tables_arena_free(elf);
+
     if(elf->fd != NULL) {
         storage_file_free(elf->fd);
     }
@@ -661,6 +892,7 @@ void elf_file_free(ELFFile* elf) {
 bool elf_file_open(ELFFile* elf, const char* path) {
     Elf32_Ehdr h;
     Elf32_Shdr sH;
+    uint32_t start_tick = furi_get_tick();
 
     if(!storage_file_open(elf->fd, path, FSAM_READ, FSOM_OPEN_EXISTING) ||
        !storage_file_seek(elf->fd, 0, true) ||
@@ -674,12 +906,18 @@ bool elf_file_open(ELFFile* elf, const char* path) {
     elf->sections_count = h.e_shnum;
     elf->section_table = h.e_shoff;
     elf->section_table_strings = sH.sh_offset;
+    elf->section_table_strings_size = sH.sh_size;
+
+    elf_tables_arena_load_headers(elf);
+
+    elf->load_timings.headers = furi_get_tick() - start_tick;
     return true;
 }
 
 bool elf_file_load_section_table(ELFFile* elf) {
     SectionType loaded_sections = SectionTypeERROR;
     FuriString* name = furi_string_alloc();
+    uint32_t start_tick = furi_get_tick();
 
     FURI_LOG_D(TAG, "Scan ELF indexs...");
     // TODO: why we start from 1?
@@ -705,7 +943,16 @@ bool elf_file_load_section_table(ELFFile* elf) {
 
     furi_string_free(name);
 
-    return IS_FLAGS_SET(loaded_sections, SectionTypeValid);
+    uint32_t symbols_start_tick = furi_get_tick();
+    elf->load_timings.section_table = symbols_start_tick - start_tick;
+
+    if(IS_FLAGS_SET(loaded_sections, SectionTypeValid)) {
+        elf_tables_arena_load_symbols(elf);
+        elf->load_timings.symbol_tables = furi_get_tick() - symbols_start_tick;
+        return true;
+    }
+
+    return false;
 }
 
 ElfProcessSectionResult elf_process_section(
@@ -748,6 +995,7 @@ ELFFileLoadStatus elf_file_load_sections(ELFFile* elf) {
     ELFFileLoadStatus status = ELFFileLoadStatusSuccess;
     ELFSectionDict_it_t it;
 
+    uint32_t start_tick = furi_get_tick();
     AddressCache_init(elf->relocation_cache);
 
     for(ELFSectionDict_it(it, elf->sections); !ELFSectionDict_end_p(it); ELFSectionDict_next(it)) {
@@ -775,6 +1023,20 @@ ELFFileLoadStatus elf_file_load_sections(ELFFile* elf) {
     FURI_LOG_D(TAG, "Trampoline cache size: %u", AddressCache_size(elf->trampoline_cache));
     AddressCache_clear(elf->relocation_cache);
 
+    elf->load_timings.relocation = furi_get_tick() - start_tick;
+    elf_tables_arena_free(elf);
+
+    {
+        const uint32_t tick_frequency = furi_kernel_get_tick_frequency();
+        FURI_LOG_I(
+            TAG,
+            "Load time: headers %lums, section table %lums, symbol tables %lums, relocation %lums",
+            elf->load_timings.headers * 1000 / tick_frequency,
+            elf->load_timings.section_table * 1000 / tick_frequency,
+            elf->load_timings.symbol_tables * 1000 / tick_frequency,
+            elf->load_timings.relocation * 1000 / tick_frequency);
+    }
+
     {
         size_t total_size = 0;
         for(ELFSectionDict_it(it, elf->sections); !ELFSectionDict_end_p(it);
@@ -782,7 +1044,12 @@ ELFFileLoadStatus elf_file_load_sections(ELFFile* elf) {
             ELFSectionDict_itref_t* itref = ELFSectionDict_ref(it);
             total_size += itref->value.size;
         }
-        FURI_LOG_I(TAG, "Total size of loaded sections: %u", total_size); //-V576
+        FURI_LOG_I(
+            TAG,
+            "Total size of loaded sections: %u, read %u bytes, %u compressed sections",
+            total_size,
+            elf->section_data_read,
+            elf->compressed_sections_count); //-V576
     }
 
     storage_file_free(elf->fd);
@@ -24,15 +24,46 @@ typedef struct {
 
 DICT_DEF2(ELFSectionDict, const char*, M_CSTR_OPLIST, ELFSection, M_POD_OPLIST)
 
+/**
+ * Tables bulk-loaded into RAM to avoid per-entry SD reads while loading.
+ * Every pointer is NULL if the table is read straight from the file.
+ */
+typedef struct {
+    Elf32_Shdr* section_headers;
+    char* section_names;
+    size_t section_names_size;
+
+    Elf32_Sym* symbols;
+    char* symbol_names;
+    size_t symbol_names_size;
+} ELFTablesArena;
+
+/**
+ * Load stage durations, in ticks
+ */
+typedef struct {
+    uint32_t headers;
+    uint32_t section_table;
+    uint32_t symbol_tables;
+    uint32_t relocation;
+} ELFLoadTimings;
+
 struct ELFFile {
     size_t sections_count;
     off_t section_table;
     off_t section_table_strings;
+    size_t section_table_strings_size;
 
     size_t symbol_count;
     off_t symbol_table;
     off_t symbol_table_strings;
+    size_t symbol_table_strings_size;
     off_t entry;
+
+    ELFTablesArena arena;
+    ELFLoadTimings load_timings;
+    size_t section_data_read;
+    size_t compressed_sections_count;
     ELFSectionDict_t sections;
 
     AddressCache_t relocation_cache;
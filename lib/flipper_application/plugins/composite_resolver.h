@@ -11,6 +11,8 @@ extern "C" {
  * Resolves API interface by calling all resolvers in order
  * Uses API version from first resolver
  * Note: when using hashtable resolvers, collisions between tables are not detected
+ * Bucketed hashtable resolvers reject symbols they don't have with a bloom filter,
+ * so symbols found in later resolvers cost little search in earlier ones
  * Can be cast to ElfApiInterface*
  */
 typedef struct CompositeApiResolver CompositeApiResolver;
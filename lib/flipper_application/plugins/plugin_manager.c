@@ -11,107 +11,515 @@
 
 #define TAG "libmgr"
 
-ARRAY_DEF(FlipperApplicationList, FlipperApplication*, M_PTR_OPLIST)
-#define M_OPL_FlipperApplicationList_t() ARRAY_OPLIST(FlipperApplicationList, M_PTR_OPLIST)
+#define PLUGIN_MANAGER_INDEX_NAME ".plugins.idx"
+#define PLUGIN_MANAGER_INDEX_MAGIC 0x58444950
+#define PLUGIN_MANAGER_INDEX_VERSION 1
+#define PLUGIN_MANAGER_INDEX_NAME_LENGTH 64
+#define PLUGIN_MANAGER_INDEX_APPID_LENGTH 32
+#define PLUGIN_MANAGER_INDEX_COUNT_MAX 256
+
+/********************************** Directory index **********************************/
+
+#pragma pack(push, 1)
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint16_t api_version_major;
+    uint16_t api_version_minor;
+    uint32_t count;
+} PluginManagerIndexHeader;
+
+typedef struct {
+    char name[PLUGIN_MANAGER_INDEX_NAME_LENGTH];
+    uint32_t size;
+    uint32_t timestamp;
+    uint32_t ep_api_version;
+    char appid[PLUGIN_MANAGER_INDEX_APPID_LENGTH];
+} PluginManagerIndexRecord;
+
+#pragma pack(pop)
+
+ARRAY_DEF(PluginManagerIndex, PluginManagerIndexRecord, M_POD_OPLIST)
+
+/********************************** Shared mappings **********************************/
+
+typedef struct {
+    FuriString* path;
+    const ElfApiInterface* api_interface;
+    FlipperApplication* lib;
+    uint32_t references;
+} PluginManagerShared;
+
+ARRAY_DEF(PluginManagerSharedList, PluginManagerShared*, M_PTR_OPLIST)
+
+static struct {
+    FuriMutex* mutex;
+    PluginManagerSharedList_t list;
+} plugin_manager_shared = {0};
+
+/*************************************************************************************/
+
+typedef struct {
+    FuriString* path;
+    uint32_t size;
+    PluginManagerShared* shared; // NULL while not mapped
+    uint32_t last_use;
+} PluginManagerEntry;
+
+ARRAY_DEF(PluginManagerEntryList, PluginManagerEntry, M_POD_OPLIST)
 
 struct PluginManager {
     const char* application_id;
     uint32_t api_version;
+    uint32_t flags;
+    uint32_t use_counter;
     Storage* storage;
-    FlipperApplicationList_t libs;
+    PluginManagerEntryList_t entries;
     const ElfApiInterface* api_interface;
 };
 
-PluginManager* plugin_manager_alloc(
+static void plugin_manager_shared_init() {
+    if(plugin_manager_shared.mutex) return;
+
+    // Mutex can't be allocated in critical section, spare one is freed
+    FuriMutex* mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    bool installed = false;
+
+    FURI_CRITICAL_ENTER();
+    if(!plugin_manager_shared.mutex) {
+        PluginManagerSharedList_init(plugin_manager_shared.list);
+        plugin_manager_shared.mutex = mutex;
+        installed = true;
+    }
+    FURI_CRITICAL_EXIT();
+
+    if(!installed) {
+        furi_mutex_free(mutex);
+    }
+}
+
+static PluginManagerError plugin_manager_map_lib(FlipperApplication* lib, const char* path) {
+    FlipperApplicationPreloadStatus preload_res = flipper_application_preload(lib, path);
+    if(preload_res != FlipperApplicationPreloadStatusSuccess) {
+        FURI_LOG_E(TAG, "Failed to preload %s", path);
+        return PluginManagerErrorLoaderError;
+    }
+
+    if(!flipper_application_is_plugin(lib)) {
+        FURI_LOG_E(TAG, "Not a plugin %s", path);
+        return PluginManagerErrorLoaderError;
+    }
+
+    FlipperApplicationLoadStatus load_status = flipper_application_map_to_memory(lib);
+    if(load_status != FlipperApplicationLoadStatusSuccess) {
+        FURI_LOG_E(
+            TAG,
+            "Failed to load %s: %s",
+            path,
+            flipper_application_load_status_to_string(load_status));
+        return load_status == FlipperApplicationLoadStatusNoFreeMemory ?
+                   PluginManagerErrorNoFreeMemory :
+                   PluginManagerErrorLoaderError;
+    }
+
+    return PluginManagerErrorNone;
+}
+
+static PluginManagerError plugin_manager_shared_map(
+    PluginManager* manager,
+    const char* path,
+    PluginManagerShared** shared) {
+    furi_check(furi_mutex_acquire(plugin_manager_shared.mutex, FuriWaitForever) == FuriStatusOk);
+
+    PluginManagerError error = PluginManagerErrorNone;
+    *shared = NULL;
+
+    for(size_t i = 0; i < PluginManagerSharedList_size(plugin_manager_shared.list); i++) {
+        PluginManagerShared* item = *PluginManagerSharedList_get(plugin_manager_shared.list, i);
+        if(item->api_interface == manager->api_interface &&
+           furi_string_equal_str(item->path, path)) {
+            item->references++;
+            *shared = item;
+            break;
+        }
+    }
+
+    // Mapping is done under lock, so same plugin is never mapped twice
+    if(*shared == NULL) {
+        FlipperApplication* lib =
+            flipper_application_alloc(manager->storage, manager->api_interface);
+        error = plugin_manager_map_lib(lib, path);
+
+        if(error == PluginManagerErrorNone) {
+            PluginManagerShared* item = malloc(sizeof(PluginManagerShared));
+            item->path = furi_string_alloc_set(path);
+            item->api_interface = manager->api_interface;
+            item->lib = lib;
+            item->references = 1;
+            PluginManagerSharedList_push_back(plugin_manager_shared.list, item);
+            *shared = item;
+        } else {
+            flipper_application_free(lib);
+        }
+    }
+
+    furi_mutex_release(plugin_manager_shared.mutex);
+    return error;
+}
+
+static void plugin_manager_shared_unmap(PluginManagerShared* shared) {
+    furi_check(furi_mutex_acquire(plugin_manager_shared.mutex, FuriWaitForever) == FuriStatusOk);
+
+    furi_assert(shared->references > 0);
+    shared->references--;
+
+    if(shared->references == 0) {
+        for(size_t i = 0; i < PluginManagerSharedList_size(plugin_manager_shared.list); i++) {
+            if(*PluginManagerSharedList_get(plugin_manager_shared.list, i) == shared) {
+                PluginManagerSharedList_remove_v(plugin_manager_shared.list, i, i + 1);
+                break;
+            }
+        }
+
+        flipper_application_free(shared->lib);
+        furi_string_free(shared->path);
+        free(shared);
+    }
+
+    furi_mutex_release(plugin_manager_shared.mutex);
+}
+
+static bool plugin_manager_shared_is_exclusive(PluginManagerShared* shared) {
+    furi_check(furi_mutex_acquire(plugin_manager_shared.mutex, FuriWaitForever) == FuriStatusOk);
+    bool exclusive = shared->references == 1;
+    furi_mutex_release(plugin_manager_shared.mutex);
+    return exclusive;
+}
+
+PluginManager* plugin_manager_alloc_ex(
     const char* application_id,
     uint32_t api_version,
-    const ElfApiInterface* api_interface) {
+    const ElfApiInterface* api_interface,
+    uint32_t flags) {
+    plugin_manager_shared_init();
+
     PluginManager* manager = malloc(sizeof(PluginManager));
     manager->application_id = application_id;
     manager->api_version = api_version;
+    manager->flags = flags;
+    manager->use_counter = 0;
     manager->api_interface = api_interface ? api_interface : firmware_api_interface;
     manager->storage = furi_record_open(RECORD_STORAGE);
-    FlipperApplicationList_init(manager->libs);
+    PluginManagerEntryList_init(manager->entries);
     return manager;
 }
 
+PluginManager* plugin_manager_alloc(
+    const char* application_id,
+    uint32_t api_version,
+    const ElfApiInterface* api_interface) {
+    return plugin_manager_alloc_ex(
+        application_id, api_version, api_interface, PluginManagerFlagNone);
+}
+
 void plugin_manager_free(PluginManager* manager) {
     for
-        M_EACH(loaded_lib, manager->libs, FlipperApplicationList_t) {
-            flipper_application_free(*loaded_lib);
+        M_EACH(entry, manager->entries, PluginManagerEntryList_t) {
+            if(entry->shared) {
+                plugin_manager_shared_unmap(entry->shared);
+            }
+            furi_string_free(entry->path);
         }
-    FlipperApplicationList_clear(manager->libs);
+    PluginManagerEntryList_clear(manager->entries);
     furi_record_close(RECORD_STORAGE);
     free(manager);
 }
 
-PluginManagerError plugin_manager_load_single(PluginManager* manager, const char* path) {
-    FlipperApplication* lib = flipper_application_alloc(manager->storage, manager->api_interface);
+static PluginManagerError plugin_manager_check_descriptor(
+    PluginManager* manager,
+    const char* path,
+    const char* appid,
+    uint32_t ep_api_version) {
+    if(strcmp(appid, manager->application_id) != 0) {
+        FURI_LOG_E(TAG, "Application id mismatch %s", path);
+        return PluginManagerErrorApplicationIdMismatch;
+    }
 
-    PluginManagerError error = PluginManagerErrorNone;
-    do {
-        FlipperApplicationPreloadStatus preload_res = flipper_application_preload(lib, path);
+    if(ep_api_version != manager->api_version) {
+        FURI_LOG_E(TAG, "API version mismatch %s", path);
+        return PluginManagerErrorAPIVersionMismatch;
+    }
 
-        if(preload_res != FlipperApplicationPreloadStatusSuccess) {
-            FURI_LOG_E(TAG, "Failed to preload %s", path);
-            error = PluginManagerErrorLoaderError;
-            break;
-        }
+    return PluginManagerErrorNone;
+}
 
-        if(!flipper_application_is_plugin(lib)) {
-            FURI_LOG_E(TAG, "Not a plugin %s", path);
-            error = PluginManagerErrorLoaderError;
-            break;
-        }
+/** Unmap least recently used plugin that is not used by other managers */
+static bool plugin_manager_evict(PluginManager* manager, const PluginManagerEntry* keep) {
+    PluginManagerEntry* victim = NULL;
 
-        FlipperApplicationLoadStatus load_status = flipper_application_map_to_memory(lib);
-        if(load_status != FlipperApplicationLoadStatusSuccess) {
-            FURI_LOG_E(TAG, "Failed to load module_demo_plugin1.fal");
-            break;
+    for
+        M_EACH(entry, manager->entries, PluginManagerEntryList_t) {
+            if(entry == keep || !entry->shared) continue;
+            if(victim && victim->last_use <= entry->last_use) continue;
+            if(plugin_manager_shared_is_exclusive(entry->shared)) victim = entry;
         }
 
+    if(!victim) {
+        return false;
+    }
+
+    FURI_LOG_D(TAG, "Evicting %s", furi_string_get_cstr(victim->path));
+    plugin_manager_shared_unmap(victim->shared);
+    victim->shared = NULL;
+    return true;
+}
+
+static PluginManagerError plugin_manager_map(PluginManager* manager, PluginManagerEntry* entry) {
+    const char* path = furi_string_get_cstr(entry->path);
+    const bool evict = manager->flags & PluginManagerFlagEvict;
+
+    // Plugin file size is more than its sections and relocations take
+    while(evict && memmgr_heap_get_max_free_block() < entry->size &&
+          plugin_manager_evict(manager, entry)) {
+    }
+
+    PluginManagerError error;
+    while(true) {
+        error = plugin_manager_shared_map(manager, path, &entry->shared);
+        if(error != PluginManagerErrorNoFreeMemory || !evict) break;
+        if(!plugin_manager_evict(manager, entry)) break;
+    }
+
+    if(error == PluginManagerErrorNone) {
         const FlipperAppPluginDescriptor* app_descriptor =
-            flipper_application_plugin_get_descriptor(lib);
+            flipper_application_plugin_get_descriptor(entry->shared->lib);
 
         if(!app_descriptor) {
             FURI_LOG_E(TAG, "Failed to get descriptor %s", path);
             error = PluginManagerErrorLoaderError;
+        } else {
+            error = plugin_manager_check_descriptor(
+                manager, path, app_descriptor->appid, app_descriptor->ep_api_version);
+        }
+
+        if(error != PluginManagerErrorNone) {
+            plugin_manager_shared_unmap(entry->shared);
+            entry->shared = NULL;
+        }
+    }
+
+    return error;
+}
+
+static PluginManagerError
+    plugin_manager_add(PluginManager* manager, const char* path, uint32_t size, bool map) {
+    PluginManagerEntry entry = {
+        .path = furi_string_alloc_set(path),
+        .size = size,
+        .shared = NULL,
+        .last_use = 0,
+    };
+
+    PluginManagerError error = PluginManagerErrorNone;
+    if(map) {
+        error = plugin_manager_map(manager, &entry);
+    }
+
+    if(error == PluginManagerErrorNone) {
+        PluginManagerEntryList_push_back(manager->entries, entry);
+    } else {
+        furi_string_free(entry.path);
+    }
+
+    return error;
+}
+
+PluginManagerError plugin_manager_load_single(PluginManager* manager, const char* path) {
+    FileInfo file_info;
+    uint32_t size = 0;
+    if(storage_common_stat(manager->storage, path, &file_info) == FSE_OK) {
+        size = file_info.size;
+    }
+
+    return plugin_manager_add(manager, path, size, true);
+}
+
+static void plugin_manager_index_load(
+    PluginManager* manager,
+    const char* path,
+    PluginManagerIndex_t index) {
+    File* file = storage_file_alloc(manager->storage);
+    FuriString* index_path = furi_string_alloc();
+    path_concat(path, PLUGIN_MANAGER_INDEX_NAME, index_path);
+
+    do {
+        if(!storage_file_open(
+               file, furi_string_get_cstr(index_path), FSAM_READ, FSOM_OPEN_EXISTING)) {
             break;
         }
 
-        if(strcmp(app_descriptor->appid, manager->application_id) != 0) {
-            FURI_LOG_E(TAG, "Application id mismatch %s", path);
-            error = PluginManagerErrorApplicationIdMismatch;
+        PluginManagerIndexHeader header;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+
+        if(header.magic != PLUGIN_MANAGER_INDEX_MAGIC ||
+           header.version != PLUGIN_MANAGER_INDEX_VERSION ||
+           header.api_version_major != manager->api_interface->api_version_major ||
+           header.api_version_minor != manager->api_interface->api_version_minor ||
+           header.count > PLUGIN_MANAGER_INDEX_COUNT_MAX) {
+            FURI_LOG_D(TAG, "Outdated index %s", furi_string_get_cstr(index_path));
             break;
         }
 
-        if(app_descriptor->ep_api_version != manager->api_version) {
-            FURI_LOG_E(TAG, "API version mismatch %s", path);
-            error = PluginManagerErrorAPIVersionMismatch;
+        // Whole index is read at once, m-array keeps records contiguous
+        size_t size = header.count * sizeof(PluginManagerIndexRecord);
+        PluginManagerIndex_resize(index, header.count);
+        if(header.count == 0) break;
+        if(storage_file_read(file, PluginManagerIndex_get(index, 0), size) != size) {
+            PluginManagerIndex_reset(index);
             break;
         }
 
-        FlipperApplicationList_push_back(manager->libs, lib);
+        for
+            M_EACH(record, index, PluginManagerIndex_t) {
+                record->name[PLUGIN_MANAGER_INDEX_NAME_LENGTH - 1] = '\0';
+                record->appid[PLUGIN_MANAGER_INDEX_APPID_LENGTH - 1] = '\0';
+            }
+    } while(false);
+
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_string_free(index_path);
+}
+
+static void plugin_manager_index_save(
+    PluginManager* manager,
+    const char* path,
+    PluginManagerIndex_t index) {
+    File* file = storage_file_alloc(manager->storage);
+    FuriString* index_path = furi_string_alloc();
+    path_concat(path, PLUGIN_MANAGER_INDEX_NAME, index_path);
+
+    PluginManagerIndexHeader header = {
+        .magic = PLUGIN_MANAGER_INDEX_MAGIC,
+        .version = PLUGIN_MANAGER_INDEX_VERSION,
+        .api_version_major = manager->api_interface->api_version_major,
+        .api_version_minor = manager->api_interface->api_version_minor,
+        .count = PluginManagerIndex_size(index),
+    };
+    size_t size = header.count * sizeof(PluginManagerIndexRecord);
+
+    bool success = false;
+    do {
+        if(!storage_file_open(
+               file, furi_string_get_cstr(index_path), FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+            break;
+        }
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(size && storage_file_write(file, PluginManagerIndex_get(index, 0), size) != size) {
+            break;
+        }
+        success = true;
     } while(false);
 
-    if(error != PluginManagerErrorNone) {
-        flipper_application_free(lib);
+    if(!success) {
+        FURI_LOG_W(TAG, "Failed to save index %s", furi_string_get_cstr(index_path));
     }
 
-    return error;
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_string_free(index_path);
+}
+
+static const PluginManagerIndexRecord* plugin_manager_index_find(
+    PluginManagerIndex_t index,
+    size_t hint,
+    const char* name,
+    uint32_t size,
+    uint32_t timestamp) {
+    const size_t count = PluginManagerIndex_size(index);
+
+    // Directory is usually listed in the same order as it was indexed
+    for(size_t i = 0; i < count; i++) {
+        const PluginManagerIndexRecord* record =
+            PluginManagerIndex_cget(index, (hint + i) % count);
+        if(strcmp(record->name, name) == 0) {
+            return (record->size == size && record->timestamp == timestamp) ? record : NULL;
+        }
+    }
+
+    return NULL;
+}
+
+static PluginManagerError plugin_manager_load_indexed(
+    PluginManager* manager,
+    const char* path,
+    const char* name,
+    uint32_t size,
+    PluginManagerIndex_t index,
+    PluginManagerIndex_t new_index,
+    bool* index_changed) {
+    uint32_t timestamp = 0;
+    storage_common_timestamp(manager->storage, path, &timestamp);
+
+    const PluginManagerIndexRecord* record = plugin_manager_index_find(
+        index, PluginManagerIndex_size(new_index), name, size, timestamp);
+
+    if(record) {
+        PluginManagerIndex_push_back(new_index, *record);
+        PluginManagerError error =
+            plugin_manager_check_descriptor(manager, path, record->appid, record->ep_api_version);
+        if(error != PluginManagerErrorNone) return error;
+        return plugin_manager_add(manager, path, size, false);
+    }
+
+    // Not indexed or changed: map it now and keep it mapped
+    PluginManagerError error = plugin_manager_add(manager, path, size, true);
+    if(error != PluginManagerErrorNone) return error;
+
+    const FlipperAppPluginDescriptor* app_descriptor =
+        plugin_manager_get(manager, plugin_manager_get_count(manager) - 1);
+
+    if(strlen(name) < PLUGIN_MANAGER_INDEX_NAME_LENGTH &&
+       strlen(app_descriptor->appid) < PLUGIN_MANAGER_INDEX_APPID_LENGTH) {
+        PluginManagerIndexRecord* new_record = PluginManagerIndex_push_new(new_index);
+        memset(new_record, 0, sizeof(PluginManagerIndexRecord));
+        strlcpy(new_record->name, name, sizeof(new_record->name));
+        strlcpy(new_record->appid, app_descriptor->appid, sizeof(new_record->appid));
+        new_record->size = size;
+        new_record->timestamp = timestamp;
+        new_record->ep_api_version = app_descriptor->ep_api_version;
+        *index_changed = true;
+    }
+
+    return PluginManagerErrorNone;
 }
 
 PluginManagerError plugin_manager_load_all(PluginManager* manager, const char* path) {
     File* directory = storage_file_alloc(manager->storage);
     char file_name_buffer[256];
+    FileInfo file_info;
     FuriString* file_name = furi_string_alloc();
+
+    const bool lazy = manager->flags & PluginManagerFlagLazy;
+    bool index_changed = false;
+    PluginManagerIndex_t index;
+    PluginManagerIndex_t new_index;
+    PluginManagerIndex_init(index);
+    PluginManagerIndex_init(new_index);
+
+    if(lazy) {
+        plugin_manager_index_load(manager, path, index);
+    }
+
     do {
         if(!storage_dir_open(directory, path)) {
             FURI_LOG_E(TAG, "Failed to open directory %s", path);
             break;
         }
         while(true) {
-            if(!storage_dir_read(directory, NULL, file_name_buffer, sizeof(file_name_buffer))) {
+            if(!storage_dir_read(
+                   directory, &file_info, file_name_buffer, sizeof(file_name_buffer))) {
                 break;
             }
 
@@ -122,8 +530,20 @@ PluginManagerError plugin_manager_load_all(PluginManager* manager, const char* p
 
             path_concat(path, file_name_buffer, file_name);
             FURI_LOG_D(TAG, "Loading %s", furi_string_get_cstr(file_name));
-            PluginManagerError error =
-                plugin_manager_load_single(manager, furi_string_get_cstr(file_name));
+            PluginManagerError error;
+            if(lazy) {
+                error = plugin_manager_load_indexed(
+                    manager,
+                    furi_string_get_cstr(file_name),
+                    file_name_buffer,
+                    file_info.size,
+                    index,
+                    new_index,
+                    &index_changed);
+            } else {
+                error = plugin_manager_add(
+                    manager, furi_string_get_cstr(file_name), file_info.size, true);
+            }
 
             if(error != PluginManagerErrorNone) {
                 FURI_LOG_E(TAG, "Failed to load %s", furi_string_get_cstr(file_name));
@@ -134,20 +554,34 @@ PluginManagerError plugin_manager_load_all(PluginManager* manager, const char* p
     storage_dir_close(directory);
     storage_file_free(directory);
     furi_string_free(file_name);
+
+    if(lazy &&
+       (index_changed || PluginManagerIndex_size(new_index) != PluginManagerIndex_size(index))) {
+        plugin_manager_index_save(manager, path, new_index);
+    }
+
+    PluginManagerIndex_clear(index);
+    PluginManagerIndex_clear(new_index);
     return PluginManagerErrorNone;
 }
 
 uint32_t plugin_manager_get_count(PluginManager* manager) {
-    return FlipperApplicationList_size(manager->libs);
+    return PluginManagerEntryList_size(manager->entries);
 }
 
 const FlipperAppPluginDescriptor* plugin_manager_get(PluginManager* manager, uint32_t index) {
-    FlipperApplication* app = *FlipperApplicationList_get(manager->libs, index);
-    return flipper_application_plugin_get_descriptor(app);
+    PluginManagerEntry* entry = PluginManagerEntryList_get(manager->entries, index);
+    entry->last_use = ++manager->use_counter;
+
+    if(!entry->shared && plugin_manager_map(manager, entry) != PluginManagerErrorNone) {
+        FURI_LOG_E(TAG, "Failed to map %s", furi_string_get_cstr(entry->path));
+        return NULL;
+    }
+
+    return flipper_application_plugin_get_descriptor(entry->shared->lib);
 }
 
 const void* plugin_manager_get_ep(PluginManager* manager, uint32_t index) {
     const FlipperAppPluginDescriptor* lib_descr = plugin_manager_get(manager, index);
-    furi_check(lib_descr);
-    return lib_descr->entry_point;
+    return lib_descr ? lib_descr->entry_point : NULL;
 }
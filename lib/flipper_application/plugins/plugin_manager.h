@@ -9,6 +9,8 @@ extern "C" {
 /**
  * @brief Object that manages plugins for an application
  * Implements mass loading of plugins and provides access to their descriptors
+ * Plugins with the same path and API interface are mapped once and shared
+ * between all PluginManager instances that use them
  */
 typedef struct PluginManager PluginManager;
 
@@ -17,8 +19,19 @@ typedef enum {
     PluginManagerErrorLoaderError,
     PluginManagerErrorApplicationIdMismatch,
     PluginManagerErrorAPIVersionMismatch,
+    PluginManagerErrorNoFreeMemory,
 } PluginManagerError;
 
+typedef enum {
+    PluginManagerFlagNone = 0,
+    /** plugin_manager_load_all takes descriptors of unchanged plugins from the directory
+     * index and maps them on first plugin_manager_get, the index is updated as needed */
+    PluginManagerFlagLazy = (1 << 0),
+    /** Least recently used plugins are unmapped when heap is too low to map another one,
+     * they are mapped again on next use */
+    PluginManagerFlagEvict = (1 << 1),
+} PluginManagerFlag;
+
 /**
  * @brief Allocates new PluginManager
  * @param application_id Application ID filter - only plugins with matching ID will be loaded
@@ -32,6 +45,21 @@ PluginManager* plugin_manager_alloc(
     uint32_t api_version,
     const ElfApiInterface* api_interface);
 
+/**
+ * @brief Allocates new PluginManager with loading flags
+ * @param application_id Application ID filter - only plugins with matching ID will be loaded
+ * @param api_version Application API version filter - only plugins with matching API version
+ * @param api_interface Application API interface - used to resolve plugins' API imports
+ *  If plugin uses private application's API, use CompoundApiInterface
+ * @param flags PluginManagerFlag combination
+ * @return new PluginManager instance
+ */
+PluginManager* plugin_manager_alloc_ex(
+    const char* application_id,
+    uint32_t api_version,
+    const ElfApiInterface* api_interface,
+    uint32_t flags);
+
 /**
  * @brief Frees PluginManager
  * @param manager PluginManager instance
@@ -48,6 +76,8 @@ PluginManagerError plugin_manager_load_single(PluginManager* manager, const char
 
 /**
  * @brief Loads all plugins from specified directory
+ * With PluginManagerFlagLazy, descriptors are kept in .plugins.idx file of the directory,
+ * only plugins that are new or changed since last time are mapped
  * @param manager PluginManager instance
  * @param path Path to directory
  * @return Error code
@@ -62,18 +92,20 @@ PluginManagerError plugin_manager_load_all(PluginManager* manager, const char* p
 uint32_t plugin_manager_get_count(PluginManager* manager);
 
 /**
- * @brief Returns plugin descriptor by index
+ * @brief Returns plugin descriptor by index, maps plugin if it is not mapped yet
+ * With PluginManagerFlagEvict, descriptors and entry points of other plugins
+ * are valid only until next plugin_manager_get or plugin_manager_get_ep call
  * @param manager PluginManager instance
  * @param index Plugin index
- * @return Plugin descriptor
+ * @return Plugin descriptor, NULL if plugin can't be mapped
  */
 const FlipperAppPluginDescriptor* plugin_manager_get(PluginManager* manager, uint32_t index);
 
 /**
- * @brief Returns plugin entry point by index
+ * @brief Returns plugin entry point by index, maps plugin if it is not mapped yet
  * @param manager PluginManager instance
  * @param index Plugin index
- * @return Plugin entry point
+ * @return Plugin entry point, NULL if plugin can't be mapped
  */
 const void* plugin_manager_get_ep(PluginManager* manager, uint32_t index);
 
@@ -132,6 +132,21 @@ bool flipper_format_seek_to_end(FlipperFormat* flipper_format) {
     return stream_seek(flipper_format->stream, 0, StreamOffsetFromEnd);
 }
 
+bool flipper_format_transaction_begin(FlipperFormat* flipper_format) {
+    furi_assert(flipper_format);
+    return stream_transaction_begin(flipper_format->stream);
+}
+
+bool flipper_format_transaction_commit(FlipperFormat* flipper_format) {
+    furi_assert(flipper_format);
+    return stream_transaction_commit(flipper_format->stream);
+}
+
+void flipper_format_transaction_abort(FlipperFormat* flipper_format) {
+    furi_assert(flipper_format);
+    stream_transaction_abort(flipper_format->stream);
+}
+
 bool flipper_format_key_exist(FlipperFormat* flipper_format, const char* key) {
     size_t pos = stream_tell(flipper_format->stream);
     stream_seek(flipper_format->stream, 0, StreamOffsetFromStart);
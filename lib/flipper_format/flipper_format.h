@@ -217,6 +217,29 @@ bool flipper_format_rewind(FlipperFormat* flipper_format);
  */
 bool flipper_format_seek_to_end(FlipperFormat* flipper_format);
 
+/**
+ * Begin transaction. Following updates, inserts and deletes are kept in memory
+ * and written to file at once on commit, instead of rewriting the file on each of them.
+ * Use it when doing several edits in a row.
+ * @param flipper_format Pointer to a FlipperFormat instance
+ * @return True if transaction was started, otherwise edits are written directly
+ */
+bool flipper_format_transaction_begin(FlipperFormat* flipper_format);
+
+/**
+ * Commit transaction: write file with all edits and replace original one with it.
+ * Does nothing if there is no transaction.
+ * @param flipper_format Pointer to a FlipperFormat instance
+ * @return True on success, on error file is left unchanged and transaction is kept
+ */
+bool flipper_format_transaction_commit(FlipperFormat* flipper_format);
+
+/**
+ * Abort transaction, edits are dropped. Closing file aborts transaction too.
+ * @param flipper_format Pointer to a FlipperFormat instance
+ */
+void flipper_format_transaction_abort(FlipperFormat* flipper_format);
+
 /**
  * Check if the key exists.
  * @param flipper_format Pointer to a FlipperFormat instance
@@ -0,0 +1,239 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <toolbox/hex.h>
+#include "flipper_format_span.h"
+
+// Same as in flipper_format_stream_i.h, not included to keep this file free of Stream
+#define FLIPPER_FORMAT_SPAN_EOLN '\n'
+#define FLIPPER_FORMAT_SPAN_EOLR '\r'
+
+typedef bool (*FlipperFormatSpanDecode)(const char* value, size_t size, void* data, size_t index);
+
+static inline bool flipper_format_span_is_space(char c) {
+    return c == ' ' || c == '\t' || c == FLIPPER_FORMAT_SPAN_EOLR;
+}
+
+// Move unconsumed bytes to the window start and read more after them
+static bool flipper_format_span_fill(FlipperFormatSpan* span) {
+    if(span->eof) return false;
+
+    size_t left = span->size - span->pos;
+    memmove(span->buffer, span->buffer + span->pos, left);
+    span->pos = 0;
+
+    size_t was_read =
+        span->read(span->context, (uint8_t*)span->buffer + left, sizeof(span->buffer) - left);
+    span->size = left + was_read;
+    if(was_read == 0) span->eof = true;
+
+    return was_read > 0;
+}
+
+void flipper_format_span_init(
+    FlipperFormatSpan* span,
+    FlipperFormatSpanReadCallback read,
+    void* context) {
+    span->read = read;
+    span->context = context;
+    span->pos = 0;
+    span->size = 0;
+    span->eof = false;
+}
+
+bool flipper_format_span_next(FlipperFormatSpan* span, const char** value, size_t* size) {
+    // Leading spaces, end of line means there is no value
+    while(true) {
+        if(span->pos == span->size && !flipper_format_span_fill(span)) return false;
+        const char c = span->buffer[span->pos];
+        if(c == FLIPPER_FORMAT_SPAN_EOLN) return false;
+        if(!flipper_format_span_is_space(c)) break;
+        span->pos++;
+    }
+
+    // Window is refilled at most once per value, value start is kept in it
+    size_t length = 0;
+    while(true) {
+        if(span->pos + length == span->size) {
+            if(length > FLIPPER_FORMAT_SPAN_VALUE_MAX || !flipper_format_span_fill(span)) break;
+        }
+        const char c = span->buffer[span->pos + length];
+        if(flipper_format_span_is_space(c) || c == FLIPPER_FORMAT_SPAN_EOLN) break;
+        length++;
+    }
+
+    if(length > FLIPPER_FORMAT_SPAN_VALUE_MAX) return false;
+
+    *value = &span->buffer[span->pos];
+    *size = length;
+    span->pos += length;
+    return true;
+}
+
+bool flipper_format_span_is_last(FlipperFormatSpan* span) {
+    while(true) {
+        if(span->pos == span->size && !flipper_format_span_fill(span)) return true;
+        const char c = span->buffer[span->pos];
+        if(c == FLIPPER_FORMAT_SPAN_EOLN) return true;
+        if(!flipper_format_span_is_space(c)) return false;
+        span->pos++;
+    }
+}
+
+size_t flipper_format_span_get_unread(FlipperFormatSpan* span) {
+    return span->size - span->pos;
+}
+
+bool flipper_format_span_count(FlipperFormatSpan* span, uint32_t* count) {
+    *count = 0;
+    const char* value;
+    size_t size;
+
+    while(true) {
+        if(!flipper_format_span_next(span, &value, &size)) return false;
+        *count = *count + 1;
+        if(flipper_format_span_is_last(span)) break;
+    }
+
+    return true;
+}
+
+static bool flipper_format_span_read_array(
+    FlipperFormatSpan* span,
+    FlipperFormatSpanDecode decode,
+    void* data,
+    size_t count) {
+    const char* value;
+    size_t size;
+
+    for(size_t i = 0; i < count; i++) {
+        if(!flipper_format_span_next(span, &value, &size)) return false;
+        if(!decode(value, size, data, i)) return false;
+        if(flipper_format_span_is_last(span) && ((i + 1) != count)) return false;
+    }
+
+    return true;
+}
+
+bool flipper_format_span_read_hex(FlipperFormatSpan* span, uint8_t* data, size_t count) {
+    const char* value;
+    size_t size;
+
+    // Hot path for dumps, no indirect call per byte
+    for(size_t i = 0; i < count; i++) {
+        if(!flipper_format_span_next(span, &value, &size)) return false;
+        if(size < 2 || !hex_char_to_uint8(value[0], value[1], &data[i])) return false;
+        if(flipper_format_span_is_last(span) && ((i + 1) != count)) return false;
+    }
+
+    return true;
+}
+
+static bool
+    flipper_format_span_decode_hex_uint64(const char* value, size_t size, void* data, size_t i) {
+    return size >= 16 && hex_chars_to_uint64(value, &((uint64_t*)data)[i]);
+}
+
+bool flipper_format_span_read_hex_uint64(FlipperFormatSpan* span, uint64_t* data, size_t count) {
+    return flipper_format_span_read_array(
+        span, flipper_format_span_decode_hex_uint64, data, count);
+}
+
+// Parse value as before with sscanf, it needs a terminated copy
+static int
+    flipper_format_span_scan(const char* value, size_t size, const char* format, void* data) {
+    char string[FLIPPER_FORMAT_SPAN_VALUE_MAX + 1];
+    memcpy(string, value, size);
+    string[size] = '\0';
+    return sscanf(string, format, data);
+}
+
+// Plain decimal up to 9 digits without leading zeros, the rest is left to sscanf
+static bool flipper_format_span_parse_decimal(
+    const char* value,
+    size_t size,
+    uint32_t* number,
+    bool* negative) {
+    *negative = (size > 0) && (value[0] == '-');
+    if(*negative) {
+        value++;
+        size--;
+    }
+
+    if(size == 0 || size > 9 || (value[0] == '0' && size > 1)) return false;
+
+    uint32_t result = 0;
+    for(size_t i = 0; i < size; i++) {
+        const uint8_t digit = value[i] - '0';
+        if(digit > 9) return false;
+        result = result * 10 + digit;
+    }
+
+    *number = result;
+    return true;
+}
+
+static bool
+    flipper_format_span_decode_int32(const char* value, size_t size, void* data, size_t i) {
+    int32_t* array = data;
+    uint32_t number;
+    bool negative;
+
+    if(flipper_format_span_parse_decimal(value, size, &number, &negative)) {
+        array[i] = negative ? -(int32_t)number : (int32_t)number;
+        return true;
+    }
+
+    return flipper_format_span_scan(value, size, "%" PRIi32, &array[i]) == 1;
+}
+
+bool flipper_format_span_read_int32(FlipperFormatSpan* span, int32_t* data, size_t count) {
+    return flipper_format_span_read_array(span, flipper_format_span_decode_int32, data, count);
+}
+
+static bool
+    flipper_format_span_decode_uint32(const char* value, size_t size, void* data, size_t i) {
+    uint32_t* array = data;
+    uint32_t number;
+    bool negative;
+
+    if(flipper_format_span_parse_decimal(value, size, &number, &negative) && !negative) {
+        array[i] = number;
+        return true;
+    }
+
+    return flipper_format_span_scan(value, size, "%" PRIu32, &array[i]) == 1;
+}
+
+bool flipper_format_span_read_uint32(FlipperFormatSpan* span, uint32_t* data, size_t count) {
+    return flipper_format_span_read_array(span, flipper_format_span_decode_uint32, data, count);
+}
+
+#ifndef FLIPPER_STREAM_LITE
+static bool
+    flipper_format_span_decode_float(const char* value, size_t size, void* data, size_t i) {
+    char string[FLIPPER_FORMAT_SPAN_VALUE_MAX + 1];
+    memcpy(string, value, size);
+    string[size] = '\0';
+
+    // newlib-nano does not have sscanf for floats
+    char* end_char;
+    ((float*)data)[i] = strtof(string, &end_char);
+    return *end_char == '\0';
+}
+
+bool flipper_format_span_read_float(FlipperFormatSpan* span, float* data, size_t count) {
+    return flipper_format_span_read_array(span, flipper_format_span_decode_float, data, count);
+}
+#endif
+
+static bool flipper_format_span_decode_bool(const char* value, size_t size, void* data, size_t i) {
+    ((bool*)data)[i] = (size == 4) && (strncasecmp(value, "true", 4) == 0);
+    return true;
+}
+
+bool flipper_format_span_read_bool(FlipperFormatSpan* span, bool* data, size_t count) {
+    return flipper_format_span_read_array(span, flipper_format_span_decode_bool, data, count);
+}
@@ -0,0 +1,139 @@
+/**
+ * @file flipper_format_span.h
+ * Flipper Format value span reader
+ *
+ * Reads values of one line through a small window, values are returned as
+ * views into the window without copying them to strings, array decoders
+ * convert them straight into caller arrays.
+ *
+ * Source is a read callback, so the reader does not depend on Stream and
+ * builds on host for benchmarking.
+ */
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FLIPPER_FORMAT_SPAN_BUFFER_SIZE (128)
+
+/** Longest value, longer ones fail to parse */
+#define FLIPPER_FORMAT_SPAN_VALUE_MAX (FLIPPER_FORMAT_SPAN_BUFFER_SIZE / 2)
+
+typedef size_t (*FlipperFormatSpanReadCallback)(void* context, uint8_t* data, size_t size);
+
+typedef struct {
+    FlipperFormatSpanReadCallback read;
+    void* context;
+    size_t pos;
+    size_t size;
+    bool eof;
+    char buffer[FLIPPER_FORMAT_SPAN_BUFFER_SIZE];
+} FlipperFormatSpan;
+
+/**
+ * Init span reader, source must be at the first value of the line
+ * @param span FlipperFormatSpan instance
+ * @param read source read callback
+ * @param context read callback context
+ */
+void flipper_format_span_init(
+    FlipperFormatSpan* span,
+    FlipperFormatSpanReadCallback read,
+    void* context);
+
+/**
+ * Get next value of the line
+ * @param span FlipperFormatSpan instance
+ * @param value value view, valid until next call
+ * @param size value size
+ * @return true if value found, false at the end of line or on error
+ */
+bool flipper_format_span_next(FlipperFormatSpan* span, const char** value, size_t* size);
+
+/**
+ * Skip spaces after value and check if it was the last one of the line
+ * @param span FlipperFormatSpan instance
+ * @return true if line or source ended
+ */
+bool flipper_format_span_is_last(FlipperFormatSpan* span);
+
+/**
+ * Get count of bytes read from source but not consumed. Seek source back by it
+ * to continue right after the last consumed value.
+ * @param span FlipperFormatSpan instance
+ * @return size_t unread bytes
+ */
+size_t flipper_format_span_get_unread(FlipperFormatSpan* span);
+
+/**
+ * Count values till the end of line
+ * @param span FlipperFormatSpan instance
+ * @param count values count
+ * @return true on success
+ */
+bool flipper_format_span_count(FlipperFormatSpan* span, uint32_t* count);
+
+/**
+ * Decode hex byte values. Decoders fail if line has less values than requested
+ * or a value can't be decoded, values after requested ones are not consumed.
+ * @param span FlipperFormatSpan instance
+ * @param data array to decode to
+ * @param count values count
+ * @return true on success
+ */
+bool flipper_format_span_read_hex(FlipperFormatSpan* span, uint8_t* data, size_t count);
+
+/**
+ * Decode 16 character hex uint64 values
+ * @param span FlipperFormatSpan instance
+ * @param data array to decode to
+ * @param count values count
+ * @return true on success
+ */
+bool flipper_format_span_read_hex_uint64(FlipperFormatSpan* span, uint64_t* data, size_t count);
+
+/**
+ * Decode int32 values
+ * @param span FlipperFormatSpan instance
+ * @param data array to decode to
+ * @param count values count
+ * @return true on success
+ */
+bool flipper_format_span_read_int32(FlipperFormatSpan* span, int32_t* data, size_t count);
+
+/**
+ * Decode uint32 values
+ * @param span FlipperFormatSpan instance
+ * @param data array to decode to
+ * @param count values count
+ * @return true on success
+ */
+bool flipper_format_span_read_uint32(FlipperFormatSpan* span, uint32_t* data, size_t count);
+
+#ifndef FLIPPER_STREAM_LITE
+/**
+ * Decode float values
+ * @param span FlipperFormatSpan instance
+ * @param data array to decode to
+ * @param count values count
+ * @return true on success
+ */
+bool flipper_format_span_read_float(FlipperFormatSpan* span, float* data, size_t count);
+#endif
+
+/**
+ * Decode bool values, "true" in any case is true, anything else is false
+ * @param span FlipperFormatSpan instance
+ * @param data array to decode to
+ * @param count values count
+ * @return true on success
+ */
+bool flipper_format_span_read_bool(FlipperFormatSpan* span, bool* data, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
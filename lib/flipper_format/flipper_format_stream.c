@@ -3,6 +3,7 @@
 #include <core/check.h>
 #include "flipper_format_stream.h"
 #include "flipper_format_stream_i.h"
+#include "flipper_format_span.h"
 
 static inline bool flipper_format_stream_is_space(char c) {
     return c == ' ' || c == '\t' || c == flipper_format_eolr;
@@ -121,74 +122,6 @@ bool flipper_format_stream_seek_to_key(Stream* stream, const char* key, bool str
     return found;
 }
 
-static bool flipper_format_stream_read_value(Stream* stream, FuriString* value, bool* last) {
-    enum { LeadingSpace, ReadValue, TrailingSpace } state = LeadingSpace;
-    const size_t buffer_size = 32;
-    uint8_t buffer[buffer_size];
-    bool result = false;
-    bool error = false;
-
-    furi_string_reset(value);
-
-    while(true) {
-        size_t was_read = stream_read(stream, buffer, buffer_size);
-
-        if(was_read == 0) {
-            if(state != LeadingSpace && stream_eof(stream)) {
-                result = true;
-                *last = true;
-            } else {
-                error = true;
-            }
-        }
-
-        for(uint16_t i = 0; i < was_read; i++) {
-            const uint8_t data = buffer[i];
-
-            if(state == LeadingSpace) {
-                if(flipper_format_stream_is_space(data)) {
-                    continue;
-                } else if(data == flipper_format_eoln) {
-                    stream_seek(stream, i - was_read, StreamOffsetFromCurrent);
-                    error = true;
-                    break;
-                } else {
-                    state = ReadValue;
-                    furi_string_push_back(value, data);
-                }
-            } else if(state == ReadValue) {
-                if(flipper_format_stream_is_space(data)) {
-                    state = TrailingSpace;
-                } else if(data == flipper_format_eoln) {
-                    if(!stream_seek(stream, i - was_read, StreamOffsetFromCurrent)) {
-                        error = true;
-                    } else {
-                        result = true;
-                        *last = true;
-                    }
-                    break;
-                } else {
-                    furi_string_push_back(value, data);
-                }
-            } else if(state == TrailingSpace) {
-                if(flipper_format_stream_is_space(data)) {
-                    continue;
-                } else if(!stream_seek(stream, i - was_read, StreamOffsetFromCurrent)) {
-                    error = true;
-                } else {
-                    *last = (data == flipper_format_eoln);
-                    result = true;
-                }
-                break;
-            }
-        }
-
-        if(error || result) break;
-    }
-
-    return result;
-}
-
 static bool flipper_format_stream_read_line(Stream* stream, FuriString* str_result) {
     furi_string_reset(str_result);
     const size_t buffer_size = 32;
@@ -354,82 +287,39 @@ bool flipper_format_stream_read_value_line(
                 break;
             }
         } else {
-            result = true;
-            FuriString* value;
-            value = furi_string_alloc();
-
-            for(size_t i = 0; i < data_size; i++) {
-                bool last = false;
-                result = flipper_format_stream_read_value(stream, value, &last);
-                if(result) {
-                    int scan_values = 0;
-
-                    switch(type) {
-                    case FlipperStreamValueHex: {
-                        uint8_t* data = _data;
-                        if(furi_string_size(value) >= 2) {
-                            // sscanf "%02X" does not work here
-                            if(hex_char_to_uint8(
-                                   furi_string_get_char(value, 0),
-                                   furi_string_get_char(value, 1),
-                                   &data[i])) {
-                                scan_values = 1;
-                            }
-                        }
-                    }; break;
+            FlipperFormatSpan span;
+            flipper_format_span_init(&span, (FlipperFormatSpanReadCallback)stream_read, stream);
+
+            switch(type) {
+            case FlipperStreamValueHex:
+                result = flipper_format_span_read_hex(&span, _data, data_size);
+                break;
 #ifndef FLIPPER_STREAM_LITE
-                    case FlipperStreamValueFloat: {
-                        float* data = _data;
-                        // newlib-nano does not have sscanf for floats
-                        // scan_values = sscanf(furi_string_get_cstr(value), "%f", &data[i]);
-                        char* end_char;
-                        data[i] = strtof(furi_string_get_cstr(value), &end_char);
-                        if(*end_char == 0) {
-                            // most likely ok
-                            scan_values = 1;
-                        }
-                    }; break;
+            case FlipperStreamValueFloat:
+                result = flipper_format_span_read_float(&span, _data, data_size);
+                break;
 #endif
-                    case FlipperStreamValueInt32: {
-                        int32_t* data = _data;
-                        scan_values = sscanf(furi_string_get_cstr(value), "%" PRIi32, &data[i]);
-                    }; break;
-                    case FlipperStreamValueUint32: {
-                        uint32_t* data = _data;
-                        scan_values = sscanf(furi_string_get_cstr(value), "%" PRIu32, &data[i]);
-                    }; break;
-                    case FlipperStreamValueHexUint64: {
-                        uint64_t* data = _data;
-                        if(furi_string_size(value) >= 16) {
-                            if(hex_chars_to_uint64(furi_string_get_cstr(value), &data[i])) {
-                                scan_values = 1;
-                            }
-                        }
-                    }; break;
-                    case FlipperStreamValueBool: {
-                        bool* data = _data;
-                        data[i] = !furi_string_cmpi(value, "true");
-                        scan_values = 1;
-                    }; break;
-                    default:
-                        furi_crash("Unknown FF type");
-                    }
-
-                    if(scan_values != 1) {
-                        result = false;
-                        break;
-                    }
-                } else {
-                    break;
-                }
-
-                if(last && ((i + 1) != data_size)) {
-                    result = false;
-                    break;
-                }
+            case FlipperStreamValueInt32:
+                result = flipper_format_span_read_int32(&span, _data, data_size);
+                break;
+            case FlipperStreamValueUint32:
+                result = flipper_format_span_read_uint32(&span, _data, data_size);
+                break;
+            case FlipperStreamValueHexUint64:
+                result = flipper_format_span_read_hex_uint64(&span, _data, data_size);
+                break;
+            case FlipperStreamValueBool:
+                result = flipper_format_span_read_bool(&span, _data, data_size);
+                break;
+            default:
+                furi_crash("Unknown FF type");
             }
 
-            furi_string_free(value);
+            // Continue right after consumed values
+            int32_t unread = flipper_format_span_get_unread(&span);
+            if(!stream_seek(stream, -unread, StreamOffsetFromCurrent)) {
+                result = false;
+            }
         }
     } while(false);
 
@@ -442,34 +332,20 @@ bool flipper_format_stream_get_value_count(
     uint32_t* count,
     bool strict_mode) {
     bool result = false;
-    bool last = false;
-
-    FuriString* value;
-    value = furi_string_alloc();
 
     uint32_t position = stream_tell(stream);
     do {
         if(!flipper_format_stream_seek_to_key(stream, key, strict_mode)) break;
-        *count = 0;
-
-        result = true;
-        while(true) {
-            if(!flipper_format_stream_read_value(stream, value, &last)) {
-                result = false;
-                break;
-            }
-
-            *count = *count + 1;
-            if(last) break;
-        }
 
+        FlipperFormatSpan span;
+        flipper_format_span_init(&span, (FlipperFormatSpanReadCallback)stream_read, stream);
+        result = flipper_format_span_count(&span, count);
     } while(false);
 
     if(!stream_seek(stream, position, StreamOffsetFromStart)) {
         result = false;
     }
 
-    furi_string_free(value);
     return result;
 }
 
@@ -0,0 +1,300 @@
+// Host benchmark for Flipper Format value parsing, built from the firmware sources:
+//   cc -O2 -I.. -I../.. -o flipper_format_span_bench flipper_format_span_bench.c
+//      ../flipper_format_span.c ../../toolbox/hex.c
+//   ./flipper_format_span_bench file.nfc file.ir file.sub ...
+// Every "Key: values" line with only hex bytes or only decimal values is parsed
+// many times with the span reader and with the previous per value reader. The
+// previous reader is reproduced here with a plain growing buffer instead of a
+// FuriString, so on device the difference is bigger. Results are compared.
+
+#include "flipper_format_span.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <toolbox/hex.h>
+
+#define FLIPPER_FORMAT_SPAN_BENCH_ROUNDS (200)
+#define FLIPPER_FORMAT_SPAN_BENCH_VALUES_MAX (4096)
+
+typedef enum {
+    FlipperFormatSpanBenchHex,
+    FlipperFormatSpanBenchInt32,
+} FlipperFormatSpanBenchType;
+
+typedef struct {
+    const char* data;
+    size_t size;
+    size_t pos;
+} FlipperFormatSpanBenchSource;
+
+typedef struct {
+    char* data;
+    size_t size;
+    size_t capacity;
+} FlipperFormatSpanBenchString;
+
+static uint32_t mismatches;
+
+static size_t flipper_format_span_bench_read(void* context, uint8_t* data, size_t size) {
+    FlipperFormatSpanBenchSource* source = context;
+    size_t left = source->size - source->pos;
+    if(size > left) size = left;
+    memcpy(data, source->data + source->pos, size);
+    source->pos += size;
+    return size;
+}
+
+static uint64_t flipper_format_span_bench_now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// Not inlined, like furi_string_push_back
+__attribute__((noinline)) static void
+    flipper_format_span_bench_push_back(FlipperFormatSpanBenchString* string, char c) {
+    if(string->size + 2 > string->capacity) {
+        string->capacity = string->capacity ? string->capacity * 2 : 16;
+        string->data = realloc(string->data, string->capacity);
+    }
+    string->data[string->size++] = c;
+    string->data[string->size] = '\0';
+}
+
+/** Same as the previous flipper_format_stream_read_value */
+static bool flipper_format_span_bench_old_value(
+    FlipperFormatSpanBenchSource* source,
+    FlipperFormatSpanBenchString* value,
+    bool* last) {
+    enum { LeadingSpace, ReadValue, TrailingSpace } state = LeadingSpace;
+    uint8_t buffer[32];
+    bool result = false;
+    bool error = false;
+
+    value->size = 0;
+    if(value->data) value->data[0] = '\0';
+
+    while(true) {
+        size_t was_read = flipper_format_span_bench_read(source, buffer, sizeof(buffer));
+
+        if(was_read == 0) {
+            if(state != LeadingSpace && source->pos == source->size) {
+                result = true;
+                *last = true;
+            } else {
+                error = true;
+            }
+        }
+
+        for(uint16_t i = 0; i < was_read; i++) {
+            const uint8_t data = buffer[i];
+            const bool space = data == ' ' || data == '\t' || data == '\r';
+
+            if(state == LeadingSpace) {
+                if(space) {
+                    continue;
+                } else if(data == '\n') {
+                    source->pos -= was_read - i;
+                    error = true;
+                    break;
+                } else {
+                    state = ReadValue;
+                    flipper_format_span_bench_push_back(value, data);
+                }
+            } else if(state == ReadValue) {
+                if(space) {
+                    state = TrailingSpace;
+                } else if(data == '\n') {
+                    source->pos -= was_read - i;
+                    result = true;
+                    *last = true;
+                    break;
+                } else {
+                    flipper_format_span_bench_push_back(value, data);
+                }
+            } else if(state == TrailingSpace) {
+                if(space) continue;
+                source->pos -= was_read - i;
+                *last = (data == '\n');
+                result = true;
+                break;
+            }
+        }
+
+        if(error || result) break;
+    }
+
+    return result;
+}
+
+static bool flipper_format_span_bench_old(
+    FlipperFormatSpanBenchSource* source,
+    FlipperFormatSpanBenchType type,
+    void* data,
+    size_t count) {
+    static FlipperFormatSpanBenchString value;
+    bool result = true;
+
+    for(size_t i = 0; i < count; i++) {
+        bool last = false;
+        result = flipper_format_span_bench_old_value(source, &value, &last);
+        if(!result) break;
+
+        if(type == FlipperFormatSpanBenchHex) {
+            result = value.size >= 2 &&
+                     hex_char_to_uint8(value.data[0], value.data[1], &((uint8_t*)data)[i]);
+        } else {
+            result = sscanf(value.data, "%" SCNi32, &((int32_t*)data)[i]) == 1;
+        }
+        if(!result) break;
+
+        if(last && ((i + 1) != count)) {
+            result = false;
+            break;
+        }
+    }
+
+    return result;
+}
+
+static bool flipper_format_span_bench_new(
+    FlipperFormatSpanBenchSource* source,
+    FlipperFormatSpanBenchType type,
+    void* data,
+    size_t count) {
+    FlipperFormatSpan span;
+    flipper_format_span_init(&span, flipper_format_span_bench_read, source);
+
+    bool result = type == FlipperFormatSpanBenchHex ?
+                      flipper_format_span_read_hex(&span, data, count) :
+                      flipper_format_span_read_int32(&span, data, count);
+    source->pos -= flipper_format_span_get_unread(&span);
+
+    return result;
+}
+
+static bool flipper_format_span_bench_type(
+    const char* line,
+    size_t size,
+    FlipperFormatSpanBenchType* type,
+    uint32_t* count) {
+    bool hex = true;
+    bool decimal = true;
+    size_t token = 0;
+    *count = 0;
+
+    for(size_t i = 0; i <= size; i++) {
+        const char c = i < size ? line[i] : ' ';
+        if(c == ' ' || c == '\r') {
+            if(token > 0) {
+                (*count)++;
+                hex &= token == 2;
+            }
+            token = 0;
+        } else {
+            uint8_t nibble;
+            hex &= hex_char_to_hex_nibble(c, &nibble);
+            decimal &= (c >= '0' && c <= '9') || (c == '-' && token == 0);
+            token++;
+        }
+    }
+
+    *type = hex ? FlipperFormatSpanBenchHex : FlipperFormatSpanBenchInt32;
+    return (*count > 0) && (*count <= FLIPPER_FORMAT_SPAN_BENCH_VALUES_MAX) && (hex || decimal);
+}
+
+static void flipper_format_span_bench_file(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if(!file) {
+        perror(path);
+        return;
+    }
+    fseek(file, 0, SEEK_END);
+    long file_size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char* data = malloc(file_size + 1);
+    size_t data_size = fread(data, 1, file_size, file);
+    fclose(file);
+    data[data_size] = '\0';
+
+    static int32_t old_values[FLIPPER_FORMAT_SPAN_BENCH_VALUES_MAX];
+    static int32_t new_values[FLIPPER_FORMAT_SPAN_BENCH_VALUES_MAX];
+    uint32_t lines = 0;
+    uint32_t values = 0;
+    uint64_t old_time = 0;
+    uint64_t new_time = 0;
+
+    for(char* line = data; line < data + data_size;) {
+        char* end = memchr(line, '\n', data + data_size - line);
+        if(!end) end = data + data_size;
+
+        // Values start after "Key: " like flipper_format_stream_seek_to_key leaves it
+        char* delimiter = memchr(line, ':', end - line);
+        FlipperFormatSpanBenchType type;
+        uint32_t count;
+        if(line[0] != '#' && delimiter && (delimiter + 2 <= end) &&
+           flipper_format_span_bench_type(delimiter + 2, end - delimiter - 2, &type, &count)) {
+            size_t start = delimiter + 2 - data;
+            FlipperFormatSpanBenchSource source = {.data = data, .size = data_size};
+
+            memset(old_values, 0, sizeof(old_values));
+            memset(new_values, 0, sizeof(new_values));
+
+            uint64_t begin = flipper_format_span_bench_now();
+            bool old_result = false;
+            for(size_t round = 0; round < FLIPPER_FORMAT_SPAN_BENCH_ROUNDS; round++) {
+                source.pos = start;
+                old_result = flipper_format_span_bench_old(&source, type, old_values, count);
+            }
+            size_t old_pos = source.pos;
+            old_time += flipper_format_span_bench_now() - begin;
+
+            begin = flipper_format_span_bench_now();
+            bool new_result = false;
+            for(size_t round = 0; round < FLIPPER_FORMAT_SPAN_BENCH_ROUNDS; round++) {
+                source.pos = start;
+                new_result = flipper_format_span_bench_new(&source, type, new_values, count);
+            }
+            new_time += flipper_format_span_bench_now() - begin;
+
+            if(old_result != new_result || old_pos != source.pos ||
+               memcmp(old_values, new_values, sizeof(old_values)) != 0) {
+                printf("mismatch: %s:%u\n", path, lines + 1);
+                mismatches++;
+            }
+
+            values += count;
+        }
+
+        lines++;
+        line = end + 1;
+    }
+
+    printf(
+        "%-48s %5u lines %7u values  old %8.1f us  span %8.1f us  x%.2f\n",
+        path,
+        lines,
+        values,
+        (double)old_time / FLIPPER_FORMAT_SPAN_BENCH_ROUNDS / 1000,
+        (double)new_time / FLIPPER_FORMAT_SPAN_BENCH_ROUNDS / 1000,
+        new_time ? (double)old_time / new_time : 0.0);
+
+    free(data);
+}
+
+int main(int argc, char** argv) {
+    if(argc < 2) {
+        printf("usage: %s file.nfc file.ir file.sub ...\n", argv[0]);
+        return 2;
+    }
+
+    for(int i = 1; i < argc; i++) {
+        flipper_format_span_bench_file(argv[i]);
+    }
+
+    printf("mismatches %u\n", mismatches);
+    return mismatches ? 1 : 0;
+}
@@ -2,9 +2,20 @@
 #include "tools/varint_pair.h"
 #include <toolbox/stream/file_stream.h>
 #include <toolbox/varint.h>
+#include <toolbox/compress.h>
 
 #define LFRFID_RAW_FILE_MAGIC 0x4C464952
 #define LFRFID_RAW_FILE_VERSION 1
+#define LFRFID_RAW_FILE_VERSION_COMPRESSED 2
+
+/** Size of delta-encoded data in one compressed block */
+#define LFRFID_RAW_FILE_BLOCK_SIZE 2048
+/** Worst case size of compressed block: heatshrink may expand data by 1 bit per byte */
+#define LFRFID_RAW_FILE_BLOCK_DATA_MAX_SIZE \
+    (LFRFID_RAW_FILE_BLOCK_SIZE + LFRFID_RAW_FILE_BLOCK_SIZE / 8 + 16)
+/** Max size of encoded pair: varint uint32 pulse and varint int32 period delta */
+#define LFRFID_RAW_FILE_PAIR_MAX_SIZE 10
+#define LFRFID_RAW_FILE_COMPRESS_BUFFER_SIZE 512
 
 #define TAG "RFID RAW File"
 
@@ -16,6 +27,19 @@ typedef struct {
     uint32_t max_buffer_size;
 } LFRFIDRawFileHeader;
 
+/**
+ * Compressed file layout:
+ * LFRFIDRawFileHeader, then blocks, each is LFRFIDRawFileBlockHeader followed by compressed data.
+ * Block data is a sequence of pairs: varint pulse, zigzag varint period delta.
+ * Period delta is reset at the beginning of each block, so every block can be decoded on its own.
+ * Interrupted capture is still readable up to the last complete block, partial block at the end
+ * of the file is treated as the end of data.
+ */
+typedef struct {
+    uint32_t raw_size;
+    uint32_t data_size;
+} LFRFIDRawFileBlockHeader;
+
 struct LFRFIDRawFile {
     Stream* stream;
     uint32_t max_buffer_size;
@@ -23,21 +47,53 @@ struct LFRFIDRawFile {
     uint8_t* buffer;
     uint32_t buffer_size;
     size_t buffer_counter;
+
+    bool compressed;
+    Compress* compress;
+    uint8_t* block_data;
+    uint32_t previous_period;
+    size_t data_end;
+    size_t blocks_count;
+
+    size_t raw_bytes;
+    size_t written_bytes;
 };
 
 LFRFIDRawFile* lfrfid_raw_file_alloc(Storage* storage) {
     LFRFIDRawFile* file = malloc(sizeof(LFRFIDRawFile));
     file->stream = file_stream_alloc(storage);
     file->buffer = NULL;
+    file->compressed = false;
+    file->compress = NULL;
+    file->block_data = NULL;
+    file->blocks_count = 0;
+    file->raw_bytes = 0;
+    file->written_bytes = 0;
     return file;
 }
 
 void lfrfid_raw_file_free(LFRFIDRawFile* file) {
     if(file->buffer) free(file->buffer);
+    if(file->block_data) free(file->block_data);
+    if(file->compress) compress_free(file->compress);
     stream_free(file->stream);
     free(file);
 }
 
+void lfrfid_raw_file_set_compressed(LFRFIDRawFile* file, bool compressed) {
+    file->compressed = compressed;
+}
+
+static void lfrfid_raw_file_compressed_init(LFRFIDRawFile* file) {
+    file->compress = compress_alloc(LFRFID_RAW_FILE_COMPRESS_BUFFER_SIZE);
+    file->max_buffer_size = LFRFID_RAW_FILE_BLOCK_SIZE;
+    file->buffer = malloc(LFRFID_RAW_FILE_BLOCK_SIZE);
+    file->block_data = malloc(LFRFID_RAW_FILE_BLOCK_DATA_MAX_SIZE);
+    file->buffer_size = 0;
+    file->buffer_counter = 0;
+    file->previous_period = 0;
+}
+
 bool lfrfid_raw_file_open_write(LFRFIDRawFile* file, const char* file_path) {
     return file_stream_open(file->stream, file_path, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS);
 }
@@ -51,9 +107,15 @@ bool lfrfid_raw_file_write_header(
     float frequency,
     float duty_cycle,
     uint32_t max_buffer_size) {
+    if(file->compressed) {
+        lfrfid_raw_file_compressed_init(file);
+        max_buffer_size = LFRFID_RAW_FILE_BLOCK_SIZE;
+    }
+
     LFRFIDRawFileHeader header = {
         .magic = LFRFID_RAW_FILE_MAGIC,
-        .version = LFRFID_RAW_FILE_VERSION,
+        .version = file->compressed ? LFRFID_RAW_FILE_VERSION_COMPRESSED :
+                                      LFRFID_RAW_FILE_VERSION,
         .frequency = frequency,
         .duty_cycle = duty_cycle,
         .max_buffer_size = max_buffer_size};
@@ -62,7 +124,75 @@ bool lfrfid_raw_file_write_header(
     return (size == sizeof(LFRFIDRawFileHeader));
 }
 
+static bool lfrfid_raw_file_flush_block(LFRFIDRawFile* file) {
+    if(file->buffer_size == 0) return true;
+
+    LFRFIDRawFileBlockHeader block_header = {.raw_size = file->buffer_size, .data_size = 0};
+    size_t data_size = 0;
+    if(!compress_encode(
+           file->compress,
+           file->buffer,
+           file->buffer_size,
+           file->block_data,
+           LFRFID_RAW_FILE_BLOCK_DATA_MAX_SIZE,
+           &data_size)) {
+        FURI_LOG_E(TAG, "flush block: failed to compress");
+        return false;
+    }
+    block_header.data_size = data_size;
+
+    if(stream_write(file->stream, (uint8_t*)&block_header, sizeof(block_header)) !=
+           sizeof(block_header) ||
+       stream_write(file->stream, file->block_data, data_size) != data_size) {
+        return false;
+    }
+
+    file->blocks_count++;
+    file->raw_bytes += file->buffer_size;
+    file->written_bytes += sizeof(block_header) + data_size;
+    file->buffer_size = 0;
+    file->previous_period = 0;
+    return true;
+}
+
+static bool lfrfid_raw_file_write_buffer_compressed(
+    LFRFIDRawFile* file,
+    uint8_t* buffer_data,
+    size_t buffer_size) {
+    size_t buffer_counter = 0;
+    while(buffer_counter < buffer_size) {
+        uint32_t pulse;
+        uint32_t period;
+        size_t pair_size = 0;
+        if(!varint_pair_unpack(
+               &buffer_data[buffer_counter],
+               buffer_size - buffer_counter,
+               &pulse,
+               &period,
+               &pair_size)) {
+            FURI_LOG_E(TAG, "write buffer: broken pair");
+            return false;
+        }
+        buffer_counter += pair_size;
+
+        if(file->buffer_size + LFRFID_RAW_FILE_PAIR_MAX_SIZE > LFRFID_RAW_FILE_BLOCK_SIZE) {
+            if(!lfrfid_raw_file_flush_block(file)) return false;
+        }
+
+        int32_t period_delta = (int32_t)(period - file->previous_period);
+        file->previous_period = period;
+        file->buffer_size += varint_uint32_pack(pulse, &file->buffer[file->buffer_size]);
+        file->buffer_size += varint_int32_pack(period_delta, &file->buffer[file->buffer_size]);
+    }
+
+    return true;
+}
+
 bool lfrfid_raw_file_write_buffer(LFRFIDRawFile* file, uint8_t* buffer_data, size_t buffer_size) {
+    if(file->compressed) {
+        return lfrfid_raw_file_write_buffer_compressed(file, buffer_data, buffer_size);
+    }
+
     size_t size;
     size = stream_write(file->stream, (uint8_t*)&buffer_size, sizeof(size_t));
     if(size != sizeof(size_t)) return false;
@@ -73,11 +203,34 @@ bool lfrfid_raw_file_write_buffer(LFRFIDRawFile* file, uint8_t* buffer_data, siz
     return true;
 }
 
+bool lfrfid_raw_file_finalize(LFRFIDRawFile* file) {
+    if(!file->compressed) return true;
+
+    if(!lfrfid_raw_file_flush_block(file)) return false;
+
+    FURI_LOG_I(
+        TAG,
+        "%zu blocks, %zu bytes of pairs saved as %zu bytes",
+        file->blocks_count,
+        file->raw_bytes,
+        file->written_bytes);
+    return true;
+}
+
 bool lfrfid_raw_file_read_header(LFRFIDRawFile* file, float* frequency, float* duty_cycle) {
     LFRFIDRawFileHeader header;
     size_t size = stream_read(file->stream, (uint8_t*)&header, sizeof(LFRFIDRawFileHeader));
     if(size == sizeof(LFRFIDRawFileHeader)) {
-        if(header.magic == LFRFID_RAW_FILE_MAGIC && header.version == LFRFID_RAW_FILE_VERSION) {
+        if(header.magic == LFRFID_RAW_FILE_MAGIC &&
+           header.version == LFRFID_RAW_FILE_VERSION_COMPRESSED) {
+            *frequency = header.frequency;
+            *duty_cycle = header.duty_cycle;
+            file->compressed = true;
+            lfrfid_raw_file_compressed_init(file);
+            file->data_end = stream_size(file->stream);
+            return true;
+        } else if(
+            header.magic == LFRFID_RAW_FILE_MAGIC && header.version == LFRFID_RAW_FILE_VERSION) {
             *frequency = header.frequency;
             *duty_cycle = header.duty_cycle;
             file->max_buffer_size = header.max_buffer_size;
@@ -93,11 +246,107 @@ bool lfrfid_raw_file_read_header(LFRFIDRawFile* file, float* frequency, float* d
     }
 }
 
+static bool
+    lfrfid_raw_file_read_block_header(LFRFIDRawFile* file, LFRFIDRawFileBlockHeader* header) {
+    size_t block_start = stream_tell(file->stream);
+    if(block_start + sizeof(LFRFIDRawFileBlockHeader) > file->data_end) return false;
+
+    if(stream_read(file->stream, (uint8_t*)header, sizeof(LFRFIDRawFileBlockHeader)) !=
+       sizeof(LFRFIDRawFileBlockHeader)) {
+        return false;
+    }
+
+    return header->data_size <= file->data_end - block_start - sizeof(LFRFIDRawFileBlockHeader);
+}
+
+static bool lfrfid_raw_file_read_block(LFRFIDRawFile* file, bool* pass_end) {
+    LFRFIDRawFileBlockHeader block_header;
+    size_t block_start = stream_tell(file->stream);
+    if(!lfrfid_raw_file_read_block_header(file, &block_header)) {
+        // data ends before this block, rewind stream and pass header
+        file->data_end = block_start;
+        stream_seek(file->stream, sizeof(LFRFIDRawFileHeader), StreamOffsetFromStart);
+        if(pass_end) *pass_end = true;
+
+        if(!lfrfid_raw_file_read_block_header(file, &block_header)) {
+            FURI_LOG_E(TAG, "read block: no complete blocks");
+            return false;
+        }
+    }
+
+    if(block_header.raw_size > LFRFID_RAW_FILE_BLOCK_SIZE ||
+       block_header.data_size > LFRFID_RAW_FILE_BLOCK_DATA_MAX_SIZE) {
+        FURI_LOG_E(TAG, "read block: block is too big");
+        return false;
+    }
+
+    if(stream_read(file->stream, file->block_data, block_header.data_size) !=
+       block_header.data_size) {
+        FURI_LOG_E(TAG, "read block: failed to read data");
+        return false;
+    }
+
+    size_t raw_size = 0;
+    if(!compress_decode(
+           file->compress,
+           file->block_data,
+           block_header.data_size,
+           file->buffer,
+           LFRFID_RAW_FILE_BLOCK_SIZE,
+           &raw_size) ||
+       raw_size != block_header.raw_size) {
+        FURI_LOG_E(TAG, "read block: failed to decompress");
+        return false;
+    }
+
+    file->buffer_size = raw_size;
+    file->buffer_counter = 0;
+    file->previous_period = 0;
+    return true;
+}
+
+static bool lfrfid_raw_file_read_pair_compressed(
+    LFRFIDRawFile* file,
+    uint32_t* duration,
+    uint32_t* pulse,
+    bool* pass_end) {
+    if(file->buffer_counter >= file->buffer_size) {
+        if(!lfrfid_raw_file_read_block(file, pass_end)) {
+            return false;
+        }
+    }
+
+    size_t available = file->buffer_size - file->buffer_counter;
+    size_t pulse_size = varint_uint32_unpack(pulse, &file->buffer[file->buffer_counter], available);
+    if(pulse_size == 0 || pulse_size >= available) {
+        FURI_LOG_E(TAG, "read pair: buffer is too small");
+        return false;
+    }
+    file->buffer_counter += pulse_size;
+
+    int32_t period_delta = 0;
+    size_t period_size = varint_int32_unpack(
+        &period_delta, &file->buffer[file->buffer_counter], available - pulse_size);
+    if(period_size == 0) {
+        FURI_LOG_E(TAG, "read pair: broken period");
+        return false;
+    }
+    file->buffer_counter += period_size;
+    file->previous_period += period_delta;
+    *duration = file->previous_period;
+
+    return true;
+}
+
 bool lfrfid_raw_file_read_pair(
     LFRFIDRawFile* file,
     uint32_t* duration,
     uint32_t* pulse,
     bool* pass_end) {
+    if(file->compressed) {
+        return lfrfid_raw_file_read_pair_compressed(file, duration, pulse, pass_end);
+    }
+
     size_t length = 0;
     if(file->buffer_counter >= file->buffer_size) {
         if(stream_eof(file->stream)) {
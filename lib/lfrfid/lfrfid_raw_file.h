@@ -40,6 +40,17 @@ bool lfrfid_raw_file_open_write(LFRFIDRawFile* file, const char* file_path);
  */
 bool lfrfid_raw_file_open_read(LFRFIDRawFile* file, const char* file_path);
 
+/**
+ * @brief Enable compressed RAW format for writing.
+ * Pairs are delta-encoded and compressed in blocks, the last block is written by
+ * lfrfid_raw_file_finalize. Must be called before lfrfid_raw_file_write_header.
+ * Reading detects the format from the header, no need to call this.
+ * 
+ * @param file 
+ * @param compressed 
+ */
+void lfrfid_raw_file_set_compressed(LFRFIDRawFile* file, bool compressed);
+
 /**
  * @brief Write RAW file header
  * 
@@ -65,6 +76,15 @@ bool lfrfid_raw_file_write_header(
  */
 bool lfrfid_raw_file_write_buffer(LFRFIDRawFile* file, uint8_t* buffer_data, size_t buffer_size);
 
+/**
+ * @brief Flush pending data as the last block, must be called after the last write.
+ * Does nothing for uncompressed files.
+ * 
+ * @param file 
+ * @return bool 
+ */
+bool lfrfid_raw_file_finalize(LFRFIDRawFile* file);
+
 /**
  * @brief Read RAW file header
  * 
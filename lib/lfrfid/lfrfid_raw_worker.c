@@ -49,6 +49,7 @@ struct LFRFIDRawWorker {
 
     float frequency;
     float duty_cycle;
+    bool compressed;
 };
 
 typedef enum {
@@ -66,6 +67,7 @@ LFRFIDRawWorker* lfrfid_raw_worker_alloc() {
     worker->events = furi_event_flag_alloc(NULL);
 
     worker->file_path = furi_string_alloc();
+    worker->compressed = false;
     return worker;
 }
 
@@ -97,6 +99,11 @@ void lfrfid_raw_worker_start_read(
     furi_thread_start(worker->thread);
 }
 
+void lfrfid_raw_worker_set_compression(LFRFIDRawWorker* worker, bool compressed) {
+    furi_check(furi_thread_get_state(worker->thread) == FuriThreadStateStopped);
+    worker->compressed = compressed;
+}
+
 void lfrfid_raw_worker_start_emulate(
     LFRFIDRawWorker* worker,
     const char* file_path,
@@ -145,6 +152,7 @@ static int32_t lfrfid_raw_read_worker_thread(void* thread_context) {
 
     if(file_valid) {
         // write header
+        lfrfid_raw_file_set_compressed(file, worker->compressed);
         file_valid = lfrfid_raw_file_write_header(
             file, worker->frequency, worker->duty_cycle, RFID_DATA_BUFFER_SIZE);
     }
@@ -190,6 +198,22 @@ static int32_t lfrfid_raw_read_worker_thread(void* thread_context) {
 
         furi_hal_rfid_tim_read_capture_stop();
         furi_hal_rfid_tim_read_stop();
+
+        // write the rest of the captured data
+        Buffer* buffer;
+        while(file_valid && (buffer = buffer_stream_receive(data->stream, 0)) != NULL) {
+            file_valid = lfrfid_raw_file_write_buffer(
+                file, buffer_get_data(buffer), buffer_get_size(buffer));
+            buffer_reset(buffer);
+        }
+
+        if(file_valid && !lfrfid_raw_file_finalize(file)) {
+            file_valid = false;
+            if(worker->read_callback != NULL) {
+                // message file_error to worker
+                worker->read_callback(LFRFIDWorkerReadRawFileError, worker->context);
+            }
+        }
     } else {
         if(worker->read_callback != NULL) {
             // message file_error to worker
@@ -289,9 +313,9 @@ static int32_t lfrfid_raw_emulate_worker_thread(void* thread_context) {
                         &data->emulate_buffer_ccr[start + i],
                         NULL);
                     if(!file_valid) break;
-                    data->emulate_buffer_arr[i] /= 8;
-                    data->emulate_buffer_arr[i] -= 1;
-                    data->emulate_buffer_ccr[i] /= 8;
+                    data->emulate_buffer_arr[start + i] /= 8;
+                    data->emulate_buffer_arr[start + i] -= 1;
+                    data->emulate_buffer_ccr[start + i] /= 8;
                 }
             } else if(size != 0) {
                 data->ctx.overrun_count++;
@@ -42,6 +42,14 @@ void lfrfid_raw_worker_start_read(
     LFRFIDWorkerReadRawCallback callback,
     void* context);
 
+/**
+ * @brief Enable compressed RAW file format for the next read
+ * 
+ * @param worker LFRFIDRawWorker instance
+ * @param compressed true to write compressed RAW file
+ */
+void lfrfid_raw_worker_set_compression(LFRFIDRawWorker* worker, bool compressed);
+
 /**
  * @brief Start emulate
  * 
@@ -27,6 +27,7 @@ LFRFIDWorker* lfrfid_worker_alloc(ProtocolDict* dict) {
     worker->write_cb = NULL;
     worker->cb_ctx = NULL;
     worker->raw_filename = NULL;
+    worker->read_raw_compressed = false;
     worker->mode_storage = NULL;
 
     worker->thread = furi_thread_alloc_ex("LfrfidWorker", 2048, lfrfid_worker_thread, worker);
@@ -97,6 +98,11 @@ void lfrfid_worker_read_raw_start(
     furi_thread_flags_set(furi_thread_get_id(worker->thread), LFRFIDEventReadRaw);
 }
 
+void lfrfid_worker_read_raw_set_compression(LFRFIDWorker* worker, bool compressed) {
+    furi_assert(worker->mode_index == LFRFIDWorkerIdle);
+    worker->read_raw_compressed = compressed;
+}
+
 void lfrfid_worker_emulate_raw_start(
     LFRFIDWorker* worker,
     const char* filename,
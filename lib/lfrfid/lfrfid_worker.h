@@ -128,6 +128,14 @@ void lfrfid_worker_read_raw_start(
     LFRFIDWorkerReadRawCallback callback,
     void* context);
 
+/**
+ * @brief Enable compressed file format for raw read mode
+ * 
+ * @param worker 
+ * @param compressed 
+ */
+void lfrfid_worker_read_raw_set_compression(LFRFIDWorker* worker, bool compressed);
+
 /**
  * Emulate raw read mode
  * @param worker 
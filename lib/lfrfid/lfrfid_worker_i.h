@@ -37,6 +37,7 @@ struct LFRFIDWorker {
     FuriThread* thread;
 
     LFRFIDWorkerReadType read_type;
+    bool read_raw_compressed;
 
     LFRFIDWorkerReadCallback read_cb;
     LFRFIDWorkerWriteCallback write_cb;
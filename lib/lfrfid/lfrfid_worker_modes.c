@@ -580,6 +580,7 @@ static void lfrfid_worker_mode_write_process(LFRFIDWorker* worker) {
 
 static void lfrfid_worker_mode_read_raw_process(LFRFIDWorker* worker) {
     LFRFIDRawWorker* raw_worker = lfrfid_raw_worker_alloc();
+    lfrfid_raw_worker_set_compression(raw_worker, worker->read_raw_compressed);
 
     switch(worker->read_type) {
     case LFRFIDWorkerReadTypePSKOnly:
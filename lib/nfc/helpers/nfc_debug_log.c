@@ -48,22 +48,20 @@ void nfc_debug_log_free(NfcDebugLog* instance) {
     free(instance);
 }
 
-void nfc_debug_log_process_data(
-    NfcDebugLog* instance,
-    uint8_t* data,
-    uint16_t len,
-    bool reader_to_tag,
-    bool crc_dropped) {
+void nfc_debug_log_process_frame(NfcDebugLog* instance, const NfcTraceFrame* frame) {
     furi_assert(instance);
     furi_assert(instance->file_stream);
     furi_assert(instance->data_str);
-    furi_assert(data);
-    UNUSED(crc_dropped);
+    furi_assert(frame);
 
-    furi_string_printf(instance->data_str, "%lu %c:", furi_get_tick(), reader_to_tag ? 'R' : 'T');
-    uint16_t data_len = len;
-    for(size_t i = 0; i < data_len; i++) {
-        furi_string_cat_printf(instance->data_str, " %02x", data[i]);
+    furi_string_printf(
+        instance->data_str,
+        "%lu.%06lu %c:",
+        (uint32_t)(frame->timestamp_us / 1000000),
+        (uint32_t)(frame->timestamp_us % 1000000),
+        frame->reader_to_tag ? 'R' : 'T');
+    for(size_t i = 0; i < frame->len; i++) {
+        furi_string_cat_printf(instance->data_str, " %02x", frame->data[i]);
     }
     furi_string_push_back(instance->data_str, '\n');
 
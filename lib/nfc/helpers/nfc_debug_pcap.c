@@ -3,7 +3,6 @@
 #include <storage/storage.h>
 #include <stream/buffered_file_stream.h>
 #include <furi_hal_nfc.h>
-#include <furi_hal_rtc.h>
 
 #define TAG "NfcDebugPcap"
 
@@ -80,32 +79,26 @@ void nfc_debug_pcap_free(NfcDebugPcap* instance) {
     free(instance);
 }
 
-void nfc_debug_pcap_process_data(
-    NfcDebugPcap* instance,
-    uint8_t* data,
-    uint16_t len,
-    bool reader_to_tag,
-    bool crc_dropped) {
+void nfc_debug_pcap_process_frame(NfcDebugPcap* instance, const NfcTraceFrame* frame) {
     furi_assert(instance);
-    furi_assert(data);
-    FuriHalRtcDateTime datetime;
-    furi_hal_rtc_get_datetime(&datetime);
+    furi_assert(frame);
 
     uint8_t event = 0;
-    if(reader_to_tag) {
-        if(crc_dropped) {
+    if(frame->reader_to_tag) {
+        if(frame->crc_dropped) {
             event = DATA_PCD_TO_PICC_CRC_DROPPED;
         } else {
             event = DATA_PCD_TO_PICC;
         }
     } else {
-        if(crc_dropped) {
+        if(frame->crc_dropped) {
             event = DATA_PICC_TO_PCD_CRC_DROPPED;
         } else {
             event = DATA_PICC_TO_PCD;
         }
     }
 
+    uint16_t len = frame->len;
     struct {
         // https://wiki.wireshark.org/Development/LibpcapFileFormat#record-packet-header
         uint32_t ts_sec;
@@ -117,8 +110,8 @@ void nfc_debug_pcap_process_data(
         uint8_t event;
         uint16_t len;
     } __attribute__((__packed__)) pkt_hdr = {
-        .ts_sec = furi_hal_rtc_datetime_to_timestamp(&datetime),
-        .ts_usec = 0,
+        .ts_sec = frame->timestamp_us / 1000000,
+        .ts_usec = frame->timestamp_us % 1000000,
         .incl_len = len + 4,
         .orig_len = len + 4,
         .version = 0,
@@ -126,5 +119,5 @@ void nfc_debug_pcap_process_data(
         .len = len << 8 | len >> 8,
     };
     stream_write(instance->file_stream, (uint8_t*)&pkt_hdr, sizeof(pkt_hdr));
-    stream_write(instance->file_stream, data, len);
+    stream_write(instance->file_stream, frame->data, len);
 }
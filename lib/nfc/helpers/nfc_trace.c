@@ -0,0 +1,191 @@
+#include "nfc_trace.h"
+
+#include <furi.h>
+#include <furi_hal_cortex.h>
+#include <furi_hal_nfc.h>
+#include <furi_hal_rtc.h>
+
+#define TAG "NfcTrace"
+
+#define NFC_TRACE_FRAME_MAX_SIZE FURI_HAL_NFC_DATA_BUFF_SIZE
+// Cycle counter wraps every ~67 s at 64 MHz, fall back to ticks for longer gaps
+#define NFC_TRACE_CYCLES_VALID_MS (30000)
+
+#define NFC_TRACE_FLAG_READER_TO_TAG (1 << 0)
+#define NFC_TRACE_FLAG_CRC_DROPPED (1 << 1)
+
+typedef struct {
+    uint64_t timestamp_us;
+    uint16_t len;
+    uint8_t flags;
+} __attribute__((packed)) NfcTraceRecordHeader;
+
+struct NfcTrace {
+    FuriStreamBuffer* ring;
+    FuriThread* thread;
+    volatile bool running;
+
+    NfcTraceCallback callback;
+    void* context;
+
+    // Timestamp anchors, producer side only
+    uint64_t timestamp_us;
+    uint32_t last_cycles;
+    uint32_t last_tick;
+    uint32_t cycles_per_us;
+
+    volatile uint32_t dropped;
+
+    // Producer builds records here to write them into the ring in one go
+    uint8_t record[sizeof(NfcTraceRecordHeader) + NFC_TRACE_FRAME_MAX_SIZE];
+    // Consumer side frame buffer
+    uint8_t frame[NFC_TRACE_FRAME_MAX_SIZE];
+};
+
+static int32_t nfc_trace_thread(void* context) {
+    NfcTrace* instance = context;
+    uint32_t dropped_reported = 0;
+
+    while(instance->running || !furi_stream_buffer_is_empty(instance->ring)) {
+        NfcTraceRecordHeader header;
+        size_t ret = furi_stream_buffer_receive(instance->ring, &header, sizeof(header), 50);
+        if(ret != sizeof(header)) continue;
+
+        // Records are written atomically, so the payload is already there
+        ret = furi_stream_buffer_receive(instance->ring, instance->frame, header.len, 0);
+        furi_check(ret == header.len);
+
+        if(instance->callback) {
+            NfcTraceFrame frame = {
+                .timestamp_us = header.timestamp_us,
+                .data = instance->frame,
+                .len = header.len,
+                .reader_to_tag = header.flags & NFC_TRACE_FLAG_READER_TO_TAG,
+                .crc_dropped = header.flags & NFC_TRACE_FLAG_CRC_DROPPED,
+            };
+            instance->callback(&frame, instance->context);
+        }
+
+        uint32_t dropped = instance->dropped;
+        if(dropped != dropped_reported) {
+            FURI_LOG_W(TAG, "%lu frames dropped", dropped - dropped_reported);
+            dropped_reported = dropped;
+        }
+    }
+
+    return 0;
+}
+
+NfcTrace* nfc_trace_alloc(size_t ring_size) {
+    furi_assert(ring_size > sizeof(NfcTraceRecordHeader) + NFC_TRACE_FRAME_MAX_SIZE);
+
+    NfcTrace* instance = malloc(sizeof(NfcTrace));
+    instance->ring = furi_stream_buffer_alloc(ring_size, sizeof(NfcTraceRecordHeader));
+    instance->thread = furi_thread_alloc_ex("NfcTraceWorker", 2048, nfc_trace_thread, instance);
+    furi_thread_set_priority(instance->thread, FuriThreadPriorityLow);
+    instance->cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+
+    return instance;
+}
+
+void nfc_trace_free(NfcTrace* instance) {
+    furi_assert(instance);
+
+    nfc_trace_stop(instance);
+    furi_thread_free(instance->thread);
+    furi_stream_buffer_free(instance->ring);
+    free(instance);
+}
+
+void nfc_trace_set_callback(NfcTrace* instance, NfcTraceCallback callback, void* context) {
+    furi_assert(instance);
+    furi_assert(!instance->running);
+
+    instance->callback = callback;
+    instance->context = context;
+}
+
+void nfc_trace_start(NfcTrace* instance) {
+    furi_assert(instance);
+    furi_assert(!instance->running);
+
+    furi_stream_buffer_reset(instance->ring);
+    instance->dropped = 0;
+
+    // RTC gives the wall clock base, everything after is measured in cycles
+    instance->timestamp_us = (uint64_t)furi_hal_rtc_get_timestamp() * 1000000;
+    instance->last_cycles = furi_hal_cortex_timer_get(0).start;
+    instance->last_tick = furi_get_tick();
+
+    instance->running = true;
+    furi_thread_start(instance->thread);
+}
+
+void nfc_trace_stop(NfcTrace* instance) {
+    furi_assert(instance);
+
+    if(!instance->running) return;
+
+    instance->running = false;
+    furi_thread_join(instance->thread);
+
+    if(instance->dropped) {
+        FURI_LOG_W(TAG, "Trace finished, %lu frames dropped", instance->dropped);
+    }
+}
+
+static uint64_t nfc_trace_get_timestamp(NfcTrace* instance) {
+    uint32_t cycles = furi_hal_cortex_timer_get(0).start;
+    uint32_t tick = furi_get_tick();
+    uint64_t elapsed_ms =
+        (uint64_t)(tick - instance->last_tick) * 1000 / furi_kernel_get_tick_frequency();
+
+    if(elapsed_ms < NFC_TRACE_CYCLES_VALID_MS) {
+        uint32_t elapsed_us = (cycles - instance->last_cycles) / instance->cycles_per_us;
+        instance->timestamp_us += elapsed_us;
+        // Keep sub-microsecond remainder for the next frame
+        instance->last_cycles += elapsed_us * instance->cycles_per_us;
+    } else {
+        instance->timestamp_us += elapsed_ms * 1000;
+        instance->last_cycles = cycles;
+    }
+    instance->last_tick = tick;
+
+    return instance->timestamp_us;
+}
+
+bool nfc_trace_push(
+    NfcTrace* instance,
+    const uint8_t* data,
+    uint16_t len,
+    bool reader_to_tag,
+    bool crc_dropped) {
+    furi_assert(instance);
+    furi_assert(data);
+
+    if(!instance->running) return false;
+
+    size_t record_size = sizeof(NfcTraceRecordHeader) + len;
+    if((len > NFC_TRACE_FRAME_MAX_SIZE) ||
+       (furi_stream_buffer_spaces_available(instance->ring) < record_size)) {
+        instance->dropped++;
+        return false;
+    }
+
+    NfcTraceRecordHeader* header = (NfcTraceRecordHeader*)instance->record;
+    header->timestamp_us = nfc_trace_get_timestamp(instance);
+    header->len = len;
+    header->flags = (reader_to_tag ? NFC_TRACE_FLAG_READER_TO_TAG : 0) |
+                    (crc_dropped ? NFC_TRACE_FLAG_CRC_DROPPED : 0);
+    memcpy(&instance->record[sizeof(NfcTraceRecordHeader)], data, len);
+
+    size_t ret = furi_stream_buffer_send(instance->ring, instance->record, record_size, 0);
+    furi_check(ret == record_size);
+
+    return true;
+}
+
+uint32_t nfc_trace_get_dropped(NfcTrace* instance) {
+    furi_assert(instance);
+    return instance->dropped;
+}
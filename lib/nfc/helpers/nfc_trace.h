@@ -0,0 +1,91 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** NFC trace engine
+ *
+ * Frames are timestamped with the cycle counter and copied into a preallocated RAM ring
+ * without blocking the NFC transaction path. A low priority thread hands them to the
+ * consumer callback, which does the slow work (SD writes, key recovery).
+ * Frames that don't fit into the ring are dropped and counted.
+ */
+typedef struct NfcTrace NfcTrace;
+
+typedef struct {
+    uint64_t timestamp_us; /**< Unix time in microseconds */
+    const uint8_t* data;
+    uint16_t len;
+    bool reader_to_tag;
+    bool crc_dropped;
+} NfcTraceFrame;
+
+typedef void (*NfcTraceCallback)(const NfcTraceFrame* frame, void* context);
+
+/** Allocate NfcTrace
+ *
+ * @param ring_size RAM ring size in bytes
+ *
+ * @return NfcTrace instance
+ */
+NfcTrace* nfc_trace_alloc(size_t ring_size);
+
+/** Free NfcTrace, stops it if running
+ *
+ * @param instance NfcTrace instance
+ */
+void nfc_trace_free(NfcTrace* instance);
+
+/** Set consumer callback, called from the trace thread
+ *
+ * @param instance NfcTrace instance
+ * @param callback NfcTraceCallback
+ * @param context callback context
+ */
+void nfc_trace_set_callback(NfcTrace* instance, NfcTraceCallback callback, void* context);
+
+/** Reset ring and counters, anchor timestamps and start the trace thread
+ *
+ * @param instance NfcTrace instance
+ */
+void nfc_trace_start(NfcTrace* instance);
+
+/** Stop the trace thread after all queued frames are delivered
+ *
+ * @param instance NfcTrace instance
+ */
+void nfc_trace_stop(NfcTrace* instance);
+
+/** Timestamp and queue a frame, never blocks
+ *
+ * @param instance NfcTrace instance
+ * @param data frame data
+ * @param len frame length in bytes
+ * @param reader_to_tag direction
+ * @param crc_dropped true if CRC was removed from data
+ *
+ * @return true if queued, false if frame was dropped
+ */
+bool nfc_trace_push(
+    NfcTrace* instance,
+    const uint8_t* data,
+    uint16_t len,
+    bool reader_to_tag,
+    bool crc_dropped);
+
+/** Get number of frames dropped since start
+ *
+ * @param instance NfcTrace instance
+ *
+ * @return dropped frames count
+ */
+uint32_t nfc_trace_get_dropped(NfcTrace* instance);
+
+#ifdef __cplusplus
+}
+#endif
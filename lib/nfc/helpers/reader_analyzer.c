@@ -7,20 +7,15 @@
 #include "mfkey32.h"
 #include "nfc_debug_pcap.h"
 #include "nfc_debug_log.h"
+#include "nfc_trace.h"
 
 #define TAG "ReaderAnalyzer"
 
-#define READER_ANALYZER_MAX_BUFF_SIZE (1024)
+#define READER_ANALYZER_TRACE_RING_SIZE (2048)
 
 #define READER_ANALYZER_UID_SIZE 7
 #define READER_ANALYZER_CUID_SIZE 4
 
-typedef struct {
-    bool reader_to_tag;
-    bool crc_dropped;
-    uint16_t len;
-} ReaderAnalyzerHeader;
-
 typedef enum {
     ReaderAnalyzerNfcDataMfClassic,
 } ReaderAnalyzerNfcData;
@@ -41,9 +36,7 @@ union {
 struct ReaderAnalyzer {
     FuriHalNfcDevData nfc_data;
 
-    bool alive;
-    FuriStreamBuffer* stream;
-    FuriThread* thread;
+    NfcTrace* trace;
 
     ReaderAnalyzerParseDataCallback callback;
     void* context;
@@ -63,52 +56,23 @@ static FuriHalNfcDevData reader_analyzer_nfc_data[] = {
          .a_data = {.sak = 0x08, .atqa = {0x44, 0x00}, .cuid = 0x2A234F80}},
 };
 
-void reader_analyzer_parse(ReaderAnalyzer* instance, uint8_t* buffer, size_t size) {
-    if(size < sizeof(ReaderAnalyzerHeader)) return;
+static void reader_analyzer_trace_callback(const NfcTraceFrame* frame, void* context) {
+    ReaderAnalyzer* instance = context;
 
-    size_t bytes_i = 0;
-    while(bytes_i < size) {
-        ReaderAnalyzerHeader* header = (ReaderAnalyzerHeader*)&buffer[bytes_i];
-        uint16_t len = header->len;
-        if(bytes_i + len > size) break;
-        bytes_i += sizeof(ReaderAnalyzerHeader);
-        if(instance->mfkey32) {
-            mfkey32_process_data(
-                instance->mfkey32,
-                &buffer[bytes_i],
-                len,
-                header->reader_to_tag,
-                header->crc_dropped);
-        }
-        if(instance->pcap) {
-            nfc_debug_pcap_process_data(
-                instance->pcap, &buffer[bytes_i], len, header->reader_to_tag, header->crc_dropped);
-        }
-        if(instance->debug_log) {
-            nfc_debug_log_process_data(
-                instance->debug_log,
-                &buffer[bytes_i],
-                len,
-                header->reader_to_tag,
-                header->crc_dropped);
-        }
-        bytes_i += len;
+    if(instance->mfkey32) {
+        mfkey32_process_data(
+            instance->mfkey32,
+            (uint8_t*)frame->data,
+            frame->len,
+            frame->reader_to_tag,
+            frame->crc_dropped);
     }
-}
-
-int32_t reader_analyzer_thread(void* context) {
-    ReaderAnalyzer* reader_analyzer = context;
-    uint8_t buffer[READER_ANALYZER_MAX_BUFF_SIZE] = {};
-
-    while(reader_analyzer->alive || !furi_stream_buffer_is_empty(reader_analyzer->stream)) {
-        size_t ret = furi_stream_buffer_receive(
-            reader_analyzer->stream, buffer, READER_ANALYZER_MAX_BUFF_SIZE, 50);
-        if(ret) {
-            reader_analyzer_parse(reader_analyzer, buffer, ret);
-        }
+    if(instance->pcap) {
+        nfc_debug_pcap_process_frame(instance->pcap, frame);
+    }
+    if(instance->debug_log) {
+        nfc_debug_log_process_frame(instance->debug_log, frame);
     }
-
-    return 0;
 }
 
 ReaderAnalyzer* reader_analyzer_alloc() {
@@ -126,13 +90,8 @@ ReaderAnalyzer* reader_analyzer_alloc() {
         nfc_util_bytes2num(Uid.uid_converter.cuid, READER_ANALYZER_CUID_SIZE);
 
     instance->nfc_data = reader_analyzer_nfc_data[ReaderAnalyzerNfcDataMfClassic];
-    instance->alive = false;
-    instance->stream =
-        furi_stream_buffer_alloc(READER_ANALYZER_MAX_BUFF_SIZE, sizeof(ReaderAnalyzerHeader));
-
-    instance->thread =
-        furi_thread_alloc_ex("ReaderAnalyzerWorker", 2048, reader_analyzer_thread, instance);
-    furi_thread_set_priority(instance->thread, FuriThreadPriorityLow);
+    instance->trace = nfc_trace_alloc(READER_ANALYZER_TRACE_RING_SIZE);
+    nfc_trace_set_callback(instance->trace, reader_analyzer_trace_callback, instance);
 
     return instance;
 }
@@ -151,7 +110,6 @@ static void reader_analyzer_mfkey_callback(Mfkey32Event event, void* context) {
 void reader_analyzer_start(ReaderAnalyzer* instance, ReaderAnalyzerMode mode) {
     furi_assert(instance);
 
-    furi_stream_buffer_reset(instance->stream);
     if(mode & ReaderAnalyzerModeDebugLog) {
         instance->debug_log = nfc_debug_log_alloc();
     }
@@ -165,15 +123,14 @@ void reader_analyzer_start(ReaderAnalyzer* instance, ReaderAnalyzerMode mode) {
         instance->pcap = nfc_debug_pcap_alloc();
     }
 
-    instance->alive = true;
-    furi_thread_start(instance->thread);
+    nfc_trace_start(instance->trace);
 }
 
 void reader_analyzer_stop(ReaderAnalyzer* instance) {
     furi_assert(instance);
 
-    instance->alive = false;
-    furi_thread_join(instance->thread);
+    // Deliver queued frames before sinks are released
+    nfc_trace_stop(instance->trace);
 
     if(instance->debug_log) {
         nfc_debug_log_free(instance->debug_log);
@@ -193,8 +150,7 @@ void reader_analyzer_free(ReaderAnalyzer* instance) {
     furi_assert(instance);
 
     reader_analyzer_stop(instance);
-    furi_thread_free(instance->thread);
-    furi_stream_buffer_free(instance->stream);
+    nfc_trace_free(instance->trace);
     free(instance);
 }
 
@@ -236,32 +192,12 @@ void reader_analyzer_set_nfc_data(ReaderAnalyzer* instance, FuriHalNfcDevData* n
     memcpy(&instance->nfc_data, nfc_data, sizeof(FuriHalNfcDevData));
 }
 
-static void reader_analyzer_write(
-    ReaderAnalyzer* instance,
-    uint8_t* data,
-    uint16_t len,
-    bool reader_to_tag,
-    bool crc_dropped) {
-    ReaderAnalyzerHeader header = {
-        .reader_to_tag = reader_to_tag, .crc_dropped = crc_dropped, .len = len};
-    size_t data_sent = 0;
-    data_sent = furi_stream_buffer_send(
-        instance->stream, &header, sizeof(ReaderAnalyzerHeader), FuriWaitForever);
-    if(data_sent != sizeof(ReaderAnalyzerHeader)) {
-        FURI_LOG_W(TAG, "Sent %zu out of %zu bytes", data_sent, sizeof(ReaderAnalyzerHeader));
-    }
-    data_sent = furi_stream_buffer_send(instance->stream, data, len, FuriWaitForever);
-    if(data_sent != len) {
-        FURI_LOG_W(TAG, "Sent %zu out of %u bytes", data_sent, len);
-    }
-}
-
 static void
     reader_analyzer_write_rx(uint8_t* data, uint16_t bits, bool crc_dropped, void* context) {
     UNUSED(crc_dropped);
     ReaderAnalyzer* reader_analyzer = context;
     uint16_t bytes = bits < 8 ? 1 : bits / 8;
-    reader_analyzer_write(reader_analyzer, data, bytes, false, crc_dropped);
+    nfc_trace_push(reader_analyzer->trace, data, bytes, false, crc_dropped);
 }
 
 static void
@@ -269,7 +205,7 @@ static void
     UNUSED(crc_dropped);
     ReaderAnalyzer* reader_analyzer = context;
     uint16_t bytes = bits < 8 ? 1 : bits / 8;
-    reader_analyzer_write(reader_analyzer, data, bytes, true, crc_dropped);
+    nfc_trace_push(reader_analyzer->trace, data, bytes, true, crc_dropped);
 }
 
 void reader_analyzer_prepare_tx_rx(
@@ -1,50 +1,104 @@
 #include "protocol_items.h"
 
 const SubGhzProtocol* subghz_protocol_registry_items[] = {
-    &subghz_protocol_gate_tx,
-    &subghz_protocol_keeloq,
-    &subghz_protocol_star_line,
-    &subghz_protocol_nice_flo,
-    &subghz_protocol_came,
-    &subghz_protocol_faac_slh,
-    &subghz_protocol_nice_flor_s,
-    &subghz_protocol_came_twee,
-    &subghz_protocol_came_atomo,
-    &subghz_protocol_nero_sketch,
-    &subghz_protocol_ido,
-    &subghz_protocol_kia,
-    &subghz_protocol_hormann,
-    &subghz_protocol_nero_radio,
-    &subghz_protocol_somfy_telis,
-    &subghz_protocol_somfy_keytis,
-    &subghz_protocol_scher_khan,
-    &subghz_protocol_princeton,
-    &subghz_protocol_raw,
-    &subghz_protocol_linear,
-    &subghz_protocol_secplus_v2,
-    &subghz_protocol_secplus_v1,
-    &subghz_protocol_megacode,
-    &subghz_protocol_holtek,
-    &subghz_protocol_chamb_code,
-    &subghz_protocol_power_smart,
-    &subghz_protocol_marantec,
-    &subghz_protocol_bett,
-    &subghz_protocol_doitrand,
-    &subghz_protocol_phoenix_v2,
-    &subghz_protocol_honeywell_wdb,
-    &subghz_protocol_magellan,
-    &subghz_protocol_intertechno_v3,
-    &subghz_protocol_clemsa,
-    &subghz_protocol_ansonic,
-    &subghz_protocol_smc5326,
-    &subghz_protocol_holtek_th12x,
-    &subghz_protocol_linear_delta3,
-    &subghz_protocol_dooya,
-    &subghz_protocol_alutech_at_4n,
-    &subghz_protocol_kinggates_stylo_4k,
-    &subghz_protocol_bin_raw,
+    [SubGhzProtocolIdGateTx] = &subghz_protocol_gate_tx,
+    [SubGhzProtocolIdKeeloq] = &subghz_protocol_keeloq,
+    [SubGhzProtocolIdStarLine] = &subghz_protocol_star_line,
+    [SubGhzProtocolIdNiceFlo] = &subghz_protocol_nice_flo,
+    [SubGhzProtocolIdCame] = &subghz_protocol_came,
+    [SubGhzProtocolIdFaacSlh] = &subghz_protocol_faac_slh,
+    [SubGhzProtocolIdNiceFlorS] = &subghz_protocol_nice_flor_s,
+    [SubGhzProtocolIdCameTwee] = &subghz_protocol_came_twee,
+    [SubGhzProtocolIdCameAtomo] = &subghz_protocol_came_atomo,
+    [SubGhzProtocolIdNeroSketch] = &subghz_protocol_nero_sketch,
+    [SubGhzProtocolIdIdo] = &subghz_protocol_ido,
+    [SubGhzProtocolIdKia] = &subghz_protocol_kia,
+    [SubGhzProtocolIdHormann] = &subghz_protocol_hormann,
+    [SubGhzProtocolIdNeroRadio] = &subghz_protocol_nero_radio,
+    [SubGhzProtocolIdSomfyTelis] = &subghz_protocol_somfy_telis,
+    [SubGhzProtocolIdSomfyKeytis] = &subghz_protocol_somfy_keytis,
+    [SubGhzProtocolIdScherKhan] = &subghz_protocol_scher_khan,
+    [SubGhzProtocolIdPrinceton] = &subghz_protocol_princeton,
+    [SubGhzProtocolIdRaw] = &subghz_protocol_raw,
+    [SubGhzProtocolIdLinear] = &subghz_protocol_linear,
+    [SubGhzProtocolIdSecplusV2] = &subghz_protocol_secplus_v2,
+    [SubGhzProtocolIdSecplusV1] = &subghz_protocol_secplus_v1,
+    [SubGhzProtocolIdMegacode] = &subghz_protocol_megacode,
+    [SubGhzProtocolIdHoltek] = &subghz_protocol_holtek,
+    [SubGhzProtocolIdChambCode] = &subghz_protocol_chamb_code,
+    [SubGhzProtocolIdPowerSmart] = &subghz_protocol_power_smart,
+    [SubGhzProtocolIdMarantec] = &subghz_protocol_marantec,
+    [SubGhzProtocolIdBett] = &subghz_protocol_bett,
+    [SubGhzProtocolIdDoitrand] = &subghz_protocol_doitrand,
+    [SubGhzProtocolIdPhoenixV2] = &subghz_protocol_phoenix_v2,
+    [SubGhzProtocolIdHoneywellWdb] = &subghz_protocol_honeywell_wdb,
+    [SubGhzProtocolIdMagellan] = &subghz_protocol_magellan,
+    [SubGhzProtocolIdIntertechnoV3] = &subghz_protocol_intertechno_v3,
+    [SubGhzProtocolIdClemsa] = &subghz_protocol_clemsa,
+    [SubGhzProtocolIdAnsonic] = &subghz_protocol_ansonic,
+    [SubGhzProtocolIdSmc5326] = &subghz_protocol_smc5326,
+    [SubGhzProtocolIdHoltekHt12x] = &subghz_protocol_holtek_th12x,
+    [SubGhzProtocolIdLinearDelta3] = &subghz_protocol_linear_delta3,
+    [SubGhzProtocolIdDooya] = &subghz_protocol_dooya,
+    [SubGhzProtocolIdAlutechAt4n] = &subghz_protocol_alutech_at_4n,
+    [SubGhzProtocolIdKinggatesStylo4k] = &subghz_protocol_kinggates_stylo_4k,
+    [SubGhzProtocolIdBinRaw] = &subghz_protocol_bin_raw,
 };
 
+// Registry indices ordered by protocol name (strcmp), keep in sync with the items above
+static const uint16_t subghz_protocol_registry_name_index[] = {
+    SubGhzProtocolIdAlutechAt4n,
+    SubGhzProtocolIdAnsonic,
+    SubGhzProtocolIdBett,
+    SubGhzProtocolIdBinRaw,
+    SubGhzProtocolIdCame,
+    SubGhzProtocolIdCameAtomo,
+    SubGhzProtocolIdCameTwee,
+    SubGhzProtocolIdChambCode,
+    SubGhzProtocolIdClemsa,
+    SubGhzProtocolIdDoitrand,
+    SubGhzProtocolIdDooya,
+    SubGhzProtocolIdFaacSlh,
+    SubGhzProtocolIdGateTx,
+    SubGhzProtocolIdHoltek,
+    SubGhzProtocolIdHoltekHt12x,
+    SubGhzProtocolIdHoneywellWdb,
+    SubGhzProtocolIdHormann,
+    SubGhzProtocolIdIntertechnoV3,
+    SubGhzProtocolIdKia,
+    SubGhzProtocolIdKeeloq,
+    SubGhzProtocolIdKinggatesStylo4k,
+    SubGhzProtocolIdLinear,
+    SubGhzProtocolIdLinearDelta3,
+    SubGhzProtocolIdMagellan,
+    SubGhzProtocolIdMarantec,
+    SubGhzProtocolIdMegacode,
+    SubGhzProtocolIdNeroRadio,
+    SubGhzProtocolIdNeroSketch,
+    SubGhzProtocolIdNiceFlo,
+    SubGhzProtocolIdNiceFlorS,
+    SubGhzProtocolIdPhoenixV2,
+    SubGhzProtocolIdPowerSmart,
+    SubGhzProtocolIdPrinceton,
+    SubGhzProtocolIdRaw,
+    SubGhzProtocolIdSmc5326,
+    SubGhzProtocolIdScherKhan,
+    SubGhzProtocolIdSecplusV1,
+    SubGhzProtocolIdSecplusV2,
+    SubGhzProtocolIdSomfyKeytis,
+    SubGhzProtocolIdSomfyTelis,
+    SubGhzProtocolIdStarLine,
+    SubGhzProtocolIdIdo,
+};
+
+_Static_assert(
+    COUNT_OF(subghz_protocol_registry_items) == SubGhzProtocolIdTotal,
+    "Protocol ids out of sync with registry items");
+_Static_assert(
+    COUNT_OF(subghz_protocol_registry_name_index) == SubGhzProtocolIdTotal,
+    "Protocol name index out of sync with registry items");
+
 const SubGhzProtocolRegistry subghz_protocol_registry = {
     .items = subghz_protocol_registry_items,
-    .size = COUNT_OF(subghz_protocol_registry_items)};
+    .size = COUNT_OF(subghz_protocol_registry_items),
+    .name_index = subghz_protocol_registry_name_index};
@@ -48,6 +48,56 @@
 extern "C" {
 #endif
 
+/** Stable protocol identifiers, index of the protocol in subghz_protocol_registry.
+ * Values are used in binary formats: only append new protocols, never renumber.
+ */
+typedef enum {
+    SubGhzProtocolIdGateTx = 0,
+    SubGhzProtocolIdKeeloq = 1,
+    SubGhzProtocolIdStarLine = 2,
+    SubGhzProtocolIdNiceFlo = 3,
+    SubGhzProtocolIdCame = 4,
+    SubGhzProtocolIdFaacSlh = 5,
+    SubGhzProtocolIdNiceFlorS = 6,
+    SubGhzProtocolIdCameTwee = 7,
+    SubGhzProtocolIdCameAtomo = 8,
+    SubGhzProtocolIdNeroSketch = 9,
+    SubGhzProtocolIdIdo = 10,
+    SubGhzProtocolIdKia = 11,
+    SubGhzProtocolIdHormann = 12,
+    SubGhzProtocolIdNeroRadio = 13,
+    SubGhzProtocolIdSomfyTelis = 14,
+    SubGhzProtocolIdSomfyKeytis = 15,
+    SubGhzProtocolIdScherKhan = 16,
+    SubGhzProtocolIdPrinceton = 17,
+    SubGhzProtocolIdRaw = 18,
+    SubGhzProtocolIdLinear = 19,
+    SubGhzProtocolIdSecplusV2 = 20,
+    SubGhzProtocolIdSecplusV1 = 21,
+    SubGhzProtocolIdMegacode = 22,
+    SubGhzProtocolIdHoltek = 23,
+    SubGhzProtocolIdChambCode = 24,
+    SubGhzProtocolIdPowerSmart = 25,
+    SubGhzProtocolIdMarantec = 26,
+    SubGhzProtocolIdBett = 27,
+    SubGhzProtocolIdDoitrand = 28,
+    SubGhzProtocolIdPhoenixV2 = 29,
+    SubGhzProtocolIdHoneywellWdb = 30,
+    SubGhzProtocolIdMagellan = 31,
+    SubGhzProtocolIdIntertechnoV3 = 32,
+    SubGhzProtocolIdClemsa = 33,
+    SubGhzProtocolIdAnsonic = 34,
+    SubGhzProtocolIdSmc5326 = 35,
+    SubGhzProtocolIdHoltekHt12x = 36,
+    SubGhzProtocolIdLinearDelta3 = 37,
+    SubGhzProtocolIdDooya = 38,
+    SubGhzProtocolIdAlutechAt4n = 39,
+    SubGhzProtocolIdKinggatesStylo4k = 40,
+    SubGhzProtocolIdBinRaw = 41,
+
+    SubGhzProtocolIdTotal,
+} SubGhzProtocolId;
+
 extern const SubGhzProtocolRegistry subghz_protocol_registry;
 
 #ifdef __cplusplus
@@ -60,6 +60,8 @@ const SubGhzProtocolDecoder subghz_protocol_raw_decoder = {
     .serialize = NULL,
     .deserialize = subghz_protocol_decoder_raw_deserialize,
     .get_string = subghz_protocol_decoder_raw_get_string,
+
+    .feed_batch = subghz_protocol_decoder_raw_feed_batch,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_raw_encoder = {
@@ -241,21 +243,46 @@ void subghz_protocol_decoder_raw_reset(void* context) {
     instance->last_level = false;
 }
 
+static inline void subghz_protocol_decoder_raw_feed_sample(
+    SubGhzProtocolDecoderRAW* instance,
+    bool level,
+    uint32_t duration) {
+    // Add check if we got duration higher than 1 second, we skipping it, temp fix
+    if(duration >= ((uint32_t)1000000)) return;
+
+    if(duration > subghz_protocol_raw_const.te_short) {
+        if(instance->last_level != level) {
+            instance->last_level = (level ? true : false);
+            instance->upload_raw[instance->ind_write++] = (level ? duration : -duration);
+        }
+    }
+
+    if(instance->ind_write == SUBGHZ_DOWNLOAD_MAX_SIZE) {
+        subghz_protocol_raw_save_to_file_write(instance);
+    }
+}
+
 void subghz_protocol_decoder_raw_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderRAW* instance = context;
-    // Add check if we got duration higher than 1 second, we skipping it, temp fix
-    if((!instance->pause && (instance->upload_raw != NULL)) && (duration < ((uint32_t)1000000))) {
-        if(duration > subghz_protocol_raw_const.te_short) {
-            if(instance->last_level != level) {
-                instance->last_level = (level ? true : false);
-                instance->upload_raw[instance->ind_write++] = (level ? duration : -duration);
-            }
-        }
+    if(instance->pause || (instance->upload_raw == NULL)) return;
 
-        if(instance->ind_write == SUBGHZ_DOWNLOAD_MAX_SIZE) {
-            subghz_protocol_raw_save_to_file_write(instance);
-        }
+    subghz_protocol_decoder_raw_feed_sample(instance, level, duration);
+}
+
+void subghz_protocol_decoder_raw_feed_batch(
+    void* context,
+    const LevelDuration* level_duration,
+    size_t count) {
+    furi_assert(context);
+    SubGhzProtocolDecoderRAW* instance = context;
+    if(instance->pause || (instance->upload_raw == NULL)) return;
+
+    for(size_t i = 0; i < count; i++) {
+        subghz_protocol_decoder_raw_feed_sample(
+            instance,
+            level_duration_get_level(level_duration[i]),
+            level_duration_get_duration(level_duration[i]));
     }
 }
 
@@ -69,6 +69,17 @@ void subghz_protocol_decoder_raw_reset(void* context);
  */
 void subghz_protocol_decoder_raw_feed(void* context, bool level, uint32_t duration);
 
+/**
+ * Parse a batch of levels and durations received from the air.
+ * @param context Pointer to a SubGhzProtocolDecoderRAW instance
+ * @param level_duration Array of LevelDuration pairs
+ * @param count Number of pairs in array
+ */
+void subghz_protocol_decoder_raw_feed_batch(
+    void* context,
+    const LevelDuration* level_duration,
+    size_t count);
+
 /**
  * Deserialize data SubGhzProtocolDecoderRAW.
  * @param context Pointer to a SubGhzProtocolDecoderRAW instance
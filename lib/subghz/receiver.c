@@ -5,34 +5,47 @@
 
 #include <m-array.h>
 
+#define TAG "SubGhzReceiver"
+
 typedef struct {
     SubGhzProtocolEncoderBase* base;
+    size_t index; // Protocol index in registry
 } SubGhzReceiverSlot;
 
 ARRAY_DEF(SubGhzReceiverSlotArray, SubGhzReceiverSlot, M_POD_OPLIST);
 #define M_OPL_SubGhzReceiverSlotArray_t() ARRAY_OPLIST(SubGhzReceiverSlotArray, M_POD_OPLIST)
 
 struct SubGhzReceiver {
+    // Slots are kept in registry order
     SubGhzReceiverSlotArray_t slots;
+    const SubGhzProtocolRegistry* protocol_registry;
     SubGhzProtocolFlag filter;
 
     SubGhzReceiverCallback callback;
     void* context;
 };
 
-SubGhzReceiver* subghz_receiver_alloc_init(SubGhzEnvironment* environment) {
+static SubGhzReceiver* subghz_receiver_alloc_slots(
+    SubGhzEnvironment* environment,
+    const uint8_t* enabled_bitmap) {
     SubGhzReceiver* instance = malloc(sizeof(SubGhzReceiver));
     SubGhzReceiverSlotArray_init(instance->slots);
     const SubGhzProtocolRegistry* protocol_registry_items =
         subghz_environment_get_protocol_registry(environment);
+    instance->protocol_registry = protocol_registry_items;
 
     for(size_t i = 0; i < subghz_protocol_registry_count(protocol_registry_items); ++i) {
+        if(enabled_bitmap && !(enabled_bitmap[i / 8] & (1 << (i % 8)))) {
+            continue;
+        }
+
         const SubGhzProtocol* protocol =
             subghz_protocol_registry_get_by_index(protocol_registry_items, i);
 
         if(protocol->decoder && protocol->decoder->alloc) {
             SubGhzReceiverSlot* slot = SubGhzReceiverSlotArray_push_new(instance->slots);
             slot->base = protocol->decoder->alloc(environment);
+            slot->index = i;
         }
     }
 
@@ -41,6 +54,37 @@ SubGhzReceiver* subghz_receiver_alloc_init(SubGhzEnvironment* environment) {
     return instance;
 }
 
+SubGhzReceiver* subghz_receiver_alloc_init(SubGhzEnvironment* environment) {
+    return subghz_receiver_alloc_slots(environment, NULL);
+}
+
+SubGhzReceiver* subghz_receiver_alloc_init_subset(
+    SubGhzEnvironment* environment,
+    const char* const* protocol_names,
+    size_t protocol_names_count) {
+    furi_assert(protocol_names);
+
+    const SubGhzProtocolRegistry* protocol_registry_items =
+        subghz_environment_get_protocol_registry(environment);
+    size_t count = subghz_protocol_registry_count(protocol_registry_items);
+    uint8_t* enabled_bitmap = malloc((count + 7) / 8);
+    memset(enabled_bitmap, 0, (count + 7) / 8);
+
+    for(size_t i = 0; i < protocol_names_count; i++) {
+        size_t index = subghz_protocol_registry_get_index_by_name(
+            protocol_registry_items, protocol_names[i]);
+        if(index == SUBGHZ_PROTOCOL_REGISTRY_INDEX_INVALID) {
+            FURI_LOG_W(TAG, "Unknown protocol %s", protocol_names[i]);
+            continue;
+        }
+        enabled_bitmap[index / 8] |= 1 << (index % 8);
+    }
+
+    SubGhzReceiver* instance = subghz_receiver_alloc_slots(environment, enabled_bitmap);
+    free(enabled_bitmap);
+    return instance;
+}
+
 void subghz_receiver_free(SubGhzReceiver* instance) {
     furi_assert(instance);
 
@@ -70,6 +114,31 @@ void subghz_receiver_decode(SubGhzReceiver* instance, bool level, uint32_t durat
         }
 }
 
+void subghz_receiver_decode_batch(
+    SubGhzReceiver* instance,
+    const LevelDuration* level_duration,
+    size_t count) {
+    furi_assert(instance);
+    furi_assert(level_duration);
+
+    for
+        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
+            if((slot->base->protocol->flag & instance->filter) == 0) continue;
+
+            const SubGhzProtocolDecoder* decoder = slot->base->protocol->decoder;
+            if(decoder->feed_batch) {
+                decoder->feed_batch(slot->base, level_duration, count);
+            } else {
+                for(size_t i = 0; i < count; i++) {
+                    decoder->feed(
+                        slot->base,
+                        level_duration_get_level(level_duration[i]),
+                        level_duration_get_duration(level_duration[i]));
+                }
+            }
+        }
+}
+
 void subghz_receiver_reset(SubGhzReceiver* instance) {
     furi_assert(instance);
     furi_assert(instance->slots);
@@ -111,14 +180,27 @@ void subghz_receiver_set_filter(SubGhzReceiver* instance, SubGhzProtocolFlag fil
 SubGhzProtocolDecoderBase* subghz_receiver_search_decoder_base_by_name(
     SubGhzReceiver* instance,
     const char* decoder_name) {
-    SubGhzProtocolDecoderBase* result = NULL;
+    furi_assert(instance);
 
-    for
-        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
-            if(strcmp(slot->base->protocol->name, decoder_name) == 0) {
-                result = (SubGhzProtocolDecoderBase*)slot->base;
-                break;
-            }
+    size_t index =
+        subghz_protocol_registry_get_index_by_name(instance->protocol_registry, decoder_name);
+    if(index == SUBGHZ_PROTOCOL_REGISTRY_INDEX_INVALID) {
+        return NULL;
+    }
+
+    // Slots are sorted by registry index
+    size_t low = 0;
+    size_t high = SubGhzReceiverSlotArray_size(instance->slots);
+    while(low < high) {
+        size_t mid = low + (high - low) / 2;
+        SubGhzReceiverSlot* slot = SubGhzReceiverSlotArray_get(instance->slots, mid);
+        if(slot->index == index) {
+            return (SubGhzProtocolDecoderBase*)slot->base;
+        } else if(slot->index < index) {
+            low = mid + 1;
+        } else {
+            high = mid;
         }
-    return result;
+    }
+    return NULL;
 }
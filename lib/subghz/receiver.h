@@ -21,6 +21,19 @@ typedef void (*SubGhzReceiverCallback)(
  */
 SubGhzReceiver* subghz_receiver_alloc_init(SubGhzEnvironment* environment);
 
+/**
+ * Allocate and init SubGhzReceiver with decoders only for chosen protocols.
+ * Decoders of other protocols are not allocated, which saves RAM.
+ * @param environment Pointer to a SubGhzEnvironment instance
+ * @param protocol_names Array of protocol names, unknown names are skipped
+ * @param protocol_names_count Number of names in array
+ * @return SubGhzReceiver* pointer to a SubGhzReceiver instance
+ */
+SubGhzReceiver* subghz_receiver_alloc_init_subset(
+    SubGhzEnvironment* environment,
+    const char* const* protocol_names,
+    size_t protocol_names_count);
+
 /**
  * Free SubGhzReceiver.
  * @param instance Pointer to a SubGhzReceiver instance
@@ -35,6 +48,18 @@ void subghz_receiver_free(SubGhzReceiver* instance);
  */
 void subghz_receiver_decode(SubGhzReceiver* instance, bool level, uint32_t duration);
 
+/**
+ * Parse a batch of levels and durations received from the air.
+ * Each decoder consumes the whole batch before the next one runs.
+ * @param instance Pointer to a SubGhzReceiver instance
+ * @param level_duration Array of LevelDuration pairs
+ * @param count Number of pairs in array
+ */
+void subghz_receiver_decode_batch(
+    SubGhzReceiver* instance,
+    const LevelDuration* level_duration,
+    size_t count);
+
 /**
  * Reset decoder SubGhzReceiver.
  * @param instance Pointer to a SubGhzReceiver instance
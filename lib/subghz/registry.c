@@ -1,16 +1,43 @@
 #include "registry.h"
 
-const SubGhzProtocol* subghz_protocol_registry_get_by_name(
+size_t subghz_protocol_registry_get_index_by_name(
     const SubGhzProtocolRegistry* protocol_registry,
     const char* name) {
     furi_assert(protocol_registry);
+    furi_assert(name);
 
-    for(size_t i = 0; i < subghz_protocol_registry_count(protocol_registry); i++) {
-        if(strcmp(name, protocol_registry->items[i]->name) == 0) {
-            return protocol_registry->items[i];
+    if(protocol_registry->name_index) {
+        size_t low = 0;
+        size_t high = subghz_protocol_registry_count(protocol_registry);
+        while(low < high) {
+            size_t mid = low + (high - low) / 2;
+            size_t index = protocol_registry->name_index[mid];
+            int cmp = strcmp(name, protocol_registry->items[index]->name);
+            if(cmp == 0) {
+                return index;
+            } else if(cmp < 0) {
+                high = mid;
+            } else {
+                low = mid + 1;
+            }
+        }
+    } else {
+        for(size_t i = 0; i < subghz_protocol_registry_count(protocol_registry); i++) {
+            if(strcmp(name, protocol_registry->items[i]->name) == 0) {
+                return i;
+            }
         }
     }
-    return NULL;
+    return SUBGHZ_PROTOCOL_REGISTRY_INDEX_INVALID;
+}
+
+const SubGhzProtocol* subghz_protocol_registry_get_by_name(
+    const SubGhzProtocolRegistry* protocol_registry,
+    const char* name) {
+    furi_assert(protocol_registry);
+
+    return subghz_protocol_registry_get_by_index(
+        protocol_registry, subghz_protocol_registry_get_index_by_name(protocol_registry, name));
 }
 
 const SubGhzProtocol* subghz_protocol_registry_get_by_index(
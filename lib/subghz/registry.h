@@ -10,9 +10,13 @@ typedef struct SubGhzEnvironment SubGhzEnvironment;
 
 typedef struct SubGhzProtocolRegistry SubGhzProtocolRegistry;
 
+#define SUBGHZ_PROTOCOL_REGISTRY_INDEX_INVALID ((size_t)-1)
+
 struct SubGhzProtocolRegistry {
     const SubGhzProtocol** items;
     const size_t size;
+    /** Optional: item indices ordered by name (strcmp), enables binary search by name */
+    const uint16_t* name_index;
 };
 
 /**
@@ -25,6 +29,18 @@ const SubGhzProtocol* subghz_protocol_registry_get_by_name(
     const SubGhzProtocolRegistry* protocol_registry,
     const char* name);
 
+/**
+ * Get index of protocol in registry by name.
+ * Index is a stable protocol id for registries that define one (see SubGhzProtocolId).
+ * O(log n) if registry has a name index, linear search otherwise.
+ * @param protocol_registry SubGhzProtocolRegistry
+ * @param name Protocol name
+ * @return Protocol index or SUBGHZ_PROTOCOL_REGISTRY_INDEX_INVALID if not found
+ */
+size_t subghz_protocol_registry_get_index_by_name(
+    const SubGhzProtocolRegistry* protocol_registry,
+    const char* name);
+
 /**
  * Registration protocol by index in array SubGhzProtocol.
  * @param protocol_registry SubGhzProtocolRegistry
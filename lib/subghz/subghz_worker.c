@@ -4,6 +4,8 @@
 
 #define TAG "SubGhzWorker"
 
+#define SUBGHZ_WORKER_BATCH_SIZE 64
+
 struct SubGhzWorker {
     FuriThread* thread;
     FuriStreamBuffer* stream;
@@ -16,6 +18,7 @@ struct SubGhzWorker {
 
     SubGhzWorkerOverrunCallback overrun_callback;
     SubGhzWorkerPairCallback pair_callback;
+    SubGhzWorkerPairBatchCallback pair_batch_callback;
     void* context;
 };
 
@@ -33,11 +36,81 @@ void subghz_worker_rx_callback(bool level, uint32_t duration, void* context) {
         instance->overrun = false;
         level_duration = level_duration_reset();
     }
-    size_t ret =
-        furi_stream_buffer_send(instance->stream, &level_duration, sizeof(LevelDuration), 0);
+    // Never write a partial pair, it would misalign the whole stream
+    size_t ret = 0;
+    if(furi_stream_buffer_spaces_available(instance->stream) >= sizeof(LevelDuration)) {
+        ret = furi_stream_buffer_send(instance->stream, &level_duration, sizeof(LevelDuration), 0);
+    }
     if(sizeof(LevelDuration) != ret) instance->overrun = true;
 }
 
+/** Hand filtered pairs to the consumer
+ * 
+ * @param instance Pointer to a SubGhzWorker instance
+ * @param level_duration array of filtered pairs
+ * @param count number of pairs
+ */
+static void subghz_worker_emit(
+    SubGhzWorker* instance,
+    const LevelDuration* level_duration,
+    size_t count) {
+    if(!count) return;
+
+    if(instance->pair_batch_callback) {
+        instance->pair_batch_callback(instance->context, level_duration, count);
+    } else if(instance->pair_callback) {
+        for(size_t i = 0; i < count; i++) {
+            instance->pair_callback(
+                instance->context,
+                level_duration_get_level(level_duration[i]),
+                level_duration_get_duration(level_duration[i]));
+        }
+    }
+}
+
+/** Apply glitch filter to a batch of raw pairs and pass the result on
+ * 
+ * Filtered pairs are compacted in place into the start of the buffer.
+ * 
+ * @param instance Pointer to a SubGhzWorker instance
+ * @param buffer array of raw pairs, overwritten
+ * @param count number of pairs
+ */
+static void
+    subghz_worker_process_batch(SubGhzWorker* instance, LevelDuration* buffer, size_t count) {
+    size_t filtered = 0;
+
+    for(size_t i = 0; i < count; i++) {
+        if(level_duration_is_reset(buffer[i])) {
+            // Deliver what came before the overrun first
+            subghz_worker_emit(instance, buffer, filtered);
+            filtered = 0;
+
+            FURI_LOG_E(TAG, "Overrun buffer");
+            if(instance->overrun_callback) instance->overrun_callback(instance->context);
+            continue;
+        }
+
+        bool level = level_duration_get_level(buffer[i]);
+        uint32_t duration = level_duration_get_duration(buffer[i]);
+
+        if((duration < instance->filter_duration) ||
+           (instance->filter_level_duration.level == level)) {
+            instance->filter_level_duration.duration += duration;
+
+        } else if(instance->filter_level_duration.level != level) {
+            // filtered <= i, so the raw pair at i has already been consumed
+            buffer[filtered++] = level_duration_make(
+                instance->filter_level_duration.level, instance->filter_level_duration.duration);
+
+            instance->filter_level_duration.duration = duration;
+            instance->filter_level_duration.level = level;
+        }
+    }
+
+    subghz_worker_emit(instance, buffer, filtered);
+}
+
 /** Worker callback thread
  * 
  * @param context 
@@ -46,33 +119,13 @@ void subghz_worker_rx_callback(bool level, uint32_t duration, void* context) {
 static int32_t subghz_worker_thread_callback(void* context) {
     SubGhzWorker* instance = context;
 
-    LevelDuration level_duration;
+    LevelDuration buffer[SUBGHZ_WORKER_BATCH_SIZE];
     while(instance->running) {
-        int ret = furi_stream_buffer_receive(
-            instance->stream, &level_duration, sizeof(LevelDuration), 10);
-        if(ret == sizeof(LevelDuration)) {
-            if(level_duration_is_reset(level_duration)) {
-                FURI_LOG_E(TAG, "Overrun buffer");
-                if(instance->overrun_callback) instance->overrun_callback(instance->context);
-            } else {
-                bool level = level_duration_get_level(level_duration);
-                uint32_t duration = level_duration_get_duration(level_duration);
-
-                if((duration < instance->filter_duration) ||
-                   (instance->filter_level_duration.level == level)) {
-                    instance->filter_level_duration.duration += duration;
-
-                } else if(instance->filter_level_duration.level != level) {
-                    if(instance->pair_callback)
-                        instance->pair_callback(
-                            instance->context,
-                            instance->filter_level_duration.level,
-                            instance->filter_level_duration.duration);
-
-                    instance->filter_level_duration.duration = duration;
-                    instance->filter_level_duration.level = level;
-                }
-            }
+        // Drain everything available, up to a batch, in one wakeup
+        size_t ret = furi_stream_buffer_receive(instance->stream, buffer, sizeof(buffer), 10);
+        size_t count = ret / sizeof(LevelDuration);
+        if(count) {
+            subghz_worker_process_batch(instance, buffer, count);
         }
     }
 
@@ -115,6 +168,13 @@ void subghz_worker_set_pair_callback(SubGhzWorker* instance, SubGhzWorkerPairCal
     instance->pair_callback = callback;
 }
 
+void subghz_worker_set_pair_batch_callback(
+    SubGhzWorker* instance,
+    SubGhzWorkerPairBatchCallback callback) {
+    furi_assert(instance);
+    instance->pair_batch_callback = callback;
+}
+
 void subghz_worker_set_context(SubGhzWorker* instance, void* context) {
     furi_assert(instance);
     instance->context = context;
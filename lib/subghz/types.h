@@ -62,6 +62,8 @@ typedef SubGhzProtocolStatus (*SubGhzDeserialize)(void* context, FlipperFormat*
 
 // Decoder specific
 typedef void (*SubGhzDecoderFeed)(void* decoder, bool level, uint32_t duration);
+typedef void (
+    *SubGhzDecoderFeedBatch)(void* decoder, const LevelDuration* level_duration, size_t count);
 typedef void (*SubGhzDecoderReset)(void* decoder);
 typedef uint8_t (*SubGhzGetHashData)(void* decoder);
 typedef void (*SubGhzGetString)(void* decoder, FuriString* output);
@@ -81,6 +83,9 @@ typedef struct {
     SubGhzGetString get_string;
     SubGhzSerialize serialize;
     SubGhzDeserialize deserialize;
+
+    // Optional, receiver falls back to calling feed for each pair
+    SubGhzDecoderFeedBatch feed_batch;
 } SubGhzProtocolDecoder;
 
 typedef struct {
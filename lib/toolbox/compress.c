@@ -188,6 +188,33 @@ bool compress_encode(
     return result;
 }
 
+/** Poll decoded data until decoder is empty, fails if it doesn't fit in data_out */
+static bool compress_decoder_poll(
+    Compress* compress,
+    uint8_t* data_out,
+    size_t data_out_size,
+    size_t* res_buff_size) {
+    HSD_poll_res poll_res;
+    size_t poll_size = 0;
+    do {
+        if(*res_buff_size == data_out_size) {
+            // Decoder reports more even if output is full, probe it for one more byte
+            uint8_t probe;
+            poll_res = heatshrink_decoder_poll(compress->decoder, &probe, 1, &poll_size);
+            return poll_res >= 0 && poll_size == 0;
+        }
+        poll_res = heatshrink_decoder_poll(
+            compress->decoder,
+            &data_out[*res_buff_size],
+            data_out_size - *res_buff_size,
+            &poll_size);
+        if(poll_res < 0) return false;
+        *res_buff_size += poll_size;
+    } while(poll_res == HSDR_POLL_MORE);
+
+    return true;
+}
+
 bool compress_decode(
     Compress* compress,
     uint8_t* data_in,
@@ -203,11 +230,9 @@ bool compress_decode(
     bool result = false;
     bool decode_failed = false;
     HSD_sink_res sink_res;
-    HSD_poll_res poll_res;
     HSD_finish_res finish_res;
     size_t sink_size = 0;
     size_t res_buff_size = 0;
-    size_t poll_size = 0;
 
     CompressHeader* header = (CompressHeader*)data_in;
     if(header->is_compressed) {
@@ -222,34 +247,29 @@ bool compress_decode(
                 break;
             }
             sunk += sink_size;
-            do {
-                poll_res = heatshrink_decoder_poll(
-                    compress->decoder, &data_out[res_buff_size], data_out_size, &poll_size);
-                if(poll_res < 0) {
-                    decode_failed = true;
-                    break;
-                }
-                res_buff_size += poll_size;
-            } while(poll_res == HSDR_POLL_MORE);
+            if(!compress_decoder_poll(compress, data_out, data_out_size, &res_buff_size)) {
+                decode_failed = true;
+            }
         }
         // Notify sinking complete and poll decoded data
         if(!decode_failed) {
             finish_res = heatshrink_decoder_finish(compress->decoder);
-            if(finish_res < 0) {
-                decode_failed = true;
-            } else {
-                do {
-                    poll_res = heatshrink_decoder_poll(
-                        compress->decoder, &data_out[res_buff_size], data_out_size, &poll_size);
-                    res_buff_size += poll_size;
-                    finish_res = heatshrink_decoder_finish(compress->decoder);
-                } while(finish_res != HSDR_FINISH_DONE);
+            while(finish_res == HSDR_FINISH_MORE) {
+                size_t polled_size = res_buff_size;
+                // Decoder that can't produce more data will never finish, input is broken
+                if(!compress_decoder_poll(compress, data_out, data_out_size, &res_buff_size) ||
+                   polled_size == res_buff_size) {
+                    decode_failed = true;
+                    break;
+                }
+                finish_res = heatshrink_decoder_finish(compress->decoder);
             }
+            if(finish_res < 0) decode_failed = true;
         }
         *data_res_size = res_buff_size;
         result = !decode_failed;
     } else if(data_out_size >= data_in_size - 1) {
-        memcpy(data_out, &data_in[1], data_in_size);
+        memcpy(data_out, &data_in[1], data_in_size - 1);
         *data_res_size = data_in_size - 1;
         result = true;
     } else {
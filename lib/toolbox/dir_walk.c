@@ -1,6 +1,9 @@
 #include "dir_walk.h"
 #include <m-list.h>
 
+#define DIR_WALK_BATCH_ENTRIES 16
+#define DIR_WALK_BATCH_NAMES_SIZE (STORAGE_DIR_BATCH_NAME_MAX * 4)
+
 LIST_DEF(DirIndexList, uint32_t);
 
 struct DirWalk {
@@ -11,6 +14,12 @@ struct DirWalk {
     bool recursive;
     DirWalkFilterCb filter_cb;
     void* filter_context;
+    // Entries of current dir read ahead with one storage request
+    StorageDirEntry* entries;
+    char* names;
+    size_t entries_count;
+    size_t entries_position;
+    FS_Error entries_error;
 };
 
 DirWalk* dir_walk_alloc(Storage* storage) {
@@ -20,6 +29,11 @@ DirWalk* dir_walk_alloc(Storage* storage) {
     DirIndexList_init(dir_walk->index_list);
     dir_walk->recursive = true;
     dir_walk->filter_cb = NULL;
+    dir_walk->entries = malloc(sizeof(StorageDirEntry) * DIR_WALK_BATCH_ENTRIES);
+    dir_walk->names = malloc(DIR_WALK_BATCH_NAMES_SIZE);
+    dir_walk->entries_count = 0;
+    dir_walk->entries_position = 0;
+    dir_walk->entries_error = FSE_OK;
     return dir_walk;
 }
 
@@ -27,9 +41,39 @@ void dir_walk_free(DirWalk* dir_walk) {
     storage_file_free(dir_walk->file);
     furi_string_free(dir_walk->path);
     DirIndexList_clear(dir_walk->index_list);
+    free(dir_walk->entries);
+    free(dir_walk->names);
     free(dir_walk);
 }
 
+static bool dir_walk_dir_open(DirWalk* dir_walk) {
+    dir_walk->entries_count = 0;
+    dir_walk->entries_position = 0;
+    dir_walk->entries_error = FSE_OK;
+    return storage_dir_open(dir_walk->file, furi_string_get_cstr(dir_walk->path));
+}
+
+/** Next entry of current dir, valid until next call */
+static FS_Error dir_walk_dir_read(DirWalk* dir_walk, StorageDirEntry** entry) {
+    while(dir_walk->entries_position == dir_walk->entries_count) {
+        if(dir_walk->entries_error != FSE_OK) {
+            return dir_walk->entries_error;
+        }
+
+        dir_walk->entries_count = storage_dir_read_batch(
+            dir_walk->file,
+            dir_walk->entries,
+            DIR_WALK_BATCH_ENTRIES,
+            dir_walk->names,
+            DIR_WALK_BATCH_NAMES_SIZE);
+        dir_walk->entries_position = 0;
+        dir_walk->entries_error = storage_file_get_error(dir_walk->file);
+    }
+
+    *entry = &dir_walk->entries[dir_walk->entries_position++];
+    return FSE_OK;
+}
+
 void dir_walk_set_recursive(DirWalk* dir_walk, bool recursive) {
     dir_walk->recursive = recursive;
 }
@@ -42,7 +86,7 @@ void dir_walk_set_filter_cb(DirWalk* dir_walk, DirWalkFilterCb cb, void* context
 bool dir_walk_open(DirWalk* dir_walk, const char* path) {
     furi_string_set(dir_walk->path, path);
     dir_walk->current_index = 0;
-    return storage_dir_open(dir_walk->file, path);
+    return dir_walk_dir_open(dir_walk);
 }
 
 static bool dir_walk_filter(DirWalk* dir_walk, const char* name, FileInfo* fileinfo) {
@@ -56,43 +100,42 @@ static bool dir_walk_filter(DirWalk* dir_walk, const char* name, FileInfo* filei
 static DirWalkResult
     dir_walk_iter(DirWalk* dir_walk, FuriString* return_path, FileInfo* fileinfo) {
     DirWalkResult result = DirWalkError;
-    char* name = malloc(256); // FIXME: remove magic number
-    FileInfo info;
+    StorageDirEntry* entry;
     bool end = false;
 
     while(!end) {
-        storage_dir_read(dir_walk->file, &info, name, 255);
+        FS_Error error = dir_walk_dir_read(dir_walk, &entry);
 
-        if(storage_file_get_error(dir_walk->file) == FSE_OK) {
+        if(error == FSE_OK) {
             result = DirWalkOK;
             dir_walk->current_index++;
 
-            if(dir_walk_filter(dir_walk, name, &info)) {
+            if(dir_walk_filter(dir_walk, entry->name, &entry->fileinfo)) {
                 if(return_path != NULL) {
                     furi_string_printf( //-V576
                         return_path,
                         "%s/%s",
                         furi_string_get_cstr(dir_walk->path),
-                        name);
+                        entry->name);
                 }
 
                 if(fileinfo != NULL) {
-                    memcpy(fileinfo, &info, sizeof(FileInfo));
+                    memcpy(fileinfo, &entry->fileinfo, sizeof(FileInfo));
                 }
 
                 end = true;
             }
 
-            if(file_info_is_dir(&info) && dir_walk->recursive) {
+            if(file_info_is_dir(&entry->fileinfo) && dir_walk->recursive) {
                 // step into
                 DirIndexList_push_back(dir_walk->index_list, dir_walk->current_index);
                 dir_walk->current_index = 0;
                 storage_dir_close(dir_walk->file);
 
-                furi_string_cat_printf(dir_walk->path, "/%s", name);
-                storage_dir_open(dir_walk->file, furi_string_get_cstr(dir_walk->path));
+                furi_string_cat_printf(dir_walk->path, "/%s", entry->name);
+                dir_walk_dir_open(dir_walk);
             }
-        } else if(storage_file_get_error(dir_walk->file) == FSE_NOT_EXIST) {
+        } else if(error == FSE_NOT_EXIST) {
             if(DirIndexList_size(dir_walk->index_list) == 0) {
                 // last
                 result = DirWalkLast;
@@ -110,7 +153,7 @@ static DirWalkResult
                     furi_string_left(dir_walk->path, last_char);
                 }
 
-                storage_dir_open(dir_walk->file, furi_string_get_cstr(dir_walk->path));
+                dir_walk_dir_open(dir_walk);
 
                 // rewind
                 while(true) {
@@ -119,7 +162,7 @@ static DirWalkResult
                         break;
                     }
 
-                    if(!storage_dir_read(dir_walk->file, &info, name, 255)) {
+                    if(dir_walk_dir_read(dir_walk, &entry) != FSE_OK) {
                         result = DirWalkError;
                         end = true;
                         break;
@@ -134,7 +177,6 @@ static DirWalkResult
         }
     }
 
-    free(name);
     return result;
 }
 
@@ -154,4 +196,6 @@ void dir_walk_close(DirWalk* dir_walk) {
     DirIndexList_reset(dir_walk->index_list);
     furi_string_reset(dir_walk->path);
     dir_walk->current_index = 0;
+    dir_walk->entries_count = 0;
+    dir_walk->entries_position = 0;
 }
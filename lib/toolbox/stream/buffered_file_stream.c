@@ -9,6 +9,7 @@ typedef struct {
     Stream* file_stream;
     StreamCache* cache;
     bool sync_pending;
+    bool transaction;
 } BufferedFileStream;
 
 static void buffered_file_stream_free(BufferedFileStream* stream);
@@ -26,6 +27,9 @@ static bool buffered_file_stream_delete_and_insert(
     size_t delete_size,
     StreamWriteCB write_callback,
     const void* ctx);
+static bool buffered_file_stream_transaction_begin(BufferedFileStream* stream);
+static bool buffered_file_stream_transaction_commit(BufferedFileStream* stream);
+static void buffered_file_stream_transaction_abort(BufferedFileStream* stream);
 
 static bool buffered_file_stream_flush(BufferedFileStream* stream);
 static bool buffered_file_stream_unread(BufferedFileStream* stream);
@@ -40,6 +44,9 @@ const StreamVTable buffered_file_stream_vtable = {
     .write = (StreamWriteFn)buffered_file_stream_write,
     .read = (StreamReadFn)buffered_file_stream_read,
     .delete_and_insert = (StreamDeleteAndInsertFn)buffered_file_stream_delete_and_insert,
+    .transaction_begin = (StreamTransactionBeginFn)buffered_file_stream_transaction_begin,
+    .transaction_commit = (StreamTransactionCommitFn)buffered_file_stream_transaction_commit,
+    .transaction_abort = (StreamTransactionAbortFn)buffered_file_stream_transaction_abort,
 };
 
 Stream* buffered_file_stream_alloc(Storage* storage) {
@@ -48,6 +55,7 @@ Stream* buffered_file_stream_alloc(Storage* storage) {
     stream->file_stream = file_stream_alloc(storage);
     stream->cache = stream_cache_alloc();
     stream->sync_pending = false;
+    stream->transaction = false;
 
     stream->stream_base.vtable = &buffered_file_stream_vtable;
     return (Stream*)stream;
@@ -61,6 +69,7 @@ bool buffered_file_stream_open(
     furi_assert(_stream);
     BufferedFileStream* stream = (BufferedFileStream*)_stream;
     furi_check(stream->stream_base.vtable == &buffered_file_stream_vtable);
+    buffered_file_stream_transaction_abort(stream);
     return file_stream_open(stream->file_stream, path, access_mode, open_mode);
 }
 
@@ -68,6 +77,7 @@ bool buffered_file_stream_close(Stream* _stream) {
     furi_assert(_stream);
     BufferedFileStream* stream = (BufferedFileStream*)_stream;
     furi_check(stream->stream_base.vtable == &buffered_file_stream_vtable);
+    buffered_file_stream_transaction_abort(stream);
     bool success = false;
     do {
         if(!(stream->sync_pending ? buffered_file_stream_flush(stream) :
@@ -95,6 +105,7 @@ FS_Error buffered_file_stream_get_error(Stream* _stream) {
 
 static void buffered_file_stream_free(BufferedFileStream* stream) {
     furi_assert(stream);
+    buffered_file_stream_transaction_abort(stream);
     buffered_file_stream_sync((Stream*)stream);
     stream_free(stream->file_stream);
     stream_cache_free(stream->cache);
@@ -222,6 +233,42 @@ static bool buffered_file_stream_delete_and_insert(
     return success;
 }
 
+static bool buffered_file_stream_transaction_begin(BufferedFileStream* stream) {
+    bool success = false;
+    do {
+        if(!(stream->sync_pending ? buffered_file_stream_flush(stream) :
+                                    buffered_file_stream_unread(stream)))
+            break;
+        if(!stream_transaction_begin(stream->file_stream)) break;
+        stream->transaction = true;
+        success = true;
+    } while(false);
+    return success;
+}
+
+static bool buffered_file_stream_transaction_commit(BufferedFileStream* stream) {
+    if(!stream->transaction) return true;
+
+    bool success = stream->sync_pending ? buffered_file_stream_flush(stream) :
+                                          buffered_file_stream_unread(stream);
+    if(success) {
+        success = stream_transaction_commit(stream->file_stream);
+    }
+    // Failed transaction is kept, so it can be committed again or aborted
+    if(success) stream->transaction = false;
+    return success;
+}
+
+static void buffered_file_stream_transaction_abort(BufferedFileStream* stream) {
+    if(!stream->transaction) return;
+    stream->transaction = false;
+
+    // Not syncing because edits are dropped anyway
+    stream->sync_pending = false;
+    stream_cache_drop(stream->cache);
+    stream_transaction_abort(stream->file_stream);
+}
+
 // Write the cache into the underlying stream and adjust seek position
 static bool buffered_file_stream_flush(BufferedFileStream* stream) {
     bool success = false;
@@ -1,11 +1,20 @@
 #include "stream.h"
 #include "stream_i.h"
 #include "file_stream.h"
+#include "string_stream.h"
+
+#define FILE_STREAM_TRANSACTION_EXT ".tmp"
+#define FILE_STREAM_TRANSACTION_BACKUP_EXT ".old.tmp"
+#define FILE_STREAM_TRANSACTION_SIZE_MAX (32 * 1024)
 
 typedef struct {
     Stream stream_base;
     Storage* storage;
     File* file;
+    FuriString* path;
+    FS_AccessMode access_mode;
+    // File copy with edits while transaction is active, NULL otherwise
+    Stream* transaction;
 } FileStream;
 
 static void file_stream_free(FileStream* stream);
@@ -21,6 +30,10 @@ static bool file_stream_delete_and_insert(
     size_t delete_size,
     StreamWriteCB write_callback,
     const void* ctx);
+static bool file_stream_transaction_begin(FileStream* stream);
+static bool file_stream_transaction_commit(FileStream* stream);
+static void file_stream_transaction_abort(FileStream* stream);
+static bool file_stream_transaction_recover(FileStream* stream);
 
 const StreamVTable file_stream_vtable = {
     .free = (StreamFreeFn)file_stream_free,
@@ -32,12 +45,18 @@ const StreamVTable file_stream_vtable = {
     .write = (StreamWriteFn)file_stream_write,
     .read = (StreamReadFn)file_stream_read,
     .delete_and_insert = (StreamDeleteAndInsertFn)file_stream_delete_and_insert,
+    .transaction_begin = (StreamTransactionBeginFn)file_stream_transaction_begin,
+    .transaction_commit = (StreamTransactionCommitFn)file_stream_transaction_commit,
+    .transaction_abort = (StreamTransactionAbortFn)file_stream_transaction_abort,
 };
 
 Stream* file_stream_alloc(Storage* storage) {
     FileStream* stream = malloc(sizeof(FileStream));
     stream->file = storage_file_alloc(storage);
     stream->storage = storage;
+    stream->path = furi_string_alloc();
+    stream->access_mode = 0;
+    stream->transaction = NULL;
 
     stream->stream_base.vtable = &file_stream_vtable;
     return (Stream*)stream;
@@ -51,13 +70,22 @@ bool file_stream_open(
     furi_assert(_stream);
     FileStream* stream = (FileStream*)_stream;
     furi_check(stream->stream_base.vtable == &file_stream_vtable);
-    return storage_file_open(stream->file, path, access_mode, open_mode);
+    file_stream_transaction_abort(stream);
+    furi_string_set(stream->path, path);
+    stream->access_mode = access_mode;
+    bool result = storage_file_open(stream->file, path, access_mode, open_mode);
+    if(!result && storage_file_get_error(stream->file) == FSE_NOT_EXIST &&
+       file_stream_transaction_recover(stream)) {
+        result = storage_file_open(stream->file, path, access_mode, open_mode);
+    }
+    return result;
 }
 
 bool file_stream_close(Stream* _stream) {
     furi_assert(_stream);
     FileStream* stream = (FileStream*)_stream;
     furi_check(stream->stream_base.vtable == &file_stream_vtable);
+    file_stream_transaction_abort(stream);
     return storage_file_close(stream->file);
 }
 
@@ -69,20 +97,29 @@ FS_Error file_stream_get_error(Stream* _stream) {
 }
 
 static void file_stream_free(FileStream* stream) {
+    file_stream_transaction_abort(stream);
     storage_file_free(stream->file);
+    furi_string_free(stream->path);
     free(stream);
 }
 
 static bool file_stream_eof(FileStream* stream) {
+    if(stream->transaction) return stream_eof(stream->transaction);
     return storage_file_eof(stream->file);
 }
 
 static void file_stream_clean(FileStream* stream) {
+    if(stream->transaction) {
+        stream_clean(stream->transaction);
+        return;
+    }
     storage_file_seek(stream->file, 0, true);
     storage_file_truncate(stream->file);
 }
 
 static bool file_stream_seek(FileStream* stream, int32_t offset, StreamOffset offset_type) {
+    if(stream->transaction) return stream_seek(stream->transaction, offset, offset_type);
+
     bool result = false;
     size_t seek_position = 0;
     size_t current_position = file_stream_tell(stream);
@@ -126,14 +163,18 @@ static bool file_stream_seek(FileStream* stream, int32_t offset, StreamOffset of
 }
 
 static size_t file_stream_tell(FileStream* stream) {
+    if(stream->transaction) return stream_tell(stream->transaction);
     return storage_file_tell(stream->file);
 }
 
 static size_t file_stream_size(FileStream* stream) {
+    if(stream->transaction) return stream_size(stream->transaction);
     return storage_file_size(stream->file);
 }
 
 static size_t file_stream_write(FileStream* stream, const uint8_t* data, size_t size) {
+    if(stream->transaction) return stream_write(stream->transaction, data, size);
+
     // TODO cache
     size_t need_to_write = size;
     while(need_to_write > 0) {
@@ -148,6 +189,8 @@ static size_t file_stream_write(FileStream* stream, const uint8_t* data, size_t
 }
 
 static size_t file_stream_read(FileStream* stream, uint8_t* data, size_t size) {
+    if(stream->transaction) return stream_read(stream->transaction, data, size);
+
     // TODO cache
     size_t need_to_read = size;
     while(need_to_read > 0) {
@@ -166,6 +209,10 @@ static bool file_stream_delete_and_insert(
     size_t delete_size,
     StreamWriteCB write_callback,
     const void* ctx) {
+    if(_stream->transaction) {
+        return stream_delete_and_insert(_stream->transaction, delete_size, write_callback, ctx);
+    }
+
     bool result = false;
     Stream* stream = (Stream*)_stream;
 
@@ -233,3 +280,139 @@ static bool file_stream_delete_and_insert(
 
     return result;
 }
+
+static bool file_stream_transaction_begin(FileStream* stream) {
+    if(stream->transaction) return false;
+    if(!(stream->access_mode & FSAM_WRITE)) return false;
+    if(!storage_file_is_open(stream->file)) return false;
+
+    // Copy and its growth must fit in heap with room to spare
+    size_t file_size = storage_file_size(stream->file);
+    if(file_size > FILE_STREAM_TRANSACTION_SIZE_MAX) return false;
+    if(file_size * 3 > memmgr_heap_get_max_free_block()) return false;
+
+    // File is open, so temporary files left by interrupted commit are stale
+    const char* path = furi_string_get_cstr(stream->path);
+    FuriString* tmp_path = furi_string_alloc_printf("%s" FILE_STREAM_TRANSACTION_EXT, path);
+    storage_common_remove(stream->storage, furi_string_get_cstr(tmp_path));
+    furi_string_printf(tmp_path, "%s" FILE_STREAM_TRANSACTION_BACKUP_EXT, path);
+    storage_common_remove(stream->storage, furi_string_get_cstr(tmp_path));
+    furi_string_free(tmp_path);
+
+    bool result = false;
+    Stream* transaction = string_stream_alloc();
+    size_t position = storage_file_tell(stream->file);
+
+    do {
+        if(!storage_file_seek(stream->file, 0, true)) break;
+        if(stream_copy((Stream*)stream, transaction, file_size) != file_size) break;
+        if(!stream_seek(transaction, position, StreamOffsetFromStart)) break;
+        result = true;
+    } while(false);
+
+    storage_file_seek(stream->file, position, true);
+
+    if(result) {
+        stream->transaction = transaction;
+    } else {
+        stream_free(transaction);
+    }
+
+    return result;
+}
+
+static bool file_stream_transaction_commit(FileStream* stream) {
+    if(!stream->transaction) return true;
+
+    bool result = false;
+    bool stored = false;
+    const char* path = furi_string_get_cstr(stream->path);
+    FuriString* tmp_path = furi_string_alloc_printf("%s" FILE_STREAM_TRANSACTION_EXT, path);
+    FuriString* backup_path =
+        furi_string_alloc_printf("%s" FILE_STREAM_TRANSACTION_BACKUP_EXT, path);
+    size_t file_position = storage_file_tell(stream->file);
+
+    do {
+        // Whole file is written sequentially next to the original one
+        Stream* tmp_stream = file_stream_alloc(stream->storage);
+        size_t size = stream_size(stream->transaction);
+        bool tmp_written = file_stream_open(
+                               tmp_stream,
+                               furi_string_get_cstr(tmp_path),
+                               FSAM_WRITE,
+                               FSOM_CREATE_ALWAYS) &&
+                           (stream_copy_full(stream->transaction, tmp_stream) == size);
+        tmp_written = file_stream_close(tmp_stream) && tmp_written;
+        stream_free(tmp_stream);
+
+        if(!tmp_written) {
+            storage_common_remove(stream->storage, furi_string_get_cstr(tmp_path));
+            break;
+        }
+
+        // Original file is kept as backup until the new one takes its place,
+        // interrupted commit is finished or rolled back on next open
+        storage_file_close(stream->file);
+        storage_common_remove(stream->storage, furi_string_get_cstr(backup_path));
+        if(storage_common_rename(stream->storage, path, furi_string_get_cstr(backup_path)) !=
+           FSE_OK) {
+            storage_common_remove(stream->storage, furi_string_get_cstr(tmp_path));
+        } else if(
+            storage_common_rename(stream->storage, furi_string_get_cstr(tmp_path), path) !=
+            FSE_OK) {
+            storage_common_rename(stream->storage, furi_string_get_cstr(backup_path), path);
+            storage_common_remove(stream->storage, furi_string_get_cstr(tmp_path));
+        } else {
+            storage_common_remove(stream->storage, furi_string_get_cstr(backup_path));
+            stored = true;
+        }
+
+        result = storage_file_open(stream->file, path, stream->access_mode, FSOM_OPEN_EXISTING) &&
+                 stored;
+    } while(false);
+
+    if(stored) {
+        size_t position = stream_tell(stream->transaction);
+        file_stream_transaction_abort(stream);
+        file_stream_seek(stream, position, StreamOffsetFromStart);
+    } else {
+        // Transaction is kept, so it can be committed again or aborted
+        storage_file_seek(stream->file, file_position, true);
+    }
+
+    furi_string_free(backup_path);
+    furi_string_free(tmp_path);
+
+    return result;
+}
+
+static void file_stream_transaction_abort(FileStream* stream) {
+    if(stream->transaction) {
+        stream_free(stream->transaction);
+        stream->transaction = NULL;
+    }
+}
+
+static bool file_stream_transaction_recover(FileStream* stream) {
+    const char* path = furi_string_get_cstr(stream->path);
+    FuriString* tmp_path = furi_string_alloc_printf("%s" FILE_STREAM_TRANSACTION_EXT, path);
+    FuriString* backup_path =
+        furi_string_alloc_printf("%s" FILE_STREAM_TRANSACTION_BACKUP_EXT, path);
+    bool recovered = false;
+
+    // Commit was interrupted, backup exists only while new file is complete
+    if(storage_common_exists(stream->storage, furi_string_get_cstr(backup_path))) {
+        if(storage_common_rename(stream->storage, furi_string_get_cstr(tmp_path), path) ==
+               FSE_OK ||
+           storage_common_rename(stream->storage, furi_string_get_cstr(backup_path), path) ==
+               FSE_OK) {
+            storage_common_remove(stream->storage, furi_string_get_cstr(backup_path));
+            recovered = true;
+        }
+    }
+
+    furi_string_free(backup_path);
+    furi_string_free(tmp_path);
+
+    return recovered;
+}
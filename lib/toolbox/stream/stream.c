@@ -131,6 +131,25 @@ bool stream_delete_and_insert(
     return stream->vtable->delete_and_insert(stream, delete_size, write_callback, ctx);
 }
 
+bool stream_transaction_begin(Stream* stream) {
+    furi_assert(stream);
+    if(!stream->vtable->transaction_begin) return false;
+    return stream->vtable->transaction_begin(stream);
+}
+
+bool stream_transaction_commit(Stream* stream) {
+    furi_assert(stream);
+    if(!stream->vtable->transaction_commit) return true;
+    return stream->vtable->transaction_commit(stream);
+}
+
+void stream_transaction_abort(Stream* stream) {
+    furi_assert(stream);
+    if(stream->vtable->transaction_abort) {
+        stream->vtable->transaction_abort(stream);
+    }
+}
+
 /********************************** Some random helpers starts here **********************************/
 
 typedef struct {
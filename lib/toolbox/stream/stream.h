@@ -110,6 +110,36 @@ bool stream_delete_and_insert(
     StreamWriteCB write_callback,
     const void* context);
 
+/**
+ * Begin transaction: following edits are collected in memory and stored at once on commit.
+ * Without transaction each delete_and_insert on a file rewrites the file tail.
+ * Not supported by all streams and not for big files, edits are applied directly then.
+ * Transactions are not nested.
+ * @param stream Stream instance
+ * @return true if transaction was started
+ * @return false if edits will be applied directly
+ */
+bool stream_transaction_begin(Stream* stream);
+
+/**
+ * Commit transaction: store collected edits with one sequential write and a rename.
+ * Original file is kept as backup until the new one is in place, if commit is interrupted
+ * by power loss, the file is restored when opening it fails next time.
+ * Stream position is kept. Does nothing if there is no transaction.
+ * @param stream Stream instance
+ * @return true if the operation was successful
+ * @return false on error, stored data is unchanged and transaction is kept,
+ * so it can be committed again or aborted
+ */
+bool stream_transaction_commit(Stream* stream);
+
+/**
+ * Abort transaction: drop collected edits, stream is back at its state before begin.
+ * Closing a file stream with transaction aborts it too.
+ * @param stream Stream instance
+ */
+void stream_transaction_abort(Stream* stream);
+
 /********************************** Some random helpers starts here **********************************/
 
 /**
@@ -24,6 +24,9 @@ typedef bool (*StreamDeleteAndInsertFn)(
     size_t delete_size,
     StreamWriteCB write_cb,
     const void* ctx);
+typedef bool (*StreamTransactionBeginFn)(Stream* stream);
+typedef bool (*StreamTransactionCommitFn)(Stream* stream);
+typedef void (*StreamTransactionAbortFn)(Stream* stream);
 
 struct StreamVTable {
     const StreamFreeFn free;
@@ -35,6 +38,10 @@ struct StreamVTable {
     const StreamWriteFn write;
     const StreamReadFn read;
     const StreamDeleteAndInsertFn delete_and_insert;
+    // Optional, NULL if stream has no transactions
+    const StreamTransactionBeginFn transaction_begin;
+    const StreamTransactionCommitFn transaction_commit;
+    const StreamTransactionAbortFn transaction_abort;
 };
 
 struct Stream {
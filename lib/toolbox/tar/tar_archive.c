@@ -4,6 +4,8 @@
 #include <storage/storage.h>
 #include <furi.h>
 #include <toolbox/path.h>
+#include <toolbox/md5.h>
+#include <lib/heatshrink/heatshrink_decoder.h>
 
 #define TAG "TarArch"
 #define MAX_NAME_LEN 255
@@ -12,11 +14,87 @@
 #define FILE_OPEN_NTRIES 10
 #define FILE_OPEN_RETRY_DELAY 25
 
+/* Unpacking reads archive and writes files with this size, it is a multiple of
+ * tar block and sector size, so reads and writes stay sector aligned */
+#define TAR_ARCHIVE_STREAM_BLOCK_SIZE (8 * FILE_BLOCK_SIZE)
+
+/* Longest ustar name, prefix + '/' + name */
+#define TAR_ARCHIVE_NAME_MAX (155 + 1 + 100)
+#define TAR_ARCHIVE_FILE_MODE (0644)
+#define TAR_ARCHIVE_DIR_MODE (0755)
+
+#define TAR_ARCHIVE_HEATSHRINK_EXT ".hs"
+#define TAR_ARCHIVE_HEATSHRINK_MAGIC (0x52545348) /* "HSTR" */
+#define TAR_ARCHIVE_HEATSHRINK_VERSION (1)
+#define TAR_ARCHIVE_HEATSHRINK_READ_SIZE (512)
+
+/* Header of heatshrink compressed tar, compressed stream follows it */
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t window_sz2;
+    uint8_t lookahead_sz2;
+    uint8_t reserved;
+} TarArchiveHeatshrinkHeader;
+
+_Static_assert(sizeof(TarArchiveHeatshrinkHeader) == 8, "Incorrect heatshrink header size");
+
+typedef struct {
+    heatshrink_decoder* decoder;
+    uint8_t* buffer;
+    size_t buffer_pos;
+    size_t buffer_size;
+} TarArchiveHeatshrink;
+
+/* ustar header block */
+typedef struct {
+    char name[100];
+    char mode[8];
+    char owner[8];
+    char group[8];
+    char size[12];
+    char mtime[12];
+    char checksum[8];
+    char type;
+    char linkname[100];
+    char magic[6];
+    char version[2];
+    char uname[32];
+    char gname[32];
+    char devmajor[8];
+    char devminor[8];
+    char prefix[155];
+    char padding[12];
+} TarArchiveRawHeader;
+
+_Static_assert(sizeof(TarArchiveRawHeader) == FILE_BLOCK_SIZE, "Incorrect tar header size");
+
+typedef struct {
+    char name[TAR_ARCHIVE_NAME_MAX + 1];
+    char type;
+    uint32_t size;
+    /* Data left in archive, with padding to tar block */
+    uint32_t unread;
+} TarArchiveEntry;
+
+typedef enum {
+    TarArchiveHeaderOk,
+    TarArchiveHeaderEnd,
+    TarArchiveHeaderError,
+} TarArchiveHeaderResult;
+
 typedef struct TarArchive {
     Storage* storage;
     mtar_t tar;
+    File* stream;
+    /* Only set for compressed archive opened for reading */
+    TarArchiveHeatshrink* heatshrink;
     tar_unpack_file_cb unpack_cb;
     void* unpack_cb_context;
+    tar_unpack_hash_cb hash_cb;
+    void* hash_cb_context;
+    /* Data of current entry written so far, padded to tar block on finalize */
+    uint32_t data_written;
 } TarArchive;
 
 /* API WRAPPER */
@@ -54,10 +132,45 @@ TarArchive* tar_archive_alloc(Storage* storage) {
     furi_check(storage);
     TarArchive* archive = malloc(sizeof(TarArchive));
     archive->storage = storage;
+    archive->stream = NULL;
+    archive->heatshrink = NULL;
     archive->unpack_cb = NULL;
+    archive->hash_cb = NULL;
+    archive->data_written = 0;
     return archive;
 }
 
+static bool tar_archive_heatshrink_open(TarArchive* archive) {
+    TarArchiveHeatshrinkHeader header;
+    if(storage_file_read(archive->stream, &header, sizeof(header)) != sizeof(header) ||
+       header.magic != TAR_ARCHIVE_HEATSHRINK_MAGIC ||
+       header.version != TAR_ARCHIVE_HEATSHRINK_VERSION || header.window_sz2 < 4 ||
+       header.window_sz2 > 15 || header.lookahead_sz2 < 3 ||
+       header.lookahead_sz2 >= header.window_sz2) {
+        FURI_LOG_E(TAG, "Bad compressed archive header");
+        return false;
+    }
+
+    TarArchiveHeatshrink* heatshrink = malloc(sizeof(TarArchiveHeatshrink));
+    heatshrink->decoder = heatshrink_decoder_alloc(
+        TAR_ARCHIVE_HEATSHRINK_READ_SIZE, header.window_sz2, header.lookahead_sz2);
+    heatshrink->buffer = malloc(TAR_ARCHIVE_HEATSHRINK_READ_SIZE);
+    heatshrink->buffer_pos = 0;
+    heatshrink->buffer_size = 0;
+    archive->heatshrink = heatshrink;
+
+    return true;
+}
+
+static void tar_archive_heatshrink_free(TarArchive* archive) {
+    if(archive->heatshrink) {
+        heatshrink_decoder_free(archive->heatshrink->decoder);
+        free(archive->heatshrink->buffer);
+        free(archive->heatshrink);
+        archive->heatshrink = NULL;
+    }
+}
+
 bool tar_archive_open(TarArchive* archive, const char* path, TarOpenMode mode) {
     furi_assert(archive);
     FS_AccessMode access_mode;
@@ -68,7 +181,8 @@ bool tar_archive_open(TarArchive* archive, const char* path, TarOpenMode mode) {
     case TAR_OPEN_MODE_READ:
         mtar_access = MTAR_READ;
         access_mode = FSAM_READ;
-        open_mode = FSOM_OPEN_EXISTING;
+        // Entries are skipped by seeking
+        open_mode = FSOM_OPEN_EXISTING | FSOM_FAST_SEEK;
         break;
     case TAR_OPEN_MODE_WRITE:
         mtar_access = MTAR_WRITE;
@@ -84,6 +198,18 @@ bool tar_archive_open(TarArchive* archive, const char* path, TarOpenMode mode) {
         storage_file_free(stream);
         return false;
     }
+    archive->stream = stream;
+
+    size_t path_len = strlen(path);
+    size_t ext_len = strlen(TAR_ARCHIVE_HEATSHRINK_EXT);
+    if(mode == TAR_OPEN_MODE_READ && path_len > ext_len &&
+       strcasecmp(path + path_len - ext_len, TAR_ARCHIVE_HEATSHRINK_EXT) == 0 &&
+       !tar_archive_heatshrink_open(archive)) {
+        storage_file_free(stream);
+        archive->stream = NULL;
+        return false;
+    }
+
     mtar_init(&archive->tar, mtar_access, &filesystem_ops, stream);
 
     return true;
@@ -94,6 +220,7 @@ void tar_archive_free(TarArchive* archive) {
     if(mtar_is_open(&archive->tar)) {
         mtar_close(&archive->tar);
     }
+    tar_archive_heatshrink_free(archive);
     free(archive);
 }
 
@@ -103,31 +230,293 @@ void tar_archive_set_file_callback(TarArchive* archive, tar_unpack_file_cb callb
     archive->unpack_cb_context = context;
 }
 
-static int tar_archive_entry_counter(mtar_t* tar, const mtar_header_t* header, void* param) {
-    UNUSED(tar);
-    UNUSED(header);
-    furi_assert(param);
-    int32_t* counter = param;
+void tar_archive_set_hash_callback(TarArchive* archive, tar_unpack_hash_cb callback, void* context) {
+    furi_assert(archive);
+    archive->hash_cb = callback;
+    archive->hash_cb_context = context;
+}
+
+/* STREAM READER */
+static size_t tar_archive_heatshrink_read(TarArchive* archive, uint8_t* data, size_t size) {
+    TarArchiveHeatshrink* heatshrink = archive->heatshrink;
+    size_t done = 0;
+
+    while(done < size) {
+        size_t poll_size = 0;
+        if(heatshrink_decoder_poll(heatshrink->decoder, &data[done], size - done, &poll_size) <
+           0) {
+            break;
+        }
+        done += poll_size;
+        if(done == size) {
+            break;
+        }
+
+        // Decoder is drained, feed it more compressed data
+        if(heatshrink->buffer_pos == heatshrink->buffer_size) {
+            heatshrink->buffer_pos = 0;
+            heatshrink->buffer_size = storage_file_read(
+                archive->stream, heatshrink->buffer, TAR_ARCHIVE_HEATSHRINK_READ_SIZE);
+            if(heatshrink->buffer_size == 0) {
+                break;
+            }
+        }
+
+        size_t sink_size = 0;
+        if(heatshrink_decoder_sink(
+               heatshrink->decoder,
+               &heatshrink->buffer[heatshrink->buffer_pos],
+               heatshrink->buffer_size - heatshrink->buffer_pos,
+               &sink_size) < 0) {
+            break;
+        }
+        heatshrink->buffer_pos += sink_size;
+    }
+
+    return done;
+}
+
+static size_t tar_archive_stream_read(TarArchive* archive, uint8_t* data, size_t size) {
+    if(archive->heatshrink) {
+        return tar_archive_heatshrink_read(archive, data, size);
+    }
+    return storage_file_read(archive->stream, data, size);
+}
+
+static bool tar_archive_stream_rewind(TarArchive* archive) {
+    if(!archive->stream) {
+        return false;
+    }
+
+    if(archive->heatshrink) {
+        // Decoder only goes forward, start over from the first compressed byte
+        heatshrink_decoder_reset(archive->heatshrink->decoder);
+        archive->heatshrink->buffer_pos = 0;
+        archive->heatshrink->buffer_size = 0;
+        return storage_file_seek(archive->stream, sizeof(TarArchiveHeatshrinkHeader), true);
+    }
+    return storage_file_seek(archive->stream, 0, true);
+}
+
+/* Skip rest of entry data, compressed data has to be decoded */
+static bool tar_archive_stream_skip(TarArchive* archive, TarArchiveEntry* entry, uint8_t* buffer) {
+    if(!archive->heatshrink) {
+        bool success = storage_file_seek(archive->stream, entry->unread, false);
+        entry->unread = 0;
+        return success;
+    }
+
+    while(entry->unread) {
+        size_t chunk_size = MIN(entry->unread, (uint32_t)TAR_ARCHIVE_STREAM_BLOCK_SIZE);
+        if(tar_archive_stream_read(archive, buffer, chunk_size) != chunk_size) {
+            return false;
+        }
+        entry->unread -= chunk_size;
+    }
+    return true;
+}
+
+static bool tar_archive_parse_octal(const char* field, size_t size, uint32_t* value) {
+    size_t i = 0;
+    while(i < size && field[i] == ' ') {
+        i++;
+    }
+
+    bool has_digits = false;
+    *value = 0;
+    for(; i < size && field[i] >= '0' && field[i] <= '7'; i++) {
+        *value = (*value << 3) | (field[i] - '0');
+        has_digits = true;
+    }
+    return has_digits;
+}
+
+static TarArchiveHeaderResult
+    tar_archive_read_header(TarArchive* archive, TarArchiveEntry* entry, uint8_t* buffer) {
+    if(tar_archive_stream_read(archive, buffer, FILE_BLOCK_SIZE) != FILE_BLOCK_SIZE) {
+        return TarArchiveHeaderError;
+    }
+
+    const TarArchiveRawHeader* header = (const TarArchiveRawHeader*)buffer;
+    if(header->checksum[0] == '\0') {
+        return TarArchiveHeaderEnd;
+    }
+
+    // Checksum is calculated with checksum field filled with spaces
+    uint32_t checksum = 0;
+    for(size_t i = 0; i < FILE_BLOCK_SIZE; i++) {
+        checksum += buffer[i];
+    }
+    for(size_t i = 0; i < sizeof(header->checksum); i++) {
+        checksum += ' ' - (uint8_t)header->checksum[i];
+    }
+
+    uint32_t stored_checksum;
+    if(!tar_archive_parse_octal(header->checksum, sizeof(header->checksum), &stored_checksum) ||
+       stored_checksum != checksum ||
+       !tar_archive_parse_octal(header->size, sizeof(header->size), &entry->size)) {
+        FURI_LOG_E(TAG, "Bad header");
+        return TarArchiveHeaderError;
+    }
+
+    size_t name_len = 0;
+    if(memcmp(header->magic, "ustar", sizeof(header->magic)) == 0 && header->prefix[0]) {
+        name_len = strnlen(header->prefix, sizeof(header->prefix));
+        memcpy(entry->name, header->prefix, name_len);
+        entry->name[name_len++] = '/';
+    }
+    size_t base_len = strnlen(header->name, sizeof(header->name));
+    memcpy(&entry->name[name_len], header->name, base_len);
+    entry->name[name_len + base_len] = '\0';
+
+    entry->type = header->type;
+    entry->unread = (entry->size + FILE_BLOCK_SIZE - 1) & ~(FILE_BLOCK_SIZE - 1);
+
+    return TarArchiveHeaderOk;
+}
+
+typedef bool (*TarArchiveEntryCallback)(
+    TarArchive* archive,
+    TarArchiveEntry* entry,
+    uint8_t* buffer,
+    void* context);
+
+/* Walk all entries from the start, data not consumed by callback is skipped */
+static bool tar_archive_foreach_entry(
+    TarArchive* archive,
+    TarArchiveEntryCallback callback,
+    void* context) {
+    if(!tar_archive_stream_rewind(archive)) {
+        return false;
+    }
+
+    uint8_t* buffer = malloc(TAR_ARCHIVE_STREAM_BLOCK_SIZE);
+    TarArchiveEntry* entry = malloc(sizeof(TarArchiveEntry));
+    bool success = false;
+
+    while(true) {
+        TarArchiveHeaderResult result = tar_archive_read_header(archive, entry, buffer);
+        if(result == TarArchiveHeaderEnd) {
+            success = true;
+            break;
+        }
+
+        if(result != TarArchiveHeaderOk || !callback(archive, entry, buffer, context) ||
+           !tar_archive_stream_skip(archive, entry, buffer)) {
+            break;
+        }
+    }
+
+    free(entry);
+    free(buffer);
+    return success;
+}
+
+static bool tar_archive_entry_counter(
+    TarArchive* archive,
+    TarArchiveEntry* entry,
+    uint8_t* buffer,
+    void* context) {
+    UNUSED(archive);
+    UNUSED(entry);
+    UNUSED(buffer);
+    furi_assert(context);
+    int32_t* counter = context;
     (*counter)++;
-    return 0;
+    return true;
 }
 
 int32_t tar_archive_get_entries_count(TarArchive* archive) {
+    furi_assert(archive);
     int32_t counter = 0;
-    if(mtar_foreach(&archive->tar, tar_archive_entry_counter, &counter) != MTAR_ESUCCESS) {
+    if(!tar_archive_foreach_entry(archive, tar_archive_entry_counter, &counter)) {
         counter = -1;
     }
     return counter;
 }
 
+/* STREAM WRITER */
+/* Names over 100 characters are split at '/' into ustar prefix and name */
+static bool tar_archive_set_header_name(TarArchiveRawHeader* header, const char* path) {
+    size_t path_len = strlen(path);
+    if(path_len <= sizeof(header->name)) {
+        memcpy(header->name, path, path_len);
+        return true;
+    }
+
+    size_t split = path_len - sizeof(header->name) - 1;
+    for(; split < path_len - 1 && split <= sizeof(header->prefix); split++) {
+        if(path[split] == '/') {
+            memcpy(header->prefix, path, split);
+            memcpy(header->name, &path[split + 1], path_len - split - 1);
+            return true;
+        }
+    }
+
+    FURI_LOG_E(TAG, "Name is too long: '%s'", path);
+    return false;
+}
+
+static bool tar_archive_write_header(
+    TarArchive* archive,
+    const char* path,
+    char type,
+    uint32_t mode,
+    uint32_t size) {
+    uint8_t* buffer = malloc(FILE_BLOCK_SIZE);
+    TarArchiveRawHeader* header = (TarArchiveRawHeader*)buffer;
+    memset(buffer, 0, FILE_BLOCK_SIZE);
+    bool success = false;
+
+    if(tar_archive_set_header_name(header, path)) {
+        snprintf(header->mode, sizeof(header->mode), "%07lo", mode);
+        snprintf(header->owner, sizeof(header->owner), "%07o", 0);
+        snprintf(header->group, sizeof(header->group), "%07o", 0);
+        snprintf(header->size, sizeof(header->size), "%011lo", size);
+        snprintf(header->mtime, sizeof(header->mtime), "%011o", 0);
+        header->type = type;
+        memcpy(header->magic, "ustar", sizeof(header->magic));
+        memcpy(header->version, "00", sizeof(header->version));
+
+        // Checksum is calculated with checksum field filled with spaces
+        memset(header->checksum, ' ', sizeof(header->checksum));
+        uint32_t checksum = 0;
+        for(size_t i = 0; i < FILE_BLOCK_SIZE; i++) {
+            checksum += buffer[i];
+        }
+        snprintf(header->checksum, sizeof(header->checksum), "%06lo", checksum);
+
+        archive->data_written = 0;
+        success = storage_file_write(archive->stream, buffer, FILE_BLOCK_SIZE) ==
+                  FILE_BLOCK_SIZE;
+    }
+
+    free(buffer);
+    return success;
+}
+
+static bool tar_archive_write_zeros(TarArchive* archive, size_t size) {
+    uint8_t* buffer = malloc(FILE_BLOCK_SIZE);
+    memset(buffer, 0, FILE_BLOCK_SIZE);
+    bool success = true;
+    while(success && size) {
+        size_t chunk_size = MIN(size, (size_t)FILE_BLOCK_SIZE);
+        success = storage_file_write(archive->stream, buffer, chunk_size) == chunk_size;
+        size -= chunk_size;
+    }
+    free(buffer);
+    return success;
+}
+
 bool tar_archive_dir_add_element(TarArchive* archive, const char* dirpath) {
     furi_assert(archive);
-    return (mtar_write_dir_header(&archive->tar, dirpath) == MTAR_ESUCCESS);
+    return tar_archive_write_header(archive, dirpath, MTAR_TDIR, TAR_ARCHIVE_DIR_MODE, 0);
 }
 
 bool tar_archive_finalize(TarArchive* archive) {
     furi_assert(archive);
-    return (mtar_finalize(&archive->tar) == MTAR_ESUCCESS);
+    // End of archive is marked with two zero blocks
+    return tar_archive_write_zeros(archive, 2 * FILE_BLOCK_SIZE);
 }
 
 bool tar_archive_store_data(
@@ -146,7 +535,7 @@ bool tar_archive_store_data(
 bool tar_archive_file_add_header(TarArchive* archive, const char* path, const int32_t data_len) {
     furi_assert(archive);
 
-    return (mtar_write_file_header(&archive->tar, path, data_len) == MTAR_ESUCCESS);
+    return tar_archive_write_header(archive, path, MTAR_TREG, TAR_ARCHIVE_FILE_MODE, data_len);
 }
 
 bool tar_archive_file_add_data_block(
@@ -155,24 +544,31 @@ bool tar_archive_file_add_data_block(
     const int32_t block_len) {
     furi_assert(archive);
 
-    return (mtar_write_data(&archive->tar, data_block, block_len) == block_len);
+    archive->data_written += block_len;
+    return (storage_file_write(archive->stream, data_block, block_len) == block_len);
 }
 
 bool tar_archive_file_finalize(TarArchive* archive) {
     furi_assert(archive);
-    return (mtar_end_data(&archive->tar) == MTAR_ESUCCESS);
+    size_t padding = (FILE_BLOCK_SIZE - archive->data_written % FILE_BLOCK_SIZE) %
+                     FILE_BLOCK_SIZE;
+    return tar_archive_write_zeros(archive, padding);
 }
 
+/* EXTRACTION */
 typedef struct {
-    TarArchive* archive;
     const char* work_dir;
     Storage_name_converter converter;
 } TarArchiveDirectoryOpParams;
 
-static bool archive_extract_current_file(TarArchive* archive, const char* dst_path) {
-    mtar_t* tar = &archive->tar;
+/* Entry data is written in blocks as read from archive, MD5 is calculated on the way */
+static bool archive_extract_current_file(
+    TarArchive* archive,
+    TarArchiveEntry* entry,
+    uint8_t* buffer,
+    const char* dst_path) {
     File* out_file = storage_file_alloc(archive->storage);
-    uint8_t* readbuf = malloc(FILE_BLOCK_SIZE);
+    md5_context* md5_ctx = archive->hash_cb ? malloc(sizeof(md5_context)) : NULL;
 
     bool success = true;
     uint8_t n_tries = FILE_OPEN_NTRIES;
@@ -191,55 +587,84 @@ static bool archive_extract_current_file(TarArchive* archive, const char* dst_pa
             break;
         }
 
-        while(!mtar_eof_data(tar)) {
-            int32_t readcnt = mtar_read_data(tar, readbuf, FILE_BLOCK_SIZE);
-            if(!readcnt || !storage_file_write(out_file, readbuf, readcnt)) {
+        if(md5_ctx) {
+            md5_starts(md5_ctx);
+        }
+
+        uint32_t data_left = entry->size;
+        while(entry->unread) {
+            // Block padding is read too, next header stays block aligned
+            size_t chunk_size = MIN(entry->unread, (uint32_t)TAR_ARCHIVE_STREAM_BLOCK_SIZE);
+            if(tar_archive_stream_read(archive, buffer, chunk_size) != chunk_size) {
                 success = false;
                 break;
             }
+            entry->unread -= chunk_size;
+
+            size_t data_size = MIN(data_left, chunk_size);
+            data_left -= data_size;
+            if(data_size == 0) {
+                continue;
+            }
+
+            if(md5_ctx) {
+                md5_update(md5_ctx, buffer, data_size);
+            }
+            if(storage_file_write(out_file, buffer, data_size) != data_size) {
+                success = false;
+                break;
+            }
+        }
+
+        if(success && md5_ctx) {
+            uint8_t md5[16];
+            md5_finish(md5_ctx, md5);
+            success = archive->hash_cb(entry->name, md5, archive->hash_cb_context);
         }
     } while(false);
     storage_file_free(out_file);
-    free(readbuf);
+    free(md5_ctx);
 
     return success;
 }
 
-static int archive_extract_foreach_cb(mtar_t* tar, const mtar_header_t* header, void* param) {
-    UNUSED(tar);
-    TarArchiveDirectoryOpParams* op_params = param;
-    TarArchive* archive = op_params->archive;
+static bool archive_extract_foreach_cb(
+    TarArchive* archive,
+    TarArchiveEntry* entry,
+    uint8_t* buffer,
+    void* context) {
+    TarArchiveDirectoryOpParams* op_params = context;
+    const bool is_directory = entry->type == MTAR_TDIR;
 
     bool skip_entry = false;
     if(archive->unpack_cb) {
-        skip_entry = !archive->unpack_cb(
-            header->name, header->type == MTAR_TDIR, archive->unpack_cb_context);
+        skip_entry = !archive->unpack_cb(entry->name, is_directory, archive->unpack_cb_context);
     }
 
     if(skip_entry) {
-        FURI_LOG_W(TAG, "filter: skipping entry \"%s\"", header->name);
-        return 0;
+        FURI_LOG_W(TAG, "filter: skipping entry \"%s\"", entry->name);
+        return true;
     }
 
     FuriString* full_extracted_fname;
-    if(header->type == MTAR_TDIR) {
+    if(is_directory) {
         full_extracted_fname = furi_string_alloc();
-        path_concat(op_params->work_dir, header->name, full_extracted_fname);
+        path_concat(op_params->work_dir, entry->name, full_extracted_fname);
 
         bool create_res =
             storage_simply_mkdir(archive->storage, furi_string_get_cstr(full_extracted_fname));
         furi_string_free(full_extracted_fname);
-        return create_res ? 0 : -1;
+        return create_res;
     }
 
-    if(header->type != MTAR_TREG) {
-        FURI_LOG_W(TAG, "not extracting unsupported type \"%s\"", header->name);
-        return 0;
+    if(entry->type != MTAR_TREG && entry->type != '\0') {
+        FURI_LOG_W(TAG, "not extracting unsupported type \"%s\"", entry->name);
+        return true;
     }
 
-    FURI_LOG_D(TAG, "Extracting %u bytes to '%s'", header->size, header->name);
+    FURI_LOG_D(TAG, "Extracting %lu bytes to '%s'", entry->size, entry->name);
 
-    FuriString* converted_fname = furi_string_alloc_set(header->name);
+    FuriString* converted_fname = furi_string_alloc_set(entry->name);
     if(op_params->converter) {
         op_params->converter(converted_fname);
     }
@@ -247,12 +672,12 @@ static int archive_extract_foreach_cb(mtar_t* tar, const mtar_header_t* header,
     full_extracted_fname = furi_string_alloc();
     path_concat(op_params->work_dir, furi_string_get_cstr(converted_fname), full_extracted_fname);
 
-    bool success =
-        archive_extract_current_file(archive, furi_string_get_cstr(full_extracted_fname));
+    bool success = archive_extract_current_file(
+        archive, entry, buffer, furi_string_get_cstr(full_extracted_fname));
 
     furi_string_free(converted_fname);
     furi_string_free(full_extracted_fname);
-    return success ? 0 : -1;
+    return success;
 }
 
 bool tar_archive_unpack_to(
@@ -261,14 +686,13 @@ bool tar_archive_unpack_to(
     Storage_name_converter converter) {
     furi_assert(archive);
     TarArchiveDirectoryOpParams param = {
-        .archive = archive,
         .work_dir = destination,
         .converter = converter,
     };
 
     FURI_LOG_I(TAG, "Restoring '%s'", destination);
 
-    return (mtar_foreach(&archive->tar, archive_extract_foreach_cb, &param) == MTAR_ESUCCESS);
+    return tar_archive_foreach_entry(archive, archive_extract_foreach_cb, &param);
 };
 
 bool tar_archive_add_file(
@@ -372,6 +796,29 @@ bool tar_archive_add_dir(TarArchive* archive, const char* fs_full_path, const ch
     return success;
 }
 
+typedef struct {
+    const char* archive_fname;
+    const char* destination;
+    bool found;
+    bool success;
+} TarArchiveUnpackFileParams;
+
+static bool archive_unpack_file_cb(
+    TarArchive* archive,
+    TarArchiveEntry* entry,
+    uint8_t* buffer,
+    void* context) {
+    TarArchiveUnpackFileParams* params = context;
+    if(strcmp(entry->name, params->archive_fname) != 0) {
+        return true;
+    }
+
+    params->found = true;
+    params->success = archive_extract_current_file(archive, entry, buffer, params->destination);
+    // Stop walking, entry is found
+    return false;
+}
+
 bool tar_archive_unpack_file(
     TarArchive* archive,
     const char* archive_fname,
@@ -379,8 +826,13 @@ bool tar_archive_unpack_file(
     furi_assert(archive);
     furi_assert(archive_fname);
     furi_assert(destination);
-    if(mtar_find(&archive->tar, archive_fname) != MTAR_ESUCCESS) {
-        return false;
-    }
-    return archive_extract_current_file(archive, destination);
+    TarArchiveUnpackFileParams params = {
+        .archive_fname = archive_fname,
+        .destination = destination,
+        .found = false,
+        .success = false,
+    };
+
+    tar_archive_foreach_entry(archive, archive_unpack_file_cb, &params);
+    return params.found && params.success;
 }
@@ -20,6 +20,7 @@ typedef enum {
 
 TarArchive* tar_archive_alloc(Storage* storage);
 
+/* Archives with ".hs" extension are opened as heatshrink compressed tar for reading */
 bool tar_archive_open(TarArchive* archive, const char* path, TarOpenMode mode);
 
 void tar_archive_free(TarArchive* archive);
@@ -50,6 +51,11 @@ typedef bool (*tar_unpack_file_cb)(const char* name, bool is_directory, void* co
 
 void tar_archive_set_file_callback(TarArchive* archive, tar_unpack_file_cb callback, void* context);
 
+/* Optional callback with MD5 of each unpacked file - return false to stop unpacking */
+typedef bool (*tar_unpack_hash_cb)(const char* name, const uint8_t* md5, void* context);
+
+void tar_archive_set_hash_callback(TarArchive* archive, tar_unpack_hash_cb callback, void* context);
+
 /* Low-level API */
 bool tar_archive_dir_add_element(TarArchive* archive, const char* dirpath);
 
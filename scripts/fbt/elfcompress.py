@@ -0,0 +1,144 @@
+import logging
+import struct
+import subprocess
+from dataclasses import dataclass
+
+# Must match ELF_COMPRESS_* in lib/flipper_application/elf/elf_file.c
+ELFCOMPRESS_HEATSHRINK = 0x60000000 + 0x4853
+HEATSHRINK_WINDOW_SZ2 = 10
+HEATSHRINK_LOOKAHEAD_SZ2 = 5
+
+# Smaller sections are not worth a decoder setup on load
+_SECTION_MIN_SIZE = 512
+
+_SHT_NULL = 0
+_SHT_PROGBITS = 1
+_SHT_NOBITS = 8
+_SHF_ALLOC = 1 << 1
+_SHF_COMPRESSED = 1 << 11
+
+_ELF_HEADER = struct.Struct("<16sHHIIIIIHHHHHH")
+_SECTION_HEADER = struct.Struct("<IIIIIIIIII")
+_COMPRESSION_HEADER = struct.Struct("<III")
+
+# Section header fields
+_SH_FLAGS = 2
+_SH_OFFSET = 4
+_SH_SIZE = 5
+_SH_ADDRALIGN = 8
+
+
+@dataclass
+class ElfCompressionStats:
+    sections: int = 0
+    raw_size: int = 0
+    compressed_size: int = 0
+    file_size: int = 0
+    compressed_file_size: int = 0
+
+
+_hs2_unavailable = False
+
+
+def heatshrink_compress(data: bytes) -> bytes:
+    global _hs2_unavailable
+    if not _hs2_unavailable:
+        try:
+            import heatshrink2
+
+            return heatshrink2.compress(
+                data,
+                window_sz2=HEATSHRINK_WINDOW_SZ2,
+                lookahead_sz2=HEATSHRINK_LOOKAHEAD_SZ2,
+            )
+        except ImportError:
+            _hs2_unavailable = True
+            logging.getLogger().info(
+                "heatshrink2 module is missing, using heatshrink cli util"
+            )
+
+    return subprocess.check_output(
+        [
+            "heatshrink",
+            "-e",
+            f"-w{HEATSHRINK_WINDOW_SZ2}",
+            f"-l{HEATSHRINK_LOOKAHEAD_SZ2}",
+        ],
+        input=data,
+    )
+
+
+def compress_elf_sections(
+    elf_path: str, out_path: str, compress=heatshrink_compress
+) -> ElfCompressionStats:
+    """Compress allocatable sections of relocatable ELF file
+
+    Compressed section has SHF_COMPRESSED flag and starts with Elf32_Chdr,
+    sections that don't get smaller are kept as is. File is laid out again,
+    so raw data of compressed sections is not kept.
+    """
+    with open(elf_path, "rb") as f:
+        elf = f.read()
+
+    header = list(_ELF_HEADER.unpack_from(elf, 0))
+    ident, e_shoff, e_ehsize, e_phnum = header[0], header[6], header[8], header[9]
+    e_shentsize, e_shnum = header[11], header[12]
+    if ident[:4] != b"\x7fELF" or ident[4] != 1 or ident[5] != 1:
+        raise ValueError(f"{elf_path}: not a 32-bit little endian ELF file")
+    if e_phnum:
+        raise ValueError(f"{elf_path}: only relocatable ELF files are supported")
+
+    stats = ElfCompressionStats(file_size=len(elf))
+    sections = [
+        list(_SECTION_HEADER.unpack_from(elf, e_shoff + index * e_shentsize))
+        for index in range(e_shnum)
+    ]
+
+    contents = {}
+    for index, section in enumerate(sections):
+        sh_type, sh_flags = section[1], section[_SH_FLAGS]
+        if sh_type in (_SHT_NULL, _SHT_NOBITS):
+            continue
+
+        offset, size = section[_SH_OFFSET], section[_SH_SIZE]
+        data = elf[offset : offset + size]
+
+        if (
+            sh_type == _SHT_PROGBITS
+            and (sh_flags & _SHF_ALLOC)
+            and not (sh_flags & _SHF_COMPRESSED)
+            and size >= _SECTION_MIN_SIZE
+        ):
+            packed = _COMPRESSION_HEADER.pack(
+                ELFCOMPRESS_HEATSHRINK, size, section[_SH_ADDRALIGN]
+            ) + compress(data)
+            if len(packed) < size:
+                data = packed
+                section[_SH_FLAGS] |= _SHF_COMPRESSED
+                section[_SH_ADDRALIGN] = 4
+                stats.sections += 1
+                stats.raw_size += size
+                stats.compressed_size += len(packed)
+
+        contents[index] = data
+
+    # Section data in original order, then section header table
+    out = bytearray(elf[:e_ehsize])
+    for index in sorted(contents, key=lambda index: sections[index][_SH_OFFSET]):
+        out += bytes(-len(out) % max(sections[index][_SH_ADDRALIGN], 1))
+        sections[index][_SH_OFFSET] = len(out)
+        sections[index][_SH_SIZE] = len(contents[index])
+        out += contents[index]
+
+    out += bytes(-len(out) % 4)
+    header[6] = len(out)
+    for section in sections:
+        entry = _SECTION_HEADER.pack(*section)
+        out += entry + bytes(e_shentsize - len(entry))
+    out[: _ELF_HEADER.size] = _ELF_HEADER.pack(*header)
+
+    with open(out_path, "wb") as f:
+        f.write(out)
+
+    stats.compressed_file_size = len(out)
+    return stats
@@ -8,6 +8,7 @@ from typing import Optional
 import SCons.Warnings
 from ansi.color import fg
 from fbt.appmanifest import FlipperApplication, FlipperAppType, FlipperManifestException
+from fbt.elfcompress import compress_elf_sections
 from fbt.elfmanifest import assemble_manifest_data
 from fbt.fapassets import FileBundler
 from fbt.sdk.cache import SdkCache
@@ -363,6 +364,16 @@ def prepare_app_files(target, source, env):
     bundler.export(files_section_node.abspath)
 
 
+def compress_app_sections(target, source, env):
+    fap_node = target[0]
+    stats = compress_elf_sections(fap_node.abspath, fap_node.abspath)
+    print(
+        f"\t{fap_node.name}: {stats.sections} sections "
+        f"{stats.raw_size} -> {stats.compressed_size} bytes, "
+        f"file {stats.file_size} -> {stats.compressed_file_size} bytes"
+    )
+
+
 def generate_embed_app_metadata_actions(source, target, env, for_signature):
     app = env["APP"]
 
@@ -394,6 +405,9 @@ def generate_embed_app_metadata_actions(source, target, env, for_signature):
         )
     )
 
+    if app.fap_compress_sections:
+        actions.append(Action(compress_app_sections, "$APPCOMPRESS_COMSTR"))
+
     return Action(actions)
 
 
@@ -454,6 +468,7 @@ def generate(env, **kw):
             APPMETA_COMSTR="\tAPPMETA\t${TARGET}",
             APPFILE_COMSTR="\tAPPFILE\t${TARGET}",
             APPMETAEMBED_COMSTR="\tFAP\t${TARGET}",
+            APPCOMPRESS_COMSTR="\tFAPZ\t${TARGET}",
             APPCHECK_COMSTR="\tAPPCHK\t${SOURCE}",
         )
 
@@ -79,7 +79,7 @@ class HardwareTargetLoader:
             accepted_sources = list(
                 filter(
                     lambda f: f.name not in seen_filenames,
-                    self.env.GlobRecursive("*.c", target_dir),
+                    self.env.GlobRecursive("*.c", target_dir, exclude=["host"]),
                 )
             )
             seen_filenames.update(f.name for f in accepted_sources)
@@ -201,6 +201,7 @@ def gen_sdk_data(sdk_cache: SdkCache):
 
     api_def.append(f"const int elf_api_version = {sdk_cache.version.as_int()};")
 
+    # Bucket order for BucketedHashtableApiInterface
     api_def.append(
         "static constexpr auto elf_api_table = sort(create_array_t<sym_entry>("
     )
@@ -216,7 +217,7 @@ def gen_sdk_data(sdk_cache: SdkCache):
 
     api_def.append(",\n".join(api_lines))
 
-    api_def.append("));")
+    api_def.append("), sym_entry_bucket_order{});")
     return api_def
 
 
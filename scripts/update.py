@@ -1,8 +1,11 @@
 #!/usr/bin/env python3
 
+import io
 import math
 import os
 import shutil
+import struct
+import subprocess
 import tarfile
 import zlib
 from os.path import exists, join
@@ -23,8 +26,16 @@ class Main(App):
     RESOURCE_TAR_MODE = "w:"
     RESOURCE_TAR_FORMAT = tarfile.USTAR_FORMAT
     RESOURCE_FILE_NAME = "resources.tar"
+    RESOURCE_COMPRESSED_FILE_NAME = "resources.tar.hs"
     RESOURCE_ENTRY_NAME_MAX_LENGTH = 100
 
+    # Must match TAR_ARCHIVE_HEATSHRINK_* in lib/toolbox/tar/tar_archive.c
+    RESOURCE_HEATSHRINK_HEADER = struct.Struct("<4sBBBB")
+    RESOURCE_HEATSHRINK_MAGIC = b"HSTR"
+    RESOURCE_HEATSHRINK_VERSION = 1
+    RESOURCE_HEATSHRINK_WINDOW_SZ2 = 12
+    RESOURCE_HEATSHRINK_LOOKAHEAD_SZ2 = 5
+
     WHITELISTED_STACK_TYPES = set(
         map(
             get_stack_type,
@@ -53,6 +64,12 @@ class Main(App):
             "--dfu", dest="dfu", default="", required=False
         )
         self.parser_generate.add_argument("-r", dest="resources", required=False)
+        self.parser_generate.add_argument(
+            "--compress-resources",
+            dest="compress_resources",
+            action="store_true",
+            help="Pack resources as heatshrink compressed tar",
+        )
         self.parser_generate.add_argument("--stage", dest="stage", required=True)
         self.parser_generate.add_argument(
             "--radio", dest="radiobin", default="", required=False
@@ -125,7 +142,11 @@ class Main(App):
                 self.args.radiobin, join(self.args.directory, radiobin_basename)
             )
         if self.args.resources:
-            resources_basename = self.RESOURCE_FILE_NAME
+            resources_basename = (
+                self.RESOURCE_COMPRESSED_FILE_NAME
+                if self.args.compress_resources
+                else self.RESOURCE_FILE_NAME
+            )
             SlideshowMain(no_exit=True)(
                 [
                     "-i",
@@ -138,7 +159,9 @@ class Main(App):
                 ]
             )
             if not self.package_resources(
-                self.args.resources, join(self.args.directory, resources_basename)
+                self.args.resources,
+                join(self.args.directory, resources_basename),
+                self.args.compress_resources,
             ):
                 return 3
 
@@ -236,16 +259,56 @@ class Main(App):
         tarinfo.uname = tarinfo.gname = "furippa"
         return tarinfo
 
-    def package_resources(self, srcdir: str, dst_name: str):
+    def _heatshrink_compress(self, data: bytes) -> bytes:
         try:
-            with tarfile.open(
-                dst_name, self.RESOURCE_TAR_MODE, format=self.RESOURCE_TAR_FORMAT
-            ) as tarball:
-                tarball.add(
-                    srcdir,
-                    arcname="",
-                    filter=self._tar_filter,
-                )
+            import heatshrink2
+
+            return heatshrink2.compress(
+                data,
+                window_sz2=self.RESOURCE_HEATSHRINK_WINDOW_SZ2,
+                lookahead_sz2=self.RESOURCE_HEATSHRINK_LOOKAHEAD_SZ2,
+            )
+        except ImportError:
+            self.logger.info("heatshrink2 module is missing, using heatshrink cli util")
+
+        return subprocess.check_output(
+            [
+                "heatshrink",
+                "-e",
+                f"-w{self.RESOURCE_HEATSHRINK_WINDOW_SZ2}",
+                f"-l{self.RESOURCE_HEATSHRINK_LOOKAHEAD_SZ2}",
+            ],
+            input=data,
+        )
+
+    def package_resources(self, srcdir: str, dst_name: str, compress: bool = False):
+        try:
+            with io.BytesIO() as tar_data:
+                with tarfile.open(
+                    fileobj=tar_data,
+                    mode=self.RESOURCE_TAR_MODE,
+                    format=self.RESOURCE_TAR_FORMAT,
+                ) as tarball:
+                    tarball.add(
+                        srcdir,
+                        arcname="",
+                        filter=self._tar_filter,
+                    )
+                data = tar_data.getvalue()
+
+            if compress:
+                raw_size = len(data)
+                data = self.RESOURCE_HEATSHRINK_HEADER.pack(
+                    self.RESOURCE_HEATSHRINK_MAGIC,
+                    self.RESOURCE_HEATSHRINK_VERSION,
+                    self.RESOURCE_HEATSHRINK_WINDOW_SZ2,
+                    self.RESOURCE_HEATSHRINK_LOOKAHEAD_SZ2,
+                    0,
+                ) + self._heatshrink_compress(data)
+                self.logger.info(f"Resources compressed {raw_size} -> {len(data)}")
+
+            with open(dst_name, "wb") as f:
+                f.write(data)
             return True
         except ValueError as e:
             self.logger.error(f"Cannot package resources: {e}")